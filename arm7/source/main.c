@@ -0,0 +1,96 @@
+/**
+ * main.c - ARM7 entry point
+ *
+ * Starts the same calico services as the stock ARM7 binary (keypad,
+ * touch, RTC, power, block devices, sound, mic, wireless, Maxmod), then
+ * a low-priority worker thread for the ARM9's coproc.h jobs.
+ *
+ * The ARM9 sends each job as a descriptor address over PXI. The worker
+ * takes them from its mailbox in order, runs them straight out of main
+ * RAM (the ARM7 has no data cache; the ARM9 flushed everything the job
+ * reads), writes the result into the descriptor and echoes the message
+ * back. Jobs run below every service thread, so audio and input are
+ * never held up by a long expansion.
+ */
+
+#include <nds.h>
+#include <maxmod7.h>
+#include "coproc.h"
+#include "sm_config.h"
+
+/* ========================================================================
+ * Job Worker
+ * ======================================================================== */
+
+static Thread  job_thread;
+static Mailbox job_mailbox;
+static u32     job_slots[COPROC_QUEUE_MAX];
+static u8      job_stack[COPROC_ARM7_STACK_SIZE] __attribute__((aligned(8)));
+
+static int job_main(void* arg) {
+    (void)arg;
+    for (;;) {
+        u32 msg = mailboxRecv(&job_mailbox);
+        CoprocDesc* d = coproc_desc_from_msg(msg);
+        d->result = coproc_job_run(d);
+        pxiSend(COPROC_PXI_CHANNEL, msg);
+    }
+    return 0;
+}
+
+static void job_start(u8 prio) {
+    mailboxPrepare(&job_mailbox, job_slots, COPROC_QUEUE_MAX);
+    pxiSetMailbox(COPROC_PXI_CHANNEL, &job_mailbox);
+    threadPrepare(&job_thread, job_main, NULL,
+                  &job_stack[sizeof(job_stack)], prio);
+    threadStart(&job_thread);
+}
+
+/* ========================================================================
+ * Main
+ * ======================================================================== */
+
+int main(void) {
+    /* Read settings from NVRAM */
+    envReadNvramSettings();
+
+    /* Extended keypad server (X/Y/hinge) */
+    keypadStartExtServer();
+
+    /* Configure and enable VBlank interrupt */
+    lcdSetIrqMask(DISPSTAT_IE_ALL, DISPSTAT_IE_VBLANK);
+    irqEnable(IRQ_VBLANK);
+
+    /* RTC */
+    rtcInit();
+    rtcSyncTime();
+
+    /* Power management */
+    pmInit();
+
+    /* Block device peripherals (SD, DLDI) */
+    blkInit();
+
+    /* Touch screen */
+    touchInit();
+    touchStartServer(80, MAIN_THREAD_PRIO);
+
+    /* Sound and mic */
+    soundStartServer(MAIN_THREAD_PRIO - 0x10);
+    micStartServer(MAIN_THREAD_PRIO - 0x18);
+
+    /* Wireless manager */
+    wlmgrStartServer(MAIN_THREAD_PRIO - 8);
+
+    /* Maxmod */
+    mmInstall(MAIN_THREAD_PRIO + 1);
+
+    /* Jobs last: lowest priority of all, and the ARM9's coproc_init
+     * waits for this channel to come up */
+    job_start(MAIN_THREAD_PRIO + 2);
+
+    while (pmMainLoop()) {
+        threadWaitForVBlank();
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+/**
+ * fat.h - Host stand-in for libfat
+ *
+ * The host has a real filesystem; fopen() works relative to the current
+ * directory. fatInitDefault() still reports failure so save.c keeps its
+ * in-memory path and tests never touch a real .sav file.
+ *
+ * Implemented in: host/source/nds_shim.c
+ */
+
+#ifndef HOST_FAT_H
+#define HOST_FAT_H
+
+#include <stdbool.h>
+
+bool fatInitDefault(void);
+
+#endif /* HOST_FAT_H */
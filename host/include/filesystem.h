@@ -0,0 +1,18 @@
+/**
+ * filesystem.h - Host stand-in for libfilesystem (NitroFS)
+ *
+ * There is no ROM image on the host; NitroFS paths are resolved against
+ * the current directory, so nitroFSInit() just reports success and
+ * ROOM_PACK_PATH is pointed at the pack host/Makefile generates.
+ *
+ * Implemented in: host/source/nds_shim.c
+ */
+
+#ifndef HOST_FILESYSTEM_H
+#define HOST_FILESYSTEM_H
+
+#include <stdbool.h>
+
+bool nitroFSInit(const char* basepath);
+
+#endif /* HOST_FILESYSTEM_H */
@@ -0,0 +1,211 @@
+/**
+ * nds.h - Host (x86) stand-in for libnds
+ *
+ * Just enough of the libnds API for the game sources to compile and run
+ * the DEBUG_TESTS suite natively. Video, OAM and DMA calls are no-ops or
+ * memcpy into plain arrays; keys always read as released; pmMainLoop()
+ * returns false so main() exits after the tests.
+ *
+ * Hardware timers are emulated from the host monotonic clock at the DS
+ * bus rate, so profiler.c and benchmarks report comparable tick counts.
+ *
+ * Only add what the game actually uses. Host builds never define ARM9.
+ *
+ * Implemented in: host/source/nds_shim.c
+ */
+
+#ifndef HOST_NDS_H
+#define HOST_NDS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ========================================================================
+ * Types
+ * ======================================================================== */
+
+typedef uint8_t           u8;
+typedef uint16_t          u16;
+typedef uint32_t          u32;
+typedef uint64_t          u64;
+typedef int8_t            s8;
+typedef int16_t           s16;
+typedef int32_t           s32;
+typedef int64_t           s64;
+typedef volatile uint16_t vu16;
+typedef volatile uint32_t vu32;
+
+#define BIT(n)          (1u << (n))
+#define RGB15(r, g, b)  ((r) | ((g) << 5) | ((b) << 10))
+
+#define SCREEN_WIDTH    256
+#define SCREEN_HEIGHT   192
+
+#define BUS_CLOCK       33513982
+
+/* TCM placement is meaningless on the host */
+#define ITCM_CODE
+#define DTCM_DATA
+#define DTCM_BSS
+
+/* ========================================================================
+ * Keys
+ * ======================================================================== */
+
+#define KEY_A       BIT(0)
+#define KEY_B       BIT(1)
+#define KEY_SELECT  BIT(2)
+#define KEY_START   BIT(3)
+#define KEY_RIGHT   BIT(4)
+#define KEY_LEFT    BIT(5)
+#define KEY_UP      BIT(6)
+#define KEY_DOWN    BIT(7)
+#define KEY_R       BIT(8)
+#define KEY_L       BIT(9)
+#define KEY_X       BIT(10)
+#define KEY_Y       BIT(11)
+#define KEY_TOUCH   BIT(12)
+#define KEY_LID     BIT(13)
+
+void scanKeys(void);
+u32  keysDown(void);
+u32  keysHeld(void);
+u32  keysUp(void);
+
+/* ========================================================================
+ * System
+ * ======================================================================== */
+
+bool pmMainLoop(void);
+void swiWaitForVBlank(void);
+void defaultExceptionHandler(void);
+
+void DC_FlushRange(const void* base, u32 size);
+void DC_InvalidateRange(const void* base, u32 size);
+
+void dmaCopy(const void* src, void* dst, u32 size);
+
+/* DMA channel registers: stored only, HBlank transfers are not emulated */
+#define DMA_ENABLE      BIT(31)
+#define DMA_START_HBL   BIT(29)
+#define DMA_REPEAT      BIT(25)
+#define DMA_16_BIT      0
+#define DMA_SRC_INC     0
+#define DMA_DST_RESET   (3u << 21)
+
+extern vu32 host_dma_cr[4];
+extern volatile uintptr_t host_dma_src[4];
+extern volatile uintptr_t host_dma_dest[4];
+
+#define DMA_CR(n)       (host_dma_cr[(n)])
+#define DMA_SRC(n)      (host_dma_src[(n)])
+#define DMA_DEST(n)     (host_dma_dest[(n)])
+
+/* ========================================================================
+ * Timers (emulated from the host clock, see nds_shim.c)
+ * ======================================================================== */
+
+#define TIMER_DIV_1     0
+#define TIMER_DIV_64    1
+#define TIMER_DIV_256   2
+#define TIMER_DIV_1024  3
+#define TIMER_CASCADE   BIT(2)
+#define TIMER_IRQ_REQ   BIT(6)
+#define TIMER_ENABLE    BIT(7)
+
+extern vu16 host_timer_cr[4];
+vu16* host_timer_data(int timer);
+
+#define TIMER_CR(n)     (host_timer_cr[(n)])
+#define TIMER_DATA(n)   (*host_timer_data(n))
+
+/* ========================================================================
+ * Video
+ * ======================================================================== */
+
+#define MODE_0_2D           0x10000
+#define DISPLAY_BG0_ACTIVE  BIT(8)
+#define DISPLAY_BG1_ACTIVE  BIT(9)
+#define DISPLAY_BG2_ACTIVE  BIT(10)
+#define DISPLAY_BG3_ACTIVE  BIT(11)
+#define DISPLAY_SPR_ACTIVE  BIT(12)
+#define DISPLAY_SPR_1D      BIT(4)
+
+typedef enum {
+    VRAM_A_MAIN_BG_0x06000000 = 1,
+    VRAM_B_MAIN_SPRITE_0x06400000 = 2,
+    VRAM_C_SUB_BG = 4,
+    VRAM_D_SUB_SPRITE = 4,
+    VRAM_E_LCD = 0,
+    VRAM_H_SUB_BG = 1,
+    VRAM_I_SUB_BG_0x06208000 = 1,
+} HostVramConfig;
+
+void videoSetMode(u32 mode);
+void videoSetModeSub(u32 mode);
+void vramSetBankA(int cfg);
+void vramSetBankB(int cfg);
+void vramSetBankC(int cfg);
+void vramSetBankD(int cfg);
+void vramSetBankE(int cfg);
+void vramSetBankH(int cfg);
+void vramSetBankI(int cfg);
+
+extern u16  BG_PALETTE[512];
+extern u16  BG_PALETTE_SUB[512];
+extern u16  SPRITE_PALETTE[512];
+extern vu16 REG_MASTER_BRIGHT;
+extern vu16 REG_MASTER_BRIGHT_SUB;
+
+/* BGnHOFS/BGnVOFS pairs for the main engine, laid out like hardware */
+extern vu16 host_bg_ofs[8];
+#define REG_BG0HOFS     (host_bg_ofs[0])
+#define REG_BG0VOFS     (host_bg_ofs[1])
+
+/* Backgrounds */
+typedef enum { BgType_Text4bpp } BgType;
+typedef enum { BgSize_T_256x256, BgSize_T_512x256, BgSize_T_512x512 } BgSize;
+
+int  bgInit(int layer, BgType type, BgSize size, int map_base, int tile_base);
+int  bgInitSub(int layer, BgType type, BgSize size, int map_base, int tile_base);
+void bgSetPriority(int id, int priority);
+void bgSetScroll(int id, int x, int y);
+void bgUpdate(void);
+u16* bgGetGfxPtr(int id);
+u16* bgGetMapPtr(int id);
+
+/* Sprites */
+typedef struct { int unused; } OamState;
+typedef enum { SpriteMapping_1D_32 } SpriteMapping;
+typedef enum {
+    SpriteSize_8x8, SpriteSize_16x16, SpriteSize_32x32, SpriteSize_64x64,
+    SpriteSize_16x8, SpriteSize_32x8, SpriteSize_32x16, SpriteSize_64x32,
+    SpriteSize_8x16, SpriteSize_8x32, SpriteSize_16x32, SpriteSize_32x64,
+} SpriteSize;
+typedef enum { SpriteColorFormat_16Color } SpriteColorFormat;
+
+extern OamState oamMain;
+extern OamState oamSub;
+
+void oamInit(OamState* oam, SpriteMapping mapping, bool ext_palette);
+void oamClear(OamState* oam, int start, int count);
+void oamClearSprite(OamState* oam, int index);
+void oamUpdate(OamState* oam);
+u16* oamGetGfxPtr(OamState* oam, int gfx_offset_index);
+void oamSet(OamState* oam, int id, int x, int y, int priority,
+            int palette_alpha, SpriteSize size, SpriteColorFormat format,
+            const void* gfx, int affine_index, bool size_double,
+            bool hide, bool hflip, bool vflip, bool mosaic);
+
+/* ========================================================================
+ * Console
+ * ======================================================================== */
+
+void consoleInit(void* console, int layer, BgType type, BgSize size,
+                 int map_base, int tile_base, bool main_display,
+                 bool load_graphics);
+void consoleClear(void);
+int  iprintf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#endif /* HOST_NDS_H */
@@ -0,0 +1,24 @@
+/**
+ * dldi.h - Host stand-in for the libnds DLDI interface
+ *
+ * Implemented in: host/source/nds_shim.c
+ */
+
+#ifndef HOST_NDS_DLDI_H
+#define HOST_NDS_DLDI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t features;
+} DISC_INTERFACE;
+
+typedef struct {
+    DISC_INTERFACE disc;
+} DLDI_INTERFACE;
+
+/* Always false on host: no DLDI driver, no FAT */
+bool dldiDumpInternal(DLDI_INTERFACE* out);
+
+#endif /* HOST_NDS_DLDI_H */
@@ -0,0 +1,198 @@
+/**
+ * nds_shim.c - Host (x86) stand-in for libnds
+ *
+ * VRAM, palettes and OAM graphics are plain static arrays so the game
+ * code can write to them exactly as it does on hardware. Everything that
+ * would program display hardware is a no-op.
+ */
+
+#include <nds.h>
+#include <nds/dldi.h>
+#include <fat.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* ========================================================================
+ * Memory Stand-ins
+ * ======================================================================== */
+
+#define HOST_BG_COUNT       8        /* 4 main + 4 sub */
+#define HOST_BG_HALFWORDS   0x10000  /* 128KB per layer: map + tiles */
+#define HOST_BG_GFX_OFFSET  0x4000   /* Tiles start 32KB into the layer */
+#define HOST_OBJ_HALFWORDS  0x10000
+
+static u16 bg_vram[HOST_BG_COUNT][HOST_BG_HALFWORDS];
+static u16 obj_vram[HOST_OBJ_HALFWORDS];
+static int bg_next_id;
+
+u16  BG_PALETTE[512];
+u16  BG_PALETTE_SUB[512];
+u16  SPRITE_PALETTE[512];
+vu16 REG_MASTER_BRIGHT;
+vu16 REG_MASTER_BRIGHT_SUB;
+vu16 host_bg_ofs[8];
+
+vu32 host_dma_cr[4];
+volatile uintptr_t host_dma_src[4];
+volatile uintptr_t host_dma_dest[4];
+
+OamState oamMain;
+OamState oamSub;
+
+/* ========================================================================
+ * System
+ * ======================================================================== */
+
+bool pmMainLoop(void)              { return false; }
+void swiWaitForVBlank(void)        { }
+void defaultExceptionHandler(void) { }
+
+void scanKeys(void)  { }
+u32  keysDown(void)  { return 0; }
+u32  keysHeld(void)  { return 0; }
+u32  keysUp(void)    { return 0; }
+
+void DC_FlushRange(const void* base, u32 size)      { (void)base; (void)size; }
+void DC_InvalidateRange(const void* base, u32 size) { (void)base; (void)size; }
+
+void dmaCopy(const void* src, void* dst, u32 size) {
+    memcpy(dst, src, size);
+}
+
+bool fatInitDefault(void) {
+    return false;
+}
+
+bool nitroFSInit(const char* basepath) {
+    (void)basepath;
+    return true;
+}
+
+bool dldiDumpInternal(DLDI_INTERFACE* out) {
+    memset(out, 0, sizeof(*out));
+    return false;
+}
+
+/* ========================================================================
+ * Timers
+ *
+ * Counters are derived from CLOCK_MONOTONIC at BUS_CLOCK rate on every
+ * read of TIMER_DATA. Prescalers and one level of cascade are honoured;
+ * reload values written to TIMER_DATA are not (counters always count up
+ * from process start), which is all the profiler needs.
+ * ======================================================================== */
+
+vu16 host_timer_cr[4];
+static vu16 timer_data[4];
+
+static const int prescale_shift[4] = { 0, 6, 8, 10 };
+
+static uint64_t bus_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec)
+           * BUS_CLOCK / 1000000000ull;
+}
+
+static uint64_t timer_count(int t) {
+    return bus_ticks() >> prescale_shift[host_timer_cr[t] & 3];
+}
+
+vu16* host_timer_data(int timer) {
+    if (timer < 0 || timer > 3) timer = 0;
+
+    u16 cr = host_timer_cr[timer];
+    if (cr & TIMER_ENABLE) {
+        if ((cr & TIMER_CASCADE) && timer > 0) {
+            timer_data[timer] = (u16)(timer_count(timer - 1) >> 16);
+        } else {
+            timer_data[timer] = (u16)timer_count(timer);
+        }
+    }
+    return &timer_data[timer];
+}
+
+/* ========================================================================
+ * Video
+ * ======================================================================== */
+
+void videoSetMode(u32 mode)    { (void)mode; }
+void videoSetModeSub(u32 mode) { (void)mode; }
+void vramSetBankA(int cfg)     { (void)cfg; }
+void vramSetBankB(int cfg)     { (void)cfg; }
+void vramSetBankC(int cfg)     { (void)cfg; }
+void vramSetBankD(int cfg)     { (void)cfg; }
+void vramSetBankE(int cfg)     { (void)cfg; }
+void vramSetBankH(int cfg)     { (void)cfg; }
+void vramSetBankI(int cfg)     { (void)cfg; }
+
+int bgInit(int layer, BgType type, BgSize size, int map_base, int tile_base) {
+    (void)layer; (void)type; (void)size; (void)map_base; (void)tile_base;
+    return bg_next_id++ % HOST_BG_COUNT;
+}
+
+int bgInitSub(int layer, BgType type, BgSize size, int map_base, int tile_base) {
+    return bgInit(layer, type, size, map_base, tile_base);
+}
+
+void bgSetPriority(int id, int priority) { (void)id; (void)priority; }
+void bgSetScroll(int id, int x, int y)   { (void)id; (void)x; (void)y; }
+void bgUpdate(void)                      { }
+
+u16* bgGetGfxPtr(int id) {
+    return bg_vram[id % HOST_BG_COUNT] + HOST_BG_GFX_OFFSET;
+}
+
+u16* bgGetMapPtr(int id) {
+    return bg_vram[id % HOST_BG_COUNT];
+}
+
+void oamInit(OamState* oam, SpriteMapping mapping, bool ext_palette) {
+    (void)oam; (void)mapping; (void)ext_palette;
+}
+
+void oamClear(OamState* oam, int start, int count) {
+    (void)oam; (void)start; (void)count;
+}
+
+void oamClearSprite(OamState* oam, int index) { (void)oam; (void)index; }
+void oamUpdate(OamState* oam)                 { (void)oam; }
+
+u16* oamGetGfxPtr(OamState* oam, int gfx_offset_index) {
+    (void)oam;
+    /* 1D_32 mapping: one index = 32 bytes = 16 halfwords */
+    return obj_vram + (gfx_offset_index * 16) % HOST_OBJ_HALFWORDS;
+}
+
+void oamSet(OamState* oam, int id, int x, int y, int priority,
+            int palette_alpha, SpriteSize size, SpriteColorFormat format,
+            const void* gfx, int affine_index, bool size_double,
+            bool hide, bool hflip, bool vflip, bool mosaic) {
+    (void)oam; (void)id; (void)x; (void)y; (void)priority;
+    (void)palette_alpha; (void)size; (void)format; (void)gfx;
+    (void)affine_index; (void)size_double; (void)hide;
+    (void)hflip; (void)vflip; (void)mosaic;
+}
+
+/* ========================================================================
+ * Console: iprintf goes to stdout, escape codes and all
+ * ======================================================================== */
+
+void consoleInit(void* console, int layer, BgType type, BgSize size,
+                 int map_base, int tile_base, bool main_display,
+                 bool load_graphics) {
+    (void)console; (void)layer; (void)type; (void)size; (void)map_base;
+    (void)tile_base; (void)main_display; (void)load_graphics;
+}
+
+void consoleClear(void) { }
+
+int iprintf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = vprintf(fmt, args);
+    va_end(args);
+    return n;
+}
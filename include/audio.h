@@ -4,6 +4,17 @@
  * Music and SFX playback with priority system.
  * Area-based music switching on room transitions.
  *
+ * Maxmod's ARM7 half mixes and sequences; the ARM9 side here only sends
+ * it commands, at most once per SFX per frame. The soundbank lives in
+ * NitroFS: SFX samples stay resident, music modules are loaded one at a
+ * time (plus one preloaded during a door fade) and unloaded after use.
+ *
+ * Soundbank entries come from the AUDIO directory, named
+ *   music_<track>.it/.xm/.mod/.s3m   (MOD_MUSIC_<TRACK>, e.g. music_title.it)
+ *   sfx_<name>.wav                   (SFX_SFX_<NAME>, e.g. sfx_beam.wav)
+ * after the MusicID / SfxID names below. Missing entries play silence,
+ * and a build without a soundbank keeps all the bookkeeping but is mute.
+ *
  * Implemented in: source/audio.c (M14)
  */
 
@@ -53,9 +64,33 @@ typedef enum {
 } SfxID;
 
 void audio_init(void);
+
+/* Start Maxmod with the soundbank at path and load the SFX samples.
+ * False without a soundbank (audio stays muted). */
+bool audio_mount(const char* path);
+
+/* Advance SFX voices and issue this frame's SFX. Call once per frame. */
+void audio_update(void);
+
 void audio_play_music(MusicID id);
 void audio_stop_music(void);
+
+/* Load a track ahead of audio_play_music so switching to it doesn't
+ * read the soundbank mid-game (door fades). One preload at a time. */
+void audio_preload_music(MusicID id);
+
+/* Request an SFX for this frame. Requests are coalesced: the same SFX
+ * several times in one frame plays once. When all AUDIO_SFX_VOICES are
+ * busy it steals the lowest-priority (then oldest) voice, or is dropped
+ * if every voice outranks it. */
 void audio_play_sfx(SfxID id);
+
 MusicID audio_get_current_music(void);
+MusicID audio_get_preloaded_music(void);
+MusicID audio_area_music(uint8_t area_id);
+
+/* SFX voice state (for tests/debug) */
+int     audio_get_active_voices(void);
+SfxID   audio_get_voice_sfx(int voice);
 
 #endif /* AUDIO_H */
@@ -0,0 +1,46 @@
+/**
+ * bench.h - Micro-benchmarks for hot paths
+ *
+ * Times fixed_math, physics, collision and entity update loops with the
+ * profiler timer and reports ARM9 cycles per call. Results are compared
+ * against a baseline file (one "name cycles" pair per line); anything
+ * slower than BENCH_TOLERANCE_PCT is flagged as a regression. A missing
+ * baseline is written from the current run.
+ *
+ * Baselines are per machine: on DS they live on the SD card, on the
+ * host build next to the binary (make -C host bench).
+ *
+ * Only compiled in with -DDEBUG_BENCH.
+ *
+ * Implemented in: source/bench.c
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "sm_types.h"
+
+#define BENCH_BASELINE_FILE  "SuperMetroidDS.bench"
+#define BENCH_TOLERANCE_PCT  15    /* Slower than baseline by more = regression */
+#define BENCH_MIN_DELTA_X10  10    /* ...and by at least 1 cycle/call (timer noise) */
+#define BENCH_REPEATS        5     /* Best-of-N to reject IRQ / cache noise */
+#define BENCH_MAX_RESULTS    16
+
+typedef struct {
+    const char* name;
+    uint32_t    calls;           /* Calls per repeat */
+    uint32_t    cycles_x10;      /* Best repeat, ARM9 cycles per call x10 */
+    uint32_t    baseline_x10;    /* 0 = no baseline */
+    bool        regressed;
+} BenchResult;
+
+/* Run every benchmark, compare with / create the baseline file.
+ * Returns false if any benchmark regressed. Leaves the room unloaded
+ * and entity pools empty. */
+bool bench_run_all(void);
+
+/* Results of the last bench_run_all() */
+int                bench_get_result_count(void);
+const BenchResult* bench_get_result(int index);
+
+#endif /* BENCH_H */
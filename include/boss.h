@@ -1,14 +1,19 @@
 /**
  * boss.h - Boss AI framework
  *
- * Single active boss instance with type-specific AI dispatch.
+ * Single active boss instance driven by a behavior program (boss_vm.h).
  * Bosses are separate from the enemy pool -- they have unique
- * state machines, vulnerability windows, and multi-phase logic.
+ * state machines, vulnerability windows, and multi-phase logic, all
+ * expressed as data run by one interpreter.
  *
- * OAM: borrows particle slots (88-111) since particles aren't
- * implemented yet. Each boss can use up to 16 OAM sprites.
+ * A boss is hit through its parts (up to BOSS_MAX_PARTS body-relative
+ * boxes from the program): each is a broadphase entry, so a shot only
+ * tests the parts near it, and the part it lands on decides whether
+ * the hit is blocked or scaled. The boss draws as one metasprite with
+ * a piece per part.
  *
- * Implemented in: source/boss.c (M13)
+ * Implemented in: source/boss.c (M13), source/boss_vm.c,
+ *                 source/boss_programs.c
  */
 
 #ifndef BOSS_H
@@ -16,6 +21,7 @@
 
 #include "sm_types.h"
 #include "physics.h"
+#include "snapshot.h"
 
 /* Boss type IDs */
 typedef enum {
@@ -33,10 +39,6 @@ typedef enum {
     BOSS_TYPE_COUNT
 } BossTypeID;
 
-/* Boss OAM allocation (borrow from unimplemented particles) */
-#define BOSS_OAM_START   OAM_PARTICLE_START  /* 88 */
-#define BOSS_OAM_COUNT   16
-
 /* Boss instance (only one active at a time) */
 typedef struct {
     BossTypeID  type;
@@ -68,6 +70,14 @@ extern Boss g_boss;
 /* Initialize boss system (zeros state) */
 void boss_init(void);
 
+/* Program directory: boss_spawn() runs <dir>/boss_NN.bin (NN = type)
+ * instead of the built-in program when that file exists and is valid. */
+void boss_mount(const char* dir);
+void boss_unmount(void);
+
+/* Write a type's built-in program in the file format boss_mount reads */
+bool boss_program_export(BossTypeID type, const char* path);
+
 /* Spawn a boss at world position (x, y) */
 void boss_spawn(BossTypeID type, fx32 x, fx32 y);
 
@@ -80,7 +90,23 @@ void boss_render(void);
 /* Apply damage to boss (respects vulnerability and invuln timer) */
 void boss_damage(int32_t damage);
 
+/* Parts of the active boss (0 when none is active) */
+int  boss_part_count(void);
+
+/* World box of a part; false if absent in the current phase */
+bool boss_part_box(int part, Vec2fx* pos, AABBfx* box);
+
+/* Damage a hit on this part would deal now (0 = blocked by armor) */
+int32_t boss_part_damage(int part, int32_t damage);
+
+/* Apply a hit landing on a part: multiplier, then boss_damage rules */
+void boss_damage_part(int part, int32_t damage);
+
 /* Query */
 bool boss_is_active(void);
 
+/* Snapshot section: g_boss, plus the running program while active */
+void boss_snapshot_save(SnapshotWriter* w);
+void boss_snapshot_load(SnapshotReader* r);
+
 #endif /* BOSS_H */
@@ -0,0 +1,321 @@
+/**
+ * boss_vm.h - Boss behavior programs and their interpreter
+ *
+ * A boss is a BossProgramHeader (stats and hit rules) plus a flat array
+ * of BossOps. BOP_STATE markers split the ops into per-state scripts;
+ * ops before the first marker run once at spawn. Each frame the script
+ * of g_boss.ai_state runs from its marker to the next one, a GOTO, or
+ * DEACTIVATE.
+ *
+ * Ops read and write Boss fields by BossField index, so a program never
+ * holds pointers and the same bytes work as built-in const data, a file
+ * in NitroFS or a snapshot section. Everything is checked once by
+ * boss_program_load(); the interpreter trusts a loaded program.
+ *
+ * The header also lists the boss's parts: body-relative hit regions,
+ * each armor or a damage-scaled weak point, optionally tied to phases.
+ * The body hitbox stays the physics box; shots and contact use parts.
+ *
+ * Field values are raw: counters are integers, positions and params are
+ * fx32. Ops that take "px" operands convert with INT_TO_FX.
+ *
+ * Built-in programs: source/boss_programs.c
+ * Implemented in: source/boss_vm.c
+ */
+
+#ifndef BOSS_VM_H
+#define BOSS_VM_H
+
+#include "sm_types.h"
+#include "sm_config.h"
+#include "boss.h"
+
+#define BOSS_PROGRAM_MAGIC    0x50534253  /* "SBSP" */
+#define BOSS_PROGRAM_VERSION  2
+
+#define BOSS_PROGRAM_MAX_OPS     96
+#define BOSS_PROGRAM_MAX_STATES  16
+#define BOSS_MAX_PHASES          3
+#define BOSS_MAX_POINTS          4
+#define BOSS_NO_STATE            0xFF
+
+/* ========================================================================
+ * Opcodes
+ *
+ * Operand use per op (a/b/c are u8, n/m int16, v/w fx32 or raw int):
+ *   STATE       a=state  b=BSF_* flags
+ *   GOTO        a=state                      (ai_timer = 0, ends frame)
+ *   GOTO_CYCLE  a=first  b=field  n=count    (state = a + field % n; field++)
+ *   DEACTIVATE                               (despawn, ends frame)
+ *   IF          a=BC_*   b=field  c=field2  n,m  v   ... END
+ *   SET/ADD     a=field  v
+ *   COPY        a=dst    b=src
+ *   SET_MOD     a=dst    b=src    n=modulus  v=base    (dst = v + src % n)
+ *   SET_HP      v=hp                         (hp = hp_max = v)
+ *   MOVE        a=axis   v=velocity
+ *   TOWARD      a=axis   b=BTW_*  v=speed    (step toward Samus)
+ *   MOVE_TO     a=axis   b=field  n=px  v=velocity   (stop at field + n)
+ *   RETURN_TO   a=axis   b=field  n=tolerance px  v=speed
+ *   PATROL      a=axis   b=direction field  n=range px  v=speed
+ *   OSC         a=axis   b=angle field  n=angle step  v=amplitude
+ *   SWEEP       a=axis   n=frames  v=width   (there and back on ai_timer)
+ *   WARP_POINT  a=index field                (anchor + points[field & 3];
+ *                                             param_b = INT_TO_FX(index))
+ *   FIRE        a=FIRE_AIM_* b=ProjectileTypeID  n,m=offset px  v=vx  w=vy
+ *   SHAKE       n=frames m=intensity
+ *   HURT        n=damage to Samus
+ *
+ * MOVE_TO and RETURN_TO set the frame's "arrived" flag (BC_ARRIVED)
+ * when they snap onto their target.
+ * ======================================================================== */
+
+typedef enum {
+    BOP_STATE = 0,
+    BOP_GOTO,
+    BOP_GOTO_CYCLE,
+    BOP_DEACTIVATE,
+    BOP_IF,
+    BOP_END,
+    BOP_SET,
+    BOP_ADD,
+    BOP_COPY,
+    BOP_SET_MOD,
+    BOP_SET_HP,
+    BOP_MOVE,
+    BOP_TOWARD,
+    BOP_MOVE_TO,
+    BOP_RETURN_TO,
+    BOP_PATROL,
+    BOP_OSC,
+    BOP_SWEEP,
+    BOP_WARP_POINT,
+    BOP_FIRE,
+    BOP_SHAKE,
+    BOP_HURT,
+    BOP_COUNT
+} BossOpcode;
+
+/* IF conditions */
+typedef enum {
+    BC_GE = 0,      /* field >= v */
+    BC_LT,          /* field <  v */
+    BC_EQ,          /* field == v */
+    BC_NE,          /* field != v */
+    BC_MOD,         /* field % v == m */
+    BC_GE_FIELD,    /* field >= field2 */
+    BC_NEAR,        /* Samus within n px on both axes (as of frame start) */
+    BC_ARRIVED,     /* A MOVE_TO / RETURN_TO snapped this frame */
+    BC_HP_BELOW,    /* hp < hp_max / v */
+    BC_AGGRO,       /* field >= v scaled down by lost HP (Ridley) */
+    BC_COUNT
+} BossCond;
+
+/* Boss fields ops can address (raw values; * = fx32) */
+typedef enum {
+    BF_AI_TIMER = 0,
+    BF_AI_COUNTER,
+    BF_SUB_TIMER,
+    BF_ATTACK_COUNT,
+    BF_PHASE,
+    BF_VULNERABLE,
+    BF_POS_X,       /* * */
+    BF_POS_Y,       /* * */
+    BF_ANCHOR_X,    /* * */
+    BF_ANCHOR_Y,    /* * */
+    BF_PARAM_A,     /* * */
+    BF_PARAM_B,     /* * */
+    BF_SAMUS_X,     /* * read-only */
+    BF_SAMUS_Y,     /* * read-only */
+    BF_COUNT
+} BossField;
+
+typedef enum {
+    BAXIS_X = 0,
+    BAXIS_Y,
+    BAXIS_COUNT
+} BossAxis;
+
+/* TOWARD modes */
+#define BTW_BIASED    0   /* Samus left: -speed, otherwise +speed */
+#define BTW_DEADZONE  1   /* No step when exactly aligned */
+
+/* FIRE aim flags: flip the sign of v / w to point at Samus */
+#define FIRE_AIM_X    0x01
+#define FIRE_AIM_Y    0x02
+
+/* BOP_STATE flags */
+#define BSF_CONTACT   0x01   /* Touching the boss hurts Samus */
+#define BSF_NO_CATCH  0x02   /* BOSS_SUPER_CATCH doesn't trigger here */
+
+typedef struct {
+    uint8_t op;             /* BossOpcode */
+    uint8_t a, b, c;
+    int16_t n, m;
+    fx32    v, w;
+} BossOp;
+
+/* ========================================================================
+ * Header
+ * ======================================================================== */
+
+/* hit_mode */
+#define BOSS_HIT_HP      0   /* Damage depletes HP */
+#define BOSS_HIT_PUSH    1   /* Hits push +X by push_px; past anchor_x -> fall_state */
+
+/* super_mode: reaction to a hit of at least super_damage */
+#define BOSS_SUPER_NONE  0
+#define BOSS_SUPER_RAGE  1   /* param_b = FX_ONE (once) */
+#define BOSS_SUPER_CATCH 2   /* Undo the damage, go to super_state */
+
+/* Hit regions. Every part present in the current phase blocks shots and
+ * hurts Samus on contact; only BPF_VULNERABLE parts pass damage on, and
+ * only while the boss itself is vulnerable. */
+#define BPF_VULNERABLE   0x01
+
+typedef struct {
+    int8_t  dx, dy;             /* Center offset from body pos, px */
+    uint8_t half_w, half_h;     /* px */
+    uint8_t flags;              /* BPF_* */
+    uint8_t damage_mul;         /* Quarters: 4 = x1, 8 = x2 */
+    uint8_t phases;             /* Bit per phase present in, 0 = all */
+    uint8_t reserved;
+} BossPart;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t op_count;
+    uint8_t  type;              /* BossTypeID */
+    uint8_t  start_state;
+    uint8_t  vulnerable;        /* At spawn */
+    uint8_t  hit_mode;
+    int32_t  hp;
+    uint16_t damage_contact;
+    int16_t  half_w, half_h;    /* Hitbox, px */
+    int16_t  push_px;           /* BOSS_HIT_PUSH distance per hit */
+    uint8_t  fall_state;        /* BOSS_HIT_PUSH: pushed past anchor_x */
+    uint8_t  flinch_state;      /* On a non-lethal hit, or BOSS_NO_STATE */
+    uint8_t  super_mode;
+    uint8_t  super_state;
+    uint16_t super_damage;
+    uint8_t  phase_count;
+    uint8_t  death_state[BOSS_MAX_PHASES];  /* Per phase; NO_STATE = despawn */
+    int16_t  points[BOSS_MAX_POINTS][2];    /* WARP_POINT offsets, px */
+    uint8_t  part_count;        /* 0: one vulnerable part over the hitbox */
+    uint8_t  reserved;
+    BossPart parts[BOSS_MAX_PARTS];
+} BossProgramHeader;
+
+/* A program ready to run: ops plus the state index built by the loader */
+typedef struct {
+    BossProgramHeader hdr;
+    BossOp            ops[BOSS_PROGRAM_MAX_OPS];
+    uint8_t           state_count;
+    uint8_t           state_flags[BOSS_PROGRAM_MAX_STATES];
+    uint16_t          state_entry[BOSS_PROGRAM_MAX_STATES]; /* Op after marker */
+    uint16_t          init_end;     /* First marker */
+} BossProgram;
+
+/* ========================================================================
+ * Authoring Macros (boss_programs.c)
+ * ======================================================================== */
+
+#define B_STATE(s, flags)     { .op = BOP_STATE, .a = (s), .b = (flags) }
+#define B_GOTO(s)             { .op = BOP_GOTO, .a = (s) }
+#define B_GOTO_CYCLE(s, f, k) { .op = BOP_GOTO_CYCLE, .a = (s), .b = (f), .n = (k) }
+#define B_DEACTIVATE()        { .op = BOP_DEACTIVATE }
+#define B_END()               { .op = BOP_END }
+
+#define B_IF(cond, f, val)    { .op = BOP_IF, .a = (cond), .b = (f), .v = (val) }
+#define B_IF_GE(f, val)       B_IF(BC_GE, f, val)
+#define B_IF_LT(f, val)       B_IF(BC_LT, f, val)
+#define B_IF_EQ(f, val)       B_IF(BC_EQ, f, val)
+#define B_IF_NE(f, val)       B_IF(BC_NE, f, val)
+#define B_IF_MOD(f, mod, rem) { .op = BOP_IF, .a = BC_MOD, .b = (f), .m = (rem), .v = (mod) }
+#define B_IF_GE_FIELD(f, f2)  { .op = BOP_IF, .a = BC_GE_FIELD, .b = (f), .c = (f2) }
+#define B_IF_NEAR(px)         { .op = BOP_IF, .a = BC_NEAR, .n = (px) }
+#define B_IF_ARRIVED()        { .op = BOP_IF, .a = BC_ARRIVED }
+#define B_IF_HP_BELOW(div)    { .op = BOP_IF, .a = BC_HP_BELOW, .v = (div) }
+#define B_IF_AGGRO(f, base)   { .op = BOP_IF, .a = BC_AGGRO, .b = (f), .v = (base) }
+
+#define B_SET(f, val)         { .op = BOP_SET, .a = (f), .v = (val) }
+#define B_ADD(f, val)         { .op = BOP_ADD, .a = (f), .v = (val) }
+#define B_COPY(dst, src)      { .op = BOP_COPY, .a = (dst), .b = (src) }
+#define B_SET_MOD(dst, base, src, mod) \
+    { .op = BOP_SET_MOD, .a = (dst), .b = (src), .n = (mod), .v = (base) }
+#define B_SET_HP(hp)          { .op = BOP_SET_HP, .v = (hp) }
+
+#define B_MOVE(axis, vel)     { .op = BOP_MOVE, .a = (axis), .v = (vel) }
+#define B_TOWARD(axis, mode, speed) \
+    { .op = BOP_TOWARD, .a = (axis), .b = (mode), .v = (speed) }
+#define B_MOVE_TO(axis, f, px, vel) \
+    { .op = BOP_MOVE_TO, .a = (axis), .b = (f), .n = (px), .v = (vel) }
+#define B_RETURN_TO(axis, f, tol_px, speed) \
+    { .op = BOP_RETURN_TO, .a = (axis), .b = (f), .n = (tol_px), .v = (speed) }
+#define B_PATROL(axis, dir_f, range_px, speed) \
+    { .op = BOP_PATROL, .a = (axis), .b = (dir_f), .n = (range_px), .v = (speed) }
+#define B_OSC(axis, angle_f, step, amp) \
+    { .op = BOP_OSC, .a = (axis), .b = (angle_f), .n = (step), .v = (amp) }
+#define B_SWEEP(axis, frames, width) \
+    { .op = BOP_SWEEP, .a = (axis), .n = (frames), .v = (width) }
+#define B_WARP_POINT(f)       { .op = BOP_WARP_POINT, .a = (f) }
+
+#define B_FIRE(aim, dx_px, dy_px, vx, vy) \
+    { .op = BOP_FIRE, .a = (aim), .b = PROJ_ENEMY_BULLET, \
+      .n = (dx_px), .m = (dy_px), .v = (vx), .w = (vy) }
+#define B_SHAKE(frames, mag)  { .op = BOP_SHAKE, .n = (frames), .m = (mag) }
+#define B_HURT(dmg)           { .op = BOP_HURT, .n = (dmg) }
+
+/* Header part entries: armor blocks, a core takes mul/4 damage */
+#define B_ARMOR(ox, oy, hw, hh) \
+    { .dx = (ox), .dy = (oy), .half_w = (hw), .half_h = (hh) }
+#define B_CORE(ox, oy, hw, hh, mul) \
+    { .dx = (ox), .dy = (oy), .half_w = (hw), .half_h = (hh), \
+      .flags = BPF_VULNERABLE, .damage_mul = (mul) }
+
+/* Common idioms */
+#define B_TICK()              B_ADD(BF_AI_TIMER, 1)
+#define B_ON_ENTER()          B_IF_EQ(BF_AI_TIMER, 0)
+#define B_AFTER(frames)       B_IF_GE(BF_AI_TIMER, frames)
+
+/* ========================================================================
+ * Built-in Programs (boss_programs.c)
+ * ======================================================================== */
+
+typedef struct {
+    BossProgramHeader hdr;      /* op_count filled by BOSS_PROGRAM_DEF */
+    const BossOp*     ops;
+} BossProgramDef;
+
+/* NULL for BOSS_NONE / out of range */
+const BossProgramDef* boss_builtin_program(BossTypeID type);
+
+/* ========================================================================
+ * Interpreter
+ * ======================================================================== */
+
+/* Validate hdr + ops and build the state index into p. On failure p is
+ * left unusable and false is returned. hdr and ops may alias p. */
+bool boss_program_load(BossProgram* p, const BossProgramHeader* hdr,
+                       const BossOp* ops);
+
+/* Apply the header's stats and run the spawn script. b->body.pos must
+ * already hold the spawn position. */
+void boss_vm_spawn(Boss* b, const BossProgram* p);
+
+/* One frame: invuln countdown, the current state's script, contact damage */
+void boss_vm_step(Boss* b, const BossProgram* p);
+
+/* Apply a hit under the header's hit rules (caller checks vulnerability) */
+void boss_vm_hit(Boss* b, const BossProgram* p, int32_t damage);
+
+/* World box of a part; false if it is out of range or absent this phase */
+bool boss_vm_part_box(const Boss* b, const BossProgram* p, int part,
+                      Vec2fx* pos, AABBfx* box);
+
+/* Damage a hit on a part would deal right now after its multiplier;
+ * 0 if the part is armor, absent, or the boss can't be hurt this frame */
+int32_t boss_vm_part_damage(const Boss* b, const BossProgram* p, int part,
+                            int32_t damage);
+
+#endif /* BOSS_VM_H */
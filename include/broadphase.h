@@ -0,0 +1,60 @@
+/**
+ * broadphase.h - Uniform grid broadphase
+ *
+ * Per-frame bucket grid of 64px cells over the current room.
+ * Enemies and each part of the active boss are inserted once per frame
+ * after they have moved; projectile, bomb blast and boss hit checks query the grid
+ * instead of scanning every pool entry.
+ *
+ * Implemented in: source/broadphase.c
+ */
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "sm_types.h"
+#include "sm_config.h"
+
+/* Cell size: 64px (1 << 6) = 4x4 metatiles */
+#define BP_CELL_SHIFT    6
+#define BP_GRID_COLS     ((MAX_ROOM_WIDTH_PX  + 63) >> BP_CELL_SHIFT)   /* 16 */
+#define BP_GRID_ROWS     ((MAX_ROOM_HEIGHT_PX + 63) >> BP_CELL_SHIFT)   /*  8 */
+
+/* Entity capacity: every enemy plus every boss part */
+#define BP_MAX_ENTITIES  (MAX_ENEMIES + BOSS_MAX_PARTS)
+
+/* Cell entry capacity (most entities touch 1-4 cells; max 255) */
+#define BP_MAX_NODES     160
+
+/* What a grid entry refers to */
+typedef enum {
+    BP_KIND_ENEMY = 0,      /* index = enemy pool index */
+    BP_KIND_BOSS,           /* index = boss part */
+    BP_KIND_COUNT
+} BroadphaseKind;
+
+#define BP_MASK_ENEMY   (1 << BP_KIND_ENEMY)
+#define BP_MASK_BOSS    (1 << BP_KIND_BOSS)
+#define BP_MASK_ALL     ((1 << BP_KIND_COUNT) - 1)
+
+typedef struct {
+    uint8_t kind;           /* BroadphaseKind */
+    uint8_t index;
+} BroadphaseRef;
+
+/* Empty the grid */
+void broadphase_clear(void);
+
+/* Insert one entity (center + half-extents, world pixels in fx32) */
+void broadphase_insert(BroadphaseKind kind, int index, Vec2fx pos, AABBfx box);
+
+/* Clear and insert all active enemies and boss parts. Once per frame. */
+void broadphase_build(void);
+
+/* Collect entities whose box overlaps the query box, filtered by
+ * kind_mask (BP_MASK_*). Each entity is reported once.
+ * Returns the number of refs written to out (at most max_out). */
+int  broadphase_query(Vec2fx pos, AABBfx box, uint8_t kind_mask,
+                      BroadphaseRef* out, int max_out);
+
+#endif /* BROADPHASE_H */
@@ -11,6 +11,7 @@
 #define CAMERA_H
 
 #include "sm_types.h"
+#include "snapshot.h"
 
 /* Camera state */
 typedef struct {
@@ -29,4 +30,8 @@ void camera_update(void);    /* Follow player, clamp to room bounds */
 void camera_shake(int frames, int magnitude);
 void camera_apply(void);     /* Write scroll offsets to graphics module */
 
+/* Snapshot section: g_camera and the shake sequence (snapshot.c) */
+void camera_snapshot_save(SnapshotWriter* w);
+void camera_snapshot_load(SnapshotReader* r);
+
 #endif /* CAMERA_H */
@@ -0,0 +1,102 @@
+/**
+ * coproc.h - ARM7 job channel
+ *
+ * Work that is off the frame's critical path -- expanding a compressed
+ * room record, checksumming a save slot -- is queued here as a job
+ * descriptor over caller-owned buffers and sent to the ARM7 worker
+ * (arm7/source/main.c) over the PXI FIFO. The ARM7 runs jobs one at a
+ * time in submission order, in parallel with the ARM9 frame, and answers
+ * each one on the same channel. The caller polls coproc_done, or calls
+ * coproc_wait to block on it when it cannot go on without the result.
+ *
+ * The ARM7 only sees main RAM, and the ARM9 data cache sits between
+ * them. So:
+ *   - src and dst must not be in DTCM or on the stack (which is DTCM);
+ *   - src is flushed from the cache at submit;
+ *   - dst must be COPROC_ALIGN'd and COPROC_ROUND'ed, because it is
+ *     invalidated when the job completes and a shared cache line would
+ *     drop the neighbour's writes;
+ *   - both belong to the job until coproc_done says it is finished.
+ * A job whose buffers break these rules runs on the ARM9 at submit
+ * instead, as does every job in the host build.
+ *
+ * Implemented in: source/coproc.c (ARM9 side), source/coproc_job.c
+ * (job bodies, linked into both CPUs)
+ */
+
+#ifndef COPROC_H
+#define COPROC_H
+
+#include "sm_types.h"
+
+typedef enum {
+    COPROC_JOB_LZ = 0,      /* lz_decompress(src, dst); result = bytes or -1 */
+    COPROC_JOB_CHECKSUM,    /* save_checksum(src); result = hi << 8 | lo */
+    COPROC_JOB_KIND_COUNT
+} CoprocJobKind;
+
+/* dst buffers: whole data cache lines */
+#define COPROC_CACHE_LINE   32
+#define COPROC_ALIGN        __attribute__((aligned(COPROC_CACHE_LINE)))
+#define COPROC_ROUND(n)     (((n) + COPROC_CACHE_LINE - 1) & ~(COPROC_CACHE_LINE - 1))
+
+/* ========================================================================
+ * Wire Format (shared with the ARM7)
+ *
+ * Descriptors live in main RAM, one cache line each. A message carries
+ * the descriptor's address as a cache-line index from the start of main
+ * RAM, which fits in a PXI payload; the ARM7 echoes it back when done.
+ * ======================================================================== */
+
+#define COPROC_PXI_CHANNEL  PxiChannel_User0
+#define COPROC_MAIN_RAM     0x02000000u
+
+typedef struct {
+    uint32_t    kind;       /* CoprocJobKind */
+    const void* src;
+    uint32_t    src_size;
+    void*       dst;
+    uint32_t    dst_size;
+    int32_t     result;     /* Written by whichever CPU runs the job */
+} COPROC_ALIGN CoprocDesc;
+
+static inline uint32_t coproc_msg_from_desc(const CoprocDesc* d) {
+    return ((uint32_t)(uintptr_t)d - COPROC_MAIN_RAM) / COPROC_CACHE_LINE;
+}
+
+static inline CoprocDesc* coproc_desc_from_msg(uint32_t msg) {
+    return (CoprocDesc*)(uintptr_t)(COPROC_MAIN_RAM + msg * COPROC_CACHE_LINE);
+}
+
+/* Run d's job on the calling CPU; returns its result */
+int32_t coproc_job_run(const CoprocDesc* d);
+
+/* ========================================================================
+ * ARM9 API
+ * ======================================================================== */
+
+/* Job handle. Results stay readable until COPROC_QUEUE_MAX newer jobs
+ * have been submitted. */
+typedef uint32_t CoprocJob;
+
+/* Wait for the ARM7 worker and hook its replies. Until this has run
+ * (and in the host build) jobs run on the ARM9 at submit. */
+void coproc_init(void);
+
+/* Queue a job. When the queue is full this waits for the oldest job,
+ * so a submit always succeeds. */
+CoprocJob coproc_submit(CoprocJobKind kind, const void* src, uint32_t src_size,
+                        void* dst, uint32_t dst_size);
+
+bool    coproc_done(CoprocJob job);
+int32_t coproc_result(CoprocJob job);   /* -1 until done, or if expired */
+
+/* Block until the job is done; returns its result */
+int32_t coproc_wait(CoprocJob job);
+
+int  coproc_pending(void);              /* Submitted, not yet done */
+
+/* Wait for everything submitted (tests, teardown) */
+void coproc_flush(void);
+
+#endif /* COPROC_H */
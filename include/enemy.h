@@ -1,8 +1,10 @@
 /**
  * enemy.h - Enemy pool management and AI
  *
- * Fixed-size pool (MAX_ENEMIES) with swap-remove.
- * Each enemy type has its own AI update function.
+ * Fixed-size pool (MAX_ENEMIES), kept grouped by EnemyTypeID.
+ * Hot movement state (PhysicsBody) lives in its own array, parallel to the
+ * cold per-enemy state, and each type's AI runs once over its whole group.
+ * Indices are stable between spawn/remove calls only.
  *
  * Implemented in: source/enemy.c, source/enemy_ai_*.c (M11)
  */
@@ -12,6 +14,14 @@
 
 #include "sm_types.h"
 #include "physics.h"
+#include "snapshot.h"
+
+/* What an enemy does while outside the activation rect */
+typedef enum {
+    ENEMY_SLEEP_NEVER = 0,  /* Always fully updated */
+    ENEMY_SLEEP_FREEZE,     /* Nothing runs; resumes exactly where it stopped */
+    ENEMY_SLEEP_TIMER       /* Only ai_timer advances (phase, despawn) */
+} EnemySleepMode;
 
 /* Enemy type IDs */
 typedef enum {
@@ -26,10 +36,9 @@ typedef enum {
     ENEMY_TYPE_COUNT
 } EnemyTypeID;
 
-/* Per-enemy instance */
+/* Per-enemy instance (cold state; movement is in enemy_get_body()) */
 typedef struct {
     EnemyTypeID type;
-    PhysicsBody body;
     Direction   facing;
     int16_t     hp;
     int16_t     hp_max;
@@ -39,6 +48,7 @@ typedef struct {
     uint16_t    anim_frame;
     uint16_t    anim_timer;
     bool        active;
+    bool        asleep;          /* Outside activation rect this frame */
 } Enemy;
 
 /* Pool management */
@@ -52,10 +62,19 @@ void enemy_update_all(void);
 void enemy_render_all(void);
 
 /* Query */
-int    enemy_get_count(void);
-Enemy* enemy_get(int index);
+int          enemy_get_count(void);
+Enemy*       enemy_get(int index);
+PhysicsBody* enemy_get_body(int index);
+
+/* Sleep policy for a type, and how many enemies are awake */
+EnemySleepMode enemy_get_sleep_mode(EnemyTypeID type);
+int          enemy_get_awake_count(void);
 
 /* Damage an enemy. Removes it if HP <= 0. */
 void   enemy_damage(int index, int16_t damage);
 
+/* Snapshot section: active enemies and their bodies (snapshot.c) */
+void enemy_snapshot_save(SnapshotWriter* w);
+void enemy_snapshot_load(SnapshotReader* r);
+
 #endif /* ENEMY_H */
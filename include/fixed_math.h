@@ -31,9 +31,25 @@ fx32 fx_lerp(fx32 a, fx32 b, fx32 t);
 fx32 fx_sin(int angle);
 fx32 fx_cos(int angle);
 
-/* Square root (Newton's method, integer) */
+/* Square root. ARM9: hardware sqrt unit. Host: divide-free bitwise
+ * integer sqrt seeded from the leading-zero count. Returns 0 for a <= 0. */
 fx32 fx_sqrt(fx32 a);
 
+/* Vector length sqrt(dx^2 + dy^2), saturating at 0x7FFFFFFF */
+fx32 fx_length(fx32 dx, fx32 dy);
+
+/* Async hardware divide / sqrt: start, do unrelated work, then collect.
+ * One divide and one sqrt may be in flight at once; starting another of
+ * the same kind replaces it. *_result() waits if the unit is still busy.
+ * On the host these compute immediately. Not for use in IRQ handlers. */
+void fx_div_start(fx32 a, fx32 b);
+bool fx_div_busy(void);
+fx32 fx_div_result(void);
+
+void fx_sqrt_start(fx32 a);
+bool fx_sqrt_busy(void);
+fx32 fx_sqrt_result(void);
+
 /* Convert SNES subpixel value (16-bit) to fx32.
  * SNES stores position as (pixel:16, subpixel:16).
  * This just reinterprets the combined 32-bit value as fx32. */
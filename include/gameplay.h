@@ -11,6 +11,7 @@
 #define GAMEPLAY_H
 
 #include "sm_types.h"
+#include "snapshot.h"
 
 /* Register gameplay, pause, and death state handlers with state manager */
 void gameplay_register_states(void);
@@ -18,4 +19,9 @@ void gameplay_register_states(void);
 /* Global progress (readable by HUD and other modules) */
 extern uint32_t g_game_time_frames;
 
+/* Snapshot section: game time and boss progress (snapshot.c). Saving
+ * fails during a door transition; loading ends one. */
+void gameplay_snapshot_save(SnapshotWriter* w);
+void gameplay_snapshot_load(SnapshotReader* r);
+
 #endif /* GAMEPLAY_H */
@@ -2,7 +2,7 @@
  * graphics.h - Hardware rendering foundation
  *
  * VRAM bank setup, shadow OAM, background tile/map loading,
- * sprite management, VBlank commit.
+ * sprite management, VBlank upload queue and commit.
  *
  * Implemented in: source/graphics.c (M4)
  */
@@ -23,30 +23,159 @@ void graphics_begin_frame(void);
 /* Call at end of frame (DMA shadow OAM + scroll regs to hardware) */
 void graphics_end_frame(void);
 
+/* Call right after swiWaitForVBlank: drains the upload queue within
+ * VRAM_UPLOAD_BUDGET, then applies BG map patches. */
+void graphics_vblank(void);
+
+/* ========================================================================
+ * VRAM Upload Queue
+ *
+ * The load functions below don't touch VRAM; they queue a transfer that
+ * graphics_vblank DMAs later. The source must stay valid and out of DTCM
+ * until the upload completes. Queuing a new transfer to a destination
+ * that already has one pending replaces it (latest data wins).
+ * ======================================================================== */
+
+/* Queue a raw transfer. size must be a multiple of 4. False if full. */
+bool graphics_queue_upload(const void* src, void* dst, uint32_t size);
+
+/* Drain everything now, ignoring the budget (loading screens, tests) */
+void graphics_flush_uploads(void);
+
+/* Bytes still waiting for a VBlank */
+uint32_t graphics_get_pending_upload_bytes(void);
+
 /* Load tileset (tile graphics / CHR) into BG VRAM for a layer */
 void graphics_load_bg_tileset(int layer, const void* data, uint32_t size);
 
+/* Load tiles into a layer's tileset starting at tile_offset (4bpp).
+ * False if the upload queue is full. */
+bool graphics_load_bg_tiles(int layer, const void* data, uint32_t size,
+                            int tile_offset);
+
 /* Load tilemap (screen map) into BG VRAM for a layer */
 void graphics_load_bg_tilemap(int layer, const void* data, uint32_t size);
 
+/* Queue a single 16-bit BG map entry write (applied at graphics_vblank).
+ * map_offset is in entries from the layer's map base.
+ * Returns false if the patch queue is full this frame. */
+bool graphics_queue_bg_map_entry(int layer, int map_offset, u16 entry);
+
 /* Load 16-color palette to BG palette RAM (slot 0-15) */
 void graphics_load_bg_palette(int palette_idx, const u16* palette);
 
-/* Load sprite tile data to OBJ VRAM at the given tile offset */
-void graphics_load_sprite_tiles(const void* data, uint32_t size, int tile_offset);
+/* Load sprite tile data to OBJ VRAM at the given tile offset.
+ * False if the upload queue is full. */
+bool graphics_load_sprite_tiles(const void* data, uint32_t size, int tile_offset);
 
 /* Load 16-color palette to OBJ palette RAM (slot 0-15) */
 void graphics_load_sprite_palette(int palette_idx, const u16* palette);
 
+/* Sub engine (bottom screen) counterparts, layers SUB_BG_LAYER_*. Map
+ * entries share the main engine's patch queue. */
+bool graphics_load_sub_bg_tiles(int layer, const void* data, uint32_t size,
+                                int tile_offset);
+bool graphics_queue_sub_bg_map_entry(int layer, int map_offset, u16 entry);
+void graphics_load_sub_bg_palette(int palette_idx, const u16* palette);
+
 /* Set BG scroll (applied at end_frame) */
 void graphics_set_bg_scroll(int layer, int scroll_x, int scroll_y);
 
-/* Set sprite in shadow OAM */
-void graphics_set_sprite(int oam_idx, int x, int y, int tile_id,
-                         int palette, int priority, bool hflip, bool vflip);
+/* ========================================================================
+ * Sprite Allocator
+ *
+ * Sprites are queued during render and packed into OAM at end_frame,
+ * highest SpritePriority first (lower OAM index draws on top). A
+ * metasprite is placed whole or not at all. When a priority band
+ * doesn't fit, the band's start point rotates each frame so every
+ * sprite in it flickers instead of the same ones vanishing.
+ * ======================================================================== */
+
+typedef enum {
+    SPR_PRIO_PLAYER = 0,   /* Samus, HUD-critical markers */
+    SPR_PRIO_HIGH,         /* Bosses, projectiles */
+    SPR_PRIO_NORMAL,       /* Enemies, pickups */
+    SPR_PRIO_LOW,          /* Particles, cosmetic effects */
+    SPR_PRIO_COUNT
+} SpritePriority;
+
+/* Per-piece flip flags (XORed with the metasprite's own flip) */
+#define SPR_PIECE_HFLIP  0x01
+#define SPR_PIECE_VFLIP  0x02
+
+/* One hardware sprite of a metasprite. Offsets are from the metasprite
+ * origin; w/h are pixels (8, 16, 32 or 64, any valid OBJ shape). */
+typedef struct {
+    int8_t   dx, dy;
+    uint8_t  w, h;
+    uint16_t tile;
+    uint8_t  flags;
+} MetaspritePiece;
+
+typedef struct {
+    const MetaspritePiece* pieces;
+    uint8_t                count;
+} Metasprite;
+
+/* Queue a metasprite with its origin at screen (x, y); flips mirror the
+ * piece layout around the origin. Piece tiles are relative to tile_base
+ * (the animation frame). bg_priority is the OBJ-vs-BG priority (0-3).
+ * Returns a handle for graphics_get_sprite_slot, or -1 if the per-frame
+ * queue is full. */
+int graphics_draw_metasprite(const Metasprite* ms, int x, int y,
+                             int tile_base, int palette, int bg_priority,
+                             bool hflip, bool vflip, SpritePriority prio);
+
+/* Queue a single 16x16 sprite (top-left at x, y) */
+int graphics_draw_sprite(int x, int y, int tile_id, int palette,
+                         int bg_priority, bool hflip, bool vflip,
+                         SpritePriority prio);
+
+/* Allocator results for the last committed frame */
+int graphics_get_sprite_slot(int handle);   /* First OAM slot, -1 if dropped */
+int graphics_get_oam_used(void);
+int graphics_get_sprites_dropped(void);      /* Metasprites not shown */
+
+/* ========================================================================
+ * HBlank Effects
+ *
+ * Each channel drives one 16-bit register from a SCREEN_HEIGHT-entry
+ * table, one entry per scanline, via HBlank-triggered repeat DMA. Build
+ * a table during the frame; graphics_vblank swaps it in and rearms the
+ * DMA. A committed table stays active until replaced or stopped, so a
+ * static effect costs nothing after the first build. Tables are double
+ * buffered: the one being scanned out is never written.
+ * ======================================================================== */
+
+typedef enum {
+    HBLANK_OFF = 0,
+    HBLANK_BG_SCROLL_X,     /* param: main BG layer 0-3 */
+    HBLANK_BG_SCROLL_Y,     /* param: main BG layer 0-3 */
+    HBLANK_BG_COLOR,        /* param: BG palette entry 0-255 */
+    HBLANK_BRIGHTNESS       /* REG_MASTER_BRIGHT values (param unused) */
+} HblankTarget;
+
+/* Back table for channel (SCREEN_HEIGHT entries) to fill this frame;
+ * applied at the next graphics_vblank. NULL on a bad channel/target. */
+u16* graphics_hblank_build(int channel, HblankTarget target, int param);
+
+/* Stop a channel at the next VBlank; the register keeps its last value
+ * until the regular per-frame writes (scroll, brightness) restore it. */
+void graphics_hblank_stop(int channel);
+
+/* Table currently being scanned out, NULL if the channel is off */
+const u16* graphics_hblank_active(int channel);
+
+/* Horizontal sine wobble on top of the layer's scroll: heat haze,
+ * underwater shimmer. wavelength in scanlines (power of two, <= 256).
+ * Call after camera_apply so the base scroll is this frame's. */
+void graphics_hblank_wave(int channel, int layer, int amplitude,
+                          int wavelength, int phase);
 
-/* Hide a specific sprite */
-void graphics_hide_sprite(int oam_idx);
+/* Vertical gradient of one BG palette entry from top to bottom colour
+ * (BGR555): water tint, darkening rooms. */
+void graphics_hblank_gradient(int channel, int color_index,
+                              u16 top, u16 bottom);
 
 /* Screen brightness control for fades.
  * level: -16 (black) to 0 (normal) to +16 (white) */
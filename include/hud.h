@@ -1,8 +1,10 @@
 /**
  * hud.h - HUD display (sub engine / bottom screen)
  *
- * Energy, missiles, supers, power bombs, mini-map.
- * Rendered on sub engine BG layers.
+ * Energy, missiles, supers, power bombs, game timer and room on a tile
+ * strip (SUB_BG_LAYER_HUD), plus a minimap window (SUB_BG_LAYER_MAP)
+ * of the screens Samus has explored in each room. Only map entries
+ * that changed since the last frame are rewritten.
  *
  * Implemented in: source/hud.c (M16)
  */
@@ -12,8 +14,20 @@
 
 #include "sm_types.h"
 
-void hud_init(void);
-void hud_update(void);   /* Refresh displayed values from player state */
-void hud_render(void);   /* Commit to sub engine */
+void hud_init(void);     /* Load glyph tiles and palette; forgets the map */
+void hud_update(void);   /* Record the screen Samus is in (gameplay update) */
+void hud_render(void);   /* Queue changed entries to the sub engine */
+
+/* Blank the HUD and minimap (menus); the next hud_render redraws both */
+void hud_hide(void);
+
+/* Forget explored screens (new game / file load) */
+void hud_reset_map(void);
+
+/* Has Samus been in this room since the last hud_reset_map? */
+bool hud_room_visited(int area_id, int room_id);
+
+/* Map entries queued by the last hud_render (0 when nothing changed) */
+int  hud_get_last_writes(void);
 
 #endif /* HUD_H */
@@ -4,6 +4,12 @@
  * Wraps libnds scanKeys/keysDown/keysHeld/keysUp with buffering.
  * Circular buffer of last INPUT_BUFFER_FRAMES frames for advanced techniques.
  *
+ * Replay: per-frame held keys can be recorded to a run-length encoded
+ * buffer and saved to FAT, then fed back through input_update() in
+ * place of the hardware. Edges (pressed/released) are always derived
+ * from successive held states, so a recording and its playback see
+ * identical input on every frame.
+ *
  * Implemented in: source/input.c (M5)
  */
 
@@ -12,6 +18,7 @@
 
 #include "sm_types.h"
 #include "sm_config.h"
+#include "snapshot.h"
 
 /* Call once per frame after scanKeys() */
 void input_update(void);
@@ -27,4 +34,59 @@ bool input_buffered(int key);
 /* How many consecutive frames has key been held? */
 int input_held_frames(int key);
 
+/* ========================================================================
+ * Replay
+ * ======================================================================== */
+
+#define REPLAY_MAGIC      0x50524D53   /* "SMRP" little-endian */
+#define REPLAY_VERSION    1
+#define REPLAY_MAX_RUNS   8192         /* 32KB buffer; one run per key change */
+
+typedef enum {
+    REPLAY_OFF = 0,
+    REPLAY_RECORDING,
+    REPLAY_PLAYING,
+    REPLAY_FINISHED     /* Playback ran out; input is live again */
+} ReplayMode;
+
+/* On-disk header, followed by run_count ReplayRun entries */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t frame_count;
+    uint32_t run_count;
+} ReplayHeader;
+
+typedef struct {
+    uint16_t keys;      /* keysHeld() bits */
+    uint16_t frames;    /* Consecutive frames with these keys (1..65535) */
+} ReplayRun;
+
+/* Start recording from the next input_update(). Clears input history. */
+void       input_replay_record(void);
+
+/* Start playing the buffer from the next input_update(). False if empty. */
+bool       input_replay_play(void);
+
+/* Stop recording or playback (buffer is kept) */
+void       input_replay_stop(void);
+
+/* Write the buffer to / read it from a FAT file. Load does not start playback. */
+bool       input_replay_save(const char* path);
+bool       input_replay_load(const char* path);
+
+ReplayMode input_replay_mode(void);
+uint32_t   input_replay_frame(void);     /* Frames recorded / played so far */
+uint32_t   input_replay_length(void);    /* Frames in buffer */
+
+/* Continue playback from the given frame, keeping the current input
+ * history (restored from a snapshot). False unless playing. */
+bool       input_replay_seek(uint32_t frame);
+
+/* Snapshot section: edge/hold history and this frame's keys (snapshot.c).
+ * The replay buffer is not part of it. */
+void       input_snapshot_save(SnapshotWriter* w);
+void       input_snapshot_load(SnapshotReader* r);
+
 #endif /* INPUT_H */
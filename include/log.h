@@ -0,0 +1,61 @@
+/**
+ * log.h - Leveled debug logging
+ *
+ * LOG_ERROR / LOG_WARN / LOG_INFO / LOG_DEBUG take printf-style
+ * arguments. Levels above LOG_LEVEL (sm_config.h) compile to nothing;
+ * the arguments are still type-checked but never evaluated.
+ *
+ * Enabled messages are formatted into a RAM ring instead of going
+ * straight to stderr, whose backends (emulator debug console, FAT) can
+ * block for milliseconds. log_drain() moves a bounded number of bytes
+ * per frame to stderr and the optional log file, after the frame's
+ * work is done. When the ring is full new messages are dropped and
+ * counted, never waited on.
+ *
+ * Implemented in: source/log.c
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include "sm_types.h"
+#include "sm_config.h"
+
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+/* Format one message into the ring. Use the LOG_* macros instead. */
+void log_write(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#define LOG_AT(level, ...) \
+    do { if (LOG_LEVEL >= (level)) log_write(__VA_ARGS__); } while (0)
+
+#define LOG_ERROR(...)  LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_WARN(...)   LOG_AT(LOG_LEVEL_WARN,  __VA_ARGS__)
+#define LOG_INFO(...)   LOG_AT(LOG_LEVEL_INFO,  __VA_ARGS__)
+#define LOG_DEBUG(...)  LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/* Discard anything pending and reset the drop count */
+void log_init(void);
+
+/* Also copy drained output to a FAT file (truncated on mount) */
+bool log_mount(const char* path);
+void log_unmount(void);
+
+/* Write up to max_bytes of pending output to the sinks. Call once per
+ * frame outside the profiled work. */
+void log_drain(int max_bytes);
+
+/* Drain everything (boot, exit, before a known stall) */
+void log_flush(void);
+
+/* Pop up to max pending bytes into dst without writing them anywhere.
+ * Returns the number of bytes copied. */
+int      log_read(char* dst, int max);
+int      log_pending(void);
+uint32_t log_dropped(void);     /* Messages dropped since last report */
+
+#endif /* LOG_H */
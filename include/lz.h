@@ -0,0 +1,26 @@
+/**
+ * lz.h - LC_LZ2 decompressor (Super Metroid's asset compression)
+ *
+ * Same format as tools/lz_decompress.py, so assets can ship compressed
+ * and be expanded at load time. Command byte CCCLLLLL, length L+1:
+ *   0 literal copy     1 byte fill      2 word fill (alternating bytes)
+ *   3 increasing fill  4 back reference (u16 LE absolute output offset)
+ *   7 extended: real command in bits 4-2, 10-bit length
+ *   $FF ends the stream.
+ *
+ * The output must be byte-addressable memory (not VRAM): decode into a
+ * RAM buffer, then queue it for upload.
+ *
+ * Implemented in: source/lz.c
+ */
+
+#ifndef LZ_H
+#define LZ_H
+
+#include "sm_types.h"
+
+/* Decompress src into dst. Returns bytes written, or -1 if the stream
+ * is malformed, truncated before $FF, or would overflow dst_size. */
+int lz_decompress(const void* src, uint32_t src_size, void* dst, uint32_t dst_size);
+
+#endif /* LZ_H */
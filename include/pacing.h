@@ -0,0 +1,33 @@
+/**
+ * pacing.h - Frame pacing (fixed simulation step, catch-up on lag)
+ *
+ * The simulation advances one fixed step per VBlank. When a frame
+ * overruns and VBlanks are missed, the next frame runs the missed steps
+ * back to back before rendering once, so game speed, physics timing and
+ * g_game_time_frames keep to real time. At most PACING_MAX_CATCHUP extra
+ * steps run per frame; lag beyond that is dropped (the game slows down
+ * for a moment instead of spending every frame catching up).
+ *
+ * VBlanks are counted from the profiler's bus-clock counter: one video
+ * frame is exactly BUS_TICKS_PER_FRAME ticks. Caught-up and dropped
+ * steps are reported to the profiler session.
+ *
+ * Implemented in: source/pacing.c
+ */
+
+#ifndef PACING_H
+#define PACING_H
+
+#include "sm_types.h"
+
+/* Start timing from now_ticks (once, just before the main loop) */
+void pacing_reset(uint32_t now_ticks);
+
+/* Call right after the VBlank wait with profiler_ticks(). Returns the
+ * simulation steps to run this frame (1 + catch-up). */
+int  pacing_frame_begin(uint32_t now_ticks);
+
+int  pacing_last_caught_up(void);   /* Extra steps granted by the last call */
+int  pacing_last_dropped(void);     /* Missed steps beyond the cap */
+
+#endif /* PACING_H */
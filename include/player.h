@@ -76,6 +76,9 @@ extern Player g_player;
 void player_init(void);
 void player_update(void);
 void player_render(void);
+
+/* Frame-bank index of the pose player_render would stream this frame */
+int  player_get_anim_frame(void);
 void player_damage(int16_t damage);
 void player_damage_from(int16_t damage, fx32 source_x);
 
@@ -0,0 +1,89 @@
+/**
+ * profiler.h - Per-frame CPU profiler
+ *
+ * Named scopes timed with a cascaded hardware timer pair. Each scope
+ * accumulates its time over a frame (inclusive of nested scopes, so
+ * PHYSICS is also counted inside PLAYER/ENEMY); a rolling window of
+ * PROF_WINDOW_FRAMES frames gives min/avg/max in ARM9 cycles.
+ *
+ * Overlay is drawn on the sub-screen console, toggled with a debug key.
+ *
+ * Implemented in: source/profiler.c
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "sm_types.h"
+#include "sm_config.h"
+
+typedef enum {
+    PROF_FRAME = 0,     /* Whole frame: uploads + input + update + render */
+    PROF_PLAYER,
+    PROF_PHYSICS,
+    PROF_ENEMY,
+    PROF_PROJECTILE,
+    PROF_BOSS,
+    PROF_CAMERA,
+    PROF_HUD,
+    PROF_UPLOAD,        /* VBlank DMA drain (graphics_vblank) */
+    PROF_SCOPE_COUNT
+} ProfScope;
+
+#define PROF_WINDOW_FRAMES      64   /* Rolling window length */
+#define PROF_OVERLAY_INTERVAL   30   /* Frames between overlay redraws */
+
+/* Per-scope statistics over the rolling window (ARM9 cycles) */
+typedef struct {
+    uint32_t last;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+} ProfStats;
+
+/* Start the timer pair and clear all history */
+void     profiler_init(void);
+
+/* Frame bracket: call right after VBlank wait and after end_frame */
+void     profiler_frame_begin(void);
+void     profiler_frame_end(void);
+
+/* Scope bracket. Scopes may nest but must not re-enter themselves. */
+void     profiler_begin(ProfScope scope);
+void     profiler_end(ProfScope scope);
+
+/* Raw 32-bit bus-clock tick counter (33.51 MHz, wraps every ~128s) */
+uint32_t profiler_ticks(void);
+
+/* Convert bus ticks to ARM9 cycles (ARM9 runs at 2x bus clock) */
+static inline uint32_t profiler_ticks_to_cycles(uint32_t ticks) {
+    return ticks * 2;
+}
+
+/* Statistics for a scope over the current window */
+void     profiler_get_stats(ProfScope scope, ProfStats* out);
+
+/* Session statistics: every frame since profiler_reset_session().
+ * Used by replay benchmarks, where the 64-frame window is too short. */
+void     profiler_reset_session(void);
+void     profiler_get_session(ProfScope scope, ProfStats* out);
+uint32_t profiler_session_frames(void);
+uint32_t profiler_session_over_budget(void);   /* Frames > CYCLES_PER_FRAME */
+
+/* Frame pacing (pacing.c): steps run late to make up missed VBlanks,
+ * and missed steps dropped past the catch-up cap */
+void     profiler_frame_pacing(int caught_up, int dropped);
+uint32_t profiler_session_caught_up(void);
+uint32_t profiler_session_dropped(void);
+
+/* Print session statistics for every scope to stderr */
+void     profiler_log_session(const char* label);
+
+/* Overlay control */
+void     profiler_toggle_overlay(void);
+bool     profiler_overlay_visible(void);
+
+/* Redraw the overlay (every PROF_OVERLAY_INTERVAL frames while visible) */
+void     profiler_render_overlay(void);
+
+#endif /* PROFILER_H */
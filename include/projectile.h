@@ -12,6 +12,7 @@
 
 #include "sm_types.h"
 #include "physics.h"
+#include "snapshot.h"
 
 /* Projectile types */
 typedef enum {
@@ -59,4 +60,8 @@ void projectile_clear_all(void);
 void projectile_update_all(void);
 void projectile_render_all(void);
 
+/* Snapshot section: active projectiles (snapshot.c) */
+void projectile_snapshot_save(SnapshotWriter* w);
+void projectile_snapshot_load(SnapshotReader* r);
+
 #endif /* PROJECTILE_H */
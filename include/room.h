@@ -1,8 +1,9 @@
 /**
  * room.h - Room loading and collision map
  *
- * Loads room data from embedded blobs. Provides O(1) tile collision query.
- * Single global room -- unload previous before loading next.
+ * Loads room data from the room pack or built-in rooms. Provides O(1)
+ * tile collision query. Single global room -- unload previous before
+ * loading next; the next room can be prefetched into a second buffer.
  *
  * Implemented in: source/room.c (M7)
  */
@@ -13,6 +14,7 @@
 #include "sm_types.h"
 #include "sm_config.h"
 #include "physics.h"
+#include "snapshot.h"
 
 /* Door connection data */
 typedef struct {
@@ -35,6 +37,36 @@ typedef struct {
     uint16_t properties;
 } EnemySpawnData;
 
+/* Packed solid bitmaps: 1 bit per metatile, set if solid for movement.
+ * Rows are indexed [y][x / 32], columns [x][y / 32], so a hitbox span
+ * along either axis is one or two masked word tests. */
+#define SOLID_ROW_WORDS ((MAX_ROOM_WIDTH_TILES + 31) / 32)
+#define SOLID_COL_WORDS ((MAX_ROOM_HEIGHT_TILES + 31) / 32)
+
+/* Returns true if collision type acts as solid for movement.
+ * Special blocks (0x20-0x2F) are solid until broken. */
+static inline bool room_coll_is_solid(uint8_t coll) {
+    if (coll == COLL_SOLID) return true;
+    if ((coll & 0xF0) == COLL_SPECIAL_BASE) return true;
+    return false;
+}
+
+/* 16x16 metatile as four DS BG map entries (tile index, flip bits,
+ * palette): TL, TR, BL, BR. tools/tile_dedup.py emits these (.mtd)
+ * against the deduplicated tileset, so flipped tiles cost no VRAM. */
+typedef struct {
+    u16 sub[4];
+} MetatileDef;
+
+/* Frames a crumble block holds after Samus stands on it */
+#define CRUMBLE_DELAY_FRAMES 30
+
+/* Crumble block counting down to break */
+typedef struct {
+    uint16_t tile_idx;      /* y * width_tiles + x */
+    uint8_t  timer;         /* Frames until it breaks */
+} CrumbleBlock;
+
 /* Room data structure (single global instance, never allocated) */
 typedef struct {
     uint16_t width_tiles;       /* Room width in 16x16 metatiles */
@@ -63,8 +95,9 @@ typedef struct {
     ItemData items[MAX_ITEMS];
     uint8_t  item_count;
 
-    /* Crumble block timers (parallel to collision array) */
-    uint8_t  crumble_timer[MAX_ROOM_WIDTH_TILES * MAX_ROOM_HEIGHT_TILES];
+    /* Active crumble blocks (swap-remove pool) */
+    CrumbleBlock crumbles[MAX_CRUMBLES];
+    uint8_t  crumble_count;
 
     /* Scroll bounds (pixels, 0 if room fits on one screen) */
     int scroll_max_x;
@@ -73,6 +106,16 @@ typedef struct {
 
 extern RoomData g_current_room;
 
+/* Solid-for-movement bitmaps of the current room, derived from
+ * collision[] at load and kept in sync by room_set_collision / crumble
+ * breaks. Separate from RoomData so it can sit in DTCM (512 bytes). */
+typedef struct {
+    uint32_t rows[MAX_ROOM_HEIGHT_TILES][SOLID_ROW_WORDS];
+    uint32_t cols[MAX_ROOM_WIDTH_TILES][SOLID_COL_WORDS];
+} RoomSolidMap;
+
+extern RoomSolidMap g_room_solid;
+
 /* Initialize room system (zero state) */
 void    room_init(void);
 
@@ -82,25 +125,91 @@ bool    room_load(uint8_t area_id, uint8_t room_id);
 /* Unload current room */
 void    room_unload(void);
 
+/* Start building a room in the background buffer without touching the
+ * current one. Replaces any other pending prefetch; no-op if this room
+ * is already pending or ready. False if the room doesn't exist. */
+bool    room_prefetch(uint8_t area_id, uint8_t room_id);
+
+/* Advance the pending prefetch by one stage. Call once per frame. */
+void    room_prefetch_update(void);
+
+/* True once the room is fully built; room_load of it is then only a
+ * buffer commit plus queued uploads. */
+bool    room_prefetch_ready(uint8_t area_id, uint8_t room_id);
+
+/* Drop any pending or ready prefetch */
+void    room_prefetch_cancel(void);
+
+/* LRU cache of rooms Samus has left (see ROOM_CACHE_BUDGET). Leaving a
+ * room stores it as it was left; loading a cached room restores that
+ * state without a decode. Reloading the live room starts it fresh.
+ * Clear the cache to give a new session untouched rooms. */
+bool    room_cache_has(uint8_t area_id, uint8_t room_id);
+int     room_cache_count(void);
+int     room_cache_capacity(void);
+void    room_cache_clear(void);
+
+/* Snapshot section: the live room, trimmed to its size (snapshot.c).
+ * Loading rebuilds the solid bitmaps and BG map, drops any prefetch and
+ * clears the cache, whose rooms belong to the replaced timeline. */
+void    room_snapshot_save(SnapshotWriter* w);
+void    room_snapshot_load(SnapshotReader* r);
+
 /* O(1) collision query. Returns COLL_SOLID for out-of-bounds. */
 uint8_t room_get_collision(int tile_x, int tile_y);
 
+/* O(1) solid test from the packed bitmap. Out-of-bounds is solid. */
+bool    room_is_solid(int tile_x, int tile_y);
+
+/* Span queries: true if any tile in the inclusive range is solid.
+ * Any part of the span outside the room counts as solid. */
+bool    room_row_has_solid(int tile_x_min, int tile_x_max, int tile_y);
+bool    room_col_has_solid(int tile_x, int tile_y_min, int tile_y_max);
+
 /* O(1) BTS query. Returns 0 for out-of-bounds. */
 uint8_t room_get_bts(int tile_x, int tile_y);
 
-/* O(1) set collision type at runtime (for breakable blocks) */
+/* O(1) set collision type at runtime (for breakable blocks).
+ * Setting COLL_AIR also clears the metatile and queues a redraw. */
 void    room_set_collision(int tile_x, int tile_y, uint8_t new_type);
 
+/* Change a metatile graphic at runtime. Queued for redraw. */
+void    room_set_metatile(int tile_x, int tile_y, uint16_t metatile);
+
 /* Check if body overlaps any door. Returns DoorData* or NULL. */
 const DoorData* room_check_door_collision(const PhysicsBody* body);
 
+/* Nearest door within margin_px of the body's centre, or NULL */
+const DoorData* room_find_door_near(const PhysicsBody* body, int margin_px);
+
 /* Check if body overlaps an item. Grants it if so. Returns item type or ITEM_NONE. */
 ItemTypeID room_check_item_pickup(const PhysicsBody* body);
 
-/* Update crumble block timers. Call once per frame during gameplay. */
+/* Start the break timer on a crumble block. No-op if the tile is not
+ * COLL_SPECIAL_CRUMBLE or is already counting down. Returns false if
+ * the active list is full (caller may retry next frame). */
+bool    room_start_crumble(int tile_x, int tile_y);
+
+/* Update active crumble block timers. Call once per frame during gameplay. */
 void    room_update_crumble_blocks(void);
 
 /* Upload current room tilemap/tileset/palette to VRAM */
 void    room_upload_to_vram(void);
 
+/* Queue BG map patches for metatiles changed since the last flush.
+ * Falls back to room_upload_to_vram() if too many changed at once.
+ * Call once per frame before graphics_end_frame. */
+void    room_flush_dirty_tiles(void);
+
+/* Stream newly exposed metatile columns/rows for the given level BG
+ * scroll (pixels). Rooms larger than the 512x512 hardware BG are shown
+ * through a wrapping 32x32 metatile window. Called from camera_apply. */
+void    room_stream_update(int scroll_x, int scroll_y);
+
+/* Top-left metatile of the resident streaming window (for tests/debug) */
+void    room_stream_get_origin(int* tile_x, int* tile_y);
+
+/* Number of metatiles waiting for redraw (for tests/debug) */
+int     room_get_dirty_tile_count(void);
+
 #endif /* ROOM_H */
@@ -0,0 +1,94 @@
+/**
+ * room_pack.h - Compiled room pack (rooms.bin) reader
+ *
+ * Rooms are compiled from the assets/rooms JSON files by tools/room_pack.py
+ * into one pack stored in NitroFS. Mounting reads the header and the sorted
+ * room index once; a room load is then a binary search plus one seek and
+ * a handful of freads straight into the destination RoomData, so load
+ * time is bounded by the room's own size, not the pack's.
+ *
+ * Records may be LC_LZ2-compressed (room_pack.py --compress); those
+ * are read whole and expanded into a scratch buffer first.
+ *
+ * Layout (little-endian; see tools/room_pack.py for the full table):
+ *   RoomPackHeader, RoomPackEntry[room_count] sorted by key,
+ *   then one record per room (RoomPackRecord + doors, spawns, items,
+ *   collision, bts, tilemap).
+ *
+ * Implemented in: source/room_pack.c
+ */
+
+#ifndef ROOM_PACK_H
+#define ROOM_PACK_H
+
+#include "sm_types.h"
+#include "room.h"
+
+#define ROOM_PACK_MAGIC    0x4B505253  /* "SRPK" */
+#define ROOM_PACK_VERSION  1
+
+/* RoomPackEntry.flags */
+#define ROOM_PACK_FLAG_LZ  0x0001       /* Record is LC_LZ2-compressed */
+
+/* Largest possible decoded record (max room, max doors/spawns/items) */
+#define ROOM_PACK_RECORD_MAX \
+    (8 + MAX_DOORS * 12 + MAX_ENEMIES * 10 + MAX_ITEMS * 8 + 3 + \
+     MAX_ROOM_WIDTH_TILES * MAX_ROOM_HEIGHT_TILES * 4 + 1)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t room_count;
+    uint32_t index_offset;
+    uint32_t file_size;
+} RoomPackHeader;
+
+typedef struct {
+    uint16_t key;           /* area_id << 8 | room_id */
+    uint16_t flags;
+    uint32_t offset;        /* Record offset from file start */
+    uint32_t size;          /* Stored size (compressed size if LZ) */
+} RoomPackEntry;
+
+typedef struct {
+    uint16_t width_tiles;
+    uint16_t height_tiles;
+    uint8_t  tileset_id;
+    uint8_t  door_count;
+    uint8_t  spawn_count;
+    uint8_t  item_count;
+} RoomPackRecord;
+
+/* Items are stored in pixels, converted to ItemData on load */
+typedef struct {
+    uint16_t type;
+    int16_t  x;
+    int16_t  y;
+    uint16_t reserved;
+} RoomPackItem;
+
+/* Open a pack and read its index. Replaces any mounted pack.
+ * False (nothing mounted) if missing, malformed or too large. */
+bool room_pack_mount(const char* path);
+
+/* Close the mounted pack */
+void room_pack_unmount(void);
+
+bool room_pack_mounted(void);
+int  room_pack_room_count(void);
+bool room_pack_has(uint8_t area_id, uint8_t room_id);
+
+/* Read a room's layout, doors, spawns and items into out. Leaves the
+ * runtime fields (ids, loaded, crumbles, scroll bounds) to the caller.
+ * False if not mounted, not in the pack, or the record is corrupt. */
+bool room_pack_read(uint8_t area_id, uint8_t room_id, RoomData* out);
+
+/* room_pack_read in two halves, so a compressed record expands in the
+ * background between them. begin reads the stored bytes and queues the
+ * expansion (replacing any read in flight); end waits for it if needed
+ * and parses. ready: end would not have to wait. */
+bool room_pack_read_begin(uint8_t area_id, uint8_t room_id);
+bool room_pack_read_ready(void);
+bool room_pack_read_end(RoomData* out);
+
+#endif /* ROOM_PACK_H */
@@ -16,7 +16,12 @@
  * Falls back to in-memory-only if FAT is unavailable.
  * Game code never touches the raw save image.
  *
- * Implemented in: source/save.c (M15)
+ * save_write/save_delete only update the in-memory image. The changed
+ * slot and checksum blocks reach the file through save_flush_update(),
+ * called once per frame, which writes at most SAVE_FLUSH_CHUNK bytes a
+ * call. A first save builds <file>.tmp and renames it over the .sav.
+ *
+ * Implemented in: source/save.c (M15), source/save_checksum.c
  */
 
 #ifndef SAVE_H
@@ -74,9 +79,23 @@ typedef struct {
 } SaveData;
 
 void save_init(void);
+
+/* Use path as the backing .sav (loaded now, written back by flushes).
+ * save_init mounts SAVE_FILE_PATH when FAT is available. */
+bool save_mount(const char* path);
+void save_unmount(void);             /* Finishes any flush first */
+
+void save_flush_update(void);        /* Once per frame */
+bool save_flush_pending(void);
+void save_flush_sync(void);          /* Block until the file is current */
+
 bool save_write(int slot, const SaveData* data);
 bool save_read(int slot, SaveData* data);
 bool save_slot_valid(int slot);
 void save_delete(int slot);
 
+/* SNES SRAM checksum (alternating-byte accumulator) over len bytes */
+void save_checksum(const uint8_t* data, uint32_t len,
+                   uint8_t* out_hi, uint8_t* out_lo);
+
 #endif /* SAVE_H */
@@ -30,6 +30,12 @@
 #define ARM9_CLOCK_HZ   67028000   /* 67.028 MHz */
 #define CYCLES_PER_FRAME (ARM9_CLOCK_HZ / TARGET_FPS)  /* ~1,117,133 */
 
+/* One video frame in bus ticks: 263 lines x 355 dots x 6 (59.83 Hz) */
+#define BUS_TICKS_PER_FRAME  560190
+
+/* Missed VBlanks made up per frame by extra simulation steps (pacing.h) */
+#define PACING_MAX_CATCHUP   3
+
 /* ========================================================================
  * VRAM Bank Assignments
  *
@@ -58,6 +64,17 @@
 #define VRAM_H_CONFIG   VRAM_H_SUB_BG
 #define VRAM_I_CONFIG   VRAM_I_SUB_BG_0x06208000
 
+/* VRAM upload queue (graphics.c). Transfers are DMA'd at the start of
+ * VBlank, at most VRAM_UPLOAD_BUDGET bytes per frame; larger ones are
+ * split and finish on later frames. ~8 KB leaves VBlank headroom for
+ * OAM, palettes and map patches. */
+#define VRAM_UPLOAD_QUEUE_MAX  32
+#define VRAM_UPLOAD_BUDGET     8192
+
+/* HBlank effect channels use DMA 0..HBLANK_CHANNELS-1 in repeat/HBlank
+ * mode. DMA 3 stays free for dmaCopy (upload queue). */
+#define HBLANK_CHANNELS        2
+
 /* ========================================================================
  * BG Layer Assignments (Main Engine - Top Screen)
  * ======================================================================== */
@@ -86,11 +103,108 @@
  * Room / World Limits
  * ======================================================================== */
 
+/* Limited by RoomData RAM only: the level BG streams a 32x32 metatile
+ * window (room.c), so rooms may exceed the 512x512 hardware BG. */
 #define MAX_ROOM_WIDTH_TILES   64   /* Max room width in metatiles (16px each) */
 #define MAX_ROOM_HEIGHT_TILES  32   /* Max room height in metatiles */
 #define MAX_ROOM_WIDTH_PX    (MAX_ROOM_WIDTH_TILES * 16)   /* 1024px */
 #define MAX_ROOM_HEIGHT_PX   (MAX_ROOM_HEIGHT_TILES * 16)  /* 512px */
 
+/* Compiled room pack (tools/room_pack.py) in NitroFS. Rooms it doesn't
+ * contain, or a missing pack, fall back to the built-in rooms in room.c.
+ * The host build points ROOM_PACK_PATH at its own generated copy. */
+#ifndef ROOM_PACK_PATH
+#define ROOM_PACK_PATH       "nitro:/rooms.bin"
+#endif
+#define ROOM_PACK_MAX_ROOMS  512   /* Index entries held in RAM (12 B each) */
+
+/* Start prefetching a door's destination room when Samus is this close */
+#define DOOR_PREFETCH_MARGIN_PX  64
+
+/* RAM for decoded rooms kept for backtracking. Each entry is a full
+ * RoomData plus solid bitmaps and BG map (~19KB), so 64KB holds three. */
+#ifndef ROOM_CACHE_BUDGET
+#define ROOM_CACHE_BUDGET    (64 * 1024)
+#endif
+
+/* ========================================================================
+ * Enemy Activation
+ *
+ * Enemies outside the camera rect grown by ENEMY_WAKE_MARGIN_PX drop to
+ * their type's sleep mode (see enemy.c). They fall asleep only once past
+ * the margin plus ENEMY_SLEEP_HYSTERESIS_PX, so an enemy sitting on the
+ * boundary doesn't toggle every frame.
+ * ======================================================================== */
+
+#define ENEMY_WAKE_MARGIN_PX       64
+#define ENEMY_SLEEP_HYSTERESIS_PX  16
+
+/* ========================================================================
+ * Bosses
+ *
+ * Replacement boss programs (boss_NN.bin, see boss.h) are looked up here
+ * at each spawn; types without a file use the built-in program. Each
+ * boss part is its own broadphase entry.
+ * ======================================================================== */
+
+#define BOSS_PROGRAM_DIR      "nitro:/bosses"
+#define BOSS_MAX_PARTS        8     /* Hit regions per boss (broadphase entries) */
+
+/* ========================================================================
+ * Audio
+ *
+ * SFX share AUDIO_SFX_VOICES Maxmod effect voices; the rest of the
+ * hardware channels are left to music.
+ * ======================================================================== */
+
+#define AUDIO_SOUNDBANK_PATH  "nitro:/soundbank.bin"
+#define AUDIO_SFX_VOICES      8
+
+/* ========================================================================
+ * ARM7 Jobs
+ *
+ * coproc.c keeps up to COPROC_QUEUE_MAX job descriptors in flight to the
+ * ARM7 worker (room record expansion, save checksums); one more waits
+ * for the oldest. The worker thread's stack is sized for the deepest job.
+ * ======================================================================== */
+
+#define COPROC_QUEUE_MAX          8     /* Power of two */
+#define COPROC_ARM7_STACK_SIZE    1024  /* Bytes, ARM7 worker thread */
+
+/* ========================================================================
+ * Save Persistence
+ *
+ * save.c keeps the 8KB SRAM image in RAM and writes it back through a
+ * temp file from save_flush_update(), at most SAVE_FLUSH_CHUNK bytes per
+ * frame so a slow SD card never stalls the game.
+ * ======================================================================== */
+
+#ifndef SAVE_FILE_PATH
+#define SAVE_FILE_PATH     "SuperMetroidDS.sav"
+#endif
+#define SAVE_FLUSH_CHUNK   512
+
+/* ========================================================================
+ * Logging
+ *
+ * Messages above LOG_LEVEL (LOG_LEVEL_* in log.h) are compiled out.
+ * Debug builds (DEBUG_TESTS) keep everything; release builds keep only
+ * warnings and errors. Override with DEFINES="-DLOG_LEVEL=n".
+ * The ring is drained at most LOG_DRAIN_BUDGET bytes per frame.
+ * ======================================================================== */
+
+#ifndef LOG_LEVEL
+#ifdef DEBUG_TESTS
+#define LOG_LEVEL          LOG_LEVEL_DEBUG
+#else
+#define LOG_LEVEL          LOG_LEVEL_WARN
+#endif
+#endif
+#define LOG_RING_SIZE      4096   /* Power of two */
+#define LOG_LINE_MAX       128    /* Longer messages are truncated */
+#define LOG_DRAIN_BUDGET   256
+#define LOG_FILE_PATH      "SuperMetroidDS.log"
+
 /* ========================================================================
  * Input Buffering
  * ======================================================================== */
@@ -98,4 +212,31 @@
 #define INPUT_BUFFER_FRAMES  8   /* Circular buffer for input history */
 #define INPUT_BUFFER_WINDOW  5   /* Frames a buffered press stays valid */
 
+/* ========================================================================
+ * Debug / Profiling
+ *
+ * The profiler cascades two hardware timers into a free-running 32-bit
+ * bus-clock counter. Timers 0/1 are left for audio and libnds.
+ * Debug keys are pressed while holding DEBUG_KEY_MODIFIER.
+ * ======================================================================== */
+
+#define PROFILER_TIMER        2   /* Low half; PROFILER_TIMER+1 is the high half */
+#define PROF_OVERLAY_ROW      4   /* First sub-screen console row of the overlay */
+
+#define DEBUG_KEY_MODIFIER  KEY_SELECT
+#define DEBUG_KEY_PROFILER  KEY_L    /* Toggle profiler overlay */
+#define DEBUG_KEY_RECORD    KEY_R    /* Start / stop-and-save replay recording */
+#define DEBUG_KEY_PLAYBACK  KEY_X    /* Play back REPLAY_FILE_NAME */
+#define DEBUG_KEY_SNAP_SAVE KEY_Y    /* Quick-save a snapshot to RAM */
+#define DEBUG_KEY_SNAP_LOAD KEY_B    /* Restore the quick-save snapshot */
+
+/* Replays restart the session at the title screen so that playback is
+ * frame-exact. Build with -DREPLAY_AUTOPLAY to play REPLAY_FILE_NAME at
+ * boot and log profiler session stats to stderr when it ends. */
+#define REPLAY_FILE_NAME    "SuperMetroidDS.rpl"
+
+/* RAM quick-save slot for simulation snapshots (snapshot.c). Covers a
+ * full-size room with full entity pools. */
+#define SNAPSHOT_MAX_BYTES  (16 * 1024)
+
 #endif /* SM_CONFIG_H */
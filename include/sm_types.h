@@ -12,6 +12,30 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/* ========================================================================
+ * Hot-Path Memory Placement
+ *
+ * SM_ITCM:     function runs from the 32KB ITCM (single-cycle fetch, no
+ *              I-cache misses, no bus contention with DMA).
+ * SM_DTCM:     initialized data in the 16KB DTCM.
+ * SM_DTCM_BSS: zeroed data in DTCM.
+ *
+ * DTCM is shared with the stack (~10KB kept free) and is invisible to
+ * DMA: never dmaCopy to or from SM_DTCM data. Check placement and the
+ * budget with tools/tcm_report.py. Build with -DSM_NO_TCM to A/B the
+ * effect in the profiler. Host builds always get plain sections.
+ * ======================================================================== */
+
+#if defined(ARM9) && !defined(SM_NO_TCM)
+#define SM_ITCM         ITCM_CODE
+#define SM_DTCM         DTCM_DATA
+#define SM_DTCM_BSS     DTCM_BSS
+#else
+#define SM_ITCM
+#define SM_DTCM
+#define SM_DTCM_BSS
+#endif
+
 /* ========================================================================
  * 16.16 Fixed-Point Arithmetic
  * Upper 16 bits = integer, lower 16 bits = fraction
@@ -35,9 +59,20 @@ static inline fx32 fx_mul(fx32 a, fx32 b) {
     return (fx32)(((int64_t)a * b) >> FX_SHIFT);
 }
 
-/* Divide two fx32: shifts numerator up first for precision */
+/* Divide two fx32: shifts numerator up first for precision.
+ * ARM9 uses the hardware divider (64/32, ~34 cycles) instead of the
+ * libgcc 64-bit software divide. Not IRQ-safe: interrupt handlers must
+ * not use the divider. See fixed_math.h for async variants. */
 static inline fx32 fx_div(fx32 a, fx32 b) {
+#ifdef ARM9
+    REG_DIVCNT = DIV_64_32;
+    REG_DIV_NUMER = (int64_t)a << FX_SHIFT;
+    REG_DIV_DENOM_L = b;
+    while (REG_DIVCNT & DIV_BUSY);
+    return (fx32)REG_DIV_RESULT_L;
+#else
     return (fx32)(((int64_t)a << FX_SHIFT) / b);
+#endif
 }
 
 /* ========================================================================
@@ -97,21 +132,19 @@ typedef enum {
 #define MAX_ITEMS         32
 #define MAX_DOORS          8
 #define MAX_PLMS          32   /* Post-Load Modifications (breakable blocks, etc.) */
+#define MAX_CRUMBLES      16   /* Crumble blocks counting down at once */
+#define MAX_TILE_ANIMS    16   /* Animated BG tile runs per tileset */
 
 /* ========================================================================
  * OAM Sprite Budget (128 per engine)
+ *
+ * Slots are packed each frame by the allocator in graphics.c; callers
+ * queue metasprites with a SpritePriority instead of owning slot ranges.
  * ======================================================================== */
 
-#define OAM_PLAYER_START    0   /* Samus: sprites 0-7 (up to 8 tiles) */
-#define OAM_PLAYER_COUNT    8
-#define OAM_ENEMY_START     8   /* Enemies: sprites 8-55 (3 per enemy * 16) */
-#define OAM_ENEMY_COUNT    48
-#define OAM_PROJ_START     56   /* Projectiles: sprites 56-87 */
-#define OAM_PROJ_COUNT     32
-#define OAM_PARTICLE_START 88   /* Particles: sprites 88-111 */
-#define OAM_PARTICLE_COUNT 24
-#define OAM_ITEM_START    112   /* Items/effects: sprites 112-127 */
-#define OAM_ITEM_COUNT     16
+#define OAM_SPRITE_COUNT  128   /* Hardware entries per engine */
+#define OAM_PIECE_MAX     256   /* Pieces queued per frame (may exceed OAM) */
+#define OAM_OBJECT_MAX    128   /* Metasprites queued per frame */
 
 /* ========================================================================
  * Tile / Collision Constants
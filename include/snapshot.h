@@ -0,0 +1,77 @@
+/**
+ * snapshot.h - Quick-save snapshots of the live simulation
+ *
+ * Unlike save.h's SNES-format slots, a snapshot is a raw copy of every
+ * piece of state one frame of gameplay reads: player, current room
+ * (including broken blocks and collected items), enemy and projectile
+ * pools, boss, camera, input history and game time. Restoring one puts
+ * the next frame exactly where the saved one would have gone, which is
+ * what practice tools and replay fast-forwarding need.
+ *
+ * Blobs are struct images, so they only load into a build with the same
+ * state layout (checked by a layout stamp in the header). The room is
+ * stored trimmed to its size; the rest of the blob is fixed-size.
+ *
+ * Implemented in: source/snapshot.c
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "sm_types.h"
+
+#define SNAPSHOT_MAGIC    0x53534D53   /* "SMSS" little-endian */
+#define SNAPSHOT_VERSION  1
+
+/* Blob header, followed by the module sections in a fixed order */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t layout;        /* Stamp over the state struct sizes */
+    uint32_t size;          /* Whole blob including this header */
+    uint32_t checksum;      /* FNV-1a over the bytes after the header */
+    uint32_t replay_frame;  /* input_replay_frame() when taken */
+} SnapshotHeader;
+
+/* Sequential writer / reader over a caller's buffer. Running past the
+ * end (or a module refusing, see gameplay) clears ok; later calls are
+ * ignored, so sections check ok once at the end. */
+typedef struct {
+    uint8_t* buf;
+    uint32_t cap;
+    uint32_t used;
+    bool     ok;
+} SnapshotWriter;
+
+typedef struct {
+    const uint8_t* buf;
+    uint32_t size;
+    uint32_t used;
+    bool     ok;
+} SnapshotReader;
+
+void snapshot_write(SnapshotWriter* w, const void* src, uint32_t len);
+void snapshot_read(SnapshotReader* r, void* dst, uint32_t len);
+
+/* Serialize the live state into buf. Returns the blob size, or 0 if it
+ * doesn't fit or the state can't be captured (door transition). */
+uint32_t snapshot_save(void* buf, uint32_t cap);
+
+/* Restore a blob from snapshot_save. False (state untouched) if it is
+ * damaged or from a build with a different state layout. During replay
+ * playback the replay is moved to the frame the snapshot was taken at. */
+bool snapshot_load(const void* buf, uint32_t size);
+
+/* Built-in RAM slot (SNAPSHOT_MAX_BYTES) for the debug quick-save keys */
+bool snapshot_quick_save(void);
+bool snapshot_quick_load(void);
+bool snapshot_quick_valid(void);
+
+/* Quick slot <-> FAT file. Save captures into the quick slot first;
+ * load checks the file, then replaces the quick slot and restores it.
+ * A missing or damaged file leaves the quick slot as it was. */
+bool snapshot_save_file(const char* path);
+bool snapshot_load_file(const char* path);
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,58 @@
+/**
+ * tile_anim.h - Animated tiles and sprite frame streaming
+ *
+ * BG animations overwrite a run of tileset tiles with the next frame's
+ * graphics on a timer (lava, acid, conveyors, water). Sprite streams
+ * keep one fixed OBJ VRAM slot per entity and upload only the frame
+ * being shown, so VRAM use doesn't grow with the animation set.
+ * Both go through the VRAM upload queue; frame data must stay valid
+ * and outside DTCM.
+ *
+ * Implemented in: source/tile_anim.c
+ */
+
+#ifndef TILE_ANIM_H
+#define TILE_ANIM_H
+
+#include "sm_types.h"
+
+/* One animated run of BG tiles. frames holds frame_count frames of
+ * tile_count 4bpp tiles each (32 bytes per tile). */
+typedef struct {
+    uint16_t  tile;          /* First tileset tile overwritten */
+    uint8_t   tile_count;
+    uint8_t   frame_count;
+    uint8_t   frame_ticks;   /* Video frames each animation frame is held */
+    const u8* frames;
+} TileAnimDef;
+
+/* Fixed-slot sprite stream. bank holds every frame back to back. */
+typedef struct {
+    const u8* bank;
+    uint16_t  frame_bytes;   /* Multiple of 32 (one 4bpp tile) */
+    uint16_t  vram_tile;     /* OBJ tile slot the current frame lives in */
+    int16_t   current;       /* Frame in VRAM (or queued), -1 = none */
+} SpriteStream;
+
+/* Drop all BG animations */
+void tile_anim_init(void);
+
+/* Install the animation table for a tileset on a BG layer. The table
+ * must outlive the room. Uploads frame 0 of each entry. */
+void tile_anim_set(int layer, const TileAnimDef* defs, int count);
+
+/* Advance timers; queues uploads for animations whose frame changed */
+void tile_anim_update(void);
+
+/* Current frame of installed animation index, -1 if out of range */
+int  tile_anim_get_frame(int index);
+
+/* Bind a stream to its bank and VRAM slot (nothing uploaded yet) */
+void sprite_stream_init(SpriteStream* s, const void* bank,
+                        uint16_t frame_bytes, uint16_t vram_tile);
+
+/* Make frame current. Queues an upload only if it changed.
+ * Returns false if the upload queue was full (retried next call). */
+bool sprite_stream_show(SpriteStream* s, int frame);
+
+#endif /* TILE_ANIM_H */
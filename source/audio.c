@@ -1,57 +1,422 @@
 /**
  * audio.c - Audio system (M14)
  *
- * Stub implementation that tracks music/SFX state.
- * When audio assets are added to the AUDIO directory,
- * the Makefile auto-links -lmm9 and this file gets
- * upgraded to real Maxmod playback.
+ * Maxmod playback when the build has a soundbank (the Makefile runs
+ * mmutil over AUDIO and links -lmm9 once audio assets exist); otherwise
+ * a silent backend. Everything above the backend -- music residency,
+ * SFX coalescing and voice allocation -- runs the same in both, so the
+ * host tests cover it.
  *
- * Current behavior:
- * - Tracks current music ID for area-based switching
- * - SFX calls are no-ops (no soundbank)
- * - Debug output via fprintf(stderr, ...)
+ * SFX requests only set a bit; audio_update() turns this frame's bits
+ * into voice starts, highest priority first. A voice counts as busy for
+ * its SFX's length in frames, so the ARM9 never has to query the ARM7.
  */
 
 #include "audio.h"
+#include "sm_config.h"
+#include "log.h"
 #include <stdio.h>
 
+#if defined(__has_include)
+#if __has_include(<maxmod9.h>) && __has_include("soundbank.h")
+#define AUDIO_MAXMOD 1
+#include <maxmod9.h>
+#include "soundbank.h"
+#endif
+#endif
+
+_Static_assert(SFX_COUNT <= 32, "SFX request mask is 32 bits");
+
+/* ========================================================================
+ * Soundbank IDs
+ *
+ * mmutil names entries after their files. Anything the asset set lacks
+ * maps to NO_ASSET and plays nothing.
+ * ======================================================================== */
+
+#define NO_ASSET 0xFFFF
+
+#ifndef MOD_MUSIC_TITLE
+#define MOD_MUSIC_TITLE                NO_ASSET
+#endif
+#ifndef MOD_MUSIC_CRATERIA_SURFACE
+#define MOD_MUSIC_CRATERIA_SURFACE     NO_ASSET
+#endif
+#ifndef MOD_MUSIC_CRATERIA_UNDERGROUND
+#define MOD_MUSIC_CRATERIA_UNDERGROUND NO_ASSET
+#endif
+#ifndef MOD_MUSIC_BRINSTAR_GREEN
+#define MOD_MUSIC_BRINSTAR_GREEN       NO_ASSET
+#endif
+#ifndef MOD_MUSIC_BRINSTAR_RED
+#define MOD_MUSIC_BRINSTAR_RED         NO_ASSET
+#endif
+#ifndef MOD_MUSIC_NORFAIR_UPPER
+#define MOD_MUSIC_NORFAIR_UPPER        NO_ASSET
+#endif
+#ifndef MOD_MUSIC_NORFAIR_LOWER
+#define MOD_MUSIC_NORFAIR_LOWER        NO_ASSET
+#endif
+#ifndef MOD_MUSIC_WRECKED_SHIP
+#define MOD_MUSIC_WRECKED_SHIP         NO_ASSET
+#endif
+#ifndef MOD_MUSIC_MARIDIA
+#define MOD_MUSIC_MARIDIA              NO_ASSET
+#endif
+#ifndef MOD_MUSIC_TOURIAN
+#define MOD_MUSIC_TOURIAN              NO_ASSET
+#endif
+#ifndef MOD_MUSIC_BOSS
+#define MOD_MUSIC_BOSS                 NO_ASSET
+#endif
+#ifndef MOD_MUSIC_MINIBOSS
+#define MOD_MUSIC_MINIBOSS             NO_ASSET
+#endif
+#ifndef MOD_MUSIC_ITEM_ROOM
+#define MOD_MUSIC_ITEM_ROOM            NO_ASSET
+#endif
+#ifndef MOD_MUSIC_ESCAPE
+#define MOD_MUSIC_ESCAPE               NO_ASSET
+#endif
+#ifndef MOD_MUSIC_ENDING
+#define MOD_MUSIC_ENDING               NO_ASSET
+#endif
+
+#ifndef SFX_SFX_BEAM
+#define SFX_SFX_BEAM           NO_ASSET
+#endif
+#ifndef SFX_SFX_MISSILE
+#define SFX_SFX_MISSILE        NO_ASSET
+#endif
+#ifndef SFX_SFX_SUPER_MISSILE
+#define SFX_SFX_SUPER_MISSILE  NO_ASSET
+#endif
+#ifndef SFX_SFX_BOMB
+#define SFX_SFX_BOMB           NO_ASSET
+#endif
+#ifndef SFX_SFX_POWER_BOMB
+#define SFX_SFX_POWER_BOMB     NO_ASSET
+#endif
+#ifndef SFX_SFX_JUMP
+#define SFX_SFX_JUMP           NO_ASSET
+#endif
+#ifndef SFX_SFX_LAND
+#define SFX_SFX_LAND           NO_ASSET
+#endif
+#ifndef SFX_SFX_DAMAGE
+#define SFX_SFX_DAMAGE         NO_ASSET
+#endif
+#ifndef SFX_SFX_ENEMY_HIT
+#define SFX_SFX_ENEMY_HIT      NO_ASSET
+#endif
+#ifndef SFX_SFX_ENEMY_DEATH
+#define SFX_SFX_ENEMY_DEATH    NO_ASSET
+#endif
+#ifndef SFX_SFX_DOOR
+#define SFX_SFX_DOOR           NO_ASSET
+#endif
+#ifndef SFX_SFX_ITEM
+#define SFX_SFX_ITEM           NO_ASSET
+#endif
+#ifndef SFX_SFX_SAVE
+#define SFX_SFX_SAVE           NO_ASSET
+#endif
+
+#ifdef AUDIO_MAXMOD
+static const uint16_t music_bank[MUSIC_COUNT] = {
+    [MUSIC_NONE]                 = NO_ASSET,
+    [MUSIC_TITLE]                = MOD_MUSIC_TITLE,
+    [MUSIC_CRATERIA_SURFACE]     = MOD_MUSIC_CRATERIA_SURFACE,
+    [MUSIC_CRATERIA_UNDERGROUND] = MOD_MUSIC_CRATERIA_UNDERGROUND,
+    [MUSIC_BRINSTAR_GREEN]       = MOD_MUSIC_BRINSTAR_GREEN,
+    [MUSIC_BRINSTAR_RED]         = MOD_MUSIC_BRINSTAR_RED,
+    [MUSIC_NORFAIR_UPPER]        = MOD_MUSIC_NORFAIR_UPPER,
+    [MUSIC_NORFAIR_LOWER]        = MOD_MUSIC_NORFAIR_LOWER,
+    [MUSIC_WRECKED_SHIP]         = MOD_MUSIC_WRECKED_SHIP,
+    [MUSIC_MARIDIA]              = MOD_MUSIC_MARIDIA,
+    [MUSIC_TOURIAN]              = MOD_MUSIC_TOURIAN,
+    [MUSIC_BOSS]                 = MOD_MUSIC_BOSS,
+    [MUSIC_MINIBOSS]             = MOD_MUSIC_MINIBOSS,
+    [MUSIC_ITEM_ROOM]            = MOD_MUSIC_ITEM_ROOM,
+    [MUSIC_ESCAPE]               = MOD_MUSIC_ESCAPE,
+    [MUSIC_ENDING]               = MOD_MUSIC_ENDING,
+};
+#endif
+
+/* Area music, indexed by area_id (0=Crateria..6=Ceres) */
+static const MusicID area_music[] = {
+    MUSIC_CRATERIA_SURFACE, MUSIC_BRINSTAR_GREEN, MUSIC_NORFAIR_UPPER,
+    MUSIC_WRECKED_SHIP, MUSIC_MARIDIA, MUSIC_TOURIAN, MUSIC_ESCAPE,
+};
+
+/* ========================================================================
+ * SFX Table
+ * ======================================================================== */
+
+typedef struct {
+    uint16_t bank;       /* Soundbank sample */
+    uint8_t  priority;   /* Higher steals lower */
+    uint8_t  volume;     /* 0-255 */
+    uint16_t frames;     /* Voice stays busy this long (sample length) */
+} SfxDef;
+
+static const SfxDef sfx_defs[SFX_COUNT] = {
+    [SFX_NONE]          = { NO_ASSET,              0,   0,   0 },
+    [SFX_BEAM]          = { SFX_SFX_BEAM,          40, 200,  12 },
+    [SFX_MISSILE]       = { SFX_SFX_MISSILE,       70, 255,  20 },
+    [SFX_SUPER_MISSILE] = { SFX_SFX_SUPER_MISSILE, 80, 255,  30 },
+    [SFX_BOMB]          = { SFX_SFX_BOMB,          60, 255,  20 },
+    [SFX_POWER_BOMB]    = { SFX_SFX_POWER_BOMB,   120, 255,  90 },
+    [SFX_JUMP]          = { SFX_SFX_JUMP,          20, 180,  10 },
+    [SFX_LAND]          = { SFX_SFX_LAND,          10, 160,   6 },
+    [SFX_DAMAGE]        = { SFX_SFX_DAMAGE,       110, 255,  20 },
+    [SFX_ENEMY_HIT]     = { SFX_SFX_ENEMY_HIT,     30, 200,   8 },
+    [SFX_ENEMY_DEATH]   = { SFX_SFX_ENEMY_DEATH,   50, 220,  24 },
+    [SFX_DOOR]          = { SFX_SFX_DOOR,          90, 255,  30 },
+    [SFX_ITEM]          = { SFX_SFX_ITEM,         200, 255,  60 },
+    [SFX_SAVE]          = { SFX_SFX_SAVE,         200, 255,  90 },
+};
+
 /* ========================================================================
  * State
  * ======================================================================== */
 
+typedef struct {
+    SfxID    sfx;           /* SFX_NONE = free */
+    uint16_t frames_left;
+    uint32_t started;       /* audio_frame at start, for oldest-first steals */
+    uint32_t handle;        /* Backend effect handle */
+} SfxVoice;
+
+static SfxVoice sfx_voices[AUDIO_SFX_VOICES];
+static uint32_t sfx_requests;       /* Bit per SfxID requested this frame */
+static uint32_t audio_frame;
+
 static MusicID current_music = MUSIC_NONE;
+static MusicID preloaded_music = MUSIC_NONE;
+static bool    bank_mounted;
+
+/* ========================================================================
+ * Backend
+ * ======================================================================== */
+
+#ifdef AUDIO_MAXMOD
+
+static void backend_mount(const char* path) {
+    mmInitDefault((char*)path);
+    for (int i = 0; i < SFX_COUNT; i++) {
+        if (sfx_defs[i].bank != NO_ASSET) mmLoadEffect(sfx_defs[i].bank);
+    }
+}
+
+static void backend_load_music(MusicID id) {
+    if (music_bank[id] != NO_ASSET) mmLoad(music_bank[id]);
+}
+
+static void backend_unload_music(MusicID id) {
+    if (music_bank[id] != NO_ASSET) mmUnload(music_bank[id]);
+}
+
+static void backend_start_music(MusicID id) {
+    if (music_bank[id] != NO_ASSET) mmStart(music_bank[id], MM_PLAY_LOOP);
+}
+
+static void backend_stop_music(void) {
+    mmStop();
+}
+
+static uint32_t backend_play_sfx(const SfxDef* def) {
+    if (def->bank == NO_ASSET) return 0;
+    mm_sound_effect fx = {
+        .id = def->bank,
+        .rate = 1024,           /* Native pitch */
+        .handle = 0,
+        .volume = def->volume,
+        .panning = 128,
+    };
+    return mmEffectEx(&fx);
+}
+
+static void backend_cancel_sfx(uint32_t handle) {
+    if (handle != 0) mmEffectCancel((mm_sfxhand)handle);
+}
+
+#else  /* No soundbank in this build */
+
+static void backend_load_music(MusicID id) { (void)id; }
+static void backend_unload_music(MusicID id) { (void)id; }
+static void backend_start_music(MusicID id) { (void)id; }
+static void backend_stop_music(void) {}
+static uint32_t backend_play_sfx(const SfxDef* def) { (void)def; return 0; }
+static void backend_cancel_sfx(uint32_t handle) { (void)handle; }
+
+#endif
+
+/* ========================================================================
+ * SFX Voices
+ * ======================================================================== */
+
+static bool voice_weaker(const SfxVoice* a, const SfxVoice* b) {
+    uint8_t pa = sfx_defs[a->sfx].priority;
+    uint8_t pb = sfx_defs[b->sfx].priority;
+    return pa < pb || (pa == pb && a->started < b->started);
+}
+
+/* Voice for a new SFX: the one already playing it (retrigger), a free
+ * one, or the weakest one it doesn't rank below. NULL to drop it. */
+static SfxVoice* pick_voice(SfxID id) {
+    SfxVoice* free_voice = NULL;
+    SfxVoice* weakest = NULL;
+    for (int i = 0; i < AUDIO_SFX_VOICES; i++) {
+        SfxVoice* v = &sfx_voices[i];
+        if (v->sfx == id) return v;
+        if (v->sfx == SFX_NONE) {
+            if (!free_voice) free_voice = v;
+        } else if (!weakest || voice_weaker(v, weakest)) {
+            weakest = v;
+        }
+    }
+    if (free_voice) return free_voice;
+    if (sfx_defs[weakest->sfx].priority > sfx_defs[id].priority) return NULL;
+    return weakest;
+}
+
+static void start_sfx(SfxID id) {
+    SfxVoice* v = pick_voice(id);
+    if (!v) return;
+
+    if (v->sfx != SFX_NONE) backend_cancel_sfx(v->handle);
+    const SfxDef* def = &sfx_defs[id];
+    v->sfx = id;
+    v->frames_left = def->frames;
+    v->started = audio_frame;
+    v->handle = bank_mounted ? backend_play_sfx(def) : 0;
+}
 
 /* ========================================================================
  * Public API
  * ======================================================================== */
 
 void audio_init(void) {
-    current_music = MUSIC_NONE;
-    fprintf(stderr, "audio: init (stub - no soundbank)\n");
+    audio_stop_music();
+    if (preloaded_music != MUSIC_NONE) {
+        if (bank_mounted) backend_unload_music(preloaded_music);
+        preloaded_music = MUSIC_NONE;
+    }
+    for (int i = 0; i < AUDIO_SFX_VOICES; i++) {
+        if (bank_mounted && sfx_voices[i].sfx != SFX_NONE) {
+            backend_cancel_sfx(sfx_voices[i].handle);
+        }
+        sfx_voices[i].sfx = SFX_NONE;
+    }
+    sfx_requests = 0;
+    audio_frame = 0;
+}
+
+bool audio_mount(const char* path) {
+#ifdef AUDIO_MAXMOD
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fclose(f);
+
+    backend_mount(path);
+    bank_mounted = true;
+    LOG_INFO("audio: soundbank %s (%d voices)\n", path, AUDIO_SFX_VOICES);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void audio_update(void) {
+    audio_frame++;
+
+    for (int i = 0; i < AUDIO_SFX_VOICES; i++) {
+        SfxVoice* v = &sfx_voices[i];
+        if (v->sfx != SFX_NONE && --v->frames_left == 0) v->sfx = SFX_NONE;
+    }
+
+    /* Highest priority first, so a full set of voices keeps the best */
+    while (sfx_requests) {
+        SfxID best = SFX_NONE;
+        for (int id = 1; id < SFX_COUNT; id++) {
+            if ((sfx_requests & (1u << id)) &&
+                (best == SFX_NONE || sfx_defs[id].priority > sfx_defs[best].priority)) {
+                best = (SfxID)id;
+            }
+        }
+        sfx_requests &= ~(1u << best);
+        start_sfx(best);
+    }
 }
 
 void audio_play_music(MusicID id) {
     if (id < 0 || id >= MUSIC_COUNT) return;
     if (id == current_music) return;
+    if (id == MUSIC_NONE) {
+        audio_stop_music();
+        return;
+    }
 
+    audio_stop_music();
+    if (preloaded_music == id) {
+        preloaded_music = MUSIC_NONE;   /* Already resident */
+    } else if (bank_mounted) {
+        backend_load_music(id);
+    }
+    if (bank_mounted) backend_start_music(id);
     current_music = id;
-    fprintf(stderr, "audio: play music %d\n", id);
 }
 
 void audio_stop_music(void) {
     if (current_music == MUSIC_NONE) return;
 
-    fprintf(stderr, "audio: stop music\n");
+    if (bank_mounted) {
+        backend_stop_music();
+        backend_unload_music(current_music);
+    }
     current_music = MUSIC_NONE;
 }
 
+void audio_preload_music(MusicID id) {
+    if (id <= MUSIC_NONE || id >= MUSIC_COUNT) return;
+    if (id == current_music || id == preloaded_music) return;
+
+    if (bank_mounted) {
+        if (preloaded_music != MUSIC_NONE) backend_unload_music(preloaded_music);
+        backend_load_music(id);
+    }
+    preloaded_music = id;
+}
+
 void audio_play_sfx(SfxID id) {
     if (id <= SFX_NONE || id >= SFX_COUNT) return;
-
-    fprintf(stderr, "audio: sfx %d\n", id);
-    /* No-op until soundbank is built */
+    sfx_requests |= 1u << id;
 }
 
 MusicID audio_get_current_music(void) {
     return current_music;
 }
+
+MusicID audio_get_preloaded_music(void) {
+    return preloaded_music;
+}
+
+MusicID audio_area_music(uint8_t area_id) {
+    if (area_id >= sizeof(area_music) / sizeof(area_music[0])) return MUSIC_NONE;
+    return area_music[area_id];
+}
+
+int audio_get_active_voices(void) {
+    int n = 0;
+    for (int i = 0; i < AUDIO_SFX_VOICES; i++) {
+        if (sfx_voices[i].sfx != SFX_NONE) n++;
+    }
+    return n;
+}
+
+SfxID audio_get_voice_sfx(int voice) {
+    if (voice < 0 || voice >= AUDIO_SFX_VOICES) return SFX_NONE;
+    return sfx_voices[voice].sfx;
+}
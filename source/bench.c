@@ -0,0 +1,340 @@
+/**
+ * bench.c - Micro-benchmarks for hot paths
+ *
+ * Each benchmark times `calls` invocations of one function, best of
+ * BENCH_REPEATS. Inputs are prepared outside the timed region where the
+ * function mutates its input (physics bodies, projectile pools).
+ *
+ * The whole file is empty unless DEBUG_BENCH is defined.
+ */
+
+#ifdef DEBUG_BENCH
+
+#include "bench.h"
+#include <nds.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fixed_math.h"
+#include "profiler.h"
+#include "room.h"
+#include "physics.h"
+#include "player.h"
+#include "enemy.h"
+#include "projectile.h"
+#include "snapshot.h"
+
+/* ========================================================================
+ * State
+ * ======================================================================== */
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int         result_count;
+
+/* Keeps results observable so the optimizer can't drop the work */
+static volatile fx32 bench_sink;
+
+typedef uint32_t (*BenchFn)(uint32_t calls);   /* Returns elapsed ticks */
+
+/* ========================================================================
+ * Benchmarks
+ * ======================================================================== */
+
+/* Spread of magnitudes: sub-pixel speeds up to room-sized distances */
+#define SQRT_INPUTS 16
+static const fx32 sqrt_inputs[SQRT_INPUTS] = {
+    0x00000100, 0x00004000, 0x00010000, 0x00020000,
+    0x00048000, 0x00100000, 0x00400000, 0x00900000,
+    0x01000000, 0x04000000, 0x10000000, 0x20000000,
+    0x40000000, 0x7FFFFFFF, 0x00000001, 0x00C80000,
+};
+
+static uint32_t bench_fx_sqrt(uint32_t calls) {
+    fx32 acc = 0;
+    uint32_t t0 = profiler_ticks();
+    for (uint32_t i = 0; i < calls; i++) {
+        acc += fx_sqrt(sqrt_inputs[i & (SQRT_INPUTS - 1)]);
+    }
+    uint32_t t1 = profiler_ticks();
+    bench_sink = acc;
+    return t1 - t0;
+}
+
+static uint32_t bench_fx_lerp(uint32_t calls) {
+    fx32 acc = 0;
+    uint32_t t0 = profiler_ticks();
+    for (uint32_t i = 0; i < calls; i++) {
+        acc += fx_lerp(INT_TO_FX(-40), INT_TO_FX(200), (fx32)(i & 0xFFFF));
+    }
+    uint32_t t1 = profiler_ticks();
+    bench_sink = acc;
+    return t1 - t0;
+}
+
+/* Physics: step a fresh copy of a template body each call */
+static uint32_t bench_body(const PhysicsBody* tmpl, uint32_t calls) {
+    static PhysicsBody bodies[64];
+    uint32_t elapsed = 0;
+
+    for (uint32_t done = 0; done < calls; ) {
+        uint32_t n = calls - done;
+        if (n > 64) n = 64;
+        for (uint32_t i = 0; i < n; i++) bodies[i] = *tmpl;
+
+        uint32_t t0 = profiler_ticks();
+        for (uint32_t i = 0; i < n; i++) physics_update_body(&bodies[i]);
+        elapsed += profiler_ticks() - t0;
+        done += n;
+    }
+    bench_sink = bodies[0].pos.y;
+    return elapsed;
+}
+
+static void body_template(PhysicsBody* b, int x, int y, fx32 vx, fx32 vy) {
+    memset(b, 0, sizeof(*b));
+    b->pos.x = INT_TO_FX(x);
+    b->pos.y = INT_TO_FX(y);
+    b->vel.x = vx;
+    b->vel.y = vy;
+    b->hitbox.half_w = INT_TO_FX(8);
+    b->hitbox.half_h = INT_TO_FX(16);
+    b->env = ENV_AIR;
+}
+
+/* Mid-air, walking speed, no contacts */
+static uint32_t bench_phys_air(uint32_t calls) {
+    PhysicsBody b;
+    body_template(&b, 40, 60, INT_TO_FX(1), 0);
+    return bench_body(&b, calls);
+}
+
+/* Standing on the floor of room 0:0 while running into nothing */
+static uint32_t bench_phys_ground(uint32_t calls) {
+    PhysicsBody b;
+    body_template(&b, 40, 160 - 16, INT_TO_FX(2), 0);
+    return bench_body(&b, calls);
+}
+
+/* Faster than a tile per frame: takes the swept path */
+static uint32_t bench_phys_fast(uint32_t calls) {
+    PhysicsBody b;
+    body_template(&b, 40, 60, INT_TO_FX(20), INT_TO_FX(12));
+    return bench_body(&b, calls);
+}
+
+/* Collision lookups: raster over the whole room, one lookup per call */
+static uint32_t bench_coll_sweep(uint32_t calls) {
+    int w = g_current_room.width_tiles;
+    int h = g_current_room.height_tiles;
+    uint32_t acc = 0;
+    int x = 0, y = 0;
+
+    uint32_t t0 = profiler_ticks();
+    for (uint32_t i = 0; i < calls; i++) {
+        acc += room_get_collision(x, y);
+        if (++x >= w) {
+            x = 0;
+            if (++y >= h) y = 0;
+        }
+    }
+    uint32_t t1 = profiler_ticks();
+    bench_sink = (fx32)acc;
+    return t1 - t0;
+}
+
+/* Span query across a player-width run of tiles */
+static uint32_t bench_row_span(uint32_t calls) {
+    int h = g_current_room.height_tiles;
+    uint32_t acc = 0;
+
+    uint32_t t0 = profiler_ticks();
+    for (uint32_t i = 0; i < calls; i++) {
+        acc += room_row_has_solid(2, 5, (int)(i % h));
+    }
+    uint32_t t1 = profiler_ticks();
+    bench_sink = (fx32)acc;
+    return t1 - t0;
+}
+
+/* Full enemy pool, one enemy_update_all per call */
+static uint32_t bench_enemy_update(uint32_t calls) {
+    enemy_clear_all();
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        EnemyTypeID type = (EnemyTypeID)(ENEMY_ZOOMER + i % (ENEMY_TYPE_COUNT - 1));
+        enemy_spawn(type, INT_TO_FX(32 + (i % 8) * 24), INT_TO_FX(64 + (i / 8) * 48));
+    }
+
+    uint32_t t0 = profiler_ticks();
+    for (uint32_t i = 0; i < calls; i++) enemy_update_all();
+    uint32_t t1 = profiler_ticks();
+
+    enemy_clear_all();
+    return t1 - t0;
+}
+
+/* Half-full projectile pool against a full enemy pool */
+#define BENCH_PROJ_FRAMES 8
+static uint32_t bench_proj_update(uint32_t calls) {
+    uint32_t elapsed = 0;
+
+    enemy_clear_all();
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        enemy_spawn(ENEMY_WAVER, INT_TO_FX(32 + (i % 8) * 24), INT_TO_FX(40 + (i / 8) * 32));
+    }
+
+    for (uint32_t done = 0; done < calls; done += BENCH_PROJ_FRAMES) {
+        projectile_clear_all();
+        for (int i = 0; i < MAX_PROJECTILES / 2; i++) {
+            projectile_spawn(PROJ_POWER_BEAM, PROJ_OWNER_PLAYER,
+                             INT_TO_FX(24 + (i % 4) * 8), INT_TO_FX(40 + i * 6),
+                             INT_TO_FX(4), 0);
+        }
+
+        uint32_t t0 = profiler_ticks();
+        for (int f = 0; f < BENCH_PROJ_FRAMES; f++) projectile_update_all();
+        elapsed += profiler_ticks() - t0;
+    }
+
+    projectile_clear_all();
+    enemy_clear_all();
+    return elapsed;
+}
+
+/* Restore of a snapshot with full entity pools (must stay well under a frame) */
+static uint32_t bench_snap_load(uint32_t calls) {
+    static u8 blob[SNAPSHOT_MAX_BYTES];
+
+    enemy_clear_all();
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(32 + (i % 8) * 24), INT_TO_FX(64 + (i / 8) * 48));
+    }
+    uint32_t size = snapshot_save(blob, sizeof(blob));
+
+    uint32_t t0 = profiler_ticks();
+    for (uint32_t i = 0; i < calls; i++) bench_sink += snapshot_load(blob, size);
+    uint32_t t1 = profiler_ticks();
+
+    enemy_clear_all();
+    return t1 - t0;
+}
+
+/* ========================================================================
+ * Baseline File ("name cycles_x10" per line)
+ * ======================================================================== */
+
+static void load_baseline(void) {
+    FILE* f = fopen(BENCH_BASELINE_FILE, "r");
+    if (!f) return;
+
+    char name[32];
+    unsigned long value;
+    while (fscanf(f, "%31s %lu", name, &value) == 2) {
+        for (int i = 0; i < result_count; i++) {
+            if (strcmp(results[i].name, name) == 0) {
+                results[i].baseline_x10 = (uint32_t)value;
+            }
+        }
+    }
+    fclose(f);
+}
+
+static bool save_baseline(void) {
+    FILE* f = fopen(BENCH_BASELINE_FILE, "w");
+    if (!f) return false;
+    for (int i = 0; i < result_count; i++) {
+        fprintf(f, "%s %lu\n", results[i].name,
+                (unsigned long)results[i].cycles_x10);
+    }
+    fclose(f);
+    return true;
+}
+
+/* ========================================================================
+ * Runner
+ * ======================================================================== */
+
+static void run_bench(const char* name, BenchFn fn, uint32_t calls) {
+    if (result_count >= BENCH_MAX_RESULTS) return;
+
+    uint32_t best = 0xFFFFFFFFu;
+    fn(calls / 8 + 1);  /* Warm caches */
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        uint32_t ticks = fn(calls);
+        if (ticks < best) best = ticks;
+    }
+
+    BenchResult* res = &results[result_count++];
+    memset(res, 0, sizeof(*res));
+    res->name = name;
+    res->calls = calls;
+    res->cycles_x10 = (uint32_t)((uint64_t)profiler_ticks_to_cycles(best) * 10 / calls);
+}
+
+bool bench_run_all(void) {
+    iprintf("--- Benchmarks ---\n");
+    result_count = 0;
+
+    room_load(0, 0);
+    player_init();
+    enemy_pool_init();
+    projectile_pool_init();
+
+    run_bench("fx_sqrt",      bench_fx_sqrt,      4096);
+    run_bench("fx_lerp",      bench_fx_lerp,      4096);
+    run_bench("phys_air",     bench_phys_air,     1024);
+    run_bench("phys_ground",  bench_phys_ground,  1024);
+    run_bench("phys_fast",    bench_phys_fast,    1024);
+    run_bench("coll_sweep",   bench_coll_sweep,   4096);
+    run_bench("row_span",     bench_row_span,     4096);
+    run_bench("enemy_update", bench_enemy_update, 64);
+    run_bench("proj_update",  bench_proj_update,  64);
+    run_bench("snap_load",    bench_snap_load,    16);
+
+    room_unload();
+
+    load_baseline();
+
+    bool have_baseline = false;
+    bool ok = true;
+    for (int i = 0; i < result_count; i++) {
+        BenchResult* r = &results[i];
+        if (r->baseline_x10) {
+            have_baseline = true;
+            uint32_t limit = (uint32_t)((uint64_t)r->baseline_x10 *
+                                        (100 + BENCH_TOLERANCE_PCT) / 100);
+            if (limit < r->baseline_x10 + BENCH_MIN_DELTA_X10)
+                limit = r->baseline_x10 + BENCH_MIN_DELTA_X10;
+            r->regressed = r->cycles_x10 > limit;
+            if (r->regressed) ok = false;
+        }
+        iprintf("%-12s %7lu.%lu %s\n", r->name,
+                (unsigned long)(r->cycles_x10 / 10),
+                (unsigned long)(r->cycles_x10 % 10),
+                r->regressed ? "SLOW" : "");
+        fprintf(stderr, "bench: %s %lu.%lu cyc/call (base %lu.%lu)%s\n",
+                r->name,
+                (unsigned long)(r->cycles_x10 / 10),
+                (unsigned long)(r->cycles_x10 % 10),
+                (unsigned long)(r->baseline_x10 / 10),
+                (unsigned long)(r->baseline_x10 % 10),
+                r->regressed ? " REGRESSED" : "");
+    }
+
+    if (!have_baseline) {
+        bool saved = save_baseline();
+        iprintf("bench: baseline %s\n", saved ? "written" : "not saved");
+    }
+
+    return ok;
+}
+
+int bench_get_result_count(void) {
+    return result_count;
+}
+
+const BenchResult* bench_get_result(int index) {
+    if (index < 0 || index >= result_count) return NULL;
+    return &results[index];
+}
+
+#endif /* DEBUG_BENCH */
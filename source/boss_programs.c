@@ -0,0 +1,1221 @@
+/**
+ * boss_programs.c - Built-in boss behavior programs
+ *
+ * One op array per boss, run by the interpreter in boss_vm.c. State
+ * numbers are part of each boss's interface (tests and saved snapshots
+ * refer to them), so new states go at the end of an enum. Ops before
+ * the first B_STATE run once at spawn; blocks between B_IF* and B_END
+ * are indented for reading only.
+ *
+ * Replacements for these programs can be shipped as files (boss_mount
+ * in boss.h); boss_program_export() writes one out as a starting point.
+ *
+ * Boss-specific field usage:
+ *   Spore Spawn:   param_a = swing angle, anchor = ceiling attachment,
+ *                  sub_timer = spore cooldown
+ *   Crocomire:     anchor_x = lava threshold (spawn_x + CROC_PUSH_THRESHOLD),
+ *                  anchor_y = ground, attack_count = spits since last lunge
+ *   Bomb Torizo:   param_a = spawn X, sub_timer = idle duration,
+ *                  attack_count = attacks since last lunge
+ *   Kraid:         param_a = rise target Y, sub_timer = idle duration,
+ *                  attack_count = attacks since last roar
+ *   Botwoon:       param_a = snake angle, param_b = hole index,
+ *                  anchor = room center, sub_timer = emerges this cycle
+ *   Phantoon:      param_a = hover angle, param_b = rage flag,
+ *                  sub_timer = flame cooldown, attack_count = flames this cycle
+ *   Draygon:       param_a = swim direction, param_b = grab timer (fx32),
+ *                  anchor = patrol center/altitude, sub_timer = attacks
+ *   Golden Torizo: param_a = spawn X, param_b = holding a caught missile,
+ *                  sub_timer = idle duration
+ *   Ridley:        param_a = fly direction, sub_timer = bob angle
+ *   Mother Brain:  phase = 0/1/2, sub_timer = shot cooldown
+ *
+ * Parts are listed in the header: armor regions (shells,
+ * claws, tails) block shots, B_CORE regions take the damage. Bosses
+ * without a part list are hit anywhere on their hitbox.
+ */
+
+#include "boss_vm.h"
+#include "projectile.h"
+
+#define OP_COUNT(ops)  (sizeof(ops) / sizeof((ops)[0]))
+
+#define HDR(boss, ops)                                  \
+    .magic = BOSS_PROGRAM_MAGIC,                        \
+    .version = BOSS_PROGRAM_VERSION,                    \
+    .op_count = OP_COUNT(ops),                          \
+    .type = (boss)
+
+/* ========================================================================
+ * Spore Spawn
+ *
+ * Swings on a pendulum, descends, opens its core (VULNERABLE, shooting
+ * spores), closes and rises back to the ceiling.
+ * ======================================================================== */
+
+enum {
+    SS_SWING = 0,
+    SS_DESCEND,
+    SS_OPEN,
+    SS_VULNERABLE,
+    SS_CLOSE,
+    SS_ASCEND,
+    SS_DEATH
+};
+
+#define SS_HP                960
+#define SS_CONTACT_DAMAGE    40
+#define SS_SWING_RADIUS      INT_TO_FX(48)   /* Horizontal swing extent */
+#define SS_SWING_SPEED       3               /* LUT angle units per frame */
+#define SS_SWING_FRAMES      300             /* ~5 sec of swinging */
+#define SS_DESCEND_SPEED     INT_TO_FX(1)    /* px/frame downward */
+#define SS_DESCEND_DIST      64              /* px below anchor */
+#define SS_ASCEND_SPEED      INT_TO_FX(1)    /* px/frame upward */
+#define SS_OPEN_FRAMES       30
+#define SS_VULN_FRAMES       120             /* ~2 sec vulnerability window */
+#define SS_CLOSE_FRAMES      30
+#define SS_SPORE_INTERVAL    45              /* Frames between spore shots */
+#define SS_SPORE_SPEED       INT_TO_FX(2)    /* Spore projectile speed */
+#define SS_DEATH_FRAMES      60              /* 1-second death animation */
+
+static const BossOp ss_ops[] = {
+    B_COPY(BF_ANCHOR_X, BF_POS_X),
+    B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+
+    B_STATE(SS_SWING, BSF_CONTACT),
+        B_OSC(BAXIS_X, BF_PARAM_A, SS_SWING_SPEED, SS_SWING_RADIUS),
+        B_COPY(BF_POS_Y, BF_ANCHOR_Y),
+        B_TICK(),
+        B_AFTER(SS_SWING_FRAMES),
+            B_COPY(BF_POS_X, BF_ANCHOR_X),  /* Center before descending */
+            B_GOTO(SS_DESCEND),
+        B_END(),
+
+    B_STATE(SS_DESCEND, BSF_CONTACT),
+        B_MOVE_TO(BAXIS_Y, BF_ANCHOR_Y, SS_DESCEND_DIST, SS_DESCEND_SPEED),
+        B_IF_ARRIVED(),
+            B_GOTO(SS_OPEN),
+        B_END(),
+
+    B_STATE(SS_OPEN, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(SS_OPEN_FRAMES),
+            B_SET(BF_VULNERABLE, 1),
+            B_SET(BF_SUB_TIMER, 0),
+            B_GOTO(SS_VULNERABLE),
+        B_END(),
+
+    B_STATE(SS_VULNERABLE, BSF_CONTACT),
+        B_TICK(),
+        B_ADD(BF_SUB_TIMER, 1),
+        B_IF_GE(BF_SUB_TIMER, SS_SPORE_INTERVAL),
+            B_SET(BF_SUB_TIMER, 0),
+            B_FIRE(FIRE_AIM_X | FIRE_AIM_Y, 0, 0,
+                   SS_SPORE_SPEED, SS_SPORE_SPEED >> 1),
+        B_END(),
+        B_AFTER(SS_VULN_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            B_GOTO(SS_CLOSE),
+        B_END(),
+
+    B_STATE(SS_CLOSE, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(SS_CLOSE_FRAMES),
+            B_GOTO(SS_ASCEND),
+        B_END(),
+
+    B_STATE(SS_ASCEND, BSF_CONTACT),
+        B_MOVE_TO(BAXIS_Y, BF_ANCHOR_Y, 0, -SS_ASCEND_SPEED),
+        B_IF_ARRIVED(),
+            B_SET(BF_PARAM_A, 0),           /* Reset swing angle */
+            B_GOTO(SS_SWING),
+        B_END(),
+
+    B_STATE(SS_DEATH, 0),
+        B_TICK(),
+        B_AFTER(SS_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Crocomire
+ *
+ * Hits push it toward the lava pit instead of depleting HP; pushed past
+ * anchor_x it falls in. Advances on Samus, spits, and lunges after
+ * every CROC_LUNGE_EVERY spits.
+ * ======================================================================== */
+
+enum {
+    CROC_ADVANCE = 0,
+    CROC_SPIT,
+    CROC_FLINCH,
+    CROC_LUNGE,
+    CROC_FALLING,
+    CROC_DEATH
+};
+
+#define CROC_HP_DUMMY           9999  /* Effectively infinite */
+#define CROC_CONTACT_DAMAGE     30
+#define CROC_ADVANCE_SPEED      0x4000       /* 0.25 px/f toward player */
+#define CROC_PUSH_PER_HIT       8            /* px pushback per hit */
+#define CROC_PUSH_THRESHOLD     INT_TO_FX(160) /* 160 px to reach lava */
+#define CROC_FLINCH_FRAMES      20
+#define CROC_SPIT_FRAMES        40           /* Duration of spit attack */
+#define CROC_SPIT_SPEED         INT_TO_FX(3)
+#define CROC_LUNGE_SPEED        INT_TO_FX(3) /* Fast forward lunge */
+#define CROC_LUNGE_FRAMES       15
+#define CROC_ADVANCE_DURATION   180          /* Frames before spit attack */
+#define CROC_LUNGE_EVERY        3            /* Lunge after every N spits */
+#define CROC_DEATH_FRAMES       90
+#define CROC_FALL_SPEED         INT_TO_FX(2)
+#define CROC_FALL_FRAMES        45
+
+static const BossOp croc_ops[] = {
+    B_COPY(BF_ANCHOR_X, BF_POS_X),
+    B_ADD(BF_ANCHOR_X, CROC_PUSH_THRESHOLD),
+    B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+
+    B_STATE(CROC_ADVANCE, BSF_CONTACT),
+        B_TOWARD(BAXIS_X, BTW_BIASED, CROC_ADVANCE_SPEED),
+        B_TICK(),
+        B_AFTER(CROC_ADVANCE_DURATION),
+            B_IF_GE(BF_ATTACK_COUNT, CROC_LUNGE_EVERY),
+                B_SET(BF_ATTACK_COUNT, 0),
+                B_GOTO(CROC_LUNGE),
+            B_END(),
+            B_GOTO(CROC_SPIT),
+        B_END(),
+
+    B_STATE(CROC_SPIT, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X | FIRE_AIM_Y, 0, 0,
+                   CROC_SPIT_SPEED, CROC_SPIT_SPEED >> 2),
+            B_ADD(BF_ATTACK_COUNT, 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(CROC_SPIT_FRAMES),
+            B_GOTO(CROC_ADVANCE),
+        B_END(),
+
+    B_STATE(CROC_FLINCH, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(CROC_FLINCH_FRAMES),
+            B_GOTO(CROC_ADVANCE),
+        B_END(),
+
+    B_STATE(CROC_LUNGE, BSF_CONTACT),
+        B_TOWARD(BAXIS_X, BTW_BIASED, CROC_LUNGE_SPEED),
+        B_TICK(),
+        B_AFTER(CROC_LUNGE_FRAMES),
+            B_GOTO(CROC_ADVANCE),
+        B_END(),
+
+    B_STATE(CROC_FALLING, 0),
+        B_MOVE(BAXIS_Y, CROC_FALL_SPEED),
+        B_TICK(),
+        B_AFTER(CROC_FALL_FRAMES),
+            B_GOTO(CROC_DEATH),
+        B_END(),
+
+    B_STATE(CROC_DEATH, 0),
+        B_TICK(),
+        B_AFTER(CROC_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Bomb Torizo
+ *
+ * Statue until Samus comes close, then alternates bomb throws with a
+ * lunge every BT_LUNGE_EVERY throws.
+ * ======================================================================== */
+
+enum {
+    BT_STATUE = 0,
+    BT_WAKE,
+    BT_IDLE,
+    BT_BOMB,
+    BT_LUNGE,
+    BT_FLINCH,
+    BT_DEATH
+};
+
+#define BT_HP                  800
+#define BT_CONTACT_DAMAGE      20
+#define BT_WAKE_DIST           80  /* px proximity that wakes the statue */
+#define BT_WAKE_FRAMES         60
+#define BT_IDLE_MIN            30
+#define BT_IDLE_RANGE          60  /* Idle duration = MIN + (counter % RANGE) */
+#define BT_BOMB_VX             INT_TO_FX(2)
+#define BT_BOMB_VY             (-INT_TO_FX(3))  /* Arc upward */
+#define BT_BOMB_FRAMES         30  /* Attack animation duration */
+#define BT_LUNGE_SPEED         INT_TO_FX(2)
+#define BT_LUNGE_FRAMES        20
+#define BT_FLINCH_FRAMES       10
+#define BT_DEATH_FRAMES        60
+#define BT_LUNGE_EVERY         2   /* Lunge after every N bomb throws */
+
+#define BT_NEXT_IDLE() \
+    B_SET_MOD(BF_SUB_TIMER, BT_IDLE_MIN, BF_AI_COUNTER, BT_IDLE_RANGE)
+
+static const BossOp bt_ops[] = {
+    B_COPY(BF_PARAM_A, BF_POS_X),
+
+    B_STATE(BT_STATUE, 0),
+        B_IF_NEAR(BT_WAKE_DIST),
+            B_SHAKE(15, 2),
+            B_GOTO(BT_WAKE),
+        B_END(),
+
+    B_STATE(BT_WAKE, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(BT_WAKE_FRAMES),
+            B_SET(BF_VULNERABLE, 1),
+            BT_NEXT_IDLE(),
+            B_GOTO(BT_IDLE),
+        B_END(),
+
+    B_STATE(BT_IDLE, BSF_CONTACT),
+        B_TICK(),
+        B_IF_GE_FIELD(BF_AI_TIMER, BF_SUB_TIMER),
+            B_IF_GE(BF_ATTACK_COUNT, BT_LUNGE_EVERY),
+                B_SET(BF_ATTACK_COUNT, 0),
+                B_GOTO(BT_LUNGE),
+            B_END(),
+            B_GOTO(BT_BOMB),
+        B_END(),
+
+    B_STATE(BT_BOMB, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X, 0, -8, BT_BOMB_VX, BT_BOMB_VY),
+            B_ADD(BF_ATTACK_COUNT, 1),
+            B_ADD(BF_AI_COUNTER, 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(BT_BOMB_FRAMES),
+            BT_NEXT_IDLE(),
+            B_GOTO(BT_IDLE),
+        B_END(),
+
+    B_STATE(BT_LUNGE, BSF_CONTACT),
+        B_TOWARD(BAXIS_X, BTW_BIASED, BT_LUNGE_SPEED),
+        B_TICK(),
+        B_AFTER(BT_LUNGE_FRAMES),
+            BT_NEXT_IDLE(),
+            B_GOTO(BT_IDLE),
+        B_END(),
+
+    B_STATE(BT_FLINCH, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(BT_FLINCH_FRAMES),
+            BT_NEXT_IDLE(),
+            B_GOTO(BT_IDLE),
+        B_END(),
+
+    B_STATE(BT_DEATH, 0),
+        B_TICK(),
+        B_AFTER(BT_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Kraid
+ *
+ * Rises from the floor, then alternates fingernails and belly spikes;
+ * every KRAID_ROAR_EVERY attacks it roars with its mouth open, the only
+ * time it is VULNERABLE. A hit closes the mouth (flinch).
+ * ======================================================================== */
+
+enum {
+    KRAID_RISE = 0,
+    KRAID_IDLE,
+    KRAID_ROAR,
+    KRAID_FINGERNAILS,
+    KRAID_BELLY_SPIKE,
+    KRAID_FLINCH,
+    KRAID_DEATH
+};
+
+#define KRAID_HP               1000
+#define KRAID_CONTACT_DAMAGE   40
+#define KRAID_RISE_SPEED       INT_TO_FX(1)  /* 1 px/f rising */
+#define KRAID_RISE_OFFSET      INT_TO_FX(48) /* Start 48px below target */
+#define KRAID_IDLE_MIN         60
+#define KRAID_IDLE_RANGE       60
+#define KRAID_ROAR_FRAMES      90            /* ~1.5 sec vulnerability window */
+#define KRAID_FLINCH_FRAMES    15
+#define KRAID_NAIL_FRAMES      30            /* Fingernail attack duration */
+#define KRAID_SPIKE_FRAMES     30            /* Belly spike attack duration */
+#define KRAID_NAIL_SPEED       INT_TO_FX(3)  /* Fingernail projectile speed */
+#define KRAID_SPIKE_VX         INT_TO_FX(1)
+#define KRAID_SPIKE_VY         (-INT_TO_FX(4)) /* Upward arc */
+#define KRAID_ROAR_EVERY       3             /* Roar after every N attacks */
+#define KRAID_DEATH_FRAMES     90
+
+#define KRAID_NEXT_IDLE() \
+    B_SET_MOD(BF_SUB_TIMER, KRAID_IDLE_MIN, BF_AI_COUNTER, KRAID_IDLE_RANGE)
+
+static const BossOp kraid_ops[] = {
+    B_COPY(BF_PARAM_A, BF_POS_Y),
+    B_ADD(BF_POS_Y, KRAID_RISE_OFFSET),
+
+    B_STATE(KRAID_RISE, 0),
+        B_MOVE_TO(BAXIS_Y, BF_PARAM_A, 0, -KRAID_RISE_SPEED),
+        B_IF_ARRIVED(),
+            B_SET(BF_SUB_TIMER, KRAID_IDLE_MIN),
+            B_SHAKE(20, 3),
+            B_GOTO(KRAID_IDLE),
+        B_END(),
+
+    B_STATE(KRAID_IDLE, BSF_CONTACT),
+        B_TICK(),
+        B_IF_GE_FIELD(BF_AI_TIMER, BF_SUB_TIMER),
+            B_IF_GE(BF_ATTACK_COUNT, KRAID_ROAR_EVERY),
+                B_SET(BF_VULNERABLE, 1),
+                B_SET(BF_ATTACK_COUNT, 0),
+                B_GOTO(KRAID_ROAR),
+            B_END(),
+            B_IF_MOD(BF_AI_COUNTER, 2, 0),
+                B_GOTO(KRAID_FINGERNAILS),
+            B_END(),
+            B_GOTO(KRAID_BELLY_SPIKE),
+        B_END(),
+
+    B_STATE(KRAID_ROAR, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(KRAID_ROAR_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            KRAID_NEXT_IDLE(),
+            B_GOTO(KRAID_IDLE),
+        B_END(),
+
+    B_STATE(KRAID_FINGERNAILS, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X, 0, -16, KRAID_NAIL_SPEED, -(KRAID_NAIL_SPEED >> 2)),
+            B_FIRE(FIRE_AIM_X, 0,   0, KRAID_NAIL_SPEED, 0),
+            B_FIRE(FIRE_AIM_X, 0,  16, KRAID_NAIL_SPEED, KRAID_NAIL_SPEED >> 2),
+            B_ADD(BF_ATTACK_COUNT, 1),
+            B_ADD(BF_AI_COUNTER, 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(KRAID_NAIL_FRAMES),
+            KRAID_NEXT_IDLE(),
+            B_GOTO(KRAID_IDLE),
+        B_END(),
+
+    B_STATE(KRAID_BELLY_SPIKE, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X, 0, 8, KRAID_SPIKE_VX, KRAID_SPIKE_VY),
+            B_FIRE(FIRE_AIM_X, 0, 8, KRAID_SPIKE_VX + (KRAID_SPIKE_VX >> 1),
+                   KRAID_SPIKE_VY),
+            B_ADD(BF_ATTACK_COUNT, 1),
+            B_ADD(BF_AI_COUNTER, 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(KRAID_SPIKE_FRAMES),
+            KRAID_NEXT_IDLE(),
+            B_GOTO(KRAID_IDLE),
+        B_END(),
+
+    B_STATE(KRAID_FLINCH, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(KRAID_FLINCH_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            B_SET(BF_SUB_TIMER, KRAID_IDLE_MIN),
+            B_GOTO(KRAID_IDLE),
+        B_END(),
+
+    B_STATE(KRAID_DEATH, 0),
+        B_MOVE(BAXIS_Y, KRAID_RISE_SPEED),  /* Sink back down */
+        B_TICK(),
+        B_AFTER(KRAID_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Botwoon
+ *
+ * Pokes its head out of one of four holes to spit (VULNERABLE while
+ * out); after BOT_EMERGE_PER_CYCLE emerges it snakes across the room.
+ * ======================================================================== */
+
+enum {
+    BOT_HIDDEN = 0,
+    BOT_EMERGE,
+    BOT_SPIT,
+    BOT_RETREAT,
+    BOT_SNAKE,
+    BOT_DEATH
+};
+
+#define BOT_HP                 3000
+#define BOT_CONTACT_DAMAGE     30
+#define BOT_HIDDEN_FRAMES      45
+#define BOT_EMERGE_FRAMES      20
+#define BOT_SPIT_FRAMES        30
+#define BOT_RETREAT_FRAMES     15
+#define BOT_SPIT_SPEED         INT_TO_FX(3)
+#define BOT_SNAKE_WIDTH        INT_TO_FX(120)  /* Sweep across room center */
+#define BOT_SNAKE_AMPLITUDE    INT_TO_FX(40)
+#define BOT_SNAKE_FREQ         4          /* LUT units per frame */
+#define BOT_SNAKE_FRAMES       180        /* ~3 sec snake phase */
+#define BOT_EMERGE_PER_CYCLE   4          /* Emerges before snake phase */
+#define BOT_DEATH_FRAMES       60
+
+static const BossOp bot_ops[] = {
+    B_COPY(BF_ANCHOR_X, BF_POS_X),
+    B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+
+    B_STATE(BOT_HIDDEN, 0),
+        B_TICK(),
+        B_AFTER(BOT_HIDDEN_FRAMES),
+            B_WARP_POINT(BF_AI_COUNTER),    /* Next hole */
+            B_GOTO(BOT_EMERGE),
+        B_END(),
+
+    B_STATE(BOT_EMERGE, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(BOT_EMERGE_FRAMES),
+            B_SET(BF_VULNERABLE, 1),
+            B_GOTO(BOT_SPIT),
+        B_END(),
+
+    B_STATE(BOT_SPIT, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X | FIRE_AIM_Y, 0, 0,
+                   BOT_SPIT_SPEED, BOT_SPIT_SPEED >> 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(BOT_SPIT_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            B_ADD(BF_SUB_TIMER, 1),
+            B_ADD(BF_AI_COUNTER, 1),
+            B_GOTO(BOT_RETREAT),
+        B_END(),
+
+    B_STATE(BOT_RETREAT, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(BOT_RETREAT_FRAMES),
+            B_IF_GE(BF_SUB_TIMER, BOT_EMERGE_PER_CYCLE),
+                B_SET(BF_PARAM_A, 0),
+                B_SET(BF_SUB_TIMER, 0),
+                B_SET(BF_VULNERABLE, 1),
+                B_GOTO(BOT_SNAKE),
+            B_END(),
+            B_GOTO(BOT_HIDDEN),
+        B_END(),
+
+    B_STATE(BOT_SNAKE, BSF_CONTACT),
+        B_OSC(BAXIS_Y, BF_PARAM_A, BOT_SNAKE_FREQ, BOT_SNAKE_AMPLITUDE),
+        B_SWEEP(BAXIS_X, BOT_SNAKE_FRAMES, BOT_SNAKE_WIDTH),
+        B_TICK(),
+        B_AFTER(BOT_SNAKE_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            B_GOTO(BOT_HIDDEN),
+        B_END(),
+
+    B_STATE(BOT_DEATH, 0),
+        B_TICK(),
+        B_AFTER(BOT_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Phantoon
+ *
+ * Alternates invisible (invulnerable) and visible (VULNERABLE, flames).
+ * A super missile hit sets the rage flag: later visible phases become
+ * RAGE (faster, twice the flames).
+ * ======================================================================== */
+
+enum {
+    PH_INVISIBLE = 0,
+    PH_FADE_IN,
+    PH_VISIBLE,
+    PH_FADE_OUT,
+    PH_RAGE,
+    PH_DEATH
+};
+
+#define PH_HP                  2500
+#define PH_CONTACT_DAMAGE      30
+#define PH_INVIS_FRAMES        90           /* Time spent invisible */
+#define PH_FADE_FRAMES         20
+#define PH_VISIBLE_FRAMES      120          /* ~2 sec visible */
+#define PH_RAGE_FRAMES         180          /* ~3 sec rage */
+#define PH_FLAME_INTERVAL      30           /* Normal flame rate */
+#define PH_RAGE_FLAME_INTERVAL 15           /* Rage flame rate */
+#define PH_FLAME_SPEED         INT_TO_FX(2)
+#define PH_RAGE_FLAME_SPEED    INT_TO_FX(3)
+#define PH_FLOAT_SPEED         3            /* LUT angle units per frame */
+#define PH_FLOAT_AMPLITUDE     INT_TO_FX(20)
+#define PH_HOVER_SPEED         0x8000       /* 0.5 px/f drift */
+#define PH_DEATH_FRAMES        60
+#define PH_FLAMES_PER_CYCLE    4
+#define PH_RAGE_FLAMES         8
+#define PH_SUPER_DAMAGE        200          /* Super missile hit enrages */
+
+/* Bob around anchor_y and drift toward Samus */
+#define PH_HOVER() \
+    B_OSC(BAXIS_Y, BF_PARAM_A, PH_FLOAT_SPEED, PH_FLOAT_AMPLITUDE), \
+    B_TOWARD(BAXIS_X, BTW_DEADZONE, PH_HOVER_SPEED)
+
+static const BossOp ph_ops[] = {
+    B_COPY(BF_ANCHOR_X, BF_POS_X),
+    B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+
+    B_STATE(PH_INVISIBLE, 0),
+        B_TICK(),
+        B_AFTER(PH_INVIS_FRAMES),
+            /* Reposition near player */
+            B_COPY(BF_POS_X, BF_SAMUS_X),
+            B_ADD(BF_POS_X, INT_TO_FX(40)),
+            B_COPY(BF_POS_Y, BF_SAMUS_Y),
+            B_ADD(BF_POS_Y, -INT_TO_FX(32)),
+            B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+            B_GOTO(PH_FADE_IN),
+        B_END(),
+
+    B_STATE(PH_FADE_IN, 0),
+        B_TICK(),
+        B_AFTER(PH_FADE_FRAMES),
+            B_SET(BF_VULNERABLE, 1),
+            B_SET(BF_SUB_TIMER, 0),
+            B_SET(BF_ATTACK_COUNT, 0),
+            B_SET(BF_PARAM_A, 0),
+            B_IF_NE(BF_PARAM_B, 0),
+                B_GOTO(PH_RAGE),
+            B_END(),
+            B_GOTO(PH_VISIBLE),
+        B_END(),
+
+    B_STATE(PH_VISIBLE, BSF_CONTACT),
+        PH_HOVER(),
+        B_TICK(),
+        B_ADD(BF_SUB_TIMER, 1),
+        B_IF_GE(BF_SUB_TIMER, PH_FLAME_INTERVAL),
+            B_IF_LT(BF_ATTACK_COUNT, PH_FLAMES_PER_CYCLE),
+                B_SET(BF_SUB_TIMER, 0),
+                B_ADD(BF_ATTACK_COUNT, 1),
+                B_FIRE(FIRE_AIM_X | FIRE_AIM_Y, 0, 0,
+                       PH_FLAME_SPEED, PH_FLAME_SPEED >> 1),
+            B_END(),
+        B_END(),
+        B_AFTER(PH_VISIBLE_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            B_GOTO(PH_FADE_OUT),
+        B_END(),
+
+    B_STATE(PH_FADE_OUT, 0),
+        B_TICK(),
+        B_AFTER(PH_FADE_FRAMES),
+            B_GOTO(PH_INVISIBLE),
+        B_END(),
+
+    B_STATE(PH_RAGE, BSF_CONTACT),
+        PH_HOVER(),
+        B_TICK(),
+        B_ADD(BF_SUB_TIMER, 1),
+        B_IF_GE(BF_SUB_TIMER, PH_RAGE_FLAME_INTERVAL),
+            B_IF_LT(BF_ATTACK_COUNT, PH_RAGE_FLAMES),
+                B_SET(BF_SUB_TIMER, 0),
+                B_ADD(BF_ATTACK_COUNT, 1),
+                /* Spread flame pattern */
+                B_FIRE(FIRE_AIM_X, 0, 0,
+                       PH_RAGE_FLAME_SPEED, -(PH_RAGE_FLAME_SPEED >> 1)),
+                B_FIRE(FIRE_AIM_X, 0, 0,
+                       PH_RAGE_FLAME_SPEED, PH_RAGE_FLAME_SPEED >> 1),
+            B_END(),
+        B_END(),
+        B_AFTER(PH_RAGE_FRAMES),
+            B_SET(BF_VULNERABLE, 0),
+            B_GOTO(PH_FADE_OUT),
+        B_END(),
+
+    B_STATE(PH_DEATH, 0),
+        B_TICK(),
+        B_AFTER(PH_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Draygon
+ *
+ * Patrols left/right, alternating a swoop at Samus (grabbing and
+ * draining her if it connects) with a gunk spit.
+ * ======================================================================== */
+
+enum {
+    DY_SWIM = 0,
+    DY_SWOOP,
+    DY_GRAB,
+    DY_SPIT,
+    DY_RETREAT,
+    DY_DEATH
+};
+
+#define DY_HP                  6000
+#define DY_CONTACT_DAMAGE      40
+#define DY_SWIM_SPEED          INT_TO_FX(1)
+#define DY_SWIM_RANGE          80               /* px from center */
+#define DY_SWIM_ATTACK_EVERY   120              /* Frames between attacks */
+#define DY_SWOOP_SPEED         INT_TO_FX(3)
+#define DY_SWOOP_FRAMES        25
+#define DY_GRAB_DIST           16               /* px to latch on */
+#define DY_GRAB_FRAMES         INT_TO_FX(90)    /* How long Draygon holds */
+#define DY_GRAB_DRAIN_EVERY    INT_TO_FX(15)
+#define DY_GRAB_DAMAGE         2                /* HP per drain */
+#define DY_SPIT_FRAMES         30
+#define DY_SPIT_SPEED          INT_TO_FX(2)
+#define DY_RETREAT_SPEED       INT_TO_FX(2)
+#define DY_RETREAT_TOLERANCE   2                /* px */
+#define DY_DEATH_FRAMES        90
+
+static const BossOp dy_ops[] = {
+    B_SET(BF_PARAM_A, FX_ONE),              /* Start swimming right */
+    B_COPY(BF_ANCHOR_X, BF_POS_X),
+    B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+
+    B_STATE(DY_SWIM, BSF_CONTACT),
+        B_PATROL(BAXIS_X, BF_PARAM_A, DY_SWIM_RANGE, DY_SWIM_SPEED),
+        B_TICK(),
+        B_AFTER(DY_SWIM_ATTACK_EVERY),
+            /* Alternate swoop and spit */
+            B_IF_MOD(BF_SUB_TIMER, 2, 0),
+                B_ADD(BF_SUB_TIMER, 1),
+                B_GOTO(DY_SWOOP),
+            B_END(),
+            B_ADD(BF_SUB_TIMER, 1),
+            B_GOTO(DY_SPIT),
+        B_END(),
+
+    B_STATE(DY_SWOOP, BSF_CONTACT),
+        B_TOWARD(BAXIS_X, BTW_DEADZONE, DY_SWOOP_SPEED),
+        B_TOWARD(BAXIS_Y, BTW_DEADZONE, DY_SWOOP_SPEED),
+        B_IF_NEAR(DY_GRAB_DIST),
+            B_SET(BF_PARAM_B, 0),
+            B_ADD(BF_ATTACK_COUNT, 1),
+            B_GOTO(DY_GRAB),
+        B_END(),
+        B_TICK(),
+        B_AFTER(DY_SWOOP_FRAMES),
+            B_GOTO(DY_RETREAT),
+        B_END(),
+
+    B_STATE(DY_GRAB, BSF_CONTACT),
+        B_ADD(BF_PARAM_B, FX_ONE),
+        B_IF_LT(BF_PARAM_B, DY_GRAB_FRAMES),
+            B_IF_MOD(BF_PARAM_B, DY_GRAB_DRAIN_EVERY, 0),
+                B_HURT(DY_GRAB_DAMAGE),
+            B_END(),
+        B_END(),
+        B_IF_GE(BF_PARAM_B, DY_GRAB_FRAMES),
+            B_GOTO(DY_RETREAT),             /* Release */
+        B_END(),
+
+    B_STATE(DY_SPIT, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X, 0, 0, DY_SPIT_SPEED, DY_SPIT_SPEED >> 1),
+            B_FIRE(FIRE_AIM_X, 0, 0, DY_SPIT_SPEED, -(DY_SPIT_SPEED >> 1)),
+        B_END(),
+        B_TICK(),
+        B_AFTER(DY_SPIT_FRAMES),
+            B_GOTO(DY_SWIM),
+        B_END(),
+
+    B_STATE(DY_RETREAT, BSF_CONTACT),
+        B_RETURN_TO(BAXIS_Y, BF_ANCHOR_Y, DY_RETREAT_TOLERANCE, DY_RETREAT_SPEED),
+        B_IF_ARRIVED(),
+            B_GOTO(DY_SWIM),
+        B_END(),
+
+    B_STATE(DY_DEATH, 0),
+        B_MOVE(BAXIS_Y, FX_ONE),            /* Sink */
+        B_TICK(),
+        B_AFTER(DY_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Golden Torizo
+ *
+ * Faster Bomb Torizo: energy balls and lunges. Catches super missiles
+ * (no damage) and throws them back.
+ * ======================================================================== */
+
+enum {
+    GT_IDLE = 0,
+    GT_ATTACK_ENERGY,
+    GT_ATTACK_LUNGE,
+    GT_CATCH,       /* Caught a super missile */
+    GT_THROW_BACK,  /* Throw caught projectile */
+    GT_FLINCH,
+    GT_DEATH
+};
+
+#define GT_HP                  8000
+#define GT_CONTACT_DAMAGE      50
+#define GT_IDLE_MIN            20
+#define GT_IDLE_RANGE          40
+#define GT_ENERGY_VX           INT_TO_FX(3)
+#define GT_ENERGY_VY           (-INT_TO_FX(2))
+#define GT_ENERGY_FRAMES       25
+#define GT_LUNGE_SPEED         INT_TO_FX(3)
+#define GT_LUNGE_FRAMES        18
+#define GT_CATCH_FRAMES        20
+#define GT_THROW_SPEED         INT_TO_FX(4)
+#define GT_THROW_FRAMES        15
+#define GT_FLINCH_FRAMES       8
+#define GT_DEATH_FRAMES        60
+#define GT_LUNGE_EVERY         2
+#define GT_SUPER_DAMAGE        200          /* Hits this hard get caught */
+
+#define GT_NEXT_IDLE() \
+    B_SET_MOD(BF_SUB_TIMER, GT_IDLE_MIN, BF_AI_COUNTER, GT_IDLE_RANGE)
+
+static const BossOp gt_ops[] = {
+    B_SET(BF_SUB_TIMER, GT_IDLE_MIN),
+    B_COPY(BF_PARAM_A, BF_POS_X),
+
+    B_STATE(GT_IDLE, BSF_CONTACT),
+        B_TICK(),
+        B_IF_GE_FIELD(BF_AI_TIMER, BF_SUB_TIMER),
+            B_IF_GE(BF_ATTACK_COUNT, GT_LUNGE_EVERY),
+                B_SET(BF_ATTACK_COUNT, 0),
+                B_GOTO(GT_ATTACK_LUNGE),
+            B_END(),
+            B_GOTO(GT_ATTACK_ENERGY),
+        B_END(),
+
+    B_STATE(GT_ATTACK_ENERGY, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X, 0, -8, GT_ENERGY_VX, GT_ENERGY_VY),
+            B_ADD(BF_ATTACK_COUNT, 1),
+            B_ADD(BF_AI_COUNTER, 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(GT_ENERGY_FRAMES),
+            GT_NEXT_IDLE(),
+            B_GOTO(GT_IDLE),
+        B_END(),
+
+    B_STATE(GT_ATTACK_LUNGE, BSF_CONTACT),
+        B_TOWARD(BAXIS_X, BTW_BIASED, GT_LUNGE_SPEED),
+        B_TICK(),
+        B_AFTER(GT_LUNGE_FRAMES),
+            B_ADD(BF_AI_COUNTER, 1),
+            GT_NEXT_IDLE(),
+            B_GOTO(GT_IDLE),
+        B_END(),
+
+    B_STATE(GT_CATCH, BSF_CONTACT | BSF_NO_CATCH),
+        B_TICK(),
+        B_AFTER(GT_CATCH_FRAMES),
+            B_GOTO(GT_THROW_BACK),
+        B_END(),
+
+    B_STATE(GT_THROW_BACK, BSF_CONTACT | BSF_NO_CATCH),
+        B_ON_ENTER(),
+            B_FIRE(FIRE_AIM_X, 0, 0, GT_THROW_SPEED, 0),
+        B_END(),
+        B_TICK(),
+        B_AFTER(GT_THROW_FRAMES),
+            B_SET(BF_PARAM_B, 0),
+            B_SET(BF_SUB_TIMER, GT_IDLE_MIN),
+            B_GOTO(GT_IDLE),
+        B_END(),
+
+    B_STATE(GT_FLINCH, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(GT_FLINCH_FRAMES),
+            GT_NEXT_IDLE(),
+            B_GOTO(GT_IDLE),
+        B_END(),
+
+    B_STATE(GT_DEATH, 0),
+        B_TICK(),
+        B_AFTER(GT_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Ridley
+ *
+ * Patrols with a sine bob and cycles tail swipe, fireballs, grab and
+ * pogo. Attacks come faster as HP drops (BC_AGGRO).
+ * ======================================================================== */
+
+enum {
+    RI_FLY = 0,
+    RI_TAIL,
+    RI_FIREBALL,
+    RI_GRAB,
+    RI_POGO,
+    RI_DEATH
+};
+
+#define RI_HP                  18000
+#define RI_CONTACT_DAMAGE      60
+#define RI_FLY_SPEED           INT_TO_FX(2)
+#define RI_FLY_RANGE           70     /* px from center */
+#define RI_BOB_SPEED           2      /* LUT angle units per frame */
+#define RI_BOB_AMPLITUDE       INT_TO_FX(12)
+#define RI_ATTACK_INTERVAL     90     /* Base interval (reduced at low HP) */
+#define RI_ATTACK_TYPES        4      /* TAIL..POGO */
+#define RI_TAIL_FRAMES         20
+#define RI_FIREBALL_SPEED      INT_TO_FX(3)
+#define RI_FIREBALL_FRAMES     25
+#define RI_GRAB_FRAMES         60
+#define RI_GRAB_DIST           12     /* px */
+#define RI_GRAB_DAMAGE         3
+#define RI_POGO_SPEED          INT_TO_FX(4)
+#define RI_POGO_FRAMES         30
+#define RI_DEATH_FRAMES        120
+
+static const BossOp ri_ops[] = {
+    B_SET(BF_PARAM_A, FX_ONE),              /* Fly direction */
+    B_COPY(BF_ANCHOR_X, BF_POS_X),
+    B_COPY(BF_ANCHOR_Y, BF_POS_Y),
+
+    B_STATE(RI_FLY, BSF_CONTACT),
+        B_PATROL(BAXIS_X, BF_PARAM_A, RI_FLY_RANGE, RI_FLY_SPEED),
+        B_OSC(BAXIS_Y, BF_SUB_TIMER, RI_BOB_SPEED, RI_BOB_AMPLITUDE),
+        B_TICK(),
+        B_IF_AGGRO(BF_AI_TIMER, RI_ATTACK_INTERVAL),
+            B_GOTO_CYCLE(RI_TAIL, BF_AI_COUNTER, RI_ATTACK_TYPES),
+        B_END(),
+
+    B_STATE(RI_TAIL, BSF_CONTACT),
+        B_TOWARD(BAXIS_X, BTW_BIASED, RI_FLY_SPEED * 2),
+        B_TICK(),
+        B_AFTER(RI_TAIL_FRAMES),
+            B_GOTO(RI_FLY),
+        B_END(),
+
+    B_STATE(RI_FIREBALL, BSF_CONTACT),
+        B_ON_ENTER(),
+            /* One fireball, three in a spread below half HP */
+            B_FIRE(FIRE_AIM_X, 0, 0, RI_FIREBALL_SPEED, -INT_TO_FX(1)),
+            B_IF_HP_BELOW(2),
+                B_FIRE(FIRE_AIM_X, 0, 0, RI_FIREBALL_SPEED, 0),
+                B_FIRE(FIRE_AIM_X, 0, 0, RI_FIREBALL_SPEED, INT_TO_FX(1)),
+            B_END(),
+        B_END(),
+        B_TICK(),
+        B_AFTER(RI_FIREBALL_FRAMES),
+            B_GOTO(RI_FLY),
+        B_END(),
+
+    B_STATE(RI_GRAB, BSF_CONTACT),
+        B_IF_LT(BF_AI_TIMER, RI_GRAB_FRAMES / 2),
+            B_TOWARD(BAXIS_X, BTW_DEADZONE, RI_FLY_SPEED * 2),
+            B_TOWARD(BAXIS_Y, BTW_DEADZONE, RI_FLY_SPEED),
+            B_IF_NEAR(RI_GRAB_DIST),
+                B_HURT(RI_GRAB_DAMAGE),
+            B_END(),
+        B_END(),
+        B_TICK(),
+        B_AFTER(RI_GRAB_FRAMES),
+            B_GOTO(RI_FLY),
+        B_END(),
+
+    B_STATE(RI_POGO, BSF_CONTACT),
+        B_MOVE(BAXIS_Y, RI_POGO_SPEED),
+        B_TICK(),
+        B_IF_EQ(BF_AI_TIMER, RI_POGO_FRAMES / 2),
+            B_SHAKE(5, 2),
+        B_END(),
+        B_IF_GE(BF_AI_TIMER, RI_POGO_FRAMES / 2 + 1),
+            B_MOVE(BAXIS_Y, -RI_POGO_SPEED), /* Bounce back up */
+        B_END(),
+        B_AFTER(RI_POGO_FRAMES),
+            B_GOTO(RI_FLY),
+        B_END(),
+
+    B_STATE(RI_DEATH, 0),
+        B_IF_MOD(BF_AI_TIMER, 10, 0),
+            B_SHAKE(5, 3),
+        B_END(),
+        B_TICK(),
+        B_AFTER(RI_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Mother Brain
+ *
+ *   Phase 1: Brain in tank (3000 HP) - fires rinkas
+ *   Phase 2: Standing form (18000 HP) - beam ring, bomb drops
+ *   Phase 3: Final (36000 HP) - hyper beam sequence (scripted)
+ *
+ * phase field tracks current phase (0, 1, 2). "Death" in the first two
+ * enters a transition state that resets HP for the next phase. Only
+ * phases 2 and 3 deal contact damage.
+ * ======================================================================== */
+
+enum {
+    MB_TANK_IDLE = 0,     /* Phase 1: idle in tank */
+    MB_TANK_ATTACK,       /* Phase 1: rinka/turret fire */
+    MB_TANK_BREAK,        /* Phase 1→2 transition */
+    MB_STAND_IDLE,        /* Phase 2: standing idle */
+    MB_STAND_BEAM,        /* Phase 2: beam attack */
+    MB_STAND_BOMB,        /* Phase 2: bomb drop */
+    MB_HYPER_SETUP,       /* Phase 2→3 transition (baby metroid) */
+    MB_HYPER_BEAM,        /* Phase 3: Samus has hyper beam */
+    MB_DEATH              /* Final death */
+};
+
+#define MB_HP_PHASE1           3000
+#define MB_HP_PHASE2           18000
+#define MB_HP_PHASE3           36000
+#define MB_CONTACT_DAMAGE      20
+#define MB_RINKA_SPEED         INT_TO_FX(2)
+#define MB_RINKA_INTERVAL      60
+#define MB_BEAM_SPEED          INT_TO_FX(4)
+#define MB_BEAM_FRAMES         30
+#define MB_BOMB_VY             INT_TO_FX(2)
+#define MB_BOMB_FRAMES         25
+#define MB_BREAK_FRAMES        90
+#define MB_HYPER_SETUP_FRAMES  120
+#define MB_HYPER_INTERVAL      30
+#define MB_IDLE_FRAMES         60
+#define MB_DEATH_FRAMES        180
+
+static const BossOp mb_ops[] = {
+    /* === Phase 1: Brain in tank === */
+    B_STATE(MB_TANK_IDLE, 0),
+        B_TICK(),
+        B_AFTER(MB_IDLE_FRAMES),
+            B_GOTO(MB_TANK_ATTACK),
+        B_END(),
+
+    B_STATE(MB_TANK_ATTACK, 0),
+        B_ADD(BF_SUB_TIMER, 1),
+        B_IF_GE(BF_SUB_TIMER, MB_RINKA_INTERVAL),
+            B_SET(BF_SUB_TIMER, 0),
+            B_FIRE(FIRE_AIM_X, 0, 0, MB_RINKA_SPEED, 0),
+            B_ADD(BF_ATTACK_COUNT, 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(MB_IDLE_FRAMES * 3),
+            B_GOTO(MB_TANK_IDLE),
+        B_END(),
+
+    B_STATE(MB_TANK_BREAK, 0),
+        B_TICK(),
+        B_IF_MOD(BF_AI_TIMER, 15, 0),
+            B_SHAKE(10, 3),
+        B_END(),
+        B_AFTER(MB_BREAK_FRAMES),
+            B_SET(BF_PHASE, 1),
+            B_SET_HP(MB_HP_PHASE2),
+            B_SET(BF_SUB_TIMER, 0),
+            B_SET(BF_ATTACK_COUNT, 0),
+            B_SET(BF_VULNERABLE, 1),
+            B_SHAKE(30, 5),
+            B_GOTO(MB_STAND_IDLE),
+        B_END(),
+
+    /* === Phase 2: Standing === */
+    B_STATE(MB_STAND_IDLE, BSF_CONTACT),
+        B_TICK(),
+        B_AFTER(MB_IDLE_FRAMES),
+            /* Alternate beam and bomb */
+            B_GOTO_CYCLE(MB_STAND_BEAM, BF_AI_COUNTER, 2),
+        B_END(),
+
+    B_STATE(MB_STAND_BEAM, BSF_CONTACT),
+        B_ON_ENTER(),
+            /* Ring pattern: 3 beams */
+            B_FIRE(FIRE_AIM_X, 0, 0, MB_BEAM_SPEED, -(MB_BEAM_SPEED >> 1)),
+            B_FIRE(FIRE_AIM_X, 0, 0, MB_BEAM_SPEED, 0),
+            B_FIRE(FIRE_AIM_X, 0, 0, MB_BEAM_SPEED, MB_BEAM_SPEED >> 1),
+        B_END(),
+        B_TICK(),
+        B_AFTER(MB_BEAM_FRAMES),
+            B_GOTO(MB_STAND_IDLE),
+        B_END(),
+
+    B_STATE(MB_STAND_BOMB, BSF_CONTACT),
+        B_ON_ENTER(),
+            B_FIRE(0, -16, 0, 0, MB_BOMB_VY),
+            B_FIRE(0,  16, 0, 0, MB_BOMB_VY),
+        B_END(),
+        B_TICK(),
+        B_AFTER(MB_BOMB_FRAMES),
+            B_GOTO(MB_STAND_IDLE),
+        B_END(),
+
+    B_STATE(MB_HYPER_SETUP, 0),
+        B_TICK(),
+        B_IF_MOD(BF_AI_TIMER, 20, 0),
+            B_SHAKE(5, 2),
+        B_END(),
+        B_AFTER(MB_HYPER_SETUP_FRAMES),
+            B_SET(BF_PHASE, 2),
+            B_SET_HP(MB_HP_PHASE3),
+            B_SET(BF_VULNERABLE, 1),
+            B_GOTO(MB_HYPER_BEAM),
+        B_END(),
+
+    /* === Phase 3: Hyper Beam === */
+    B_STATE(MB_HYPER_BEAM, BSF_CONTACT),
+        B_ADD(BF_SUB_TIMER, 1),
+        B_IF_GE(BF_SUB_TIMER, MB_HYPER_INTERVAL),
+            B_SET(BF_SUB_TIMER, 0),
+            B_FIRE(FIRE_AIM_X, 0, 0, MB_BEAM_SPEED, 0),
+        B_END(),
+
+    B_STATE(MB_DEATH, 0),
+        B_IF_MOD(BF_AI_TIMER, 10, 0),
+            B_SHAKE(10, 4),
+        B_END(),
+        B_TICK(),
+        B_AFTER(MB_DEATH_FRAMES),
+            B_DEACTIVATE(),
+        B_END(),
+};
+
+/* ========================================================================
+ * Program Table
+ * ======================================================================== */
+
+static const BossProgramDef builtin_programs[BOSS_TYPE_COUNT] = {
+    [BOSS_SPORE_SPAWN] = { .ops = ss_ops, .hdr = {
+        HDR(BOSS_SPORE_SPAWN, ss_ops),
+        .hp = SS_HP, .damage_contact = SS_CONTACT_DAMAGE,
+        .half_w = 12, .half_h = 16,
+        .part_count = 2, .parts = {
+            B_ARMOR(0, -6, 12, 10),         /* Shell */
+            B_CORE(0, 8, 8, 8, 4),          /* Core, opens to shoot spores */
+        },
+        .start_state = SS_SWING,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { SS_DEATH },
+    }},
+    [BOSS_CROCOMIRE] = { .ops = croc_ops, .hdr = {
+        HDR(BOSS_CROCOMIRE, croc_ops),
+        .hp = CROC_HP_DUMMY, .damage_contact = CROC_CONTACT_DAMAGE,
+        .half_w = 16, .half_h = 20,
+        .part_count = 2, .parts = {
+            B_CORE(-10, -8, 8, 8, 4),       /* Mouth: pushes */
+            B_ARMOR(4, 4, 14, 16),          /* Body */
+        },
+        .start_state = CROC_ADVANCE,
+        .vulnerable = 1,            /* Always open to push hits */
+        .hit_mode = BOSS_HIT_PUSH, .push_px = CROC_PUSH_PER_HIT,
+        .flinch_state = CROC_FLINCH, .fall_state = CROC_FALLING,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { CROC_DEATH },
+    }},
+    [BOSS_BOMB_TORIZO] = { .ops = bt_ops, .hdr = {
+        HDR(BOSS_BOMB_TORIZO, bt_ops),
+        .hp = BT_HP, .damage_contact = BT_CONTACT_DAMAGE,
+        .half_w = 12, .half_h = 20,
+        .start_state = BT_STATUE,   /* Not vulnerable until awake */
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { BT_DEATH },
+    }},
+    [BOSS_KRAID] = { .ops = kraid_ops, .hdr = {
+        HDR(BOSS_KRAID, kraid_ops),
+        .hp = KRAID_HP, .damage_contact = KRAID_CONTACT_DAMAGE,
+        .half_w = 20, .half_h = 24,
+        .part_count = 3, .parts = {
+            B_CORE(0, -18, 8, 6, 4),        /* Mouth */
+            B_ARMOR(0, 4, 20, 20),          /* Belly */
+            B_ARMOR(-24, 4, 6, 8),          /* Claw */
+        },
+        .start_state = KRAID_RISE,
+        .flinch_state = KRAID_FLINCH, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { KRAID_DEATH },
+    }},
+    [BOSS_BOTWOON] = { .ops = bot_ops, .hdr = {
+        HDR(BOSS_BOTWOON, bot_ops),
+        .hp = BOT_HP, .damage_contact = BOT_CONTACT_DAMAGE,
+        .half_w = 10, .half_h = 10,
+        .start_state = BOT_HIDDEN,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { BOT_DEATH },
+        /* Holes, relative to room center */
+        .points = { { -60, -30 }, { 60, -30 }, { -60, 30 }, { 60, 30 } },
+    }},
+    [BOSS_PHANTOON] = { .ops = ph_ops, .hdr = {
+        HDR(BOSS_PHANTOON, ph_ops),
+        .hp = PH_HP, .damage_contact = PH_CONTACT_DAMAGE,
+        .half_w = 16, .half_h = 16,
+        .start_state = PH_INVISIBLE,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_mode = BOSS_SUPER_RAGE, .super_damage = PH_SUPER_DAMAGE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { PH_DEATH },
+    }},
+    [BOSS_DRAYGON] = { .ops = dy_ops, .hdr = {
+        HDR(BOSS_DRAYGON, dy_ops),
+        .hp = DY_HP, .damage_contact = DY_CONTACT_DAMAGE,
+        .half_w = 18, .half_h = 14,
+        .part_count = 2, .parts = {
+            B_CORE(0, 0, 16, 12, 4),        /* Body */
+            B_ARMOR(22, 6, 8, 4),           /* Tail */
+        },
+        .start_state = DY_SWIM, .vulnerable = 1,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { DY_DEATH },
+    }},
+    [BOSS_GOLDEN_TORIZO] = { .ops = gt_ops, .hdr = {
+        HDR(BOSS_GOLDEN_TORIZO, gt_ops),
+        .hp = GT_HP, .damage_contact = GT_CONTACT_DAMAGE,
+        .half_w = 14, .half_h = 22,
+        .start_state = GT_IDLE, .vulnerable = 1,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_mode = BOSS_SUPER_CATCH, .super_damage = GT_SUPER_DAMAGE,
+        .super_state = GT_CATCH,
+        .phase_count = 1, .death_state = { GT_DEATH },
+    }},
+    [BOSS_RIDLEY] = { .ops = ri_ops, .hdr = {
+        HDR(BOSS_RIDLEY, ri_ops),
+        .hp = RI_HP, .damage_contact = RI_CONTACT_DAMAGE,
+        .half_w = 16, .half_h = 18,
+        .part_count = 2, .parts = {
+            B_CORE(0, -4, 14, 14, 4),       /* Body */
+            B_ARMOR(-20, 12, 10, 4),        /* Tail */
+        },
+        .start_state = RI_FLY, .vulnerable = 1,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 1, .death_state = { RI_DEATH },
+    }},
+    [BOSS_MOTHER_BRAIN] = { .ops = mb_ops, .hdr = {
+        HDR(BOSS_MOTHER_BRAIN, mb_ops),
+        .hp = MB_HP_PHASE1, .damage_contact = MB_CONTACT_DAMAGE,
+        .half_w = 16, .half_h = 16,
+        .part_count = 2, .parts = {
+            B_CORE(0, 0, 16, 16, 4),        /* Brain */
+            { .dx = 0, .dy = 40, .half_w = 20, .half_h = 24,
+              .phases = 0x06 },             /* Body, phases 2-3 */
+        },
+        .start_state = MB_TANK_IDLE, .vulnerable = 1,
+        .flinch_state = BOSS_NO_STATE, .fall_state = BOSS_NO_STATE,
+        .super_state = BOSS_NO_STATE,
+        .phase_count = 3,
+        .death_state = { MB_TANK_BREAK, MB_HYPER_SETUP, MB_DEATH },
+    }},
+};
+
+const BossProgramDef* boss_builtin_program(BossTypeID type) {
+    if (type <= BOSS_NONE || type >= BOSS_TYPE_COUNT) return NULL;
+    return &builtin_programs[type];
+}
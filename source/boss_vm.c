@@ -0,0 +1,617 @@
+/**
+ * boss_vm.c - Boss program loader and interpreter
+ *
+ * boss_program_load() checks a program once (opcodes, operands, state
+ * references, IF/END nesting per script) and indexes its BOP_STATE
+ * markers, so the per-frame interpreter does no validation. A header
+ * without parts gets one vulnerable part covering its hitbox. The
+ * interpreter is a single switch over a flat op array and runs from
+ * ITCM; bosses differ only in the data they hand it.
+ */
+
+#include "boss_vm.h"
+#include "camera.h"
+#include "player.h"
+#include "projectile.h"
+#include "fixed_math.h"
+#include <string.h>
+
+/* On-disk layout (boss program files, snapshot sections) */
+_Static_assert(sizeof(BossOp) == 16, "BossOp layout");
+_Static_assert(sizeof(BossPart) == 8, "BossPart layout");
+_Static_assert(sizeof(BossProgramHeader) == 52 + 8 * BOSS_MAX_PARTS,
+               "BossProgramHeader layout");
+_Static_assert(BOSS_PROGRAM_MAX_STATES <= BOSS_NO_STATE, "state index range");
+_Static_assert((BOSS_MAX_POINTS & (BOSS_MAX_POINTS - 1)) == 0,
+               "BOSS_MAX_POINTS must be a power of two");
+
+#define BOSS_HIT_INVULN   10   /* I-frames after a hit (all bosses) */
+
+#define NO_ENTRY          0xFFFF
+
+/* ========================================================================
+ * Field Access
+ * ======================================================================== */
+
+static int32_t field_get(const Boss* b, int f) {
+    switch (f) {
+        case BF_AI_TIMER:     return b->ai_timer;
+        case BF_AI_COUNTER:   return b->ai_counter;
+        case BF_SUB_TIMER:    return b->sub_timer;
+        case BF_ATTACK_COUNT: return b->attack_count;
+        case BF_PHASE:        return b->phase;
+        case BF_VULNERABLE:   return b->vulnerable;
+        case BF_POS_X:        return b->body.pos.x;
+        case BF_POS_Y:        return b->body.pos.y;
+        case BF_ANCHOR_X:     return b->anchor_x;
+        case BF_ANCHOR_Y:     return b->anchor_y;
+        case BF_PARAM_A:      return b->param_a;
+        case BF_PARAM_B:      return b->param_b;
+        case BF_SAMUS_X:      return g_player.body.pos.x;
+        case BF_SAMUS_Y:      return g_player.body.pos.y;
+        default:              return 0;
+    }
+}
+
+static void field_set(Boss* b, int f, int32_t v) {
+    switch (f) {
+        case BF_AI_TIMER:     b->ai_timer = (uint16_t)v; break;
+        case BF_AI_COUNTER:   b->ai_counter = (uint16_t)v; break;
+        case BF_SUB_TIMER:    b->sub_timer = (uint16_t)v; break;
+        case BF_ATTACK_COUNT: b->attack_count = (uint16_t)v; break;
+        case BF_PHASE:        b->phase = (uint16_t)v; break;
+        case BF_VULNERABLE:   b->vulnerable = v != 0; break;
+        case BF_POS_X:        b->body.pos.x = v; break;
+        case BF_POS_Y:        b->body.pos.y = v; break;
+        case BF_ANCHOR_X:     b->anchor_x = v; break;
+        case BF_ANCHOR_Y:     b->anchor_y = v; break;
+        case BF_PARAM_A:      b->param_a = v; break;
+        case BF_PARAM_B:      b->param_b = v; break;
+        default:              break;    /* Read-only */
+    }
+}
+
+/* fx32 fields hold angles in whole LUT units */
+static bool field_is_fx(int f) {
+    return f >= BF_POS_X;
+}
+
+static fx32* axis_pos(Boss* b, int axis) {
+    return axis == BAXIS_X ? &b->body.pos.x : &b->body.pos.y;
+}
+
+static fx32 axis_anchor(const Boss* b, int axis) {
+    return axis == BAXIS_X ? b->anchor_x : b->anchor_y;
+}
+
+static fx32 axis_samus(int axis) {
+    return axis == BAXIS_X ? g_player.body.pos.x : g_player.body.pos.y;
+}
+
+static bool aabb_overlap(Vec2fx pos_a, AABBfx box_a,
+                         Vec2fx pos_b, AABBfx box_b) {
+    fx32 dx = pos_a.x - pos_b.x;
+    fx32 dy = pos_a.y - pos_b.y;
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    return dx < (box_a.half_w + box_b.half_w) &&
+           dy < (box_a.half_h + box_b.half_h);
+}
+
+/* ========================================================================
+ * Loader
+ * ======================================================================== */
+
+static bool field_ok(int f)     { return f < BF_COUNT; }
+static bool dest_ok(int f)      { return f < BF_SAMUS_X; }
+static bool axis_ok(int axis)   { return axis < BAXIS_COUNT; }
+
+static bool cond_ok(const BossOp* op) {
+    switch (op->a) {
+        case BC_GE: case BC_LT: case BC_EQ: case BC_NE: case BC_AGGRO:
+            return field_ok(op->b);
+        case BC_MOD:
+            return field_ok(op->b) && op->v > 0;
+        case BC_GE_FIELD:
+            return field_ok(op->b) && field_ok(op->c);
+        case BC_NEAR:
+            return op->n > 0;
+        case BC_ARRIVED:
+            return true;
+        case BC_HP_BELOW:
+            return op->v > 0;
+        default:
+            return false;
+    }
+}
+
+/* Operand ranges that don't depend on the state count */
+static bool operands_ok(const BossOp* op) {
+    switch (op->op) {
+        case BOP_STATE:
+            return op->a < BOSS_PROGRAM_MAX_STATES;
+        case BOP_GOTO: case BOP_DEACTIVATE: case BOP_END:
+        case BOP_SHAKE: case BOP_HURT:
+            return true;
+        case BOP_GOTO_CYCLE:
+            return field_ok(op->b) && op->n > 0;
+        case BOP_IF:
+            return cond_ok(op);
+        case BOP_SET: case BOP_ADD: case BOP_WARP_POINT:
+            return dest_ok(op->a);
+        case BOP_COPY:
+            return dest_ok(op->a) && field_ok(op->b);
+        case BOP_SET_MOD:
+            return dest_ok(op->a) && field_ok(op->b) && op->n > 0;
+        case BOP_SET_HP:
+            return op->v > 0;
+        case BOP_MOVE:
+            return axis_ok(op->a);
+        case BOP_TOWARD:
+            return axis_ok(op->a) && op->b <= BTW_DEADZONE;
+        case BOP_MOVE_TO: case BOP_RETURN_TO:
+            return axis_ok(op->a) && field_ok(op->b);
+        case BOP_PATROL: case BOP_OSC:
+            return axis_ok(op->a) && dest_ok(op->b);
+        case BOP_SWEEP:
+            return axis_ok(op->a) && op->n > 0;
+        case BOP_FIRE:
+            return op->b > PROJ_NONE && op->b < PROJ_TYPE_COUNT;
+        default:
+            return false;
+    }
+}
+
+static bool state_ok(const BossProgram* p, int s) {
+    return s < p->state_count;
+}
+
+static bool state_or_none_ok(const BossProgram* p, int s) {
+    return s == BOSS_NO_STATE || state_ok(p, s);
+}
+
+static bool parts_ok(const BossProgramHeader* h) {
+    if (h->part_count > BOSS_MAX_PARTS) return false;
+    for (int i = 0; i < h->part_count; i++) {
+        const BossPart* pt = &h->parts[i];
+        if (pt->half_w == 0 || pt->half_h == 0) return false;
+        if (pt->flags & ~BPF_VULNERABLE) return false;
+        if ((pt->flags & BPF_VULNERABLE) && pt->damage_mul == 0) return false;
+        if (pt->phases >> h->phase_count) return false;
+    }
+    return true;
+}
+
+bool boss_program_load(BossProgram* p, const BossProgramHeader* hdr,
+                       const BossOp* ops) {
+    if (hdr->magic != BOSS_PROGRAM_MAGIC ||
+        hdr->version != BOSS_PROGRAM_VERSION) return false;
+    if (hdr->op_count == 0 || hdr->op_count > BOSS_PROGRAM_MAX_OPS) return false;
+    if (hdr->type == BOSS_NONE || hdr->type >= BOSS_TYPE_COUNT) return false;
+    if (hdr->hp <= 0) return false;
+    if (hdr->phase_count == 0 || hdr->phase_count > BOSS_MAX_PHASES) return false;
+    if (hdr->hit_mode > BOSS_HIT_PUSH || hdr->super_mode > BOSS_SUPER_CATCH) {
+        return false;
+    }
+
+    if (!parts_ok(hdr)) return false;
+    if (hdr->part_count == 0 &&
+        (hdr->half_w <= 0 || hdr->half_w > 255 ||
+         hdr->half_h <= 0 || hdr->half_h > 255)) return false;
+
+    int count = hdr->op_count;
+    memmove(&p->hdr, hdr, sizeof(BossProgramHeader));
+    memmove(p->ops, ops, (size_t)count * sizeof(BossOp));
+
+    BossProgramHeader* h = &p->hdr;
+    if (h->part_count == 0) {
+        h->parts[0] = (BossPart)B_CORE(0, 0, (uint8_t)h->half_w,
+                                       (uint8_t)h->half_h, 4);
+        h->part_count = 1;
+    }
+    memset(&h->parts[h->part_count], 0,
+           (BOSS_MAX_PARTS - h->part_count) * sizeof(BossPart));
+
+    /* Index states; IF/END must balance within each script */
+    p->state_count = 0;
+    p->init_end = (uint16_t)count;
+    for (int s = 0; s < BOSS_PROGRAM_MAX_STATES; s++) {
+        p->state_entry[s] = NO_ENTRY;
+        p->state_flags[s] = 0;
+    }
+
+    int depth = 0;
+    for (int i = 0; i < count; i++) {
+        const BossOp* op = &p->ops[i];
+        if (!operands_ok(op)) goto bad;
+
+        if (op->op == BOP_STATE) {
+            if (depth != 0 || p->state_entry[op->a] != NO_ENTRY) goto bad;
+            p->state_entry[op->a] = (uint16_t)(i + 1);
+            p->state_flags[op->a] = op->b;
+            if (op->a >= p->state_count) p->state_count = op->a + 1;
+            if (p->init_end == count) p->init_end = (uint16_t)i;
+        } else if (op->op == BOP_IF) {
+            depth++;
+        } else if (op->op == BOP_END) {
+            if (depth == 0) goto bad;
+            depth--;
+        }
+    }
+    if (depth != 0 || p->state_count == 0) goto bad;
+
+    for (int s = 0; s < p->state_count; s++) {
+        if (p->state_entry[s] == NO_ENTRY) goto bad;
+    }
+
+    /* State references */
+    for (int i = 0; i < count; i++) {
+        const BossOp* op = &p->ops[i];
+        if (op->op == BOP_GOTO && !state_ok(p, op->a)) goto bad;
+        if (op->op == BOP_GOTO_CYCLE &&
+            op->a + op->n > p->state_count) goto bad;
+    }
+    if (!state_ok(p, p->hdr.start_state) ||
+        !state_or_none_ok(p, p->hdr.flinch_state) ||
+        !state_or_none_ok(p, p->hdr.fall_state) ||
+        !state_or_none_ok(p, p->hdr.super_state)) goto bad;
+    for (int ph = 0; ph < p->hdr.phase_count; ph++) {
+        if (!state_or_none_ok(p, p->hdr.death_state[ph])) goto bad;
+    }
+    return true;
+
+bad:
+    p->state_count = 0;
+    return false;
+}
+
+/* ========================================================================
+ * Interpreter
+ * ======================================================================== */
+
+/* Ridley-style aggression: wait less as HP drops */
+static int32_t aggro_interval(const Boss* b, int32_t base) {
+    int32_t ratio = b->hp * 100 / b->hp_max;
+    if (ratio > 75) return base;
+    if (ratio > 50) return (base * 3) / 4;
+    if (ratio > 25) return (base * 3) / 5;
+    return base / 3;
+}
+
+static bool eval_cond(const Boss* b, const BossOp* op,
+                      fx32 near_dx, fx32 near_dy, bool arrived) {
+    switch (op->a) {
+        case BC_GE:       return field_get(b, op->b) >= op->v;
+        case BC_LT:       return field_get(b, op->b) < op->v;
+        case BC_EQ:       return field_get(b, op->b) == op->v;
+        case BC_NE:       return field_get(b, op->b) != op->v;
+        case BC_MOD:      return field_get(b, op->b) % op->v == op->m;
+        case BC_GE_FIELD: return field_get(b, op->b) >= field_get(b, op->c);
+        case BC_NEAR:     return near_dx < INT_TO_FX(op->n) &&
+                                 near_dy < INT_TO_FX(op->n);
+        case BC_ARRIVED:  return arrived;
+        case BC_HP_BELOW: return b->hp < b->hp_max / op->v;
+        case BC_AGGRO:    return field_get(b, op->b) >= aggro_interval(b, op->v);
+        default:          return false;
+    }
+}
+
+/* pc is just past a false IF: return the op after its END */
+static int skip_block(const BossOp* ops, int pc) {
+    int depth = 0;
+    for (;; pc++) {
+        if (ops[pc].op == BOP_IF) {
+            depth++;
+        } else if (ops[pc].op == BOP_END) {
+            if (depth == 0) return pc + 1;
+            depth--;
+        }
+    }
+}
+
+/* Run ops from pc up to the next state marker, a GOTO or DEACTIVATE */
+SM_ITCM static void run_script(Boss* b, const BossProgram* p, int pc) {
+    const BossOp* ops = p->ops;
+    int end = p->hdr.op_count;
+
+    /* Proximity checks see where Samus was before this frame's moves */
+    fx32 near_dx = fx_abs(g_player.body.pos.x - b->body.pos.x);
+    fx32 near_dy = fx_abs(g_player.body.pos.y - b->body.pos.y);
+    bool arrived = false;
+
+    while (pc < end) {
+        const BossOp* op = &ops[pc++];
+        switch (op->op) {
+            case BOP_STATE:
+                return;
+
+            case BOP_GOTO:
+                b->ai_state = op->a;
+                b->ai_timer = 0;
+                return;
+
+            case BOP_GOTO_CYCLE: {
+                int32_t k = field_get(b, op->b);
+                b->ai_state = op->a + k % op->n;
+                b->ai_timer = 0;
+                field_set(b, op->b, k + 1);
+                return;
+            }
+
+            case BOP_DEACTIVATE:
+                b->active = false;
+                return;
+
+            case BOP_IF:
+                if (!eval_cond(b, op, near_dx, near_dy, arrived)) {
+                    pc = skip_block(ops, pc);
+                }
+                break;
+
+            case BOP_END:
+                break;
+
+            case BOP_SET:
+                field_set(b, op->a, op->v);
+                break;
+
+            case BOP_ADD:
+                field_set(b, op->a, field_get(b, op->a) + op->v);
+                break;
+
+            case BOP_COPY:
+                field_set(b, op->a, field_get(b, op->b));
+                break;
+
+            case BOP_SET_MOD:
+                field_set(b, op->a, op->v + field_get(b, op->b) % op->n);
+                break;
+
+            case BOP_SET_HP:
+                b->hp = op->v;
+                b->hp_max = op->v;
+                break;
+
+            case BOP_MOVE:
+                *axis_pos(b, op->a) += op->v;
+                break;
+
+            case BOP_TOWARD: {
+                fx32* pos = axis_pos(b, op->a);
+                fx32 d = axis_samus(op->a) - *pos;
+                if (op->b == BTW_DEADZONE) {
+                    if (d > 0) *pos += op->v;
+                    else if (d < 0) *pos -= op->v;
+                } else {
+                    *pos += (d < 0) ? -op->v : op->v;
+                }
+                break;
+            }
+
+            case BOP_MOVE_TO: {
+                fx32* pos = axis_pos(b, op->a);
+                fx32 target = field_get(b, op->b) + INT_TO_FX(op->n);
+                *pos += op->v;
+                if (op->v > 0 ? *pos >= target : *pos <= target) {
+                    *pos = target;
+                    arrived = true;
+                }
+                break;
+            }
+
+            case BOP_RETURN_TO: {
+                fx32* pos = axis_pos(b, op->a);
+                fx32 target = field_get(b, op->b);
+                fx32 d = target - *pos;
+                fx32 tol = INT_TO_FX(op->n);
+                if (d > tol) {
+                    *pos += op->v;
+                } else if (d < -tol) {
+                    *pos -= op->v;
+                } else {
+                    *pos = target;
+                    arrived = true;
+                }
+                break;
+            }
+
+            case BOP_PATROL: {
+                fx32* pos = axis_pos(b, op->a);
+                fx32 anchor = axis_anchor(b, op->a);
+                fx32 range = INT_TO_FX(op->n);
+                if (field_get(b, op->b) > 0) {
+                    *pos += op->v;
+                    if (*pos > anchor + range) field_set(b, op->b, -FX_ONE);
+                } else {
+                    *pos -= op->v;
+                    if (*pos < anchor - range) field_set(b, op->b, FX_ONE);
+                }
+                break;
+            }
+
+            case BOP_OSC: {
+                bool fx = field_is_fx(op->b);
+                int32_t angle = field_get(b, op->b) +
+                                (fx ? INT_TO_FX(op->n) : op->n);
+                field_set(b, op->b, angle);
+                if (fx) angle = FX_TO_INT(angle);
+                *axis_pos(b, op->a) = axis_anchor(b, op->a) +
+                                      fx_mul(fx_sin((uint8_t)angle), op->v);
+                break;
+            }
+
+            case BOP_SWEEP: {
+                /* Left edge to right edge over the first half, then back */
+                fx32 progress = fx_div(INT_TO_FX(b->ai_timer),
+                                       INT_TO_FX(op->n));
+                fx32 t = (b->ai_timer < op->n / 2)
+                       ? progress << 1
+                       : FX_ONE - ((progress - FX_HALF) << 1);
+                *axis_pos(b, op->a) = axis_anchor(b, op->a) - (op->v >> 1) +
+                                      fx_mul(op->v, t);
+                break;
+            }
+
+            case BOP_WARP_POINT: {
+                int i = field_get(b, op->a) & (BOSS_MAX_POINTS - 1);
+                b->param_b = INT_TO_FX(i);
+                b->body.pos.x = b->anchor_x + INT_TO_FX(p->hdr.points[i][0]);
+                b->body.pos.y = b->anchor_y + INT_TO_FX(p->hdr.points[i][1]);
+                break;
+            }
+
+            case BOP_FIRE: {
+                fx32 vx = op->v;
+                fx32 vy = op->w;
+                if ((op->a & FIRE_AIM_X) &&
+                    g_player.body.pos.x - b->body.pos.x <= 0) vx = -vx;
+                if ((op->a & FIRE_AIM_Y) &&
+                    g_player.body.pos.y - b->body.pos.y <= 0) vy = -vy;
+                projectile_spawn((ProjectileTypeID)op->b, PROJ_OWNER_ENEMY,
+                                b->body.pos.x + INT_TO_FX(op->n),
+                                b->body.pos.y + INT_TO_FX(op->m), vx, vy);
+                break;
+            }
+
+            case BOP_SHAKE:
+                camera_shake(op->n, op->m);
+                break;
+
+            case BOP_HURT:
+                player_damage(op->n);
+                break;
+        }
+    }
+}
+
+void boss_vm_spawn(Boss* b, const BossProgram* p) {
+    const BossProgramHeader* h = &p->hdr;
+    b->hp = h->hp;
+    b->hp_max = h->hp;
+    b->damage_contact = h->damage_contact;
+    b->body.hitbox.half_w = INT_TO_FX(h->half_w);
+    b->body.hitbox.half_h = INT_TO_FX(h->half_h);
+    b->vulnerable = h->vulnerable != 0;
+    b->ai_state = h->start_state;
+    run_script(b, p, 0);
+}
+
+SM_ITCM void boss_vm_step(Boss* b, const BossProgram* p) {
+    if (b->invuln_timer > 0) b->invuln_timer--;
+
+    if (b->ai_state >= p->state_count) return;
+    run_script(b, p, p->state_entry[b->ai_state]);
+
+    /* Contact damage from any part, per the state the frame ended in */
+    if (b->active && b->ai_state < p->state_count &&
+        (p->state_flags[b->ai_state] & BSF_CONTACT)) {
+        for (int i = 0; i < p->hdr.part_count; i++) {
+            Vec2fx pos;
+            AABBfx box;
+            if (!boss_vm_part_box(b, p, i, &pos, &box)) continue;
+            if (aabb_overlap(pos, box, g_player.body.pos, g_player.body.hitbox)) {
+                player_damage(b->damage_contact);
+                break;
+            }
+        }
+    }
+}
+
+/* ========================================================================
+ * Parts
+ * ======================================================================== */
+
+static bool part_present(const BossPart* pt, int phase) {
+    return pt->phases == 0 || (phase < 8 && (pt->phases & (1u << phase)));
+}
+
+bool boss_vm_part_box(const Boss* b, const BossProgram* p, int part,
+                      Vec2fx* pos, AABBfx* box) {
+    if (part < 0 || part >= p->hdr.part_count) return false;
+    const BossPart* pt = &p->hdr.parts[part];
+    if (!part_present(pt, b->phase)) return false;
+
+    pos->x = b->body.pos.x + INT_TO_FX(pt->dx);
+    pos->y = b->body.pos.y + INT_TO_FX(pt->dy);
+    box->half_w = INT_TO_FX(pt->half_w);
+    box->half_h = INT_TO_FX(pt->half_h);
+    return true;
+}
+
+int32_t boss_vm_part_damage(const Boss* b, const BossProgram* p, int part,
+                            int32_t damage) {
+    if (!b->active || !b->vulnerable || b->invuln_timer > 0) return 0;
+    if (part < 0 || part >= p->hdr.part_count) return 0;
+    const BossPart* pt = &p->hdr.parts[part];
+    if (!(pt->flags & BPF_VULNERABLE)) return 0;
+    if (!part_present(pt, b->phase)) return 0;
+
+    int32_t scaled = (damage * pt->damage_mul) >> 2;
+    return scaled > 0 ? scaled : 1;
+}
+
+/* ========================================================================
+ * Hits
+ * ======================================================================== */
+
+static void enter_state(Boss* b, uint8_t s) {
+    if (s == BOSS_NO_STATE) return;
+    b->ai_state = s;
+    b->ai_timer = 0;
+}
+
+void boss_vm_hit(Boss* b, const BossProgram* p, int32_t damage) {
+    const BossProgramHeader* h = &p->hdr;
+
+    b->invuln_timer = BOSS_HIT_INVULN;
+    camera_shake(5, 2);
+
+    /* Push bosses (Crocomire) are beaten by position, not HP */
+    if (h->hit_mode == BOSS_HIT_PUSH) {
+        b->body.pos.x += INT_TO_FX(h->push_px);
+        enter_state(b, h->flinch_state);
+        if (b->body.pos.x >= b->anchor_x) {
+            b->body.pos.x = b->anchor_x;
+            b->vulnerable = false;
+            enter_state(b, h->fall_state);
+            camera_shake(30, 4);
+        }
+        return;
+    }
+
+    b->hp -= damage;
+
+    if (b->hp > 0 && h->super_mode != BOSS_SUPER_NONE &&
+        damage >= h->super_damage) {
+        if (h->super_mode == BOSS_SUPER_RAGE) {
+            if (b->param_b == 0) b->param_b = FX_ONE;
+        } else if (b->ai_state < p->state_count &&
+                   !(p->state_flags[b->ai_state] & BSF_NO_CATCH)) {
+            b->hp += damage;
+            enter_state(b, h->super_state);
+            b->param_b = FX_ONE;
+            return;
+        }
+    }
+
+    /* Flinch closes the vulnerability window */
+    if (b->hp > 0 && h->flinch_state != BOSS_NO_STATE) {
+        enter_state(b, h->flinch_state);
+        b->vulnerable = false;
+    }
+
+    if (b->hp <= 0) {
+        b->hp = 0;
+        b->vulnerable = false;
+        b->ai_timer = 0;
+        camera_shake(30, 4);
+
+        /* Multi-phase bosses move on to the next phase's transition */
+        int phase = b->phase < h->phase_count ? b->phase : h->phase_count - 1;
+        if (h->death_state[phase] == BOSS_NO_STATE) {
+            b->active = false;
+        } else {
+            b->ai_state = h->death_state[phase];
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * broadphase.c - Uniform grid broadphase
+ *
+ * Entities are rebuilt into the grid every frame (no incremental moves):
+ * with at most BP_MAX_ENTITIES entries a full rebuild is cheaper than
+ * tracking cell changes. Each cell is a singly-linked list of nodes in
+ * a static pool (links are node index + 1, 0 = end, so a zeroed grid
+ * is empty); an entity overlapping several cells gets one node per
+ * cell and is deduplicated at query time with a per-query stamp.
+ */
+
+#include "broadphase.h"
+#include "enemy.h"
+#include "boss.h"
+#include <string.h>
+
+/* ========================================================================
+ * Grid Storage
+ * ======================================================================== */
+
+typedef struct {
+    BroadphaseRef ref;
+    Vec2fx        pos;
+    AABBfx        box;
+    uint16_t      stamp;        /* Last query that reported this entity */
+} BpEntity;
+
+typedef struct {
+    uint8_t entity;
+    uint8_t next;               /* Next node in cell (index + 1), 0 = end */
+} BpNode;
+
+SM_DTCM_BSS static BpEntity entities[BP_MAX_ENTITIES];
+static int      entity_count;
+
+SM_DTCM_BSS static BpNode   nodes[BP_MAX_NODES];
+static int      node_count;
+
+SM_DTCM_BSS static uint8_t  cell_head[BP_GRID_ROWS * BP_GRID_COLS];  /* node index + 1 */
+
+static uint16_t query_stamp;
+
+/* ========================================================================
+ * Helpers
+ * ======================================================================== */
+
+static inline int clamp_cell(int c, int max) {
+    if (c < 0) return 0;
+    if (c >= max) return max - 1;
+    return c;
+}
+
+/* Inclusive cell range covered by a box */
+static void cell_range(Vec2fx pos, AABBfx box,
+                       int* cx0, int* cy0, int* cx1, int* cy1) {
+    *cx0 = clamp_cell(FX_TO_INT(pos.x - box.half_w) >> BP_CELL_SHIFT, BP_GRID_COLS);
+    *cx1 = clamp_cell(FX_TO_INT(pos.x + box.half_w) >> BP_CELL_SHIFT, BP_GRID_COLS);
+    *cy0 = clamp_cell(FX_TO_INT(pos.y - box.half_h) >> BP_CELL_SHIFT, BP_GRID_ROWS);
+    *cy1 = clamp_cell(FX_TO_INT(pos.y + box.half_h) >> BP_CELL_SHIFT, BP_GRID_ROWS);
+}
+
+static inline bool box_overlap(Vec2fx pos_a, AABBfx box_a, Vec2fx pos_b, AABBfx box_b) {
+    fx32 dx = pos_a.x - pos_b.x;
+    fx32 dy = pos_a.y - pos_b.y;
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    return dx < (box_a.half_w + box_b.half_w) &&
+           dy < (box_a.half_h + box_b.half_h);
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+void broadphase_clear(void) {
+    entity_count = 0;
+    node_count = 0;
+    memset(cell_head, 0, sizeof(cell_head));
+}
+
+void broadphase_insert(BroadphaseKind kind, int index, Vec2fx pos, AABBfx box) {
+    if (entity_count >= BP_MAX_ENTITIES) return;
+
+    int id = entity_count++;
+    BpEntity* ent = &entities[id];
+    ent->ref.kind = (uint8_t)kind;
+    ent->ref.index = (uint8_t)index;
+    ent->pos = pos;
+    ent->box = box;
+    ent->stamp = query_stamp;
+
+    int cx0, cy0, cx1, cy1;
+    cell_range(pos, box, &cx0, &cy0, &cx1, &cy1);
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            if (node_count >= BP_MAX_NODES) return;
+            int cell = cy * BP_GRID_COLS + cx;
+            BpNode* n = &nodes[node_count++];
+            n->entity = (uint8_t)id;
+            n->next = cell_head[cell];
+            cell_head[cell] = (uint8_t)node_count;
+        }
+    }
+}
+
+void broadphase_build(void) {
+    broadphase_clear();
+
+    int count = enemy_get_count();
+    for (int i = 0; i < count; i++) {
+        Enemy* e = enemy_get(i);
+        if (!e || !e->active) continue;
+        PhysicsBody* b = enemy_get_body(i);
+        broadphase_insert(BP_KIND_ENEMY, i, b->pos, b->hitbox);
+    }
+
+    int parts = boss_part_count();
+    for (int i = 0; i < parts; i++) {
+        Vec2fx pos;
+        AABBfx box;
+        if (boss_part_box(i, &pos, &box)) {
+            broadphase_insert(BP_KIND_BOSS, i, pos, box);
+        }
+    }
+}
+
+SM_ITCM int broadphase_query(Vec2fx pos, AABBfx box, uint8_t kind_mask,
+                             BroadphaseRef* out, int max_out) {
+    /* New stamp; on wrap, reset all entity stamps so none look visited */
+    if (++query_stamp == 0) {
+        for (int i = 0; i < entity_count; i++) entities[i].stamp = 0;
+        query_stamp = 1;
+    }
+
+    int cx0, cy0, cx1, cy1;
+    cell_range(pos, box, &cx0, &cy0, &cx1, &cy1);
+
+    int found = 0;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            for (int n = cell_head[cy * BP_GRID_COLS + cx]; n != 0; n = nodes[n - 1].next) {
+                BpEntity* ent = &entities[nodes[n - 1].entity];
+                if (ent->stamp == query_stamp) continue;
+                ent->stamp = query_stamp;
+
+                if (!(kind_mask & (1 << ent->ref.kind))) continue;
+                if (!box_overlap(pos, box, ent->pos, ent->box)) continue;
+
+                if (found >= max_out) return found;
+                out[found++] = ent->ref;
+            }
+        }
+    }
+    return found;
+}
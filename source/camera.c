@@ -20,7 +20,8 @@
 Camera g_camera;
 
 /* Simple PRNG for screen shake (quality doesn't matter) */
-static uint32_t shake_seed = 7919;
+#define SHAKE_SEED_INIT 7919
+static uint32_t shake_seed = SHAKE_SEED_INIT;
 
 static int shake_rand(void) {
     shake_seed ^= shake_seed << 13;
@@ -36,6 +37,7 @@ void camera_init(void) {
     g_camera.target_y = 0;
     g_camera.shake_frames = 0;
     g_camera.shake_mag = 0;
+    shake_seed = SHAKE_SEED_INIT;   /* Same shake sequence every session (replays) */
 }
 
 void camera_update(void) {
@@ -94,6 +96,10 @@ void camera_apply(void) {
         }
     }
 
+    /* Stream any level columns/rows the camera has just exposed. The BG
+     * map wraps every 512px, so the raw scroll can go straight to hardware. */
+    room_stream_update(sx, sy);
+
     /* Level BG scrolls 1:1 */
     graphics_set_bg_scroll(BG_LAYER_LEVEL, sx, sy);
 
@@ -103,3 +109,17 @@ void camera_apply(void) {
     /* Foreground at 1:1 */
     graphics_set_bg_scroll(BG_LAYER_FG, sx, sy);
 }
+
+/* ========================================================================
+ * Snapshot
+ * ======================================================================== */
+
+void camera_snapshot_save(SnapshotWriter* w) {
+    snapshot_write(w, &g_camera, sizeof(g_camera));
+    snapshot_write(w, &shake_seed, sizeof(shake_seed));
+}
+
+void camera_snapshot_load(SnapshotReader* r) {
+    snapshot_read(r, &g_camera, sizeof(g_camera));
+    snapshot_read(r, &shake_seed, sizeof(shake_seed));
+}
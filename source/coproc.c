@@ -0,0 +1,167 @@
+/**
+ * coproc.c - ARM7 job channel (ARM9 side)
+ *
+ * A fixed ring of COPROC_QUEUE_MAX descriptors in main RAM. Handles are
+ * submission sequence numbers: job N lives in slot N % COPROC_QUEUE_MAX.
+ * The ARM7 answers jobs in the order it got them, so its replies only
+ * need counting -- the PXI handler bumps 'answered' -- and "done" is
+ * N < completed. A slot is reused only by the job COPROC_QUEUE_MAX
+ * submissions later, which is how long a result stays readable.
+ *
+ * Cache upkeep: the descriptor and src are flushed before the message
+ * goes out; the descriptor and dst are invalidated when a reply is
+ * first seen (settle), before anyone on the ARM9 can read them. Jobs
+ * the ARM7 can't take -- no worker, buffers outside main RAM, a dst
+ * that doesn't own its cache lines -- run here at submit, once the
+ * ones ahead are done, and count as done straight away.
+ */
+
+#include "coproc.h"
+#include "sm_config.h"
+#include "log.h"
+#include <nds.h>
+
+_Static_assert((COPROC_QUEUE_MAX & (COPROC_QUEUE_MAX - 1)) == 0,
+               "COPROC_QUEUE_MAX must be a power of two");
+#ifdef ARM9     /* 64-bit host pointers make it two */
+_Static_assert(sizeof(CoprocDesc) == COPROC_CACHE_LINE,
+               "CoprocDesc must be one cache line");
+#endif
+
+static CoprocDesc ring[COPROC_QUEUE_MAX];
+static uint32_t   submitted;    /* Next handle */
+static uint32_t   completed;    /* Settled; all handles below are done */
+
+#ifdef ARM9
+static bool              worker_up;
+static volatile uint32_t answered;  /* ARM7 replies, counted by the PXI IRQ */
+static uint32_t          sent;      /* Jobs handed to the ARM7 */
+
+/* Main RAM below the DTCM / shared WRAM window at the top */
+#define WORKER_RAM_END  0x02FF0000u
+#endif
+
+/* ========================================================================
+ * Hand-off
+ * ======================================================================== */
+
+#ifdef ARM9
+static void on_reply(void* user, u32 msg) {
+    (void)user;
+    (void)msg;
+    answered++;
+}
+
+static bool worker_reaches(const void* p, uint32_t size) {
+    uint32_t a = (uint32_t)(uintptr_t)p;
+    return a >= COPROC_MAIN_RAM && a + size <= WORKER_RAM_END;
+}
+
+/* True if the ARM7 can run d: it must see both buffers, and dst must
+ * own its cache lines so the completion invalidate loses nothing */
+static bool worker_can_take(const CoprocDesc* d) {
+    if (!worker_up) return false;
+    if (d->src_size && !worker_reaches(d->src, d->src_size)) return false;
+    if (!d->dst_size) return true;
+    return worker_reaches(d->dst, d->dst_size) &&
+           ((uint32_t)(uintptr_t)d->dst % COPROC_CACHE_LINE) == 0 &&
+           (d->dst_size % COPROC_CACHE_LINE) == 0;
+}
+#endif
+
+/* Jobs in flight on the ARM7 (always the newest unsettled ones) */
+static uint32_t in_flight(void) {
+#ifdef ARM9
+    return sent - answered;
+#else
+    return 0;
+#endif
+}
+
+/* Make every answered job's output visible to the ARM9 */
+static void settle(void) {
+    uint32_t done = submitted - in_flight();
+    while (completed != done) {
+#ifdef ARM9
+        CoprocDesc* d = &ring[completed & (COPROC_QUEUE_MAX - 1)];
+        DC_InvalidateRange(d, sizeof(*d));
+        if (d->dst_size) DC_InvalidateRange(d->dst, d->dst_size);
+#endif
+        completed++;
+    }
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+void coproc_init(void) {
+#ifdef ARM9
+    pxiSetHandler(COPROC_PXI_CHANNEL, on_reply, NULL);
+    pxiWaitRemote(COPROC_PXI_CHANNEL);
+    worker_up = true;
+    LOG_INFO("coproc: ARM7 worker up\n");
+#endif
+}
+
+CoprocJob coproc_submit(CoprocJobKind kind, const void* src, uint32_t src_size,
+                        void* dst, uint32_t dst_size) {
+    if (submitted - completed == COPROC_QUEUE_MAX) {
+        LOG_DEBUG("coproc: queue full, waiting on job %u\n", (unsigned)completed);
+        coproc_wait(completed);
+    }
+
+    CoprocDesc* d = &ring[submitted & (COPROC_QUEUE_MAX - 1)];
+    *d = (CoprocDesc){ (uint32_t)kind, src, src_size, dst, dst_size, -1 };
+
+#ifdef ARM9
+    if (worker_can_take(d)) {
+        if (src_size) DC_FlushRange(src, src_size);
+        if (dst_size) DC_FlushRange(dst, dst_size);     /* No dirty evictions later */
+        DC_FlushRange(d, sizeof(*d));
+        sent++;
+        pxiSend(COPROC_PXI_CHANNEL, coproc_msg_from_desc(d));
+        return submitted++;
+    }
+    /* Jobs ahead of this one finish first, so "done" stays in order.
+     * Nothing to invalidate here: the result is the ARM9's own write. */
+    coproc_flush();
+#endif
+
+    d->result = coproc_job_run(d);
+    completed++;
+    return submitted++;
+}
+
+bool coproc_done(CoprocJob job) {
+    settle();
+    /* Ages are wrap-safe; the newest pending handles are the unfinished ones */
+    uint32_t age = submitted - job;
+    return age > submitted - completed && age <= COPROC_QUEUE_MAX;
+}
+
+int32_t coproc_result(CoprocJob job) {
+    if (!coproc_done(job)) return -1;
+    return ring[job & (COPROC_QUEUE_MAX - 1)].result;
+}
+
+int32_t coproc_wait(CoprocJob job) {
+    uint32_t age = submitted - job;
+    if (age == 0 || age > COPROC_QUEUE_MAX) {
+        LOG_WARN("coproc: wait on expired job %u\n", (unsigned)job);
+        return -1;
+    }
+    while (!coproc_done(job)) {
+        /* Replies arrive by IRQ */
+    }
+    return coproc_result(job);
+}
+
+int coproc_pending(void) {
+    settle();
+    return (int)(submitted - completed);
+}
+
+void coproc_flush(void) {
+    if (submitted != completed) coproc_wait(submitted - 1);
+}
@@ -0,0 +1,26 @@
+/**
+ * coproc_job.c - ARM7 job bodies
+ *
+ * Linked into both binaries: the ARM7 worker runs jobs from here, and
+ * the ARM9 falls back to the same code for jobs it cannot hand over.
+ * Keep it free of ARM9-only state -- it may only touch the job's own
+ * buffers.
+ */
+
+#include "coproc.h"
+#include "lz.h"
+#include "save.h"
+
+int32_t coproc_job_run(const CoprocDesc* d) {
+    switch (d->kind) {
+        case COPROC_JOB_LZ:
+            return lz_decompress(d->src, d->src_size, d->dst, d->dst_size);
+        case COPROC_JOB_CHECKSUM: {
+            uint8_t hi, lo;
+            save_checksum(d->src, d->src_size, &hi, &lo);
+            return (int32_t)((hi << 8) | lo);
+        }
+        default:
+            return -1;
+    }
+}
@@ -1,8 +1,19 @@
 /**
  * enemy.c - Enemy pool management and AI
  *
- * Fixed-size pool (MAX_ENEMIES=16) with swap-remove pattern.
- * Each enemy type has an AI update function dispatched via table.
+ * Fixed-size pool (MAX_ENEMIES=16) kept grouped by type: type_start[t]
+ * is the first slot of type t, type_start[t + 1] one past its last.
+ * Spawn/remove rotate one entry per later group to keep groups packed.
+ *
+ * PhysicsBody is split out of Enemy into bodies[], so movement passes
+ * stream through 16 contiguous bodies. Each AI function is dispatched
+ * once per frame with its whole group (first, count).
+ *
+ * Activation: enemies outside the camera rect + ENEMY_WAKE_MARGIN_PX are
+ * put to sleep before AI runs. AI loops skip sleeping entries; the type's
+ * EnemySleepMode decides whether a sleeper is frozen or only ticks its
+ * timer. The rect depends only on the camera, so replays wake enemies on
+ * the same frames.
  * Enemies use the physics engine for movement and tile collision.
  *
  * Implemented AI:
@@ -19,6 +30,8 @@
 #include "player.h"
 #include "room.h"
 #include "graphics.h"
+#include "audio.h"
+#include "profiler.h"
 #include "fixed_math.h"
 #include "sm_config.h"
 #include <string.h>
@@ -27,8 +40,21 @@
  * Enemy Pool
  * ======================================================================== */
 
-static Enemy pool[MAX_ENEMIES];
+SM_DTCM_BSS static Enemy       pool[MAX_ENEMIES];     /* Cold per-enemy state */
+SM_DTCM_BSS static PhysicsBody bodies[MAX_ENEMIES];   /* Hot: parallel to pool */
+static uint8_t type_start[ENEMY_TYPE_COUNT + 1];      /* [COUNT] == active_count */
 static int active_count;
+static int awake_count;
+
+static inline void move_slot(int dst, int src) {
+    pool[dst] = pool[src];
+    bodies[dst] = bodies[src];
+}
+
+static inline void clear_slot(int idx) {
+    memset(&pool[idx], 0, sizeof(Enemy));
+    memset(&bodies[idx], 0, sizeof(PhysicsBody));
+}
 
 /* ========================================================================
  * Placeholder Sprite Data
@@ -64,24 +90,30 @@ typedef struct {
     fx32     speed;
     fx32     half_w;
     fx32     half_h;
+    EnemySleepMode sleep;
 } EnemyTypeDef;
 
+/* Rinka homes from off-screen, so it never sleeps. Waver keeps its sine
+ * phase running so it doesn't visibly restart on wake. */
 static const EnemyTypeDef enemy_defs[ENEMY_TYPE_COUNT] = {
-    [ENEMY_NONE]       = {   0,  0, 0,                        0,            0 },
-    [ENEMY_ZOOMER]     = {  20,  8, 0x00008000, INT_TO_FX(6), INT_TO_FX(6) },
-    [ENEMY_GEEMER]     = {  60, 20, 0x0000C000, INT_TO_FX(6), INT_TO_FX(6) },
-    [ENEMY_WAVER]      = {  40, 16, 0x00010000, INT_TO_FX(6), INT_TO_FX(6) },
-    [ENEMY_RINKA]      = {   1, 16, 0x00018000, INT_TO_FX(4), INT_TO_FX(4) },
-    [ENEMY_SIDEHOPPER] = { 200, 40, 0x00018000, INT_TO_FX(8), INT_TO_FX(12) },
-    [ENEMY_KI_HUNTER]  = { 600, 48, 0x00010000, INT_TO_FX(8), INT_TO_FX(8) },
-    [ENEMY_ZEBESIAN]   = { 400, 32, 0x00010000, INT_TO_FX(6), INT_TO_FX(10) },
+    [ENEMY_NONE]       = {   0,  0, 0,          0,            0,             ENEMY_SLEEP_FREEZE },
+    [ENEMY_ZOOMER]     = {  20,  8, 0x00008000, INT_TO_FX(6), INT_TO_FX(6),  ENEMY_SLEEP_FREEZE },
+    [ENEMY_GEEMER]     = {  60, 20, 0x0000C000, INT_TO_FX(6), INT_TO_FX(6),  ENEMY_SLEEP_FREEZE },
+    [ENEMY_WAVER]      = {  40, 16, 0x00010000, INT_TO_FX(6), INT_TO_FX(6),  ENEMY_SLEEP_TIMER },
+    [ENEMY_RINKA]      = {   1, 16, 0x00018000, INT_TO_FX(4), INT_TO_FX(4),  ENEMY_SLEEP_NEVER },
+    [ENEMY_SIDEHOPPER] = { 200, 40, 0x00018000, INT_TO_FX(8), INT_TO_FX(12), ENEMY_SLEEP_FREEZE },
+    [ENEMY_KI_HUNTER]  = { 600, 48, 0x00010000, INT_TO_FX(8), INT_TO_FX(8),  ENEMY_SLEEP_FREEZE },
+    [ENEMY_ZEBESIAN]   = { 400, 32, 0x00010000, INT_TO_FX(6), INT_TO_FX(10), ENEMY_SLEEP_FREEZE },
 };
 
-/* Solid tile test (matches physics.c is_collision_solid logic) */
-static inline bool tile_is_solid(uint8_t coll) {
-    if (coll == COLL_SOLID) return true;
-    if ((coll & 0xF0) == COLL_SPECIAL_BASE) return true;
-    return false;
+/* Physics step for a contiguous run of bodies (one PHYSICS scope for
+ * the run, not one per body) */
+SM_ITCM static void physics_batch(int first, int count) {
+    profiler_begin(PROF_PHYSICS);
+    for (int i = first; i < first + count; i++) {
+        if (!pool[i].asleep) physics_update_body(&bodies[i]);
+    }
+    profiler_end(PROF_PHYSICS);
 }
 
 /* ========================================================================
@@ -91,37 +123,47 @@ static inline bool tile_is_solid(uint8_t coll) {
  * Uses full physics (gravity, tile collision).
  * ======================================================================== */
 
-static void ai_crawler(Enemy* e) {
-    const EnemyTypeDef* def = &enemy_defs[e->type];
+static void ai_crawler(int first, int count) {
+    int end = first + count;
 
     /* Move in facing direction */
-    e->body.vel.x = (e->facing == DIR_RIGHT) ? def->speed : -def->speed;
+    for (int i = first; i < end; i++) {
+        if (pool[i].asleep) continue;
+        fx32 speed = enemy_defs[pool[i].type].speed;
+        bodies[i].vel.x = (pool[i].facing == DIR_RIGHT) ? speed : -speed;
+    }
 
     /* Physics: gravity + collision */
-    physics_update_body(&e->body);
+    physics_batch(first, count);
 
-    /* Reverse on wall hit */
-    if (e->body.contact.on_wall_right) {
-        e->facing = DIR_LEFT;
-    } else if (e->body.contact.on_wall_left) {
-        e->facing = DIR_RIGHT;
-    }
-
-    /* Reverse at floor edges: check tile below leading foot */
-    if (e->body.contact.on_ground) {
-        int look_x;
-        if (e->facing == DIR_RIGHT) {
-            look_x = FX_TO_INT(e->body.pos.x + e->body.hitbox.half_w +
-                               INT_TO_FX(1)) >> TILE_SHIFT;
-        } else {
-            look_x = FX_TO_INT(e->body.pos.x - e->body.hitbox.half_w -
-                               INT_TO_FX(1)) >> TILE_SHIFT;
+    for (int i = first; i < end; i++) {
+        Enemy* e = &pool[i];
+        PhysicsBody* b = &bodies[i];
+        if (e->asleep) continue;
+
+        /* Reverse on wall hit */
+        if (b->contact.on_wall_right) {
+            e->facing = DIR_LEFT;
+        } else if (b->contact.on_wall_left) {
+            e->facing = DIR_RIGHT;
         }
-        int foot_y = FX_TO_INT(e->body.pos.y + e->body.hitbox.half_h)
-                     >> TILE_SHIFT;
 
-        if (!tile_is_solid(room_get_collision(look_x, foot_y))) {
-            e->facing = (e->facing == DIR_RIGHT) ? DIR_LEFT : DIR_RIGHT;
+        /* Reverse at floor edges: check tile below leading foot */
+        if (b->contact.on_ground) {
+            int look_x;
+            if (e->facing == DIR_RIGHT) {
+                look_x = FX_TO_INT(b->pos.x + b->hitbox.half_w +
+                                   INT_TO_FX(1)) >> TILE_SHIFT;
+            } else {
+                look_x = FX_TO_INT(b->pos.x - b->hitbox.half_w -
+                                   INT_TO_FX(1)) >> TILE_SHIFT;
+            }
+            int foot_y = FX_TO_INT(b->pos.y + b->hitbox.half_h)
+                         >> TILE_SHIFT;
+
+            if (!room_is_solid(look_x, foot_y)) {
+                e->facing = (e->facing == DIR_RIGHT) ? DIR_LEFT : DIR_RIGHT;
+            }
         }
     }
 }
@@ -133,25 +175,31 @@ static void ai_crawler(Enemy* e) {
  * Ignores gravity. Reverses at room horizontal edges.
  * ======================================================================== */
 
-static void ai_waver(Enemy* e) {
-    const EnemyTypeDef* def = &enemy_defs[e->type];
+static void ai_waver(int first, int count) {
+    int room_w = g_current_room.width_tiles * TILE_SIZE;
+
+    for (int i = first; i < first + count; i++) {
+        Enemy* e = &pool[i];
+        PhysicsBody* b = &bodies[i];
+        fx32 speed = enemy_defs[e->type].speed;
+        if (e->asleep) continue;
 
-    /* Horizontal movement */
-    e->body.vel.x = (e->facing == DIR_RIGHT) ? def->speed : -def->speed;
+        /* Horizontal movement */
+        b->vel.x = (e->facing == DIR_RIGHT) ? speed : -speed;
 
-    /* Sine wave on Y using ai_timer as phase */
-    e->ai_timer++;
-    e->body.vel.y = fx_sin(e->ai_timer & 0xFF) >> 1;
+        /* Sine wave on Y using ai_timer as phase */
+        e->ai_timer++;
+        b->vel.y = fx_sin(e->ai_timer & 0xFF) >> 1;
 
-    /* Direct position update (no gravity) */
-    e->body.pos.x += e->body.vel.x;
-    e->body.pos.y += e->body.vel.y;
+        /* Direct position update (no gravity) */
+        b->pos.x += b->vel.x;
+        b->pos.y += b->vel.y;
 
-    /* Reverse at room edges */
-    int px = FX_TO_INT(e->body.pos.x);
-    int room_w = g_current_room.width_tiles * TILE_SIZE;
-    if (px <= TILE_SIZE || px >= room_w - TILE_SIZE) {
-        e->facing = (e->facing == DIR_RIGHT) ? DIR_LEFT : DIR_RIGHT;
+        /* Reverse at room edges */
+        int px = FX_TO_INT(b->pos.x);
+        if (px <= TILE_SIZE || px >= room_w - TILE_SIZE) {
+            e->facing = (e->facing == DIR_RIGHT) ? DIR_LEFT : DIR_RIGHT;
+        }
     }
 }
 
@@ -162,22 +210,28 @@ static void ai_waver(Enemy* e) {
  * Ignores gravity and tile collision.
  * ======================================================================== */
 
-static void ai_rinka(Enemy* e) {
-    const EnemyTypeDef* def = &enemy_defs[e->type];
-    fx32 dx = g_player.body.pos.x - e->body.pos.x;
-    fx32 dy = g_player.body.pos.y - e->body.pos.y;
+static void ai_rinka(int first, int count) {
+    fx32 speed = enemy_defs[ENEMY_RINKA].speed;
 
-    /* Approximate normalized direction */
-    e->body.vel.x = (dx > 0) ? def->speed : (dx < 0) ? -def->speed : 0;
-    e->body.vel.y = (dy > 0) ? def->speed : (dy < 0) ? -def->speed : 0;
-
-    e->body.pos.x += e->body.vel.x;
-    e->body.pos.y += e->body.vel.y;
-
-    /* Despawn timer (5 seconds @ 60fps) */
-    e->ai_timer++;
-    if (e->ai_timer > 300) {
-        e->active = false;
+    for (int i = first; i < first + count; i++) {
+        Enemy* e = &pool[i];
+        PhysicsBody* b = &bodies[i];
+        if (e->asleep) continue;
+        fx32 dx = g_player.body.pos.x - b->pos.x;
+        fx32 dy = g_player.body.pos.y - b->pos.y;
+
+        /* Approximate normalized direction */
+        b->vel.x = (dx > 0) ? speed : (dx < 0) ? -speed : 0;
+        b->vel.y = (dy > 0) ? speed : (dy < 0) ? -speed : 0;
+
+        b->pos.x += b->vel.x;
+        b->pos.y += b->vel.y;
+
+        /* Despawn timer (5 seconds @ 60fps) */
+        e->ai_timer++;
+        if (e->ai_timer > 300) {
+            e->active = false;
+        }
     }
 }
 
@@ -189,48 +243,58 @@ static void ai_rinka(Enemy* e) {
  * Uses full physics.
  * ======================================================================== */
 
-static void ai_sidehopper(Enemy* e) {
-    const EnemyTypeDef* def = &enemy_defs[e->type];
+static void ai_sidehopper(int first, int count) {
+    int end = first + count;
+    fx32 speed = enemy_defs[ENEMY_SIDEHOPPER].speed;
 
-    switch (e->ai_state) {
-        case 0: /* Idle on ground */
-            e->body.vel.x = 0;
-            physics_update_body(&e->body);
-            e->ai_timer++;
-            if (e->ai_timer > 60) {
-                e->ai_state = 1;
-                e->ai_timer = 0;
-                /* Jump toward player */
-                e->body.vel.y = -(JUMP_VEL_NORMAL >> 1);
-                if (g_player.body.pos.x > e->body.pos.x) {
-                    e->facing = DIR_RIGHT;
-                    e->body.vel.x = def->speed;
-                } else {
-                    e->facing = DIR_LEFT;
-                    e->body.vel.x = -def->speed;
+    /* Idle hoppers stand still (physics keeps them grounded) */
+    for (int i = first; i < end; i++) {
+        if (!pool[i].asleep && pool[i].ai_state == 0) bodies[i].vel.x = 0;
+    }
+
+    physics_batch(first, count);
+
+    for (int i = first; i < end; i++) {
+        Enemy* e = &pool[i];
+        PhysicsBody* b = &bodies[i];
+        if (e->asleep) continue;
+
+        switch (e->ai_state) {
+            case 0: /* Idle on ground */
+                e->ai_timer++;
+                if (e->ai_timer > 60) {
+                    e->ai_state = 1;
+                    e->ai_timer = 0;
+                    /* Jump toward player */
+                    b->vel.y = -(JUMP_VEL_NORMAL >> 1);
+                    if (g_player.body.pos.x > b->pos.x) {
+                        e->facing = DIR_RIGHT;
+                        b->vel.x = speed;
+                    } else {
+                        e->facing = DIR_LEFT;
+                        b->vel.x = -speed;
+                    }
                 }
-            }
-            break;
-
-        case 1: /* Airborne */
-            physics_update_body(&e->body);
-            if (e->body.contact.on_ground) {
-                e->ai_state = 0;
-                e->ai_timer = 0;
-                e->body.vel.x = 0;
-            }
-            break;
+                break;
+
+            case 1: /* Airborne */
+                if (b->contact.on_ground) {
+                    e->ai_state = 0;
+                    e->ai_timer = 0;
+                    b->vel.x = 0;
+                }
+                break;
+        }
     }
 }
 
-/* Stub for unimplemented AI */
-static void ai_stub(Enemy* e) {
-    /* Just apply physics so it doesn't float */
-    physics_update_body(&e->body);
+/* Stub for unimplemented AI: just apply physics so it doesn't float */
+static void ai_stub(int first, int count) {
+    physics_batch(first, count);
 }
 
-/* AI dispatch table */
-typedef void (*AIUpdateFn)(Enemy*);
+/* AI dispatch table: one call per type group per frame */
+typedef void (*AIUpdateFn)(int first, int count);
 
 static const AIUpdateFn ai_fns[ENEMY_TYPE_COUNT] = {
     [ENEMY_NONE]       = ai_stub,
@@ -248,8 +312,7 @@ static const AIUpdateFn ai_fns[ENEMY_TYPE_COUNT] = {
  * ======================================================================== */
 
 void enemy_pool_init(void) {
-    memset(pool, 0, sizeof(pool));
-    active_count = 0;
+    enemy_clear_all();
     sprites_loaded = false;
 }
 
@@ -259,9 +322,21 @@ int enemy_spawn(EnemyTypeID type, fx32 x, fx32 y) {
 
     load_enemy_sprites();
 
+    /* Open a slot at the end of this type's group: each later group
+     * moves its first entry to its end, walking the free slot down. */
+    int slot = active_count;
+    for (int t = ENEMY_TYPE_COUNT - 1; t > (int)type; t--) {
+        int first = type_start[t];
+        if (first != slot) move_slot(slot, first);
+        slot = first;
+        type_start[t]++;
+    }
+    type_start[ENEMY_TYPE_COUNT]++;
+    active_count++;
+
     const EnemyTypeDef* def = &enemy_defs[type];
 
-    Enemy* e = &pool[active_count];
+    Enemy* e = &pool[slot];
     memset(e, 0, sizeof(Enemy));
     e->type = type;
     e->active = true;
@@ -270,31 +345,46 @@ int enemy_spawn(EnemyTypeID type, fx32 x, fx32 y) {
     e->damage_contact = def->damage;
     e->facing = DIR_LEFT;
 
-    e->body.pos.x = x;
-    e->body.pos.y = y;
-    e->body.hitbox.half_w = def->half_w;
-    e->body.hitbox.half_h = def->half_h;
-    e->body.env = ENV_AIR;
+    PhysicsBody* b = &bodies[slot];
+    memset(b, 0, sizeof(PhysicsBody));
+    b->pos.x = x;
+    b->pos.y = y;
+    b->hitbox.half_w = def->half_w;
+    b->hitbox.half_h = def->half_h;
+    b->env = ENV_AIR;
 
-    int idx = active_count;
-    active_count++;
-    return idx;
+    return slot;
 }
 
 void enemy_remove(int index) {
     if (index < 0 || index >= active_count) return;
 
-    /* Swap with last active entry */
-    active_count--;
-    if (index < active_count) {
-        pool[index] = pool[active_count];
+    /* Fill the hole with the last entry of its group, then let each
+     * later group move its last entry into the new hole. */
+    int type = pool[index].type;
+    int hole = type_start[type + 1] - 1;
+    if (index != hole) move_slot(index, hole);
+
+    for (int t = type + 1; t < ENEMY_TYPE_COUNT; t++) {
+        int last = type_start[t + 1] - 1;
+        if (last >= type_start[t]) {
+            move_slot(hole, last);
+            hole = last;
+        }
+        type_start[t]--;
     }
-    memset(&pool[active_count], 0, sizeof(Enemy));
+    type_start[ENEMY_TYPE_COUNT]--;
+    active_count--;
+
+    clear_slot(hole);
 }
 
 void enemy_clear_all(void) {
     memset(pool, 0, sizeof(pool));
+    memset(bodies, 0, sizeof(bodies));
+    memset(type_start, 0, sizeof(type_start));
     active_count = 0;
+    awake_count = 0;
 }
 
 /* ========================================================================
@@ -302,35 +392,77 @@ void enemy_clear_all(void) {
  * ======================================================================== */
 
 /* AABB overlap check for contact damage */
-static bool enemy_aabb_overlap(const Enemy* e, const PhysicsBody* target) {
-    fx32 dx = e->body.pos.x - target->pos.x;
-    fx32 dy = e->body.pos.y - target->pos.y;
+SM_ITCM static bool enemy_aabb_overlap(const PhysicsBody* a, const PhysicsBody* target) {
+    fx32 dx = a->pos.x - target->pos.x;
+    fx32 dy = a->pos.y - target->pos.y;
     if (dx < 0) dx = -dx;
     if (dy < 0) dy = -dy;
-    return dx < (e->body.hitbox.half_w + target->hitbox.half_w) &&
-           dy < (e->body.hitbox.half_h + target->hitbox.half_h);
+    return dx < (a->hitbox.half_w + target->hitbox.half_w) &&
+           dy < (a->hitbox.half_h + target->hitbox.half_h);
 }
 
-void enemy_update_all(void) {
-    /* Iterate backward so swap-remove doesn't skip entries */
-    for (int i = active_count - 1; i >= 0; i--) {
+/* Decide who is awake this frame. Sleepers in TIMER mode tick here, so
+ * AI functions only ever see awake enemies. */
+SM_ITCM static void update_activation(void) {
+    fx32 wake = INT_TO_FX(ENEMY_WAKE_MARGIN_PX);
+    fx32 sleep = INT_TO_FX(ENEMY_WAKE_MARGIN_PX + ENEMY_SLEEP_HYSTERESIS_PX);
+    fx32 left = g_camera.x;
+    fx32 top = g_camera.y;
+    fx32 right = left + INT_TO_FX(SCREEN_WIDTH);
+    fx32 bottom = top + INT_TO_FX(SCREEN_HEIGHT);
+
+    awake_count = 0;
+    for (int i = 0; i < active_count; i++) {
         Enemy* e = &pool[i];
-        if (!e->active) {
-            enemy_remove(i);
-            continue;
+        EnemySleepMode mode = enemy_defs[e->type].sleep;
+
+        if (mode != ENEMY_SLEEP_NEVER) {
+            const PhysicsBody* b = &bodies[i];
+            fx32 m = e->asleep ? wake : sleep;
+            bool inside = b->pos.x + b->hitbox.half_w >= left - m &&
+                          b->pos.x - b->hitbox.half_w <= right + m &&
+                          b->pos.y + b->hitbox.half_h >= top - m &&
+                          b->pos.y - b->hitbox.half_h <= bottom + m;
+            e->asleep = !inside;
+        }
+
+        if (!e->asleep) {
+            awake_count++;
+        } else if (mode == ENEMY_SLEEP_TIMER) {
+            e->ai_timer++;
         }
+    }
+}
+
+SM_ITCM void enemy_update_all(void) {
+    /* Reap enemies killed since last frame. Backward, so the entries
+     * remove() moves down have already been visited. */
+    for (int i = active_count - 1; i >= 0; i--) {
+        if (!pool[i].active) enemy_remove(i);
+    }
+
+    update_activation();
 
-        /* Run type-specific AI */
-        if (ai_fns[e->type]) {
-            ai_fns[e->type](e);
+    /* Run type-specific AI, one batch per type */
+    for (int t = ENEMY_NONE + 1; t < ENEMY_TYPE_COUNT; t++) {
+        int first = type_start[t];
+        int count = type_start[t + 1] - first;
+        if (count > 0 && ai_fns[t]) {
+            ai_fns[t](first, count);
         }
+    }
 
-        /* Contact damage vs player */
-        if (e->active && e->damage_contact > 0 &&
-            g_player.alive && g_player.invuln_timer == 0) {
-            if (enemy_aabb_overlap(e, &g_player.body)) {
-                player_damage_from(e->damage_contact, e->body.pos.x);
-            }
+    bool can_hurt = g_player.alive && g_player.invuln_timer == 0;
+
+    for (int i = 0; i < active_count; i++) {
+        Enemy* e = &pool[i];
+        if (e->asleep) continue;
+
+        /* Contact damage vs player (first hit starts i-frames) */
+        if (can_hurt && e->active && e->damage_contact > 0 &&
+            enemy_aabb_overlap(&bodies[i], &g_player.body)) {
+            player_damage_from(e->damage_contact, bodies[i].pos.x);
+            can_hurt = g_player.alive && g_player.invuln_timer == 0;
         }
 
         /* Animation timer (simple 4-frame cycle) */
@@ -350,24 +482,16 @@ void enemy_render_all(void) {
         Enemy* e = &pool[i];
 
         /* World to screen (subtract camera) */
-        int sx = FX_TO_INT(e->body.pos.x) - cam_x - 8;
-        int sy = FX_TO_INT(e->body.pos.y) - cam_y - 8;
-
-        int oam_idx = OAM_ENEMY_START + i;
+        int sx = FX_TO_INT(bodies[i].pos.x) - cam_x - 8;
+        int sy = FX_TO_INT(bodies[i].pos.y) - cam_y - 8;
 
         /* Cull off-screen sprites */
         if (sx < -16 || sx > SCREEN_WIDTH || sy < -16 || sy > SCREEN_HEIGHT) {
-            graphics_hide_sprite(oam_idx);
             continue;
         }
 
-        graphics_set_sprite(oam_idx, sx, sy, 4, 1, 2,
-                           e->facing == DIR_LEFT, false);
-    }
-
-    /* Hide unused enemy OAM slots */
-    for (int i = active_count; i < MAX_ENEMIES; i++) {
-        graphics_hide_sprite(OAM_ENEMY_START + i);
+        graphics_draw_sprite(sx, sy, 4, 1, 2, e->facing == DIR_LEFT, false,
+                             SPR_PRIO_NORMAL);
     }
 }
 
@@ -380,11 +504,55 @@ Enemy* enemy_get(int index) {
     return &pool[index];
 }
 
+EnemySleepMode enemy_get_sleep_mode(EnemyTypeID type) {
+    if (type >= ENEMY_TYPE_COUNT) return ENEMY_SLEEP_NEVER;
+    return enemy_defs[type].sleep;
+}
+
+int enemy_get_awake_count(void) {
+    return awake_count;
+}
+
+PhysicsBody* enemy_get_body(int index) {
+    if (index < 0 || index >= active_count) return NULL;
+    return &bodies[index];
+}
+
 void enemy_damage(int index, int16_t damage) {
     if (index < 0 || index >= active_count) return;
     Enemy* e = &pool[index];
     e->hp -= damage;
     if (e->hp <= 0) {
         e->active = false;
+        audio_play_sfx(SFX_ENEMY_DEATH);
+    } else {
+        audio_play_sfx(SFX_ENEMY_HIT);
     }
 }
+
+/* ========================================================================
+ * Snapshot
+ * ======================================================================== */
+
+void enemy_snapshot_save(SnapshotWriter* w) {
+    snapshot_write(w, &active_count, sizeof(active_count));
+    snapshot_write(w, &awake_count, sizeof(awake_count));
+    snapshot_write(w, type_start, sizeof(type_start));
+    snapshot_write(w, pool, active_count * sizeof(Enemy));
+    snapshot_write(w, bodies, active_count * sizeof(PhysicsBody));
+}
+
+void enemy_snapshot_load(SnapshotReader* r) {
+    int count = 0;
+    snapshot_read(r, &count, sizeof(count));
+    if (count < 0 || count > MAX_ENEMIES) r->ok = false;
+    if (!r->ok) return;
+
+    enemy_clear_all();
+    active_count = count;
+    snapshot_read(r, &awake_count, sizeof(awake_count));
+    snapshot_read(r, type_start, sizeof(type_start));
+    snapshot_read(r, pool, active_count * sizeof(Enemy));
+    snapshot_read(r, bodies, active_count * sizeof(PhysicsBody));
+    if (active_count > 0) load_enemy_sprites();
+}
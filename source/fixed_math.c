@@ -43,7 +43,7 @@ fx32 fx_lerp(fx32 a, fx32 b, fx32 t) {
  * Generated: sin_lut[i] = round(sin(i * 2*PI / 256) * 65536)
  * ======================================================================== */
 
-static const fx32 sin_lut[256] = {
+SM_DTCM static const fx32 sin_lut[256] = {
      0x00000, 0x00648, 0x00C90, 0x012D5, 0x01918, 0x01F56, 0x02590, 0x02BC4,
      0x031F1, 0x03817, 0x03E34, 0x04447, 0x04A50, 0x0504D, 0x0563E, 0x05C22,
      0x061F8, 0x067BE, 0x06D74, 0x0731A, 0x078AD, 0x07E2F, 0x0839C, 0x088F6,
@@ -94,36 +94,109 @@ fx32 fx_cos(int angle) {
  * Uses 64-bit intermediate to handle the shifted value.
  * ======================================================================== */
 
+/* sqrt of a 16.16 value in 16.16: sqrt(a / 2^16) * 2^16 = sqrt(a << 16) */
+static inline uint64_t sqrt_arg(fx32 a) {
+    return (uint64_t)a << FX_SHIFT;
+}
+
+#ifndef ARM9
+/* floor(sqrt(v)) by the digit-by-digit method: one compare/subtract per
+ * result bit, no divides. Starts at the highest even bit <= msb(v). */
+static uint32_t isqrt64(uint64_t v) {
+    if (v == 0) return 0;
+
+    uint64_t bit = (uint64_t)1 << ((63 - __builtin_clzll(v)) & ~1);
+    uint64_t res = 0;
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+#endif
+
 fx32 fx_sqrt(fx32 a) {
     if (a <= 0) return 0;
+#ifdef ARM9
+    REG_SQRTCNT = SQRT_64;
+    REG_SQRT_PARAM = sqrt_arg(a);
+    while (REG_SQRTCNT & SQRT_BUSY);
+    return (fx32)REG_SQRT_RESULT;
+#else
+    return (fx32)isqrt64(sqrt_arg(a));
+#endif
+}
 
-    /* We need sqrt(a) where a is in 16.16 fixed-point.
-     * Result should also be 16.16.
-     * sqrt(a_fixed) = sqrt(a_real * 65536) = sqrt(a_real) * 256
-     * But we want the result in 16.16: sqrt(a_real) * 65536
-     * So: result = sqrt(a_fixed * 65536) = sqrt(a_fixed << 16) */
-    uint64_t val = (uint64_t)a << FX_SHIFT;
-
-    /* Newton's method for integer sqrt of val */
-    uint64_t guess = val;
-
-    /* Start with a reasonable initial guess */
-    if (guess > (uint64_t)1 << 32) {
-        guess = (uint64_t)1 << 24;
-    } else {
-        guess = (uint64_t)1 << 16;
-    }
+fx32 fx_length(fx32 dx, fx32 dy) {
+    /* dx^2 + dy^2 in 32.32; its 64-bit sqrt is already 16.16 */
+    uint64_t sq = (uint64_t)((int64_t)dx * dx) + (uint64_t)((int64_t)dy * dy);
+    uint32_t len;
+#ifdef ARM9
+    REG_SQRTCNT = SQRT_64;
+    REG_SQRT_PARAM = sq;
+    while (REG_SQRTCNT & SQRT_BUSY);
+    len = REG_SQRT_RESULT;
+#else
+    len = isqrt64(sq);
+#endif
+    return (len > 0x7FFFFFFFu) ? 0x7FFFFFFF : (fx32)len;
+}
 
-    for (int i = 0; i < 16; i++) {
-        if (guess == 0) break;
-        uint64_t next = (guess + val / guess) >> 1;
-        if (next >= guess) break;  /* Converged */
-        guess = next;
-    }
+/* ========================================================================
+ * Async Hardware Math
+ * ======================================================================== */
+
+#ifdef ARM9
+
+void fx_div_start(fx32 a, fx32 b) {
+    REG_DIVCNT = DIV_64_32;
+    REG_DIV_NUMER = (int64_t)a << FX_SHIFT;
+    REG_DIV_DENOM_L = b;
+}
 
-    return (fx32)guess;
+bool fx_div_busy(void) {
+    return (REG_DIVCNT & DIV_BUSY) != 0;
 }
 
+fx32 fx_div_result(void) {
+    while (REG_DIVCNT & DIV_BUSY);
+    return (fx32)REG_DIV_RESULT_L;
+}
+
+void fx_sqrt_start(fx32 a) {
+    REG_SQRTCNT = SQRT_64;
+    REG_SQRT_PARAM = (a > 0) ? sqrt_arg(a) : 0;
+}
+
+bool fx_sqrt_busy(void) {
+    return (REG_SQRTCNT & SQRT_BUSY) != 0;
+}
+
+fx32 fx_sqrt_result(void) {
+    while (REG_SQRTCNT & SQRT_BUSY);
+    return (fx32)REG_SQRT_RESULT;
+}
+
+#else
+
+static fx32 div_pending;
+static fx32 sqrt_pending;
+
+void fx_div_start(fx32 a, fx32 b) { div_pending = fx_div(a, b); }
+bool fx_div_busy(void)            { return false; }
+fx32 fx_div_result(void)          { return div_pending; }
+
+void fx_sqrt_start(fx32 a)        { sqrt_pending = fx_sqrt(a); }
+bool fx_sqrt_busy(void)           { return false; }
+fx32 fx_sqrt_result(void)         { return sqrt_pending; }
+
+#endif
+
 /* ========================================================================
  * SNES Subpixel Conversion
  *
@@ -19,6 +19,7 @@
 #include "fixed_math.h"
 #include "input.h"
 #include "graphics.h"
+#include "tile_anim.h"
 #include "room.h"
 #include "physics.h"
 #include "player.h"
@@ -30,6 +31,8 @@
 #include "save.h"
 #include "state.h"
 #include "hud.h"
+#include "profiler.h"
+#include "log.h"
 
 /* ========================================================================
  * Global Progress
@@ -87,6 +90,9 @@ static void gameplay_exit(void);  /* Forward declaration */
 
 static void start_door_transition(const DoorData* door) {
     trans_door = *door;
+    room_prefetch(door->dest_area, door->dest_room);
+    audio_preload_music(audio_area_music(door->dest_area));
+    audio_play_sfx(SFX_DOOR);
     trans_state = TRANS_FADEOUT;
     trans_timer = FADE_FRAMES;
 }
@@ -97,6 +103,9 @@ static bool update_door_transition(void) {
 
     switch (trans_state) {
         case TRANS_FADEOUT: {
+            /* Finish building the destination while the screen fades */
+            room_prefetch_update();
+
             int level = -16 + (trans_timer * 16 / FADE_FRAMES);
             graphics_set_brightness(level);
             graphics_set_brightness_sub(level);
@@ -116,7 +125,9 @@ static bool update_door_transition(void) {
             projectile_clear_all();
             boss_init();
 
+            /* Prefetched during approach/fade-out: commit + queued uploads */
             room_load(trans_door.dest_area, trans_door.dest_room);
+            audio_play_music(audio_area_music(g_current_room.area_id));
 
             g_player.body.pos.x = INT_TO_FX(trans_door.spawn_x);
             g_player.body.pos.y = INT_TO_FX(trans_door.spawn_y);
@@ -137,12 +148,13 @@ static bool update_door_transition(void) {
                 if (!(g_boss_flags & BOSS_FLAG_SPORE_SPAWN)) {
                     boss_spawn(BOSS_SPORE_SPAWN, INT_TO_FX(128), INT_TO_FX(48));
                     g_boss_was_active = true;
+                    audio_play_music(MUSIC_BOSS);
                 }
             }
 
-            fprintf(stderr, "Door -> room %d:%d spawn(%d,%d)\n",
-                    trans_door.dest_area, trans_door.dest_room,
-                    trans_door.spawn_x, trans_door.spawn_y);
+            LOG_INFO("Door -> room %d:%d spawn(%d,%d)\n",
+                     trans_door.dest_area, trans_door.dest_room,
+                     trans_door.spawn_x, trans_door.spawn_y);
 
             trans_state = TRANS_FADEIN;
             trans_timer = FADE_FRAMES;
@@ -150,6 +162,9 @@ static bool update_door_transition(void) {
         }
 
         case TRANS_FADEIN: {
+            /* Stay black until the new room's tiles and map are in VRAM */
+            if (graphics_get_pending_upload_bytes() > 0) break;
+
             int level = -16 + ((FADE_FRAMES - trans_timer) * 16 / FADE_FRAMES);
             graphics_set_brightness(level);
             graphics_set_brightness_sub(level);
@@ -178,11 +193,12 @@ static bool gameplay_pausing;
 static void gameplay_enter(void) {
     /* Resume from pause: room already loaded, skip re-initialization */
     if (gameplay_initialized && g_current_room.loaded) {
-        fprintf(stderr, "Gameplay: resumed from pause\n");
+        LOG_DEBUG("Gameplay: resumed from pause\n");
         return;
     }
 
     consoleClear();
+    hud_reset_map();
     player_init();
     camera_init();
     enemy_pool_init();
@@ -192,6 +208,7 @@ static void gameplay_enter(void) {
     g_boss_was_active = false;
 
     if (!g_current_room.loaded) room_load(0, 0);
+    audio_play_music(audio_area_music(g_current_room.area_id));
 
     /* Spawn enemies from room data */
     for (int i = 0; i < g_current_room.spawn_count; i++) {
@@ -205,17 +222,21 @@ static void gameplay_enter(void) {
         if (!(g_boss_flags & BOSS_FLAG_SPORE_SPAWN)) {
             boss_spawn(BOSS_SPORE_SPAWN, INT_TO_FX(128), INT_TO_FX(48));
             g_boss_was_active = true;
+            audio_play_music(MUSIC_BOSS);
         }
     }
 
     gameplay_initialized = true;
 
-    fprintf(stderr, "Gameplay: room %d:%d enemies=%d\n",
-            g_current_room.area_id, g_current_room.room_id,
-            enemy_get_count());
+    LOG_INFO("Gameplay: room %d:%d enemies=%d\n",
+             g_current_room.area_id, g_current_room.room_id,
+             enemy_get_count());
 }
 
 static void gameplay_exit(void) {
+    /* Menus draw on the console layer; the HUD comes back on resume */
+    hud_hide();
+
     /* When pausing, preserve all game state for seamless resume */
     if (gameplay_pausing) {
         gameplay_pausing = false;
@@ -227,6 +248,9 @@ static void gameplay_exit(void) {
     projectile_clear_all();
     boss_init();
     gameplay_initialized = false;
+
+    /* Rooms left behind this session don't carry into the next */
+    room_cache_clear();
 }
 
 static void gameplay_update(void) {
@@ -251,7 +275,9 @@ static void gameplay_update(void) {
     /* Game timer */
     g_game_time_frames++;
 
+    profiler_begin(PROF_PLAYER);
     player_update();
+    profiler_end(PROF_PLAYER);
 
     /* Save station interaction: UP on save tile */
     if (input_pressed(KEY_UP) && g_player.body.contact.on_ground) {
@@ -277,7 +303,8 @@ static void gameplay_update(void) {
             sd.time_seconds = (g_game_time_frames / 60) % 60;
             sd.time_frames = g_game_time_frames % 60;
             save_write(g_active_save_slot, &sd);
-            fprintf(stderr, "Saved to slot %d\n", g_active_save_slot);
+            audio_play_sfx(SFX_SAVE);
+            LOG_INFO("Saved to slot %d\n", g_active_save_slot);
         }
     }
 
@@ -288,9 +315,16 @@ static void gameplay_update(void) {
             g_boss_flags |= BOSS_FLAG_SPORE_SPAWN;
         }
         camera_shake(30, 4);
-        fprintf(stderr, "Boss defeated! flags=0x%04x\n", g_boss_flags);
+        audio_play_music(audio_area_music(g_current_room.area_id));
+        LOG_INFO("Boss defeated! flags=0x%04x\n", g_boss_flags);
     }
 
+    /* Build the room behind a nearby door before Samus reaches it */
+    const DoorData* near_door =
+        room_find_door_near(&g_player.body, DOOR_PREFETCH_MARGIN_PX);
+    if (near_door) room_prefetch(near_door->dest_area, near_door->dest_room);
+    room_prefetch_update();
+
     /* Door transition check (locked during boss fight) */
     const DoorData* door = NULL;
     if (!boss_is_active()) {
@@ -319,6 +353,7 @@ static void gameplay_update(void) {
             projectile_spawn(beam, PROJ_OWNER_PLAYER,
                            g_player.body.pos.x, g_player.body.pos.y,
                            vx, 0);
+            audio_play_sfx(SFX_BEAM);
         }
         if (input_pressed(KEY_R) && g_player.missiles > 0) {
             g_player.missiles--;
@@ -327,6 +362,7 @@ static void gameplay_update(void) {
             projectile_spawn(PROJ_MISSILE, PROJ_OWNER_PLAYER,
                            g_player.body.pos.x, g_player.body.pos.y,
                            vx, 0);
+            audio_play_sfx(SFX_MISSILE);
         }
         if (input_pressed(KEY_L) && g_player.supers > 0) {
             g_player.supers--;
@@ -335,6 +371,7 @@ static void gameplay_update(void) {
             projectile_spawn(PROJ_SUPER_MISSILE, PROJ_OWNER_PLAYER,
                            g_player.body.pos.x, g_player.body.pos.y,
                            vx, 0);
+            audio_play_sfx(SFX_SUPER_MISSILE);
         }
     }
 
@@ -344,11 +381,13 @@ static void gameplay_update(void) {
         input_pressed(KEY_B)) {
         projectile_spawn(PROJ_BOMB, PROJ_OWNER_PLAYER,
                        g_player.body.pos.x, g_player.body.pos.y, 0, 0);
+        audio_play_sfx(SFX_BOMB);
     }
 
     /* Item pickup */
     ItemTypeID pickup = room_check_item_pickup(&g_player.body);
     if (pickup != ITEM_NONE) {
+        audio_play_sfx(SFX_ITEM);
         switch (pickup) {
             case ITEM_ENERGY_TANK:
                 g_player.hp_max += ENERGY_TANK_VALUE;
@@ -386,25 +425,43 @@ static void gameplay_update(void) {
                 break;
             default: break;
         }
-        fprintf(stderr, "Item pickup: type %d\n", pickup);
+        LOG_INFO("Item pickup: type %d\n", pickup);
     }
 
     /* Crumble blocks */
     room_update_crumble_blocks();
 
+    profiler_begin(PROF_ENEMY);
     enemy_update_all();
+    profiler_end(PROF_ENEMY);
+
+    profiler_begin(PROF_BOSS);
     boss_update();
+    profiler_end(PROF_BOSS);
+
+    profiler_begin(PROF_PROJECTILE);
     projectile_update_all();
+    profiler_end(PROF_PROJECTILE);
+
+    profiler_begin(PROF_CAMERA);
     camera_update();
+    profiler_end(PROF_CAMERA);
+
+    hud_update();
 }
 
 static void gameplay_render(void) {
     camera_apply();
+    room_flush_dirty_tiles();
+    tile_anim_update();
     player_render();
     enemy_render_all();
     boss_render();
     projectile_render_all();
+
+    profiler_begin(PROF_HUD);
     hud_render();
+    profiler_end(PROF_HUD);
 }
 
 /* ========================================================================
@@ -421,7 +478,7 @@ static void title_enter(void) {
     iprintf("\x1b[18;2Hv0.17 - M17 Integration");
 
     audio_play_music(MUSIC_TITLE);
-    fprintf(stderr, "STATE_TITLE entered\n");
+    LOG_DEBUG("STATE_TITLE entered\n");
 
     trans_state = TRANS_FADEIN;
     trans_timer = FADE_FRAMES;
@@ -474,7 +531,7 @@ static void file_select_enter(void) {
     }
     iprintf("\n  A=Load/New  B=Back");
 
-    fprintf(stderr, "STATE_FILE_SELECT entered\n");
+    LOG_DEBUG("STATE_FILE_SELECT entered\n");
 }
 
 static void file_select_exit(void) {
@@ -535,7 +592,7 @@ static void pause_enter(void) {
     iprintf("\n  Room: %d:%d\n",
             g_current_room.area_id, g_current_room.room_id);
     iprintf("\n  START = Resume");
-    fprintf(stderr, "STATE_PAUSE entered\n");
+    LOG_DEBUG("STATE_PAUSE entered\n");
 }
 
 static void pause_exit(void) {
@@ -562,7 +619,7 @@ static void death_enter(void) {
     iprintf("\x1b[10;8HGAME OVER");
     iprintf("\x1b[12;5HPress A to continue");
     audio_stop_music();
-    fprintf(stderr, "STATE_DEATH entered\n");
+    LOG_DEBUG("STATE_DEATH entered\n");
 }
 
 static void death_exit(void) {
@@ -601,7 +658,7 @@ static void ending_enter(void) {
     iprintf("\x1b[14;4HPress A for title");
 
     audio_stop_music();
-    fprintf(stderr, "STATE_ENDING entered\n");
+    LOG_DEBUG("STATE_ENDING entered\n");
 }
 
 static void ending_exit(void) {
@@ -642,3 +699,25 @@ void gameplay_register_states(void) {
         ending_enter, ending_exit, ending_update, ending_render
     });
 }
+
+/* ========================================================================
+ * Public: Snapshot
+ * ======================================================================== */
+
+void gameplay_snapshot_save(SnapshotWriter* w) {
+    /* Mid-transition state spans the room swap; capture before or after */
+    if (trans_state != TRANS_NONE) w->ok = false;
+    snapshot_write(w, &g_game_time_frames, sizeof(g_game_time_frames));
+    snapshot_write(w, &g_boss_flags, sizeof(g_boss_flags));
+    snapshot_write(w, &g_boss_was_active, sizeof(g_boss_was_active));
+}
+
+void gameplay_snapshot_load(SnapshotReader* r) {
+    snapshot_read(r, &g_game_time_frames, sizeof(g_game_time_frames));
+    snapshot_read(r, &g_boss_flags, sizeof(g_boss_flags));
+    snapshot_read(r, &g_boss_was_active, sizeof(g_boss_was_active));
+
+    trans_state = TRANS_NONE;
+    graphics_set_brightness(0);
+    graphics_set_brightness_sub(0);
+}
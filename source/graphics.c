@@ -2,13 +2,14 @@
  * graphics.c - Hardware rendering foundation
  *
  * VRAM bank configuration, BG layer management, shadow OAM,
- * sprite management, and VBlank commit.
+ * sprite management, VBlank upload queue, and VBlank commit.
  *
  * CRITICAL: VRAM banks are set ONCE at init and never reconfigured.
  * All rendering is hardware tile/sprite compositing -- NO software framebuffer.
  */
 
 #include "graphics.h"
+#include "fixed_math.h"
 #include <string.h>
 
 /* ========================================================================
@@ -23,8 +24,86 @@ static int bg_sub[4];
 static int bg_scroll_x[4];
 static int bg_scroll_y[4];
 
-/* OAM management */
+/* OAM management: pieces queued this frame, grouped into objects
+ * (one per metasprite), packed into slots at end_frame. */
+typedef struct {
+    int16_t  x, y;
+    uint16_t tile;
+    uint8_t  size;      /* SpriteSize */
+    uint8_t  palette;
+    uint8_t  bg_priority;
+    uint8_t  flags;     /* SPR_PIECE_* after applying object flip */
+} OamPiece;
+
+typedef struct {
+    uint16_t first_piece;
+    uint8_t  piece_count;
+    uint8_t  prio;
+    int16_t  slot;      /* Assigned at commit, -1 if dropped */
+} OamObject;
+
+static OamPiece  oam_pieces[OAM_PIECE_MAX];
+static OamObject oam_objects[OAM_OBJECT_MAX];
+static int oam_piece_count;
+static int oam_object_count;
 static int oam_used_count;
+static int oam_dropped_count;
+
+/* Slots of the last committed frame, by handle; the queue above is
+ * reset at the next begin_frame */
+static int16_t oam_committed_slot[OAM_OBJECT_MAX];
+static int     oam_committed_count;
+
+/* Per-band rotation; advances by the number placed whenever the band
+ * overflowed, so the dropped ones lead next frame. */
+static uint16_t oam_rotate[SPR_PRIO_COUNT];
+
+/* BG map patch queue: individual map entry writes committed at end_frame.
+ * Used for destructible terrain so a broken block costs 4 halfword
+ * writes instead of a full 8KB map re-upload, and for scroll streaming
+ * (one column + one row = 256 entries, plus headroom for dirty tiles).
+ * The bottom-screen HUD patches its changed digits through it too. */
+#define BG_MAP_PATCH_MAX 512
+
+typedef struct {
+    uint8_t  layer;
+    uint8_t  sub;       /* Layer is a sub engine (bottom screen) BG */
+    uint16_t offset;
+    u16      entry;
+} BgMapPatch;
+
+static BgMapPatch bg_map_patches[BG_MAP_PATCH_MAX];
+static int bg_map_patch_count;
+
+/* VRAM upload FIFO. done tracks progress through a transfer that was
+ * split across frames by the budget. */
+typedef struct {
+    const u8* src;
+    u8*       dst;
+    uint32_t  size;
+    uint32_t  done;
+} VramUpload;
+
+static VramUpload uploads[VRAM_UPLOAD_QUEUE_MAX];
+static int upload_head;
+static int upload_count;
+
+/* HBlank effect channels. Tables must be in main RAM: DMA can't read
+ * DTCM. front is scanned out; back is what the game is building. */
+typedef struct {
+    HblankTarget target;
+    int16_t      param;
+    uint8_t      front;
+    bool         active;
+    bool         pending;   /* back was built this frame */
+    bool         stopping;
+    HblankTarget next_target;
+    int16_t      next_param;
+} HblankChannel;
+
+static HblankChannel hblank[HBLANK_CHANNELS];
+/* +1: the HBlank after the last line still fetches an entry */
+static u16 hblank_tables[HBLANK_CHANNELS][2][SCREEN_HEIGHT + 1];
 
 /* ========================================================================
  * Initialization
@@ -97,15 +176,29 @@ void graphics_init(void) {
         bg_scroll_y[i] = 0;
     }
 
+    oam_piece_count = 0;
+    oam_object_count = 0;
     oam_used_count = 0;
+    oam_dropped_count = 0;
+    oam_committed_count = 0;
+    memset(oam_rotate, 0, sizeof(oam_rotate));
+    bg_map_patch_count = 0;
+    upload_head = 0;
+    upload_count = 0;
+
+    for (int ch = 0; ch < HBLANK_CHANNELS; ch++) DMA_CR(ch) = 0;
+    memset(hblank, 0, sizeof(hblank));
 }
 
 /* ========================================================================
  * Per-Frame Management
  * ======================================================================== */
 
+static void commit_sprites(void);
+
 void graphics_begin_frame(void) {
-    oam_used_count = 0;
+    oam_piece_count = 0;
+    oam_object_count = 0;
 
     /* Hide all sprites by clearing OAM entries */
     oamClear(&oamMain, 0, 128);
@@ -113,7 +206,8 @@ void graphics_begin_frame(void) {
 }
 
 void graphics_end_frame(void) {
-    /* DMA shadow OAM to hardware */
+    /* Pack queued sprites, then DMA shadow OAM to hardware */
+    commit_sprites();
     oamUpdate(&oamMain);
     oamUpdate(&oamSub);
 
@@ -136,44 +230,294 @@ void graphics_end_frame(void) {
     bgUpdate();
 }
 
+/* ========================================================================
+ * VBlank Upload Queue
+ * ======================================================================== */
+
+static VramUpload* upload_at(int i) {
+    return &uploads[(upload_head + i) % VRAM_UPLOAD_QUEUE_MAX];
+}
+
+/* Copy up to budget bytes from the queue front. Returns bytes left. */
+static uint32_t drain_uploads(uint32_t budget) {
+    while (upload_count > 0 && budget > 0) {
+        VramUpload* u = upload_at(0);
+        uint32_t chunk = u->size - u->done;
+        if (chunk > budget) chunk = budget;
+
+        DC_FlushRange(u->src + u->done, chunk);
+        dmaCopy(u->src + u->done, u->dst + u->done, chunk);
+        u->done += chunk;
+        budget -= chunk;
+
+        if (u->done < u->size) break;
+        upload_head = (upload_head + 1) % VRAM_UPLOAD_QUEUE_MAX;
+        upload_count--;
+    }
+    return budget;
+}
+
+/* True while a queued upload still has bytes to write into [dst, dst+size) */
+static bool upload_pending_in(const void* dst, uint32_t size) {
+    const u8* lo = dst;
+    const u8* hi = lo + size;
+    for (int i = 0; i < upload_count; i++) {
+        const VramUpload* u = upload_at(i);
+        if (u->dst + u->done < hi && u->dst + u->size > lo) return true;
+    }
+    return false;
+}
+
+bool graphics_queue_upload(const void* src, void* dst, uint32_t size) {
+    if (!src || !dst || size == 0 || (size & 3)) return false;
+
+    /* Same destination already queued: restart it with the new source */
+    for (int i = 0; i < upload_count; i++) {
+        VramUpload* u = upload_at(i);
+        if (u->dst == dst && u->size == size) {
+            u->src = src;
+            u->done = 0;
+            return true;
+        }
+    }
+
+    if (upload_count >= VRAM_UPLOAD_QUEUE_MAX) return false;
+    VramUpload* u = upload_at(upload_count++);
+    u->src = src;
+    u->dst = dst;
+    u->size = size;
+    u->done = 0;
+    return true;
+}
+
+void graphics_flush_uploads(void) {
+    drain_uploads(UINT32_MAX);
+}
+
+uint32_t graphics_get_pending_upload_bytes(void) {
+    uint32_t total = 0;
+    for (int i = 0; i < upload_count; i++) {
+        const VramUpload* u = upload_at(i);
+        total += u->size - u->done;
+    }
+    return total;
+}
+
+/* ========================================================================
+ * HBlank Effects
+ * ======================================================================== */
+
+static vu16* hblank_register(HblankTarget target, int param) {
+    switch (target) {
+    case HBLANK_BG_SCROLL_X:
+        return (param >= 0 && param < 4) ? &REG_BG0HOFS + param * 2 : NULL;
+    case HBLANK_BG_SCROLL_Y:
+        return (param >= 0 && param < 4) ? &REG_BG0VOFS + param * 2 : NULL;
+    case HBLANK_BG_COLOR:
+        return (param >= 0 && param < 256) ? (vu16*)&BG_PALETTE[param] : NULL;
+    case HBLANK_BRIGHTNESS:
+        return &REG_MASTER_BRIGHT;
+    default:
+        return NULL;
+    }
+}
+
+u16* graphics_hblank_build(int channel, HblankTarget target, int param) {
+    if (channel < 0 || channel >= HBLANK_CHANNELS) return NULL;
+    if (!hblank_register(target, param)) return NULL;
+
+    HblankChannel* c = &hblank[channel];
+    c->next_target = target;
+    c->next_param = (int16_t)param;
+    c->pending = true;
+    c->stopping = false;
+    return hblank_tables[channel][c->front ^ 1];
+}
+
+void graphics_hblank_stop(int channel) {
+    if (channel < 0 || channel >= HBLANK_CHANNELS) return;
+    hblank[channel].pending = false;
+    hblank[channel].stopping = true;
+}
+
+const u16* graphics_hblank_active(int channel) {
+    if (channel < 0 || channel >= HBLANK_CHANNELS) return NULL;
+    if (!hblank[channel].active) return NULL;
+    return hblank_tables[channel][hblank[channel].front];
+}
+
+void graphics_hblank_wave(int channel, int layer, int amplitude,
+                          int wavelength, int phase) {
+    if (wavelength <= 0) return;
+    u16* t = graphics_hblank_build(channel, HBLANK_BG_SCROLL_X, layer);
+    if (!t) return;
+
+    /* 256 LUT steps per period */
+    int step = 256 / wavelength;
+    int base = bg_scroll_x[layer];
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        fx32 s = fx_sin((phase + y * step) & 0xFF);
+        t[y] = (u16)(base + FX_TO_INT(s * amplitude));
+    }
+}
+
+void graphics_hblank_gradient(int channel, int color_index,
+                              u16 top, u16 bottom) {
+    u16* t = graphics_hblank_build(channel, HBLANK_BG_COLOR, color_index);
+    if (!t) return;
+
+    /* Per-channel 5-bit lerp, 8.8 fixed step over the screen height */
+    int r0 = top & 31, g0 = (top >> 5) & 31, b0 = (top >> 10) & 31;
+    int dr = (bottom & 31) - r0;
+    int dg = ((bottom >> 5) & 31) - g0;
+    int db = ((bottom >> 10) & 31) - b0;
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        int k = (y << 8) / (SCREEN_HEIGHT - 1);
+        t[y] = (u16)RGB15(r0 + ((dr * k) >> 8),
+                          g0 + ((dg * k) >> 8),
+                          b0 + ((db * k) >> 8));
+    }
+}
+
+/* Swap in built tables and rearm each active channel. Line 0 is written
+ * directly; the DMA then feeds entries 1.. on each HBlank. Repeat-mode
+ * source addresses keep incrementing, so this runs every VBlank. */
+static void hblank_commit(void) {
+    for (int ch = 0; ch < HBLANK_CHANNELS; ch++) {
+        HblankChannel* c = &hblank[ch];
+
+        if (c->pending) {
+            c->front ^= 1;
+            c->target = c->next_target;
+            c->param = c->next_param;
+            c->active = true;
+            c->pending = false;
+        } else if (c->stopping) {
+            c->active = false;
+            c->stopping = false;
+        }
+
+        DMA_CR(ch) = 0;
+        if (!c->active) continue;
+
+        u16* table = hblank_tables[ch][c->front];
+        vu16* reg = hblank_register(c->target, c->param);
+        table[SCREEN_HEIGHT] = table[0];
+        DC_FlushRange(table, sizeof(hblank_tables[ch][0]));
+
+        *reg = table[0];
+        DMA_SRC(ch) = (uintptr_t)&table[1];
+        DMA_DEST(ch) = (uintptr_t)reg;
+        DMA_CR(ch) = DMA_ENABLE | DMA_REPEAT | DMA_START_HBL |
+                     DMA_16_BIT | DMA_SRC_INC | DMA_DST_RESET | 1;
+    }
+}
+
+void graphics_vblank(void) {
+    hblank_commit();
+    drain_uploads(VRAM_UPLOAD_BUDGET);
+
+    /* Apply queued BG map patches (VRAM accepts 16-bit writes). Patches
+     * for a layer whose map upload hasn't finished wait for it, or the
+     * rest of the upload would overwrite them. */
+    int kept = 0;
+    for (int i = 0; i < bg_map_patch_count; i++) {
+        const BgMapPatch* p = &bg_map_patches[i];
+        u16* map = bgGetMapPtr(p->sub ? bg_sub[p->layer] : bg_main[p->layer]);
+        if (upload_count > 0 &&
+            upload_pending_in(&map[p->offset], sizeof(u16))) {
+            bg_map_patches[kept++] = *p;
+            continue;
+        }
+        map[p->offset] = p->entry;
+    }
+    bg_map_patch_count = kept;
+}
+
 /* ========================================================================
  * BG Tile/Map/Palette Loading
  * ======================================================================== */
 
 void graphics_load_bg_tileset(int layer, const void* data, uint32_t size) {
     if (layer < 0 || layer > 3 || bg_main[layer] < 0) return;
-    DC_FlushRange(data, size);
-    dmaCopy(data, bgGetGfxPtr(bg_main[layer]), size);
+    graphics_queue_upload(data, bgGetGfxPtr(bg_main[layer]), size);
+}
+
+bool graphics_load_bg_tiles(int layer, const void* data, uint32_t size,
+                            int tile_offset) {
+    if (layer < 0 || layer > 3 || bg_main[layer] < 0) return false;
+    u8* base = (u8*)bgGetGfxPtr(bg_main[layer]);
+    return graphics_queue_upload(data, base + tile_offset * 32, size);
 }
 
 void graphics_load_bg_tilemap(int layer, const void* data, uint32_t size) {
     if (layer < 0 || layer > 3 || bg_main[layer] < 0) return;
-    DC_FlushRange(data, size);
-    dmaCopy(data, bgGetMapPtr(bg_main[layer]), size);
+    graphics_queue_upload(data, bgGetMapPtr(bg_main[layer]), size);
+
+    /* A full map upload supersedes any pending patches for this layer */
+    int kept = 0;
+    for (int i = 0; i < bg_map_patch_count; i++) {
+        if (bg_map_patches[i].sub || bg_map_patches[i].layer != layer) {
+            bg_map_patches[kept++] = bg_map_patches[i];
+        }
+    }
+    bg_map_patch_count = kept;
+}
+
+static bool queue_map_patch(int layer, bool sub, int map_offset, u16 entry) {
+    if (bg_map_patch_count >= BG_MAP_PATCH_MAX) return false;
+    BgMapPatch* p = &bg_map_patches[bg_map_patch_count++];
+    p->layer = (uint8_t)layer;
+    p->sub = sub;
+    p->offset = (uint16_t)map_offset;
+    p->entry = entry;
+    return true;
+}
+
+bool graphics_queue_bg_map_entry(int layer, int map_offset, u16 entry) {
+    if (layer < 0 || layer > 3 || bg_main[layer] < 0) return false;
+    return queue_map_patch(layer, false, map_offset, entry);
 }
 
 void graphics_load_bg_palette(int palette_idx, const u16* palette) {
     if (palette_idx < 0 || palette_idx > 15) return;
-    DC_FlushRange(palette, 32);
-    dmaCopy(palette, BG_PALETTE + (palette_idx * 16), 32);
+    graphics_queue_upload(palette, BG_PALETTE + (palette_idx * 16), 32);
+}
+
+/* ========================================================================
+ * Sub Engine BG Loading
+ * ======================================================================== */
+
+bool graphics_load_sub_bg_tiles(int layer, const void* data, uint32_t size,
+                                int tile_offset) {
+    if (layer < 0 || layer > 3 || bg_sub[layer] < 0) return false;
+    u8* base = (u8*)bgGetGfxPtr(bg_sub[layer]);
+    return graphics_queue_upload(data, base + tile_offset * 32, size);
+}
+
+bool graphics_queue_sub_bg_map_entry(int layer, int map_offset, u16 entry) {
+    if (layer < 0 || layer > 3 || bg_sub[layer] < 0) return false;
+    return queue_map_patch(layer, true, map_offset, entry);
+}
+
+void graphics_load_sub_bg_palette(int palette_idx, const u16* palette) {
+    if (palette_idx < 0 || palette_idx > 15) return;
+    graphics_queue_upload(palette, BG_PALETTE_SUB + (palette_idx * 16), 32);
 }
 
 /* ========================================================================
  * Sprite Tile/Palette Loading
  * ======================================================================== */
 
-void graphics_load_sprite_tiles(const void* data, uint32_t size, int tile_offset) {
+bool graphics_load_sprite_tiles(const void* data, uint32_t size, int tile_offset) {
     u16* dest = oamGetGfxPtr(&oamMain, tile_offset);
-    if (dest) {
-        DC_FlushRange(data, size);
-        dmaCopy(data, dest, size);
-    }
+    if (!dest) return false;
+    return graphics_queue_upload(data, dest, size);
 }
 
 void graphics_load_sprite_palette(int palette_idx, const u16* palette) {
     if (palette_idx < 0 || palette_idx > 15) return;
-    DC_FlushRange(palette, 32);
-    dmaCopy(palette, SPRITE_PALETTE + (palette_idx * 16), 32);
+    graphics_queue_upload(palette, SPRITE_PALETTE + (palette_idx * 16), 32);
 }
 
 /* ========================================================================
@@ -187,38 +531,165 @@ void graphics_set_bg_scroll(int layer, int scroll_x, int scroll_y) {
 }
 
 /* ========================================================================
- * Sprite Management
+ * Sprite Allocator
  * ======================================================================== */
 
-void graphics_set_sprite(int oam_idx, int x, int y, int tile_id,
-                         int palette, int priority, bool hflip, bool vflip) {
-    if (oam_idx < 0 || oam_idx >= 128) return;
-
-    u16* gfx_ptr = oamGetGfxPtr(&oamMain, tile_id);
-
-    oamSet(&oamMain,
-           oam_idx,
-           x, y,
-           priority,
-           palette,
-           SpriteSize_16x16,
-           SpriteColorFormat_16Color,
-           gfx_ptr,
-           -1,      /* No affine transform */
-           false,    /* Not double-size */
-           false,    /* Not hidden */
-           hflip,
-           vflip,
-           false);   /* No mosaic */
-
-    if (oam_idx >= oam_used_count) {
-        oam_used_count = oam_idx + 1;
+/* Centred so flipping a lone sprite leaves it in place */
+static const MetaspritePiece single_16x16 = { -8, -8, 16, 16, 0, 0 };
+static const Metasprite single_sprite = { &single_16x16, 1 };
+
+/* Map a piece's pixel dimensions to an OBJ shape/size. Returns false for
+ * dimensions the hardware can't draw. */
+static bool piece_sprite_size(int w, int h, SpriteSize* out) {
+    switch ((w << 8) | h) {
+    case (8  << 8) | 8:  *out = SpriteSize_8x8;   return true;
+    case (16 << 8) | 16: *out = SpriteSize_16x16; return true;
+    case (32 << 8) | 32: *out = SpriteSize_32x32; return true;
+    case (64 << 8) | 64: *out = SpriteSize_64x64; return true;
+    case (16 << 8) | 8:  *out = SpriteSize_16x8;  return true;
+    case (32 << 8) | 8:  *out = SpriteSize_32x8;  return true;
+    case (32 << 8) | 16: *out = SpriteSize_32x16; return true;
+    case (64 << 8) | 32: *out = SpriteSize_64x32; return true;
+    case (8  << 8) | 16: *out = SpriteSize_8x16;  return true;
+    case (8  << 8) | 32: *out = SpriteSize_8x32;  return true;
+    case (16 << 8) | 32: *out = SpriteSize_16x32; return true;
+    case (32 << 8) | 64: *out = SpriteSize_32x64; return true;
+    default: return false;
     }
 }
 
-void graphics_hide_sprite(int oam_idx) {
-    if (oam_idx < 0 || oam_idx >= 128) return;
-    oamClearSprite(&oamMain, oam_idx);
+int graphics_draw_metasprite(const Metasprite* ms, int x, int y,
+                             int tile_base, int palette, int bg_priority,
+                             bool hflip, bool vflip, SpritePriority prio) {
+    if (!ms || ms->count == 0 || prio >= SPR_PRIO_COUNT) return -1;
+    if (oam_object_count >= OAM_OBJECT_MAX ||
+        oam_piece_count + ms->count > OAM_PIECE_MAX) return -1;
+
+    OamObject* obj = &oam_objects[oam_object_count];
+    obj->first_piece = (uint16_t)oam_piece_count;
+    obj->piece_count = 0;
+    obj->prio = (uint8_t)prio;
+    obj->slot = -1;
+
+    uint8_t flip = (hflip ? SPR_PIECE_HFLIP : 0) | (vflip ? SPR_PIECE_VFLIP : 0);
+
+    for (int i = 0; i < ms->count; i++) {
+        const MetaspritePiece* src = &ms->pieces[i];
+        SpriteSize size;
+        if (!piece_sprite_size(src->w, src->h, &size)) continue;
+
+        OamPiece* dst = &oam_pieces[oam_piece_count++];
+        dst->x = (int16_t)(x + (hflip ? -src->dx - src->w : src->dx));
+        dst->y = (int16_t)(y + (vflip ? -src->dy - src->h : src->dy));
+        dst->tile = (uint16_t)(tile_base + src->tile);
+        dst->size = (uint8_t)size;
+        dst->palette = (uint8_t)palette;
+        dst->bg_priority = (uint8_t)bg_priority;
+        dst->flags = src->flags ^ flip;
+        obj->piece_count++;
+    }
+
+    if (obj->piece_count == 0) return -1;
+    return oam_object_count++;
+}
+
+int graphics_draw_sprite(int x, int y, int tile_id, int palette,
+                         int bg_priority, bool hflip, bool vflip,
+                         SpritePriority prio) {
+    return graphics_draw_metasprite(&single_sprite, x + 8, y + 8, tile_id,
+                                    palette, bg_priority, hflip, vflip, prio);
+}
+
+static void place_object(OamObject* obj, int slot) {
+    obj->slot = (int16_t)slot;
+    for (int i = 0; i < obj->piece_count; i++) {
+        const OamPiece* p = &oam_pieces[obj->first_piece + i];
+        oamSet(&oamMain,
+               slot + i,
+               p->x, p->y,
+               p->bg_priority,
+               p->palette,
+               (SpriteSize)p->size,
+               SpriteColorFormat_16Color,
+               oamGetGfxPtr(&oamMain, p->tile),
+               -1,      /* No affine transform */
+               false,   /* Not double-size */
+               false,   /* Not hidden */
+               (p->flags & SPR_PIECE_HFLIP) != 0,
+               (p->flags & SPR_PIECE_VFLIP) != 0,
+               false);  /* No mosaic */
+    }
+}
+
+/* Pack queued objects into OAM, band by band. Within a band objects keep
+ * submission order unless the band overflows, in which case placement
+ * starts at the band's rotation point and wraps. */
+static void commit_sprites(void) {
+    uint8_t order[OAM_OBJECT_MAX];
+    int band_start[SPR_PRIO_COUNT + 1];
+    int band_pieces[SPR_PRIO_COUNT];
+
+    /* Stable counting sort by priority */
+    memset(band_start, 0, sizeof(band_start));
+    memset(band_pieces, 0, sizeof(band_pieces));
+    for (int i = 0; i < oam_object_count; i++) {
+        band_start[oam_objects[i].prio + 1]++;
+        band_pieces[oam_objects[i].prio] += oam_objects[i].piece_count;
+    }
+    for (int b = 0; b < SPR_PRIO_COUNT; b++) {
+        band_start[b + 1] += band_start[b];
+    }
+    int fill[SPR_PRIO_COUNT];
+    memcpy(fill, band_start, sizeof(fill));
+    for (int i = 0; i < oam_object_count; i++) {
+        order[fill[oam_objects[i].prio]++] = (uint8_t)i;
+    }
+
+    int slot = 0;
+    oam_dropped_count = 0;
+
+    for (int b = 0; b < SPR_PRIO_COUNT; b++) {
+        int first = band_start[b];
+        int count = band_start[b + 1] - first;
+        if (count == 0) continue;
+
+        bool overflow = slot + band_pieces[b] > OAM_SPRITE_COUNT;
+        int start = overflow ? oam_rotate[b] % count : 0;
+        int placed = 0;
+
+        for (int k = 0; k < count; k++) {
+            OamObject* obj = &oam_objects[order[first + (start + k) % count]];
+            if (slot + obj->piece_count > OAM_SPRITE_COUNT) {
+                obj->slot = -1;
+                oam_dropped_count++;
+                continue;
+            }
+            place_object(obj, slot);
+            slot += obj->piece_count;
+            placed++;
+        }
+
+        if (overflow) oam_rotate[b] = (uint16_t)(oam_rotate[b] + placed);
+    }
+
+    oam_used_count = slot;
+    for (int i = 0; i < oam_object_count; i++) {
+        oam_committed_slot[i] = oam_objects[i].slot;
+    }
+    oam_committed_count = oam_object_count;
+}
+
+int graphics_get_sprite_slot(int handle) {
+    if (handle < 0 || handle >= oam_committed_count) return -1;
+    return oam_committed_slot[handle];
+}
+
+int graphics_get_oam_used(void) {
+    return oam_used_count;
+}
+
+int graphics_get_sprites_dropped(void) {
+    return oam_dropped_count;
 }
 
 /* ========================================================================
@@ -1,50 +1,434 @@
 /**
  * hud.c - HUD display (sub engine / bottom screen)
  *
- * Text-based HUD using sub engine console.
- * Displays: HP, missiles, supers, power bombs, game timer, room ID.
- * Uses ANSI escape codes for cursor positioning to avoid scroll.
+ * Tile-based HUD: an 8x8 glyph set built at init, three text rows on
+ * SUB_BG_LAYER_HUD and a 5x3 minimap window on SUB_BG_LAYER_MAP (both
+ * layers share tile base 1, see graphics_init). Nothing is formatted
+ * or written unless it changed:
+ *   - each numeric field remembers the value it shows and is skipped
+ *     while that value holds;
+ *   - every map entry goes through a shadow copy, so a field that does
+ *     change only queues the digits that differ (98 -> 97 is one entry);
+ *   - the minimap redraws only when Samus's screen or the explored set
+ *     changes.
+ * Entries reach VRAM through the graphics map patch queue. A write the
+ * queue refuses leaves the shadow untouched and is retried next frame.
  *
- * The console is initialized in main.c on sub BG3.
- * HUD writes to the top 3 rows each frame during gameplay.
+ * Minimap cells are 256x256px room screens. Explored screens are kept
+ * per (area, room) for the session, so revisiting a room shows what was
+ * already seen; a room counts as visited once any screen is explored.
  */
 
 #include "hud.h"
 #include "gameplay.h"
+#include "graphics.h"
 #include "player.h"
 #include "room.h"
-#include <stdio.h>
+#include "fixed_math.h"
+#include "sm_config.h"
+#include <string.h>
+
+/* ========================================================================
+ * Layout
+ * ======================================================================== */
+
+#define HUD_COLS          32      /* Map row stride (256px layer) */
+#define HUD_ROWS          3
+#define HUD_PALETTE       1       /* Sub BG palette slot */
+
+#define MINIMAP_COL       26
+#define MINIMAP_ROW       0
+#define MINIMAP_W         5
+#define MINIMAP_H         3
+
+#define HUD_MAP_AREAS       8     /* area_id 0-6 (Crateria..Ceres) */
+#define HUD_MAP_CELL_SHIFT  8     /* 256px screens */
+#define HUD_MAP_CELLS_W     (MAX_ROOM_WIDTH_PX  >> HUD_MAP_CELL_SHIFT)
+#define HUD_MAP_CELLS_H     (MAX_ROOM_HEIGHT_PX >> HUD_MAP_CELL_SHIFT)
+
+_Static_assert(HUD_MAP_CELLS_W * HUD_MAP_CELLS_H <= 8,
+               "explored screens are one byte per room");
+
+#define ENTRY_UNKNOWN     0xFFFF  /* Shadow: VRAM contents not known */
+
+/* Static text; '#' cells belong to fields */
+static const char* const row_text[HUD_ROWS] = {
+    "HP ####/#### M ###/###",
+    "S  ###/###  PB ###/###",
+    "TIME ##:##:## RM #:###",
+};
+
+typedef enum {
+    HF_HP = 0,
+    HF_HP_MAX,
+    HF_MISSILES,
+    HF_MISSILES_MAX,
+    HF_SUPERS,
+    HF_SUPERS_MAX,
+    HF_PBOMBS,
+    HF_PBOMBS_MAX,
+    HF_HOURS,
+    HF_MINUTES,
+    HF_SECONDS,
+    HF_AREA,
+    HF_ROOM,
+    HF_COUNT
+} HudFieldID;
+
+typedef struct {
+    uint8_t col, row;
+    uint8_t digits;
+    bool    zero_pad;
+} HudField;
+
+static const HudField fields[HF_COUNT] = {
+    [HF_HP]           = {  3, 0, 4, false },
+    [HF_HP_MAX]       = {  8, 0, 4, false },
+    [HF_MISSILES]     = { 15, 0, 3, false },
+    [HF_MISSILES_MAX] = { 19, 0, 3, false },
+    [HF_SUPERS]       = {  3, 1, 3, false },
+    [HF_SUPERS_MAX]   = {  7, 1, 3, false },
+    [HF_PBOMBS]       = { 15, 1, 3, false },
+    [HF_PBOMBS_MAX]   = { 19, 1, 3, false },
+    [HF_HOURS]        = {  5, 2, 2, false },
+    [HF_MINUTES]      = {  8, 2, 2, true  },
+    [HF_SECONDS]      = { 11, 2, 2, true  },
+    [HF_AREA]         = { 17, 2, 1, false },
+    [HF_ROOM]         = { 19, 2, 3, false },
+};
+
+/* ========================================================================
+ * Tiles
+ *
+ * Tile 0 is blank so untouched map entries stay transparent. Glyphs are
+ * 1bpp rows (bit 7 = leftmost pixel) expanded to 4bpp at init.
+ * ======================================================================== */
+
+static const char glyph_chars[] = "0123456789/:BEHIMPRST";
+
+#define GLYPH_COUNT        (sizeof(glyph_chars) - 1)
+#define TILE_GLYPH0        1
+#define TILE_MAP_SEEN      (TILE_GLYPH0 + GLYPH_COUNT)   /* Room screen, unexplored */
+#define TILE_MAP_EXPLORED  (TILE_MAP_SEEN + 1)
+#define TILE_MAP_SAMUS     (TILE_MAP_SEEN + 2)
+#define HUD_TILE_COUNT     (TILE_MAP_SEEN + 3)
+
+static const u8 glyph_rows[GLYPH_COUNT][8] = {
+    { 0x3C, 0x66, 0x6E, 0x76, 0x66, 0x66, 0x3C, 0x00 },  /* 0 */
+    { 0x18, 0x38, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x00 },  /* 1 */
+    { 0x3C, 0x66, 0x06, 0x0C, 0x30, 0x60, 0x7E, 0x00 },  /* 2 */
+    { 0x3C, 0x66, 0x06, 0x1C, 0x06, 0x66, 0x3C, 0x00 },  /* 3 */
+    { 0x0C, 0x1C, 0x3C, 0x6C, 0x7E, 0x0C, 0x0C, 0x00 },  /* 4 */
+    { 0x7E, 0x60, 0x7C, 0x06, 0x06, 0x66, 0x3C, 0x00 },  /* 5 */
+    { 0x3C, 0x66, 0x60, 0x7C, 0x66, 0x66, 0x3C, 0x00 },  /* 6 */
+    { 0x7E, 0x66, 0x0C, 0x18, 0x18, 0x18, 0x18, 0x00 },  /* 7 */
+    { 0x3C, 0x66, 0x66, 0x3C, 0x66, 0x66, 0x3C, 0x00 },  /* 8 */
+    { 0x3C, 0x66, 0x66, 0x3E, 0x06, 0x66, 0x3C, 0x00 },  /* 9 */
+    { 0x00, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x00, 0x00 },  /* / */
+    { 0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00 },  /* : */
+    { 0x7C, 0x66, 0x66, 0x7C, 0x66, 0x66, 0x7C, 0x00 },  /* B */
+    { 0x7E, 0x60, 0x60, 0x78, 0x60, 0x60, 0x7E, 0x00 },  /* E */
+    { 0x66, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x66, 0x00 },  /* H */
+    { 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00 },  /* I */
+    { 0x63, 0x77, 0x7F, 0x6B, 0x63, 0x63, 0x63, 0x00 },  /* M */
+    { 0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60, 0x60, 0x00 },  /* P */
+    { 0x7C, 0x66, 0x66, 0x7C, 0x78, 0x6C, 0x66, 0x00 },  /* R */
+    { 0x3C, 0x66, 0x60, 0x3C, 0x06, 0x66, 0x3C, 0x00 },  /* S */
+    { 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00 },  /* T */
+};
+
+static const u16 hud_palette[16] = {
+    RGB15(0, 0, 0),       /* 0: transparent */
+    RGB15(31, 31, 31),    /* 1: text */
+    RGB15(6, 8, 20),      /* 2: unexplored screen */
+    RGB15(24, 6, 20),     /* 3: explored screen */
+    RGB15(31, 31, 31),    /* 4: screen border */
+    RGB15(31, 20, 0),     /* 5: Samus */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* Upload source: main RAM, stays valid for the queued DMA */
+static u8 hud_tiles[HUD_TILE_COUNT * 32];
+
+static void set_pixel(u8* tile, int x, int y, int color) {
+    u8* b = &tile[y * 4 + (x >> 1)];
+    if (x & 1) *b = (u8)((*b & 0x0F) | (color << 4));
+    else       *b = (u8)((*b & 0xF0) | color);
+}
+
+static void build_tiles(void) {
+    memset(hud_tiles, 0, sizeof(hud_tiles));
+
+    for (int g = 0; g < (int)GLYPH_COUNT; g++) {
+        u8* tile = &hud_tiles[(TILE_GLYPH0 + g) * 32];
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 8; x++) {
+                if (glyph_rows[g][y] & (0x80 >> x)) set_pixel(tile, x, y, 1);
+            }
+        }
+    }
+
+    for (int t = TILE_MAP_SEEN; t <= TILE_MAP_SAMUS; t++) {
+        u8* tile = &hud_tiles[t * 32];
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 8; x++) {
+                bool edge = x == 0 || x == 7 || y == 0 || y == 7;
+                if (t == TILE_MAP_SEEN) {
+                    if (edge) set_pixel(tile, x, y, 2);
+                } else {
+                    set_pixel(tile, x, y, edge ? 4 : 3);
+                }
+            }
+        }
+    }
+    u8* samus = &hud_tiles[TILE_MAP_SAMUS * 32];
+    for (int y = 3; y <= 4; y++) {
+        for (int x = 3; x <= 4; x++) set_pixel(samus, x, y, 5);
+    }
+}
+
+static int char_tile(char c) {
+    for (int i = 0; i < (int)GLYPH_COUNT; i++) {
+        if (glyph_chars[i] == c) return TILE_GLYPH0 + i;
+    }
+    return 0;
+}
+
+/* ========================================================================
+ * State
+ * ======================================================================== */
+
+static u16     hud_shadow[HUD_ROWS * HUD_COLS];
+static u16     map_shadow[MINIMAP_H * MINIMAP_W];
+
+static bool    text_shown;
+static int32_t field_shown[HF_COUNT];       /* -1 = redraw */
+
+static uint8_t explored[HUD_MAP_AREAS][256];   /* Bit per screen, per room */
+
+typedef struct {
+    bool    valid;
+    uint8_t area, room;
+    uint8_t cx, cy;
+    uint8_t mask;
+} MinimapView;
+
+static MinimapView map_shown;
+
+static int last_writes;
+
+static void invalidate(void) {
+    text_shown = false;
+    for (int i = 0; i < HF_COUNT; i++) field_shown[i] = -1;
+    map_shown.valid = false;
+}
+
+/* ========================================================================
+ * Entry Writes
+ * ======================================================================== */
+
+static bool put_entry(int layer, u16* shadow, int map_offset, int tile) {
+    u16 entry = tile ? (u16)(tile | (HUD_PALETTE << 12)) : 0;
+    if (*shadow == entry) return true;
+    if (!graphics_queue_sub_bg_map_entry(layer, map_offset, entry)) return false;
+    *shadow = entry;
+    last_writes++;
+    return true;
+}
+
+static bool hud_put(int col, int row, int tile) {
+    return put_entry(SUB_BG_LAYER_HUD, &hud_shadow[row * HUD_COLS + col],
+                     row * HUD_COLS + col, tile);
+}
+
+static bool map_put(int x, int y, int tile) {
+    return put_entry(SUB_BG_LAYER_MAP, &map_shadow[y * MINIMAP_W + x],
+                     (MINIMAP_ROW + y) * HUD_COLS + MINIMAP_COL + x, tile);
+}
+
+/* ========================================================================
+ * Text Rows
+ * ======================================================================== */
+
+static bool draw_text(void) {
+    bool ok = true;
+    for (int row = 0; row < HUD_ROWS; row++) {
+        const char* s = row_text[row];
+        for (int col = 0; s[col]; col++) {
+            if (s[col] != '#') ok &= hud_put(col, row, char_tile(s[col]));
+        }
+    }
+    return ok;
+}
+
+static bool draw_field(int id, int32_t value) {
+    const HudField* f = &fields[id];
+
+    int32_t limit = 1;
+    for (int i = 0; i < f->digits; i++) limit *= 10;
+    if (value < 0) value = 0;
+    if (value >= limit) value = limit - 1;
+
+    /* Right to left; leading zeros blank unless zero_pad */
+    bool ok = true;
+    int32_t v = value;
+    for (int i = f->digits - 1; i >= 0; i--) {
+        bool blank = !f->zero_pad && v == 0 && i != f->digits - 1;
+        int tile = blank ? 0 : TILE_GLYPH0 + (int)(v % 10);
+        ok &= hud_put(f->col + i, f->row, tile);
+        v /= 10;
+    }
+    return ok;
+}
+
+static void render_fields(void) {
+    uint32_t total_secs = g_game_time_frames / 60;
+    int32_t values[HF_COUNT] = {
+        [HF_HP]           = g_player.hp,
+        [HF_HP_MAX]       = g_player.hp_max,
+        [HF_MISSILES]     = g_player.missiles,
+        [HF_MISSILES_MAX] = g_player.missiles_max,
+        [HF_SUPERS]       = g_player.supers,
+        [HF_SUPERS_MAX]   = g_player.supers_max,
+        [HF_PBOMBS]       = g_player.power_bombs,
+        [HF_PBOMBS_MAX]   = g_player.power_bombs_max,
+        [HF_HOURS]        = (int32_t)(total_secs / 3600),
+        [HF_MINUTES]      = (int32_t)((total_secs / 60) % 60),
+        [HF_SECONDS]      = (int32_t)(total_secs % 60),
+        [HF_AREA]         = g_current_room.area_id,
+        [HF_ROOM]         = g_current_room.room_id,
+    };
+
+    for (int i = 0; i < HF_COUNT; i++) {
+        if (values[i] == field_shown[i]) continue;
+        if (draw_field(i, values[i])) field_shown[i] = values[i];
+    }
+}
+
+/* ========================================================================
+ * Minimap
+ * ======================================================================== */
+
+static void room_cells(int* cells_w, int* cells_h) {
+    *cells_w = (g_current_room.width_tiles + 15) >> 4;
+    *cells_h = (g_current_room.height_tiles + 15) >> 4;
+}
+
+static int clamp_cell(int c, int count) {
+    if (c < 0) return 0;
+    if (c >= count) return count - 1;
+    return c;
+}
+
+static void samus_cell(int* cx, int* cy) {
+    int cells_w, cells_h;
+    room_cells(&cells_w, &cells_h);
+    *cx = clamp_cell(FX_TO_INT(g_player.body.pos.x) >> HUD_MAP_CELL_SHIFT, cells_w);
+    *cy = clamp_cell(FX_TO_INT(g_player.body.pos.y) >> HUD_MAP_CELL_SHIFT, cells_h);
+}
+
+static void render_minimap(void) {
+    int area = g_current_room.area_id;
+    int room = g_current_room.room_id;
+    if (!g_current_room.loaded || area >= HUD_MAP_AREAS) return;
+
+    int cx, cy;
+    samus_cell(&cx, &cy);
+    uint8_t mask = explored[area][room];
+
+    if (map_shown.valid && map_shown.area == area && map_shown.room == room &&
+        map_shown.cx == cx && map_shown.cy == cy && map_shown.mask == mask) {
+        return;
+    }
+
+    int cells_w, cells_h;
+    room_cells(&cells_w, &cells_h);
+
+    /* Samus's screen sits in the middle of the window */
+    bool ok = true;
+    for (int y = 0; y < MINIMAP_H; y++) {
+        for (int x = 0; x < MINIMAP_W; x++) {
+            int mx = cx + x - MINIMAP_W / 2;
+            int my = cy + y - MINIMAP_H / 2;
+            int tile = 0;
+            if (mx >= 0 && mx < cells_w && my >= 0 && my < cells_h) {
+                if (mx == cx && my == cy) {
+                    tile = TILE_MAP_SAMUS;
+                } else if (mask & (1 << (my * HUD_MAP_CELLS_W + mx))) {
+                    tile = TILE_MAP_EXPLORED;
+                } else {
+                    tile = TILE_MAP_SEEN;
+                }
+            }
+            ok &= map_put(x, y, tile);
+        }
+    }
+    if (!ok) return;
+
+    map_shown.valid = true;
+    map_shown.area = (uint8_t)area;
+    map_shown.room = (uint8_t)room;
+    map_shown.cx = (uint8_t)cx;
+    map_shown.cy = (uint8_t)cy;
+    map_shown.mask = mask;
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
 
 void hud_init(void) {
-    /* Console already initialized in main.c */
+    build_tiles();
+    graphics_load_sub_bg_tiles(SUB_BG_LAYER_HUD, hud_tiles, sizeof(hud_tiles), 0);
+    graphics_load_sub_bg_palette(HUD_PALETTE, hud_palette);
+
+    /* Whatever is in VRAM now gets overwritten on the first render */
+    for (int i = 0; i < HUD_ROWS * HUD_COLS; i++) hud_shadow[i] = ENTRY_UNKNOWN;
+    for (int i = 0; i < MINIMAP_H * MINIMAP_W; i++) map_shadow[i] = ENTRY_UNKNOWN;
+    invalidate();
+    hud_reset_map();
+    last_writes = 0;
 }
 
 void hud_update(void) {
-    /* Values read directly from g_player in render */
+    int area = g_current_room.area_id;
+    if (!g_current_room.loaded || area >= HUD_MAP_AREAS) return;
+
+    int cx, cy;
+    samus_cell(&cx, &cy);
+    explored[area][g_current_room.room_id] |=
+        (uint8_t)(1 << (cy * HUD_MAP_CELLS_W + cx));
 }
 
 void hud_render(void) {
-    /* Each line padded to 32 chars to clear stale console text */
+    last_writes = 0;
 
-    /* Row 0: HP and missiles */
-    iprintf("\x1b[0;0H");
-    iprintf("HP:%4d/%-4d M:%3d/%-3d      ",
-            g_player.hp, g_player.hp_max,
-            g_player.missiles, g_player.missiles_max);
+    if (!text_shown) text_shown = draw_text();
+    render_fields();
+    render_minimap();
+}
 
-    /* Row 1: supers and power bombs */
-    iprintf("\x1b[1;0H");
-    iprintf("S: %3d/%-3d PB:%3d/%-3d      ",
-            g_player.supers, g_player.supers_max,
-            g_player.power_bombs, g_player.power_bombs_max);
+void hud_hide(void) {
+    for (int row = 0; row < HUD_ROWS; row++) {
+        for (int col = 0; col < HUD_COLS; col++) hud_put(col, row, 0);
+    }
+    for (int y = 0; y < MINIMAP_H; y++) {
+        for (int x = 0; x < MINIMAP_W; x++) map_put(x, y, 0);
+    }
+    invalidate();
+}
 
-    /* Row 2: game timer and room ID */
-    uint32_t total_secs = g_game_time_frames / 60;
-    uint32_t hours = total_secs / 3600;
-    uint32_t mins  = (total_secs / 60) % 60;
-    uint32_t secs  = total_secs % 60;
-    iprintf("\x1b[2;0H");
-    iprintf("TIME:%d:%02d:%02d  RM:%d:%d          ",
-            (int)hours, (int)mins, (int)secs,
-            g_current_room.area_id, g_current_room.room_id);
+void hud_reset_map(void) {
+    memset(explored, 0, sizeof(explored));
+    map_shown.valid = false;
+}
+
+bool hud_room_visited(int area_id, int room_id) {
+    if (area_id < 0 || area_id >= HUD_MAP_AREAS) return false;
+    if (room_id < 0 || room_id > 255) return false;
+    return explored[area_id][room_id] != 0;
+}
+
+int hud_get_last_writes(void) {
+    return last_writes;
 }
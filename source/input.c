@@ -7,9 +7,16 @@
  *
  * NOTE: The caller (main loop) must call scanKeys() BEFORE input_update().
  * This module does NOT call scanKeys() itself.
+ *
+ * Replay buffer is a static array of (keys, frames) runs. Held keys only
+ * change a few times a second, so a minute of play is usually well under
+ * a thousand runs.
  */
 
 #include "input.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
 
 /* Circular buffer storing pressed keys for each of the last 8 frames */
 static uint32_t press_buffer[INPUT_BUFFER_FRAMES];
@@ -23,11 +30,187 @@ static uint32_t cur_pressed;
 static uint32_t cur_held;
 static uint32_t cur_released;
 
+/* Replay state */
+static ReplayRun  replay_runs[REPLAY_MAX_RUNS];
+static uint32_t   replay_run_count;
+static uint32_t   replay_frames;       /* Total frames in buffer */
+static ReplayMode replay_mode;
+static bool       replay_start_pending;
+static uint32_t   replay_pos;          /* Frames recorded or played */
+static uint32_t   replay_run;          /* Playback: current run */
+static uint16_t   replay_run_frame;    /* Playback: frames into current run */
+
+/* ========================================================================
+ * Replay Record / Playback
+ * ======================================================================== */
+
+/* Clear edge and hold history so live and replayed sessions start alike */
+static void reset_history(void) {
+    memset(press_buffer, 0, sizeof(press_buffer));
+    memset(hold_duration, 0, sizeof(hold_duration));
+    buffer_index = 0;
+    cur_pressed = 0;
+    cur_held = 0;
+    cur_released = 0;
+}
+
+static void replay_record_frame(uint16_t keys) {
+    if (replay_run_count > 0) {
+        ReplayRun* r = &replay_runs[replay_run_count - 1];
+        if (r->keys == keys && r->frames < 0xFFFF) {
+            r->frames++;
+            replay_frames++;
+            replay_pos++;
+            return;
+        }
+    }
+    if (replay_run_count >= REPLAY_MAX_RUNS) {
+        LOG_WARN("replay: buffer full at frame %lu\n",
+                 (unsigned long)replay_pos);
+        replay_mode = REPLAY_OFF;
+        return;
+    }
+    replay_runs[replay_run_count].keys = keys;
+    replay_runs[replay_run_count].frames = 1;
+    replay_run_count++;
+    replay_frames++;
+    replay_pos++;
+}
+
+static uint32_t replay_play_frame(void) {
+    if (replay_run >= replay_run_count) {
+        replay_mode = REPLAY_FINISHED;
+        return keysHeld();
+    }
+    ReplayRun* r = &replay_runs[replay_run];
+    uint32_t keys = r->keys;
+    if (++replay_run_frame >= r->frames) {
+        replay_run++;
+        replay_run_frame = 0;
+    }
+    replay_pos++;
+    return keys;
+}
+
+void input_replay_record(void) {
+    replay_run_count = 0;
+    replay_frames = 0;
+    replay_pos = 0;
+    replay_mode = REPLAY_RECORDING;
+    replay_start_pending = true;
+}
+
+bool input_replay_play(void) {
+    if (replay_run_count == 0) return false;
+    replay_pos = 0;
+    replay_run = 0;
+    replay_run_frame = 0;
+    replay_mode = REPLAY_PLAYING;
+    replay_start_pending = true;
+    return true;
+}
+
+void input_replay_stop(void) {
+    replay_mode = REPLAY_OFF;
+    replay_start_pending = false;
+}
+
+bool input_replay_save(const char* path) {
+    if (replay_run_count == 0) return false;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    ReplayHeader hdr = {
+        .magic = REPLAY_MAGIC,
+        .version = REPLAY_VERSION,
+        .reserved = 0,
+        .frame_count = replay_frames,
+        .run_count = replay_run_count,
+    };
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              fwrite(replay_runs, sizeof(ReplayRun), replay_run_count, f)
+                  == replay_run_count;
+    fclose(f);
+    return ok;
+}
+
+bool input_replay_load(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    ReplayHeader hdr;
+    bool ok = fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+              hdr.magic == REPLAY_MAGIC &&
+              hdr.version == REPLAY_VERSION &&
+              hdr.run_count > 0 && hdr.run_count <= REPLAY_MAX_RUNS &&
+              fread(replay_runs, sizeof(ReplayRun), hdr.run_count, f)
+                  == hdr.run_count;
+    fclose(f);
+
+    if (!ok) {
+        replay_run_count = 0;
+        replay_frames = 0;
+        return false;
+    }
+
+    /* Trust the runs, not the header's frame total */
+    replay_run_count = hdr.run_count;
+    replay_frames = 0;
+    for (uint32_t i = 0; i < replay_run_count; i++) {
+        replay_frames += replay_runs[i].frames;
+    }
+    replay_mode = REPLAY_OFF;
+    return true;
+}
+
+ReplayMode input_replay_mode(void) {
+    return replay_mode;
+}
+
+uint32_t input_replay_frame(void) {
+    return replay_pos;
+}
+
+uint32_t input_replay_length(void) {
+    return replay_frames;
+}
+
+bool input_replay_seek(uint32_t frame) {
+    if (replay_mode != REPLAY_PLAYING || frame > replay_frames) return false;
+
+    replay_run = 0;
+    replay_pos = frame;
+    while (replay_run < replay_run_count && frame >= replay_runs[replay_run].frames) {
+        frame -= replay_runs[replay_run].frames;
+        replay_run++;
+    }
+    replay_run_frame = (uint16_t)frame;
+    replay_start_pending = false;
+    return true;
+}
+
+/* ========================================================================
+ * Per-Frame Update
+ * ======================================================================== */
+
 void input_update(void) {
-    /* Read current frame state from libnds (scanKeys already called) */
-    cur_pressed  = keysDown();
-    cur_held     = keysHeld();
-    cur_released = keysUp();
+    if (replay_start_pending) {
+        reset_history();
+        replay_start_pending = false;
+    }
+
+    /* Held state comes from libnds (scanKeys already called) or the
+     * replay buffer; edges are derived from the previous held state. */
+    uint32_t prev_held = cur_held;
+    uint32_t held = (replay_mode == REPLAY_PLAYING) ? replay_play_frame()
+                                                    : keysHeld();
+    held &= 0xFFFF;
+    if (replay_mode == REPLAY_RECORDING) replay_record_frame((uint16_t)held);
+
+    cur_held     = held;
+    cur_pressed  = held & ~prev_held;
+    cur_released = prev_held & ~held;
 
     /* Store pressed keys in circular buffer */
     press_buffer[buffer_index] = cur_pressed;
@@ -76,3 +259,26 @@ int input_held_frames(int key) {
     }
     return 0;
 }
+
+/* ========================================================================
+ * Snapshot
+ * ======================================================================== */
+
+void input_snapshot_save(SnapshotWriter* w) {
+    snapshot_write(w, press_buffer, sizeof(press_buffer));
+    snapshot_write(w, &buffer_index, sizeof(buffer_index));
+    snapshot_write(w, hold_duration, sizeof(hold_duration));
+    snapshot_write(w, &cur_pressed, sizeof(cur_pressed));
+    snapshot_write(w, &cur_held, sizeof(cur_held));
+    snapshot_write(w, &cur_released, sizeof(cur_released));
+}
+
+void input_snapshot_load(SnapshotReader* r) {
+    snapshot_read(r, press_buffer, sizeof(press_buffer));
+    snapshot_read(r, &buffer_index, sizeof(buffer_index));
+    snapshot_read(r, hold_duration, sizeof(hold_duration));
+    snapshot_read(r, &cur_pressed, sizeof(cur_pressed));
+    snapshot_read(r, &cur_held, sizeof(cur_held));
+    snapshot_read(r, &cur_released, sizeof(cur_released));
+    if (buffer_index < 0 || buffer_index >= INPUT_BUFFER_FRAMES) r->ok = false;
+}
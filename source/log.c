@@ -0,0 +1,133 @@
+/**
+ * log.c - Leveled debug logging into a RAM ring
+ *
+ * log_write() formats into a stack line and copies it into a byte ring
+ * of LOG_RING_SIZE; a message that doesn't fit whole is dropped, so the
+ * ring only ever holds complete lines. log_drain() hands contiguous runs
+ * of the ring to stderr and the log file, reporting drops first.
+ */
+
+#include "log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+_Static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0,
+               "LOG_RING_SIZE must be a power of two");
+
+/* ========================================================================
+ * State
+ * ======================================================================== */
+
+static char     ring[LOG_RING_SIZE];
+static uint32_t ring_head;          /* Total bytes written */
+static uint32_t ring_tail;          /* Total bytes consumed */
+static uint32_t dropped;
+static FILE*    log_file;
+
+#define RING_MASK  (LOG_RING_SIZE - 1)
+
+/* ========================================================================
+ * Ring
+ * ======================================================================== */
+
+static void ring_put(const char* src, uint32_t len) {
+    uint32_t at = ring_head & RING_MASK;
+    uint32_t first = LOG_RING_SIZE - at;
+    if (first > len) first = len;
+    memcpy(ring + at, src, first);
+    memcpy(ring, src + first, len - first);
+    ring_head += len;
+}
+
+/* Longest run of pending bytes that is contiguous in the ring */
+static uint32_t ring_run(void) {
+    uint32_t pending = ring_head - ring_tail;
+    uint32_t to_end = LOG_RING_SIZE - (ring_tail & RING_MASK);
+    return pending < to_end ? pending : to_end;
+}
+
+void log_write(const char* fmt, ...) {
+    char line[LOG_LINE_MAX];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    if (n >= (int)sizeof(line)) n = sizeof(line) - 1;
+
+    if ((uint32_t)n > LOG_RING_SIZE - (ring_head - ring_tail)) {
+        dropped++;
+        return;
+    }
+    ring_put(line, (uint32_t)n);
+}
+
+/* ========================================================================
+ * Sinks
+ * ======================================================================== */
+
+void log_init(void) {
+    ring_head = ring_tail = 0;
+    dropped = 0;
+}
+
+bool log_mount(const char* path) {
+    log_unmount();
+    log_file = fopen(path, "w");
+    return log_file != NULL;
+}
+
+void log_unmount(void) {
+    if (log_file) fclose(log_file);
+    log_file = NULL;
+}
+
+static void sink_write(const char* src, uint32_t len) {
+    fwrite(src, 1, len, stderr);
+    if (log_file) fwrite(src, 1, len, log_file);
+}
+
+void log_drain(int max_bytes) {
+    if (dropped) {
+        char note[40];
+        int n = snprintf(note, sizeof(note), "log: %lu dropped\n",
+                         (unsigned long)dropped);
+        sink_write(note, (uint32_t)n);
+        dropped = 0;
+    }
+
+    while (max_bytes > 0 && ring_head != ring_tail) {
+        uint32_t run = ring_run();
+        if (run > (uint32_t)max_bytes) run = (uint32_t)max_bytes;
+        sink_write(ring + (ring_tail & RING_MASK), run);
+        ring_tail += run;
+        max_bytes -= (int)run;
+    }
+}
+
+void log_flush(void) {
+    log_drain(LOG_RING_SIZE);
+    fflush(stderr);
+    if (log_file) fflush(log_file);
+}
+
+int log_read(char* dst, int max) {
+    int copied = 0;
+    while (copied < max && ring_head != ring_tail) {
+        uint32_t run = ring_run();
+        if (run > (uint32_t)(max - copied)) run = (uint32_t)(max - copied);
+        memcpy(dst + copied, ring + (ring_tail & RING_MASK), run);
+        ring_tail += run;
+        copied += (int)run;
+    }
+    return copied;
+}
+
+int log_pending(void) {
+    return (int)(ring_head - ring_tail);
+}
+
+uint32_t log_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,88 @@
+/**
+ * lz.c - LC_LZ2 decompressor
+ *
+ * Runs are expanded with block operations: literals and non-overlapping
+ * back references are memcpy, byte fills memset, word fills a 16-bit
+ * store loop. Only back references that overlap their own output (the
+ * LZ repeat idiom) fall back to a byte loop. Every read and write is
+ * bounds-checked, so a corrupt asset fails the load instead of
+ * scribbling over RAM.
+ */
+
+#include "lz.h"
+#include <string.h>
+
+int lz_decompress(const void* src, uint32_t src_size, void* dst, uint32_t dst_size) {
+    const u8* in = (const u8*)src;
+    const u8* in_end = in + src_size;
+    u8* out = (u8*)dst;
+    uint32_t pos = 0;
+
+    while (in < in_end) {
+        u8 cmd_byte = *in++;
+        if (cmd_byte == 0xFF) return (int)pos;
+
+        uint32_t command = cmd_byte >> 5;
+        uint32_t length = (cmd_byte & 0x1F) + 1;
+        if (command == 7) {
+            if (in >= in_end) return -1;
+            command = (cmd_byte >> 2) & 0x07;
+            length = (((uint32_t)(cmd_byte & 0x03) << 8) | *in++) + 1;
+        }
+        if (length > dst_size - pos) return -1;
+
+        switch (command) {
+            case 0:     /* Literal copy */
+                if (length > (uint32_t)(in_end - in)) return -1;
+                memcpy(out + pos, in, length);
+                in += length;
+                break;
+
+            case 1:     /* Byte fill */
+                if (in >= in_end) return -1;
+                memset(out + pos, *in++, length);
+                break;
+
+            case 2: {   /* Word fill: a, b, a, b, ... */
+                if (in_end - in < 2) return -1;
+                u8 a = in[0], b = in[1];
+                in += 2;
+                u8* p = out + pos;
+                uint32_t i = 0;
+                if (((uintptr_t)p & 1) == 0) {
+                    u16 pair = (u16)(a | (b << 8));   /* Little-endian */
+                    for (; i + 1 < length; i += 2) *(u16*)(p + i) = pair;
+                }
+                for (; i < length; i++) p[i] = (i & 1) ? b : a;
+                break;
+            }
+
+            case 3: {   /* Increasing fill */
+                if (in >= in_end) return -1;
+                u8 v = *in++;
+                u8* p = out + pos;
+                for (uint32_t i = 0; i < length; i++) p[i] = (u8)(v + i);
+                break;
+            }
+
+            case 4: {   /* Back reference into the output so far */
+                if (in_end - in < 2) return -1;
+                uint32_t ref = in[0] | ((uint32_t)in[1] << 8);
+                in += 2;
+                if (ref >= pos) return -1;
+                if (ref + length <= pos) {
+                    memcpy(out + pos, out + ref, length);
+                } else {
+                    /* Overlaps its output: each byte may be one just written */
+                    for (uint32_t i = 0; i < length; i++) out[pos + i] = out[ref + i];
+                }
+                break;
+            }
+
+            default:
+                return -1;
+        }
+        pos += length;
+    }
+    return -1;  /* No end marker */
+}
@@ -9,6 +9,7 @@
  */
 
 #include <nds.h>
+#include <filesystem.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -21,18 +22,29 @@
 #include "fixed_math.h"
 #include "input.h"
 #include "graphics.h"
+#include "tile_anim.h"
 #include "room.h"
+#include "room_pack.h"
+#include "lz.h"
+#include "coproc.h"
 #include "physics.h"
 #include "player.h"
 #include "enemy.h"
 #include "projectile.h"
 #include "boss.h"
+#include "boss_vm.h"
+#include "broadphase.h"
 #include "camera.h"
 #include "audio.h"
 #include "save.h"
 #include "state.h"
 #include "hud.h"
 #include "gameplay.h"
+#include "snapshot.h"
+#include "profiler.h"
+#include "pacing.h"
+#include "bench.h"
+#include "log.h"
 
 #ifdef DEBUG_TESTS
 
@@ -87,6 +99,16 @@ static void run_fixed_math_tests(void) {
 
     fx32 sqrt4 = fx_sqrt(INT_TO_FX(4));
     test("sqrt(4)~=2", fx_abs(sqrt4 - INT_TO_FX(2)) <= 1);
+    test("sqrt(0.25)=0.5", fx_sqrt(FX_ONE / 4) == FX_HALF);
+    test("sqrt(2)", fx_sqrt(INT_TO_FX(2)) == 0x16A09);
+    test("sqrt(max)", fx_sqrt(0x7FFFFFFF) == 0xB504F3);
+    test("sqrt(neg)=0", fx_sqrt(-FX_ONE) == 0);
+    test("length 3,4", fx_length(INT_TO_FX(3), INT_TO_FX(-4)) == INT_TO_FX(5));
+
+    fx_div_start(INT_TO_FX(7), INT_TO_FX(2));
+    fx_sqrt_start(INT_TO_FX(9));
+    test("div async", fx_div_result() == INT_TO_FX(7) / 2);
+    test("sqrt async", fx_sqrt_result() == INT_TO_FX(3));
 
     test("from_snes", fx_from_snes(5, 0x8000) == 0x58000);
 
@@ -118,6 +140,48 @@ static void run_fixed_math_tests(void) {
  * M7: Room / Collision Tests
  * ======================================================================== */
 
+/* Load every room of the pack at path, then its built-in definition,
+ * and compare. Leaves the pack at path mounted. */
+static bool pack_matches_builtin(const char* path) {
+    static RoomData packed;
+    bool same = room_pack_mount(path);
+    for (uint8_t r = 0; r < 4 && same; r++) {
+        same = room_pack_has(0, r) && room_load(0, r);
+        memcpy(&packed, &g_current_room, sizeof(RoomData));
+        room_pack_unmount();
+        same = same && room_load(0, r);
+        room_pack_mount(path);
+        same = same &&
+            packed.width_tiles == g_current_room.width_tiles &&
+            packed.height_tiles == g_current_room.height_tiles &&
+            packed.tileset_id == g_current_room.tileset_id &&
+            packed.door_count == g_current_room.door_count &&
+            packed.spawn_count == g_current_room.spawn_count &&
+            packed.item_count == g_current_room.item_count &&
+            memcmp(packed.collision, g_current_room.collision, sizeof(packed.collision)) == 0 &&
+            memcmp(packed.bts, g_current_room.bts, sizeof(packed.bts)) == 0 &&
+            memcmp(packed.tilemap, g_current_room.tilemap, sizeof(packed.tilemap)) == 0 &&
+            memcmp(packed.doors, g_current_room.doors,
+                   packed.door_count * sizeof(DoorData)) == 0 &&
+            memcmp(packed.spawns, g_current_room.spawns,
+                   packed.spawn_count * sizeof(EnemySpawnData)) == 0 &&
+            memcmp(packed.items, g_current_room.items,
+                   packed.item_count * sizeof(ItemData)) == 0;
+    }
+    return same;
+}
+
+/* True if 8x8 map column tx of the level BG holds entry in its first
+ * rows * 2 tile rows (the 64x64 map is four 32x32 blocks) */
+static bool bg_column_is(int tx, int rows, u16 entry) {
+    const u16* map = bgGetMapPtr(0);
+    for (int ty = 0; ty < rows * 2; ty++) {
+        int block = (tx >= 32 ? 1 : 0) + (ty >= 32 ? 2 : 0);
+        if (map[block * 1024 + (ty & 31) * 32 + (tx & 31)] != entry) return false;
+    }
+    return true;
+}
+
 static void run_room_tests(void) {
     iprintf("--- Room Tests ---\n");
     int pre_passed = tests_passed;
@@ -152,6 +216,16 @@ static void run_room_tests(void) {
     test("oob(0,-1)=solid", room_get_collision(0, -1) == COLL_SOLID);
     test("oob(0,12)=solid", room_get_collision(0, 12) == COLL_SOLID);
 
+    /* Packed solid bitmap + span queries */
+    test("bit_floor", room_is_solid(5, 10));
+    test("bit_air", !room_is_solid(5, 3));
+    test("bit_oob", room_is_solid(-1, 3) && room_is_solid(16, 3));
+    test("row_span_air", !room_row_has_solid(1, 14, 3));
+    test("row_span_wall", room_row_has_solid(0, 3, 3));
+    test("row_span_oob", room_row_has_solid(14, 16, 3));
+    test("col_span_air", !room_col_has_solid(2, 1, 9));
+    test("col_span_floor", room_col_has_solid(5, 8, 10));
+
     /* BTS queries */
     test("bts(5,3)=0", room_get_bts(5, 3) == 0);
     test("bts_oob(-1,0)=0", room_get_bts(-1, 0) == 0);
@@ -205,6 +279,186 @@ static void run_room_tests(void) {
     test_body.pos.y = INT_TO_FX(80);
     test("no_door_center", room_check_door_collision(&test_body) == NULL);
 
+    /* Dirty-tile queue: breaking a block queues one redraw */
+    room_load(0, 1);
+    test("dirty_clean_on_load", room_get_dirty_tile_count() == 0);
+    room_set_collision(20, 8, COLL_AIR);
+    test("dirty_break_tile=0", g_current_room.tilemap[8 * 32 + 20] == 0);
+    test("break_clears_bit", !room_is_solid(20, 8) &&
+                             !room_col_has_solid(20, 8, 8));
+    test("dirty_queued", room_get_dirty_tile_count() == 1);
+    room_set_collision(20, 8, COLL_AIR);
+    test("dirty_dedup", room_get_dirty_tile_count() == 1);
+    room_flush_dirty_tiles();
+    test("dirty_flushed", room_get_dirty_tile_count() == 0);
+
+    /* Crumble blocks: active list, breaks after CRUMBLE_DELAY_FRAMES */
+    test("crumble_none", g_current_room.crumble_count == 0);
+    room_start_crumble(3, 5);
+    room_start_crumble(3, 5);
+    room_start_crumble(8, 5);  /* plain air: ignored */
+    test("crumble_started", g_current_room.crumble_count == 1);
+    for (int f = 0; f < CRUMBLE_DELAY_FRAMES - 1; f++) {
+        room_update_crumble_blocks();
+    }
+    test("crumble_holding", room_get_collision(3, 5) == COLL_SPECIAL_CRUMBLE);
+    room_update_crumble_blocks();
+    test("crumble_broken", room_get_collision(3, 5) == COLL_AIR);
+    test("crumble_bit_clear", !room_is_solid(3, 5));
+    test("crumble_removed", g_current_room.crumble_count == 0);
+    room_flush_dirty_tiles();
+
+    /* Scroll streaming: a room that fits the 32x32 window never moves it */
+    int org_x = -1, org_y = -1;
+    room_stream_update(g_current_room.scroll_max_x, g_current_room.scroll_max_y);
+    room_stream_get_origin(&org_x, &org_y);
+    test("stream_fit_origin", org_x == 0 && org_y == 0);
+
+    /* Scroll streaming across a 64-metatile room: metatile 2 in column 1
+     * (resident) and columns 32-34, 43 and 44 (streamed in), 0 elsewhere */
+    room_load(0, 1);
+    {
+        RoomData* r = &g_current_room;
+        const int w = 64, h = 12;
+        r->width_tiles = w;
+        r->height_tiles = h;
+        memset(r->tilemap, 0, sizeof(r->tilemap));
+        for (int my = 0; my < h; my++) {
+            r->tilemap[my * w + 1] = 2;
+            r->tilemap[my * w + 32] = 2;
+            r->tilemap[my * w + 33] = 2;
+            r->tilemap[my * w + 34] = 2;
+            r->tilemap[my * w + 43] = 2;
+            r->tilemap[my * w + 44] = 2;
+        }
+        room_upload_to_vram();
+        graphics_flush_uploads();
+        graphics_vblank();
+        bool built = bg_column_is(2, h, 2) && bg_column_is(0, h, 0);
+
+        /* Camera inside the left margin: window stays at 0 */
+        room_stream_update(8 * TILE_SIZE, 0);
+        room_stream_get_origin(&org_x, &org_y);
+        test("stream_margin_hold", built && org_x == 0 && org_y == 0);
+
+        /* One metatile right: column 32 lands in map columns 0-1 */
+        room_stream_update(9 * TILE_SIZE, 0);
+        room_stream_get_origin(&org_x, &org_y);
+        graphics_vblank();
+        test("stream_step_1", org_x == 1 && org_y == 0 &&
+                              bg_column_is(0, h, 2) && bg_column_is(1, h, 2) &&
+                              bg_column_is(2, h, 2));
+
+        /* STREAM_MAX_STEP (2) still streams: columns 33-34 -> map 2-5 */
+        room_stream_update(11 * TILE_SIZE, 0);
+        room_stream_get_origin(&org_x, &org_y);
+        graphics_vblank();
+        test("stream_step_max", org_x == 3 &&
+                                bg_column_is(2, h, 2) && bg_column_is(5, h, 2) &&
+                                bg_column_is(6, h, 0));
+
+        /* Larger jump rebuilds the window at the new origin (12..43) */
+        room_stream_update(20 * TILE_SIZE, 0);
+        room_stream_get_origin(&org_x, &org_y);
+        graphics_flush_uploads();
+        graphics_vblank();
+        test("stream_jump_rebuild", org_x == 12 &&
+                                    bg_column_is(0, h, 2) && bg_column_is(5, h, 2) &&
+                                    bg_column_is(22, h, 2) && bg_column_is(24, h, 0));
+
+        /* Back left by one: column 11 overwrites map 22-23 (was 43) */
+        room_stream_update(19 * TILE_SIZE, 0);
+        room_stream_get_origin(&org_x, &org_y);
+        graphics_vblank();
+        test("stream_step_left", org_x == 11 && bg_column_is(22, h, 0));
+
+        /* Origin clamps at the room's right edge and at the top; the
+         * vertical margin (10 rows) can't move it in a 12-row room */
+        room_stream_update(60 * TILE_SIZE, 11 * TILE_SIZE);
+        room_stream_get_origin(&org_x, &org_y);
+        graphics_flush_uploads();
+        graphics_vblank();
+        test("stream_clamp", org_x == w - 32 && org_y == 0 &&
+                             bg_column_is((43 * 2) & 63, h, 2) &&
+                             bg_column_is((44 * 2) & 63, h, 2));
+    }
+
+    /* Prefetch: staged build in the second buffer, live room untouched */
+    room_load(0, 0);
+    room_cache_clear();
+    {
+        bool ok = room_prefetch(0, 1);
+        room_prefetch_update();
+        test("prefetch_staged", ok && !room_prefetch_ready(0, 1));
+        room_prefetch_update();     /* Parse the record the job expanded */
+        room_prefetch_update();
+        room_prefetch_update();
+        test("prefetch_ready", room_prefetch_ready(0, 1));
+        test("prefetch_live_intact",
+             g_current_room.room_id == 0 && g_current_room.width_tiles == 16 &&
+             room_is_solid(5, 6) && !room_is_solid(5, 5));
+
+        graphics_flush_uploads();
+        bool loaded = room_load(0, 1);
+        test("prefetch_commit",
+             loaded && g_current_room.room_id == 1 &&
+             g_current_room.width_tiles == 32 && !room_prefetch_ready(0, 1) &&
+             graphics_get_pending_upload_bytes() > 0);
+        test("prefetch_missing", !room_prefetch(9, 9));
+
+        /* Door lookahead finds room (0,1)'s right door from 64px away */
+        PhysicsBody b = { 0 };
+        b.pos.x = INT_TO_FX(31 * TILE_SIZE - 64);
+        b.pos.y = INT_TO_FX(8 * TILE_SIZE);
+        const DoorData* d = room_find_door_near(&b, DOOR_PREFETCH_MARGIN_PX);
+        b.pos.x -= INT_TO_FX(2);
+        test("prefetch_door_near",
+             d && d->dest_room == 2 &&
+             !room_find_door_near(&b, DOOR_PREFETCH_MARGIN_PX));
+    }
+
+    /* Room cache: a room left behind comes back as it was left */
+    room_cache_clear();
+    room_load(0, 1);
+    room_set_collision(20, 8, COLL_AIR);
+    g_current_room.items[0].collected = true;
+    room_load(0, 2);
+    test("cache_stored", room_cache_has(0, 1) && room_cache_count() == 1);
+    room_load(0, 1);
+    test("cache_restored",
+         room_get_collision(20, 8) == COLL_AIR && !room_is_solid(20, 8) &&
+         g_current_room.items[0].collected && g_current_room.width_tiles == 32);
+    room_load(0, 1);
+    test("cache_reload_fresh",
+         room_get_collision(20, 8) != COLL_AIR && !g_current_room.items[0].collected &&
+         !room_cache_has(0, 1));
+
+    /* Least recently used room is evicted first; a fetch counts as use */
+    room_cache_clear();
+    room_load(0, 2);
+    room_load(0, 3);
+    room_load(0, 0);
+    room_load(0, 1);
+    room_load(0, 0);
+    test("cache_lru_evict",
+         room_cache_count() <= room_cache_capacity() &&
+         room_cache_has(0, 1) && room_cache_has(0, 3) &&
+         (room_cache_capacity() >= 4 || !room_cache_has(0, 2)));
+    room_cache_clear();
+    test("cache_clear", room_cache_count() == 0);
+
+    /* Room pack: every packed room matches its built-in definition */
+    test("pack_mounted", room_pack_mounted() && room_pack_room_count() == 4);
+    test("pack_matches_builtin", pack_matches_builtin(ROOM_PACK_PATH));
+#ifdef ROOM_PACK_RAW_PATH
+    /* Uncompressed records take the direct-fread path */
+    test("pack_raw_matches_builtin", pack_matches_builtin(ROOM_PACK_RAW_PATH));
+    room_pack_mount(ROOM_PACK_PATH);
+#endif
+    test("pack_missing_room", !room_pack_has(9, 9) && !room_pack_read(9, 9, &g_current_room));
+    test("pack_bad_path", !room_pack_mount("no_such_pack.bin") && !room_pack_mounted());
+    room_pack_mount(ROOM_PACK_PATH);
+
     /* Restore room (0,0) for subsequent tests */
     room_load(0, 0);
 
@@ -279,7 +533,7 @@ static void run_physics_tests(void) {
     {
         PhysicsBody b;
         memset(&b, 0, sizeof(b));
-        b.pos.x = INT_TO_FX(128);
+        b.pos.x = INT_TO_FX(32);  /* Clear of the mid-room platform (x 80-175) */
         b.pos.y = INT_TO_FX(80);
         b.hitbox.half_w = INT_TO_FX(8);
         b.hitbox.half_h = INT_TO_FX(8);
@@ -395,6 +649,36 @@ static void run_physics_tests(void) {
         test("apex ~f64", apex_frame >= 63 && apex_frame <= 65);
     }
 
+    /* Test: swept X stops at the wall instead of tunneling out of the room */
+    {
+        PhysicsBody b;
+        memset(&b, 0, sizeof(b));
+        b.pos.x = INT_TO_FX(200);
+        b.pos.y = INT_TO_FX(40);
+        b.vel.x = INT_TO_FX(64);
+        b.hitbox.half_w = INT_TO_FX(8);
+        b.hitbox.half_h = INT_TO_FX(8);
+        b.env = ENV_AIR;
+        physics_update_body(&b);
+        test("sweep_x_wall", FX_TO_INT(b.pos.x) == 232);
+        test("sweep_x_contact", b.contact.on_wall_right && b.vel.x == 0);
+    }
+
+    /* Test: swept Y hits the 1-tile platform underside (row 6) */
+    {
+        PhysicsBody b;
+        memset(&b, 0, sizeof(b));
+        b.pos.x = INT_TO_FX(128);
+        b.pos.y = INT_TO_FX(140);
+        b.vel.y = INT_TO_FX(-48);
+        b.hitbox.half_w = INT_TO_FX(8);
+        b.hitbox.half_h = INT_TO_FX(8);
+        b.env = ENV_AIR;
+        physics_update_body(&b);
+        test("sweep_y_ceiling", FX_TO_INT(b.pos.y) == 120);
+        test("sweep_y_contact", b.contact.on_ceiling);
+    }
+
     iprintf("%d/%d phys OK\n",
             tests_passed - pre_passed,
             tests_total - pre_total);
@@ -503,6 +787,67 @@ static void run_enemy_tests(void) {
     enemy_clear_all();
     test("eclear_0", enemy_get_count() == 0);
 
+    /* Test 9: pool stays grouped by type; bodies follow their enemy */
+    enemy_spawn(ENEMY_WAVER,  INT_TO_FX(100), INT_TO_FX(40));
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(50),  INT_TO_FX(40));
+    enemy_spawn(ENEMY_RINKA,  INT_TO_FX(70),  INT_TO_FX(40));
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(60),  INT_TO_FX(40));
+    bool sorted = true;
+    for (int i = 1; i < enemy_get_count(); i++) {
+        if (enemy_get(i)->type < enemy_get(i - 1)->type) sorted = false;
+    }
+    test("egroup_sorted", sorted);
+    test("egroup_body",
+         enemy_get(2)->type == ENEMY_WAVER &&
+         enemy_get_body(2)->pos.x == INT_TO_FX(100));
+
+    /* Test 10: removing from the first group keeps later groups intact */
+    enemy_remove(0);
+    test("egroup_remove",
+         enemy_get_count() == 3 &&
+         enemy_get(0)->type == ENEMY_ZOOMER &&
+         enemy_get(1)->type == ENEMY_WAVER &&
+         enemy_get_body(1)->pos.x == INT_TO_FX(100) &&
+         enemy_get(2)->type == ENEMY_RINKA &&
+         enemy_get_body(2)->pos.x == INT_TO_FX(70));
+
+    /* Test 11: dead enemies are reaped at the start of the next update */
+    enemy_damage(1, 1000);
+    enemy_update_all();
+    test("egroup_reap", enemy_get_count() == 2 &&
+                        enemy_get(1)->type == ENEMY_RINKA);
+    enemy_clear_all();
+
+    /* Test 12: enemies beyond the activation margin sleep per type */
+    Camera saved_cam = g_camera;
+    g_camera.x = 0;
+    g_camera.y = 0;
+    fx32 far_x = INT_TO_FX(SCREEN_WIDTH + ENEMY_WAKE_MARGIN_PX +
+                           ENEMY_SLEEP_HYSTERESIS_PX + 32);
+    enemy_spawn(ENEMY_ZOOMER, far_x, INT_TO_FX(40));
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(64), INT_TO_FX(40));
+    enemy_spawn(ENEMY_WAVER,  far_x, INT_TO_FX(40));
+    enemy_spawn(ENEMY_RINKA,  far_x, INT_TO_FX(40));
+    Vec2fx far_pos = enemy_get_body(0)->pos;
+    uint16_t waver_timer = enemy_get(2)->ai_timer;
+    for (int f = 0; f < 4; f++) enemy_update_all();
+    test("esleep_freeze", enemy_get(0)->asleep &&
+                          enemy_get_body(0)->pos.x == far_pos.x &&
+                          enemy_get_body(0)->pos.y == far_pos.y);
+    test("esleep_near_awake", !enemy_get(1)->asleep);
+    test("esleep_timer", enemy_get(2)->asleep &&
+                         enemy_get(2)->ai_timer == waver_timer + 4);
+    test("esleep_never", !enemy_get(3)->asleep &&
+                         enemy_get_awake_count() == 2);
+
+    /* Test 13: moving the camera toward a sleeper wakes it */
+    g_camera.x = far_x - INT_TO_FX(SCREEN_WIDTH);
+    enemy_update_all();
+    test("esleep_wake", !enemy_get(0)->asleep &&
+                        enemy_get_awake_count() == 4);
+    g_camera = saved_cam;
+    enemy_clear_all();
+
     iprintf("%d/%d enemy OK\n",
             tests_passed - pre_passed,
             tests_total - pre_total);
@@ -577,6 +922,41 @@ static void run_projectile_tests(void) {
     Enemy* hit_enemy = enemy_get(0);
     test("pbeam_dmg", hit_enemy != NULL && hit_enemy->hp < 20);
 
+    /* Test 8b: a bomb going off on an enemy a beam killed earlier in the
+     * same frame doesn't hit it again (the grid still lists it) */
+    projectile_pool_init();
+    enemy_pool_init();
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(140), INT_TO_FX(80));
+    projectile_spawn(PROJ_BOMB, PROJ_OWNER_PLAYER,
+                     INT_TO_FX(140), INT_TO_FX(80), 0, 0);
+    for (int f = 1; f < BOMB_TIMER_FRAMES; f++) projectile_update_all();
+    enemy_get(0)->hp = 1;
+    projectile_spawn(PROJ_POWER_BEAM, PROJ_OWNER_PLAYER,     /* Updated first */
+                     INT_TO_FX(136), INT_TO_FX(80), INT_TO_FX(4), 0);
+    projectile_update_all();  /* Beam kills it, then the bomb explodes */
+    Enemy* dead = enemy_get(0);
+    test("pbomb_skip_dead", dead != NULL && !dead->active && dead->hp == 1 - 20);
+
+    /* Test 9: broadphase returns only overlapping entities, once each */
+    enemy_pool_init();
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(60), INT_TO_FX(64));   /* straddles cells */
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(200), INT_TO_FX(140));
+    broadphase_build();
+    {
+        BroadphaseRef refs[BP_MAX_ENTITIES];
+        Vec2fx q = { INT_TO_FX(64), INT_TO_FX(64) };
+        AABBfx small = { INT_TO_FX(8), INT_TO_FX(8) };
+        int n = broadphase_query(q, small, BP_MASK_ALL, refs, BP_MAX_ENTITIES);
+        test("bp_one_hit", n == 1 && refs[0].kind == BP_KIND_ENEMY &&
+                           refs[0].index == 0);
+
+        AABBfx room_box = { INT_TO_FX(256), INT_TO_FX(256) };
+        n = broadphase_query(q, room_box, BP_MASK_ENEMY, refs, BP_MAX_ENTITIES);
+        test("bp_all_dedup", n == 2);
+        n = broadphase_query(q, room_box, BP_MASK_BOSS, refs, BP_MAX_ENTITIES);
+        test("bp_mask", n == 0);
+    }
+
     /* Cleanup */
     projectile_pool_init();
     enemy_pool_init();
@@ -914,6 +1294,150 @@ static void run_boss_tests(void) {
     }
     test("mb_dead", !boss_is_active());
 
+    /* --- Behavior programs --- */
+
+    /* Every built-in program passes the loader */
+    static BossProgram prog;
+    bool all_load = true;
+    for (int t = BOSS_SPORE_SPAWN; t < BOSS_TYPE_COUNT; t++) {
+        const BossProgramDef* def = boss_builtin_program(t);
+        all_load = all_load && def && boss_program_load(&prog, &def->hdr, def->ops);
+    }
+    test("vm_builtin_load", all_load);
+
+    /* Loader rejects broken programs */
+    static const BossOp bad_if[] = {
+        B_STATE(0, 0), B_AFTER(10), B_GOTO(0),
+    };
+    static const BossOp bad_goto[] = {
+        B_STATE(0, 0), B_GOTO(3),
+    };
+    static const BossOp bad_gap[] = {
+        B_STATE(0, 0), B_STATE(2, 0),
+    };
+    BossProgramHeader bh = boss_builtin_program(BOSS_KRAID)->hdr;
+    bh.start_state = 0;
+    bh.flinch_state = BOSS_NO_STATE;
+    bh.death_state[0] = BOSS_NO_STATE;
+    bh.op_count = 3;
+    test("vm_rej_if", !boss_program_load(&prog, &bh, bad_if));
+    bh.op_count = 2;
+    test("vm_rej_goto", !boss_program_load(&prog, &bh, bad_goto));
+    test("vm_rej_gap", !boss_program_load(&prog, &bh, bad_gap));
+    bh.magic = 0;
+    test("vm_rej_magic", !boss_program_load(&prog, &bh, bad_goto));
+
+    /* Spore Spawn ends its swing at frame 300, Kraid's rise at 48 */
+    boss_init();
+    boss_spawn(BOSS_SPORE_SPAWN, INT_TO_FX(128), INT_TO_FX(48));
+    for (int f = 0; f < 299; f++) boss_update();
+    test("vm_ss_swing", g_boss.ai_state == 0);
+    boss_update();
+    test("vm_ss_descend", g_boss.ai_state == 1 &&
+                          g_boss.body.pos.x == INT_TO_FX(128));
+    boss_spawn(BOSS_KRAID, INT_TO_FX(128), INT_TO_FX(100));
+    for (int f = 0; f < 48; f++) boss_update();
+    test("vm_kr_risen", g_boss.ai_state == 1 &&
+                        g_boss.body.pos.y == INT_TO_FX(100));
+
+    /* An exported program run from a mounted file behaves identically */
+    Boss builtin_run;
+    g_player.body.pos.x = INT_TO_FX(60);
+    g_player.body.pos.y = INT_TO_FX(100);
+    boss_spawn(BOSS_BOTWOON, INT_TO_FX(128), INT_TO_FX(96));
+    for (int f = 0; f < 400; f++) boss_update();
+    builtin_run = g_boss;
+
+    const char* prog_path = "./boss_05.bin";
+    test("vm_export", boss_program_export(BOSS_BOTWOON, prog_path));
+    boss_mount(".");
+    boss_spawn(BOSS_BOTWOON, INT_TO_FX(128), INT_TO_FX(96));
+    for (int f = 0; f < 400; f++) boss_update();
+    test("vm_file_same", memcmp(&builtin_run, &g_boss, sizeof(Boss)) == 0);
+
+    /* The file really is what runs; a corrupt one falls back to built-in */
+    FILE* pf = fopen(prog_path, "r+b");
+    BossProgramHeader fh;
+    fread(&fh, sizeof(fh), 1, pf);
+    fh.hp = 1234;
+    fseek(pf, 0, SEEK_SET);
+    fwrite(&fh, sizeof(fh), 1, pf);
+    fclose(pf);
+    boss_spawn(BOSS_BOTWOON, INT_TO_FX(128), INT_TO_FX(96));
+    test("vm_file_hp", g_boss.hp == 1234);
+
+    BossOp junk = { .op = 0xEE };
+    pf = fopen(prog_path, "r+b");
+    fseek(pf, sizeof(fh), SEEK_SET);
+    fwrite(&junk, sizeof(junk), 1, pf);
+    fclose(pf);
+    boss_spawn(BOSS_BOTWOON, INT_TO_FX(128), INT_TO_FX(96));
+    test("vm_file_bad", boss_is_active() && g_boss.hp == 3000);
+    boss_unmount();
+    remove(prog_path);
+
+    /* Parts: each is a broadphase entry; armor blocks, cores take hits */
+    projectile_pool_init();
+    enemy_pool_init();
+    boss_spawn(BOSS_KRAID, INT_TO_FX(128), INT_TO_FX(100));
+    g_boss.body.pos.y = INT_TO_FX(100);
+    broadphase_build();
+    {
+        BroadphaseRef refs[BP_MAX_ENTITIES];
+        Vec2fx q = { INT_TO_FX(128), INT_TO_FX(100) };
+        AABBfx room_box = { INT_TO_FX(256), INT_TO_FX(256) };
+        int n = broadphase_query(q, room_box, BP_MASK_BOSS, refs, BP_MAX_ENTITIES);
+        test("part_bp", n == 3 && boss_part_count() == 3);
+    }
+    g_boss.vulnerable = true;
+    test("part_armor", boss_part_damage(1, 100) == 0 &&
+                       boss_part_damage(0, 100) == 100);
+
+    projectile_spawn(PROJ_POWER_BEAM, PROJ_OWNER_PLAYER,
+                     INT_TO_FX(124), INT_TO_FX(110), INT_TO_FX(4), 0);
+    projectile_update_all();    /* Belly only */
+    test("part_shot_armor", g_boss.hp == 1000 &&
+                            projectile_spawn(PROJ_POWER_BEAM, PROJ_OWNER_PLAYER,
+                                             0, 0, 0, 0) == 0);
+    projectile_pool_init();
+    projectile_spawn(PROJ_POWER_BEAM, PROJ_OWNER_PLAYER,
+                     INT_TO_FX(124), INT_TO_FX(86), INT_TO_FX(4), 0);
+    projectile_update_all();    /* Mouth and belly: the mouth wins */
+    test("part_shot_core", g_boss.hp == 980);
+    projectile_pool_init();
+
+    /* Multipliers scale, phase masks hide parts */
+    BossProgramHeader ph = boss_builtin_program(BOSS_KRAID)->hdr;
+    ph.parts[0].damage_mul = 8;
+    Boss pb;
+    memset(&pb, 0, sizeof(pb));
+    pb.active = true;
+    pb.vulnerable = true;
+    test("part_mul", boss_program_load(&prog, &ph,
+                                       boss_builtin_program(BOSS_KRAID)->ops) &&
+                     boss_vm_part_damage(&pb, &prog, 0, 100) == 200);
+    ph.parts[1].phases = 0x02;
+    test("part_rej_phase", !boss_program_load(&prog, &ph,
+                                           boss_builtin_program(BOSS_KRAID)->ops));
+    ph.parts[1].phases = 0;
+    ph.parts[1].half_w = 0;
+    test("part_rej_size", !boss_program_load(&prog, &ph,
+                                          boss_builtin_program(BOSS_KRAID)->ops));
+
+    const BossProgramDef* bot = boss_builtin_program(BOSS_BOTWOON);
+    test("part_default", boss_program_load(&prog, &bot->hdr, bot->ops) &&
+                         prog.hdr.part_count == 1 &&
+                         prog.hdr.parts[0].half_w == bot->hdr.half_w &&
+                         (prog.hdr.parts[0].flags & BPF_VULNERABLE));
+
+    Vec2fx ppos;
+    AABBfx pbox;
+    boss_spawn(BOSS_MOTHER_BRAIN, INT_TO_FX(128), INT_TO_FX(64));
+    test("part_phase0", !boss_part_box(1, &ppos, &pbox));
+    g_boss.phase = 1;
+    test("part_phase1", boss_part_box(1, &ppos, &pbox) &&
+                        ppos.y == INT_TO_FX(104));
+
     /* Cleanup */
     boss_init();
 
@@ -1002,6 +1526,84 @@ static void run_audio_tests(void) {
     audio_play_music(MUSIC_NONE);
     test("aud_none_ok", audio_get_current_music() == MUSIC_NONE);
 
+    /* Test 9: repeat requests in one frame start one voice */
+    audio_init();
+    audio_play_sfx(SFX_BEAM);
+    audio_play_sfx(SFX_BEAM);
+    audio_play_sfx(SFX_BEAM);
+    test("aud_sfx_pending", audio_get_active_voices() == 0);
+    audio_update();
+    test("aud_sfx_coalesce", audio_get_active_voices() == 1 &&
+                             audio_get_voice_sfx(0) == SFX_BEAM);
+
+    /* Test 10: retrigger reuses the voice, a new SFX takes a free one */
+    audio_play_sfx(SFX_BEAM);
+    audio_play_sfx(SFX_JUMP);
+    audio_update();
+    test("aud_sfx_retrigger", audio_get_active_voices() == 2 &&
+                              audio_get_voice_sfx(0) == SFX_BEAM &&
+                              audio_get_voice_sfx(1) == SFX_JUMP);
+
+    /* Test 11: voices free after the SFX length (SFX_LAND: 6 frames) */
+    audio_init();
+    audio_play_sfx(SFX_LAND);
+    audio_update();
+    for (int i = 0; i < 5; i++) audio_update();
+    bool land_held = audio_get_active_voices() == 1;
+    audio_update();
+    test("aud_sfx_expire", land_held && audio_get_active_voices() == 0);
+
+    /* Test 12: full voices: a higher priority steals the weakest */
+    audio_init();
+    audio_play_sfx(SFX_LAND);
+    audio_play_sfx(SFX_JUMP);
+    audio_play_sfx(SFX_ENEMY_HIT);
+    audio_play_sfx(SFX_BEAM);
+    audio_play_sfx(SFX_ENEMY_DEATH);
+    audio_play_sfx(SFX_BOMB);
+    audio_play_sfx(SFX_MISSILE);
+    audio_play_sfx(SFX_SUPER_MISSILE);
+    audio_update();
+    bool full = audio_get_active_voices() == AUDIO_SFX_VOICES;
+    audio_play_sfx(SFX_ITEM);
+    audio_update();
+    bool item_on = false, land_on = false;
+    for (int i = 0; i < AUDIO_SFX_VOICES; i++) {
+        if (audio_get_voice_sfx(i) == SFX_ITEM) item_on = true;
+        if (audio_get_voice_sfx(i) == SFX_LAND) land_on = true;
+    }
+    test("aud_sfx_steal", full && item_on && !land_on);
+
+    /* Test 13: ...and a lower one than every voice is dropped */
+    audio_play_sfx(SFX_LAND);
+    audio_update();
+    land_on = false;
+    for (int i = 0; i < AUDIO_SFX_VOICES; i++) {
+        if (audio_get_voice_sfx(i) == SFX_LAND) land_on = true;
+    }
+    test("aud_sfx_drop", !land_on &&
+                         audio_get_active_voices() == AUDIO_SFX_VOICES);
+
+    /* Test 14: preloaded track is taken over by play */
+    audio_init();
+    audio_play_music(MUSIC_TITLE);
+    audio_preload_music(MUSIC_MARIDIA);
+    bool preloaded = audio_get_preloaded_music() == MUSIC_MARIDIA &&
+                     audio_get_current_music() == MUSIC_TITLE;
+    audio_play_music(MUSIC_MARIDIA);
+    test("aud_preload", preloaded &&
+                        audio_get_current_music() == MUSIC_MARIDIA &&
+                        audio_get_preloaded_music() == MUSIC_NONE);
+
+    /* Test 15: preloading the current track is a no-op */
+    audio_preload_music(MUSIC_MARIDIA);
+    test("aud_preload_cur", audio_get_preloaded_music() == MUSIC_NONE);
+
+    /* Test 16: area music */
+    test("aud_area_music", audio_area_music(0) == MUSIC_CRATERIA_SURFACE &&
+                           audio_area_music(4) == MUSIC_MARIDIA &&
+                           audio_area_music(200) == MUSIC_NONE);
+
     /* Cleanup */
     audio_init();
 
@@ -1014,6 +1616,27 @@ static void run_audio_tests(void) {
  * M15: Save System Tests
  * ======================================================================== */
 
+static long file_size(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+/* Copy a file as it is on disk now (missing source: no copy) */
+static void copy_file(const char* from, const char* to) {
+    remove(to);
+    FILE* in = fopen(from, "rb");
+    if (!in) return;
+    FILE* out = fopen(to, "wb");
+    int c;
+    while (out && (c = fgetc(in)) != EOF) fputc(c, out);
+    if (out) fclose(out);
+    fclose(in);
+}
+
 static void run_save_tests(void) {
     iprintf("--- Save Tests ---\n");
     int pre_passed = tests_passed;
@@ -1093,11 +1716,896 @@ static void run_save_tests(void) {
     save_delete(1);
     save_delete(2);
 
+    /* Test 8: without a backing file nothing waits to flush */
+    test("sv_flush_idle", !save_flush_pending());
+
+    /* Test 9: first save builds the whole image over several frames */
+    const char* sav = "save_test.sav";
+    const char* tmp = "save_test.sav.tmp";
+    remove(sav);
+    remove(tmp);
+    save_mount(sav);
+    save_write(1, &s2);
+    save_flush_update();
+    test("sv_flush_chunked", save_flush_pending());
+    save_flush_sync();
+    FILE* f = fopen(sav, "rb");
+    long size = -1;
+    if (f) {
+        fseek(f, 0, SEEK_END);
+        size = ftell(f);
+        fclose(f);
+    }
+    test("sv_flush_image", size == 0x2000 && !save_flush_pending());
+
+    /* Test 10: later saves also go through the temp image, a chunk a frame */
+    save_write(2, &s1);
+    int steps = 0;
+    while (save_flush_pending() && steps < 32) {
+        save_flush_update();
+        steps++;
+    }
+    test("sv_flush_steps", steps == 16 && file_size(tmp) < 0);  /* 8KB at 512/frame */
+
+    /* Test 10b: power lost mid-flush (card state copied aside) keeps the
+     * slot's previous save */
+    SaveData s3 = s1;
+    s3.hp = 77;
+    save_write(2, &s3);
+    for (int i = 0; i < 3; i++) save_flush_update();
+    copy_file(sav, "save_cut.sav");
+    copy_file(tmp, "save_cut.sav.tmp");
+    save_mount("save_cut.sav");
+    memset(&r1, 0, sizeof(r1));
+    test("sv_flush_cut", save_read(2, &r1) && r1.hp == 50 &&
+                         file_size("save_cut.sav.tmp") < 0);
+    save_unmount();
+    remove("save_cut.sav");
+    save_mount(sav);
+    save_write(2, &s1);     /* Test 11 expects the first value */
+    save_flush_sync();
+
+    /* Test 11: remount reads back both slots */
+    save_mount(sav);
+    memset(&r1, 0, sizeof(r1));
+    memset(&r2, 0, sizeof(r2));
+    test("sv_mount_reload", save_read(1, &r2) && r2.hp == 200 &&
+                            save_read(2, &r1) && r1.hp == 50);
+
+    /* Test 12: a finished temp image left by a cut replace is recovered */
+    save_unmount();
+    rename(sav, tmp);
+    save_mount(sav);
+    FILE* left = fopen(tmp, "rb");
+    test("sv_tmp_recover", save_slot_valid(1) && left == NULL);
+    if (left) fclose(left);
+
+    /* Test 13: a half-written temp next to a good .sav is discarded */
+    save_unmount();
+    f = fopen(tmp, "wb");
+    if (f) {
+        fputc(0, f);
+        fclose(f);
+    }
+    save_mount(sav);
+    left = fopen(tmp, "rb");
+    test("sv_tmp_stale", save_slot_valid(2) && left == NULL);
+    if (left) fclose(left);
+
+    /* Test 14: a first save cut short leaves only a partial temp, which
+     * is dropped rather than promoted */
+    save_unmount();
+    remove(sav);
+    f = fopen(tmp, "wb");
+    if (f) {
+        for (int i = 0; i < 1000; i++) fputc(0xFF, f);
+        fclose(f);
+    }
+    save_mount(sav);
+    test("sv_tmp_partial", !save_slot_valid(1) && file_size(tmp) < 0 &&
+                           file_size(sav) < 0);
+
+    save_unmount();
+    remove(sav);
+    remove(tmp);
+
     iprintf("%d/%d save OK\n",
             tests_passed - pre_passed,
             tests_total - pre_total);
 }
 
+/* ========================================================================
+ * OAM Allocator Tests
+ * ======================================================================== */
+
+static void run_oam_tests(void) {
+    iprintf("--- OAM Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    static const MetaspritePiece pair_pieces[2] = {
+        { -8, -16, 16, 16, 0, 0 },
+        { -8,   0, 16, 16, 4, 0 },
+    };
+    static const Metasprite pair = { pair_pieces, 2 };
+
+    /* Test 1: higher priority takes lower slots regardless of order */
+    graphics_begin_frame();
+    int h_enemy = graphics_draw_sprite(10, 10, 4, 1, 2, false, false, SPR_PRIO_NORMAL);
+    int h_player = graphics_draw_sprite(20, 20, 0, 0, 1, false, false, SPR_PRIO_PLAYER);
+    graphics_end_frame();
+    test("oam_prio_order", graphics_get_sprite_slot(h_player) == 0 &&
+                           graphics_get_sprite_slot(h_enemy) == 1);
+
+    /* Test 1b: results survive into the next frame's queueing */
+    graphics_begin_frame();
+    graphics_draw_sprite(0, 0, 0, 0, 1, false, false, SPR_PRIO_LOW);
+    test("oam_slot_committed", graphics_get_sprite_slot(h_enemy) == 1);
+    graphics_end_frame();
+
+    /* Test 2: a metasprite uses one slot per piece */
+    graphics_begin_frame();
+    int h_pair = graphics_draw_metasprite(&pair, 50, 50, 0, 0, 1, true, false,
+                                          SPR_PRIO_NORMAL);
+    graphics_end_frame();
+    test("oam_meta_slots", graphics_get_sprite_slot(h_pair) == 0 &&
+                           graphics_get_oam_used() == 2);
+
+    /* Test 3: saturation drops whole metasprites, never the player */
+    int handles[70];
+    graphics_begin_frame();
+    for (int i = 0; i < 70; i++) {
+        handles[i] = graphics_draw_metasprite(&pair, 100, 100, 0, 0, 2,
+                                              false, false, SPR_PRIO_NORMAL);
+    }
+    h_player = graphics_draw_sprite(0, 0, 0, 0, 1, false, false, SPR_PRIO_PLAYER);
+    graphics_end_frame();
+    test("oam_saturate", graphics_get_oam_used() == OAM_SPRITE_COUNT - 1 &&
+                         graphics_get_sprites_dropped() == 7 &&
+                         graphics_get_sprite_slot(h_player) == 0);
+
+    /* Test 4: the dropped ones lead the band next frame */
+    int first_dropped = -1;
+    for (int i = 0; i < 70; i++) {
+        if (graphics_get_sprite_slot(handles[i]) < 0) { first_dropped = i; break; }
+    }
+    graphics_begin_frame();
+    for (int i = 0; i < 70; i++) {
+        graphics_draw_metasprite(&pair, 100, 100, 0, 0, 2,
+                                 false, false, SPR_PRIO_NORMAL);
+    }
+    graphics_draw_sprite(0, 0, 0, 0, 1, false, false, SPR_PRIO_PLAYER);
+    graphics_end_frame();
+    test("oam_rotate", first_dropped == 63 &&
+                       graphics_get_sprite_slot(handles[first_dropped]) == 1);
+
+    /* Test 5: invalid piece sizes are skipped, empty results rejected */
+    static const MetaspritePiece bad_piece = { 0, 0, 24, 24, 0, 0 };
+    static const Metasprite bad = { &bad_piece, 1 };
+    graphics_begin_frame();
+    test("oam_bad_size", graphics_draw_metasprite(&bad, 0, 0, 0, 0, 0,
+                                                  false, false, SPR_PRIO_LOW) == -1);
+    graphics_end_frame();
+
+    iprintf("%d/%d oam OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * LC_LZ2 Decompressor Tests
+ * ======================================================================== */
+
+static void run_lz_tests(void) {
+    iprintf("--- LZ Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    static u8 out[2048];
+
+    /* Literal "AB", byte fill 5x'C', word fill 5 bytes "DE", inc fill 4 from 'a' */
+    static const u8 runs[] = {
+        0x01, 'A', 'B', 0x24, 'C', 0x44, 'D', 'E', 0x63, 'a', 0xFF
+    };
+    int n = lz_decompress(runs, sizeof(runs), out, sizeof(out));
+    test("lz_runs", n == 16 && memcmp(out, "ABCCCCCDEDEDabcd", 16) == 0);
+
+    /* Back reference: copy 4 from offset 0, then overlapping repeat of 6 */
+    static const u8 refs[] = {
+        0x01, 'x', 'y', 0x83, 0x00, 0x00, 0x85, 0x05, 0x00, 0xFF
+    };
+    n = lz_decompress(refs, sizeof(refs), out, sizeof(out));
+    test("lz_backref", n == 12 && memcmp(out, "xyxyxyyyyyyy", 12) == 0);
+
+    /* Extended length: byte fill of 1000 (10-bit length 999) */
+    static const u8 ext[] = { 0xE4 | 0x03, 0xE7, 0x5A, 0xFF };
+    n = lz_decompress(ext, sizeof(ext), out, sizeof(out));
+    bool filled = n == 1000;
+    for (int i = 0; filled && i < 1000; i++) filled = out[i] == 0x5A;
+    test("lz_extended", filled);
+
+    /* Corrupt streams fail instead of overrunning */
+    test("lz_overflow", lz_decompress(ext, sizeof(ext), out, 999) == -1);
+    test("lz_truncated", lz_decompress(runs, sizeof(runs) - 1, out, sizeof(out)) == -1);
+    static const u8 bad_ref[] = { 0x80, 0x04, 0x00, 0xFF };
+    test("lz_bad_ref", lz_decompress(bad_ref, sizeof(bad_ref), out, sizeof(out)) == -1);
+
+    iprintf("%d/%d lz OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * VRAM Upload Queue Tests
+ * ======================================================================== */
+
+static void run_upload_tests(void) {
+    iprintf("--- Upload Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    /* Static: DMA sources can't live on the DTCM stack */
+    static u16 src_small[16];
+    static u16 src_big[VRAM_UPLOAD_BUDGET];   /* 2x budget in bytes */
+    static u16 map_img[64 * 64];
+
+    graphics_flush_uploads();
+    for (int i = 0; i < 16; i++) src_small[i] = (u16)(0xA000 + i);
+    for (int i = 0; i < VRAM_UPLOAD_BUDGET; i++) src_big[i] = (u16)i;
+
+    /* Test 1: queued data reaches VRAM only at VBlank */
+    u16* tiles = oamGetGfxPtr(&oamMain, 200);
+    memset(tiles, 0, sizeof(src_small));
+    graphics_load_sprite_tiles(src_small, sizeof(src_small), 200);
+    bool untouched = tiles[0] == 0;
+    graphics_vblank();
+    test("upl_deferred", untouched && tiles[15] == 0xA00F &&
+                         graphics_get_pending_upload_bytes() == 0);
+
+    /* Test 2: transfers over budget spill to the next VBlank */
+    u16* big_dst = oamGetGfxPtr(&oamMain, 256);
+    graphics_load_sprite_tiles(src_big, sizeof(src_big), 256);
+    graphics_vblank();
+    bool spilled = graphics_get_pending_upload_bytes() ==
+                   sizeof(src_big) - VRAM_UPLOAD_BUDGET;
+    graphics_vblank();
+    test("upl_spill", spilled && graphics_get_pending_upload_bytes() == 0 &&
+                      big_dst[VRAM_UPLOAD_BUDGET - 1] == VRAM_UPLOAD_BUDGET - 1);
+
+    /* Test 3: re-queueing a destination replaces the pending transfer */
+    graphics_load_sprite_tiles(src_small, sizeof(src_small), 200);
+    graphics_load_sprite_tiles(src_small, sizeof(src_small), 200);
+    test("upl_coalesce", graphics_get_pending_upload_bytes() == sizeof(src_small));
+    graphics_flush_uploads();
+
+    /* Test 4: a map patch waits for an in-flight map upload */
+    if (!g_current_room.loaded) room_load(0, 0);
+    graphics_flush_uploads();
+    memset(map_img, 0, sizeof(map_img));
+    graphics_load_sprite_tiles(src_small, sizeof(src_small), 200);
+    graphics_load_bg_tilemap(BG_LAYER_LEVEL, map_img, sizeof(map_img));
+    graphics_queue_bg_map_entry(BG_LAYER_LEVEL, 64 * 64 - 1, 0x1234);
+    graphics_vblank();
+    u16* map = bgGetMapPtr(0);
+    bool held = map[64 * 64 - 1] != 0x1234;
+    graphics_vblank();
+    test("upl_patch_after_map", held && map[64 * 64 - 1] == 0x1234);
+
+    /* Restore the room's own map */
+    room_upload_to_vram();
+    graphics_flush_uploads();
+    graphics_vblank();
+
+    iprintf("%d/%d upload OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * Tile Animation / Sprite Stream Tests
+ * ======================================================================== */
+
+static void run_tile_anim_tests(void) {
+    iprintf("--- Tile Anim Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    static u8 frames[3][32];
+    for (int f = 0; f < 3; f++) memset(frames[f], 0x10 + f, 32);
+    static const TileAnimDef defs[1] = {
+        { 10, 1, 3, 2, &frames[0][0] },
+    };
+
+    if (!g_current_room.loaded) room_load(0, 0);
+    graphics_flush_uploads();
+
+    /* Test 1: installing a table uploads frame 0 */
+    tile_anim_set(BG_LAYER_LEVEL, defs, 1);
+    graphics_flush_uploads();
+    const u8* tile10 = (const u8*)bgGetGfxPtr(0) + 10 * 32;
+    test("tanim_frame0", tile_anim_get_frame(0) == 0 && tile10[0] == 0x10);
+
+    /* Test 2: frames advance every frame_ticks updates and wrap */
+    tile_anim_update();
+    bool held = tile_anim_get_frame(0) == 0;
+    tile_anim_update();
+    test("tanim_advance", held && tile_anim_get_frame(0) == 1);
+    for (int i = 0; i < 4; i++) tile_anim_update();
+    test("tanim_wrap", tile_anim_get_frame(0) == 0);
+
+    /* Test 3: a frame change uploads that frame's tiles */
+    tile_anim_update();
+    tile_anim_update();
+    graphics_flush_uploads();
+    test("tanim_upload", tile10[0] == 0x11);
+
+    /* Test 4: a stream only uploads when the frame changes */
+    static u8 bank[2][128];
+    memset(bank[0], 0x44, 128);
+    memset(bank[1], 0x55, 128);
+    SpriteStream st;
+    sprite_stream_init(&st, bank, 128, 300);
+    sprite_stream_show(&st, 0);
+    graphics_flush_uploads();
+    sprite_stream_show(&st, 0);
+    bool idle = graphics_get_pending_upload_bytes() == 0;
+    sprite_stream_show(&st, 1);
+    test("tstream_on_change", idle &&
+         graphics_get_pending_upload_bytes() == 128);
+    graphics_flush_uploads();
+    test("tstream_slot", ((const u8*)oamGetGfxPtr(&oamMain, 300))[0] == 0x55);
+
+    /* Restore the room's tileset and animation table */
+    room_upload_to_vram();
+    graphics_flush_uploads();
+
+    iprintf("%d/%d tanim OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * HBlank Effect Tests
+ * ======================================================================== */
+
+static void run_hblank_tests(void) {
+    iprintf("--- HBlank Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    /* Test 1: bad channel / target rejected */
+    test("hbl_bad_args",
+         graphics_hblank_build(HBLANK_CHANNELS, HBLANK_BRIGHTNESS, 0) == NULL &&
+         graphics_hblank_build(0, HBLANK_BG_SCROLL_X, 4) == NULL);
+
+    /* Test 2: a built table goes live at VBlank, line 0 written directly */
+    graphics_set_bg_scroll(BG_LAYER_PARALLAX, 40, 0);
+    graphics_hblank_wave(0, BG_LAYER_PARALLAX, 4, 64, 0);
+    bool idle = graphics_hblank_active(0) == NULL;
+    graphics_vblank();
+    const u16* t = graphics_hblank_active(0);
+    test("hbl_commit", idle && t != NULL &&
+                       (&REG_BG0HOFS)[BG_LAYER_PARALLAX * 2] == t[0] &&
+                       (DMA_CR(0) & DMA_START_HBL) &&
+                       DMA_SRC(0) == (uintptr_t)&t[1]);
+
+    /* Test 3: wave oscillates around the base scroll */
+    test("hbl_wave", t[0] == 40 && t[16] == 44 && t[48] == 36);
+
+    /* Test 4: tables persist and stay rearmed without a rebuild */
+    DMA_CR(0) = 0;
+    graphics_vblank();
+    test("hbl_persist", graphics_hblank_active(0) == t && DMA_CR(0) != 0);
+
+    /* Test 5: gradient hits both end colours */
+    graphics_hblank_gradient(1, 0, RGB15(0, 0, 31), RGB15(31, 0, 0));
+    graphics_vblank();
+    const u16* g = graphics_hblank_active(1);
+    test("hbl_gradient", g && g[0] == RGB15(0, 0, 31) &&
+                         g[SCREEN_HEIGHT - 1] == RGB15(31, 0, 0));
+
+    /* Test 6: stop disarms the channel */
+    graphics_hblank_stop(0);
+    graphics_hblank_stop(1);
+    graphics_vblank();
+    test("hbl_stop", graphics_hblank_active(0) == NULL &&
+                     graphics_hblank_active(1) == NULL && DMA_CR(0) == 0);
+
+    graphics_set_bg_scroll(BG_LAYER_PARALLAX, 0, 0);
+
+    iprintf("%d/%d hblank OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * Profiler Tests
+ * ======================================================================== */
+
+static void run_profiler_tests(void) {
+    iprintf("--- Profiler Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    ProfStats st;
+
+    /* Test 1: fresh profiler reports nothing */
+    profiler_init();
+    profiler_get_stats(PROF_FRAME, &st);
+    test("prof_empty", st.last == 0 && st.max == 0 && st.avg == 0);
+
+    /* Test 2: ticks are monotonic between reads */
+    uint32_t t0 = profiler_ticks();
+    uint32_t t1 = profiler_ticks();
+    test("prof_ticks_mono", t1 - t0 < 0x80000000u);
+
+    /* Test 3: nested scope never exceeds its parent */
+    for (int i = 0; i < 4; i++) {
+        profiler_frame_begin();
+        profiler_begin(PROF_PLAYER);
+        profiler_begin(PROF_PHYSICS);
+        room_update_crumble_blocks();
+        profiler_end(PROF_PHYSICS);
+        profiler_end(PROF_PLAYER);
+        profiler_frame_end();
+    }
+    ProfStats fr, pl, ph;
+    profiler_get_stats(PROF_FRAME, &fr);
+    profiler_get_stats(PROF_PLAYER, &pl);
+    profiler_get_stats(PROF_PHYSICS, &ph);
+    test("prof_nested", ph.max <= pl.max && pl.max <= fr.max);
+
+    /* Test 4: window statistics are ordered */
+    test("prof_min_avg_max", fr.min <= fr.avg && fr.avg <= fr.max);
+
+    /* Test 5: untouched scope stays zero */
+    profiler_get_stats(PROF_BOSS, &st);
+    test("prof_unused_zero", st.max == 0);
+
+    /* Test 6: overlay toggle */
+    profiler_toggle_overlay();
+    bool on = profiler_overlay_visible();
+    profiler_toggle_overlay();
+    test("prof_toggle", on && !profiler_overlay_visible());
+
+    /* Cleanup */
+    profiler_init();
+
+    iprintf("%d/%d prof OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * Replay Tests
+ * ======================================================================== */
+
+static void run_replay_tests(void) {
+    iprintf("--- Replay Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    /* Test 1: recording counts frames; steady keys share one run */
+    uint32_t live = keysHeld() & 0xFFFF;
+    input_replay_record();
+    for (int i = 0; i < 10; i++) input_update();
+    test("rp_rec_frames", input_replay_frame() == 10);
+    input_replay_stop();
+    test("rp_rec_length", input_replay_length() == 10);
+
+    /* Test 2: playback reproduces held state and reports progress */
+    test("rp_play_start", input_replay_play());
+    input_update();
+    test("rp_play_mode", input_replay_mode() == REPLAY_PLAYING);
+    test("rp_play_held", input_held(0xFFFF) == (live != 0));
+    for (int i = 1; i < 10; i++) input_update();
+    test("rp_play_frames", input_replay_frame() == 10);
+
+    /* Test 3: running past the end finishes and returns to live input */
+    input_update();
+    test("rp_play_finish", input_replay_mode() == REPLAY_FINISHED);
+
+    /* Test 4: stop clears mode; missing file fails to load */
+    input_replay_stop();
+    test("rp_stop", input_replay_mode() == REPLAY_OFF);
+    test("rp_load_missing", !input_replay_load("no_such_replay.rpl"));
+
+    iprintf("%d/%d replay OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * Snapshot Tests
+ * ======================================================================== */
+
+static void run_snapshot_tests(void) {
+    iprintf("--- Snapshot Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    static u8 blob[SNAPSHOT_MAX_BYTES];
+
+    /* Test 1: nothing to capture without a room */
+    room_unload();
+    test("snap_no_room", snapshot_save(blob, sizeof(blob)) == 0);
+
+    /* Test 2: capture a populated room */
+    room_load(0, 0);
+    player_init();
+    enemy_pool_init();
+    projectile_pool_init();
+    boss_init();
+    camera_init();
+    g_player.body.pos.x = INT_TO_FX(100);
+    enemy_spawn(ENEMY_ZOOMER, INT_TO_FX(64), INT_TO_FX(96));
+    enemy_spawn(ENEMY_WAVER, INT_TO_FX(128), INT_TO_FX(64));
+    projectile_spawn(PROJ_POWER_BEAM, PROJ_OWNER_PLAYER,
+                     INT_TO_FX(80), INT_TO_FX(80), INT_TO_FX(4), 0);
+    g_camera.x = INT_TO_FX(12);
+    int floor_y = g_current_room.height_tiles - 1;
+    uint32_t size = snapshot_save(blob, sizeof(blob));
+    test("snap_save", size > sizeof(SnapshotHeader));
+    test("snap_small_buf", snapshot_save(blob, size - 1) == 0);
+    size = snapshot_save(blob, sizeof(blob));
+
+    /* Test 3: restore undoes every mutation */
+    room_set_collision(4, floor_y, COLL_AIR);
+    g_player.body.pos.x = INT_TO_FX(10);
+    enemy_clear_all();
+    projectile_clear_all();
+    g_camera.x = 0;
+    test("snap_load", snapshot_load(blob, size));
+    test("snap_room", room_get_collision(4, floor_y) == COLL_SOLID &&
+                      room_is_solid(4, floor_y));
+    test("snap_player", g_player.body.pos.x == INT_TO_FX(100));
+    test("snap_enemies", enemy_get_count() == 2 &&
+                         enemy_get(1)->type == ENEMY_WAVER);
+    test("snap_bodies", enemy_get_body(0)->pos.x == INT_TO_FX(64));
+    test("snap_camera", g_camera.x == INT_TO_FX(12));
+
+    /* Test 4: damaged or truncated blobs are refused, state untouched */
+    g_player.body.pos.x = INT_TO_FX(10);
+    blob[size - 1] ^= 0xFF;
+    test("snap_bad_sum", !snapshot_load(blob, size));
+    blob[size - 1] ^= 0xFF;
+    test("snap_truncated", !snapshot_load(blob, size - 1));
+    test("snap_untouched", g_player.body.pos.x == INT_TO_FX(10));
+
+    /* Test 5: restoring from another room brings the saved room back */
+    room_load(0, 1);
+    test("snap_other_room", snapshot_load(blob, size) &&
+                            g_current_room.room_id == 0 &&
+                            room_is_solid(4, floor_y));
+
+    /* Test 6: quick slot and file round trips */
+    test("snap_quick_save", snapshot_quick_save() && snapshot_quick_valid());
+    g_player.body.pos.x = INT_TO_FX(10);
+    test("snap_quick_load", snapshot_quick_load() &&
+                            g_player.body.pos.x == INT_TO_FX(100));
+    test("snap_file_save", snapshot_save_file("snapshot_test.sms"));
+    g_player.body.pos.x = INT_TO_FX(10);
+    test("snap_file_load", snapshot_load_file("snapshot_test.sms") &&
+                           g_player.body.pos.x == INT_TO_FX(100));
+    remove("snapshot_test.sms");
+    test("snap_file_missing", !snapshot_load_file("snapshot_test.sms"));
+
+    /* Test 6b: a bad file is rejected before it replaces the quick slot */
+    {
+        FILE* f = fopen("snapshot_test.sms", "wb");
+        blob[size - 1] ^= 0xFF;             /* Body corrupt, header fine */
+        if (f) {
+            fwrite(blob, 1, size, f);
+            fclose(f);
+        }
+        blob[size - 1] ^= 0xFF;
+        bool corrupt = snapshot_load_file("snapshot_test.sms");
+        f = fopen("snapshot_test.sms", "wb");
+        if (f) {
+            fwrite(blob, 1, sizeof(SnapshotHeader) + 16, f);   /* Truncated */
+            fclose(f);
+        }
+        bool truncated = snapshot_load_file("snapshot_test.sms");
+        remove("snapshot_test.sms");
+        g_player.body.pos.x = INT_TO_FX(10);
+        test("snap_file_bad_keeps_quick", !corrupt && !truncated &&
+                                          snapshot_quick_valid() &&
+                                          g_player.body.pos.x == INT_TO_FX(10) &&
+                                          snapshot_quick_load() &&
+                                          g_player.body.pos.x == INT_TO_FX(100));
+    }
+
+    /* Test 7: replay playback can jump to a snapshot's frame */
+    input_replay_record();
+    for (int i = 0; i < 10; i++) input_update();
+    input_replay_stop();
+    test("snap_seek_off", !input_replay_seek(4));
+    input_replay_play();
+    test("snap_seek", input_replay_seek(4) && input_replay_frame() == 4);
+    for (int i = 0; i < 6; i++) input_update();
+    test("snap_seek_end", input_replay_mode() == REPLAY_PLAYING &&
+                          input_replay_frame() == 10);
+    input_replay_stop();
+
+    enemy_clear_all();
+    projectile_clear_all();
+    room_unload();
+
+    iprintf("%d/%d snapshot OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * Log Tests
+ * ======================================================================== */
+
+static int log_eval_count;
+
+static int log_eval(void) {
+    return ++log_eval_count;
+}
+
+static void run_log_tests(void) {
+    iprintf("--- Log Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    /* Earlier tests' messages go out now, so the ring starts empty */
+    log_flush();
+    test("log_flushed", log_pending() == 0);
+
+    /* Test 1: message is formatted into the ring, not written out */
+    log_write("log: test %d\n", 42);
+    test("log_pending", log_pending() == 13);
+
+    /* Test 2: read pops the formatted text */
+    char text[32];
+    int n = log_read(text, sizeof(text) - 1);
+    text[n] = '\0';
+    test("log_read", n == 13 && strcmp(text, "log: test 42\n") == 0 &&
+                     log_pending() == 0);
+
+    /* Test 3: a message split by the ring's end reads back whole */
+    log_write("offset\n");
+    log_read(text, sizeof(text));
+    for (int i = 0; i < LOG_RING_SIZE / 16 - 1; i++) {
+        log_write("0123456789abcde\n");
+    }
+    log_write("wrap-%04d-line\n", 7);
+    while (log_pending() > 16) log_read(text, 16);
+    n = log_read(text, sizeof(text) - 1);
+    text[n] = '\0';
+    test("log_wrap", strcmp(text, "wrap-0007-line\n") == 0);
+
+    /* Test 4: a full ring drops whole messages and counts them */
+    while (log_pending() + 16 <= LOG_RING_SIZE) log_write("0123456789abcde\n");
+    int full = log_pending();
+    log_write("0123456789abcde\n");
+    log_write("0123456789abcde\n");
+    test("log_drop", log_pending() == full && log_dropped() == 2);
+
+    /* Test 5: long messages are truncated to LOG_LINE_MAX - 1 */
+    log_init();
+    log_write("%0200d", 0);
+    test("log_truncate", log_pending() == LOG_LINE_MAX - 1);
+
+    /* Test 6: levels above LOG_LEVEL don't evaluate their arguments */
+    log_init();
+    log_eval_count = 0;
+    LOG_ERROR("log: eval %d\n", log_eval());
+    LOG_DEBUG("log: eval %d\n", log_eval());
+    test("log_levels", log_eval_count ==
+                       (LOG_LEVEL >= LOG_LEVEL_DEBUG ? 2 : 1));
+
+    /* Test 7: init discards pending output and the drop count */
+    log_write("0123456789abcde\n");
+    log_init();
+    test("log_init", log_pending() == 0 && log_dropped() == 0);
+
+    iprintf("%d/%d log OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * M16: HUD Tests
+ * ======================================================================== */
+
+static void run_hud_tests(void) {
+    iprintf("--- HUD Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    room_load(0, 0);
+    player_init();
+    g_game_time_frames = 59 * 60;
+    graphics_flush_uploads();
+    graphics_vblank();
+
+    /* Test 1: first render draws the strip; entries land at VBlank */
+    hud_init();
+    hud_render();
+    int first = hud_get_last_writes();
+    graphics_flush_uploads();
+    graphics_vblank();
+    u16* hud_map = bgGetMapPtr(3);   /* Sub BG0 (4th layer created) */
+    test("hud_first", first > 0 && (hud_map[0] >> 12) == 1 &&
+                      (hud_map[0] & 0x3FF) != 0 && hud_map[2] == 0);
+
+    /* Test 2: nothing changed, nothing queued */
+    hud_render();
+    test("hud_idle", hud_get_last_writes() == 0);
+
+    /* Test 3: 99 -> 98 rewrites one digit */
+    g_player.hp = 98;
+    hud_render();
+    test("hud_hp_digit", hud_get_last_writes() == 1);
+
+    /* Test 4: 0:00:59 -> 0:01:00 rewrites three digits */
+    g_game_time_frames += 60;
+    hud_render();
+    test("hud_timer", hud_get_last_writes() == 3);
+    graphics_vblank();
+
+    /* Test 5: visiting explores Samus's screen; moving one screen right
+     * updates the two minimap cells that changed */
+    room_load(0, 1);
+    g_player.body.pos.x = INT_TO_FX(100);
+    g_player.body.pos.y = INT_TO_FX(100);
+    test("hud_unvisited", !hud_room_visited(0, 1));
+    hud_update();
+    hud_render();
+    graphics_vblank();
+    test("hud_visited", hud_room_visited(0, 1));
+    g_player.body.pos.x = INT_TO_FX(300);
+    hud_update();
+    hud_render();
+    test("hud_map_move", hud_get_last_writes() == 2);
+    graphics_vblank();
+
+    /* Test 6: hide blanks everything; the next render redraws it */
+    hud_hide();
+    graphics_vblank();
+    bool blank = hud_map[0] == 0;
+    hud_render();
+    test("hud_hide", blank && hud_get_last_writes() > 0);
+
+    /* Test 7: map reset forgets visits */
+    hud_reset_map();
+    test("hud_reset", !hud_room_visited(0, 1));
+
+    /* Cleanup: the game starts in room 0:0 */
+    hud_hide();
+    graphics_vblank();
+    g_game_time_frames = 0;
+    room_load(0, 0);
+    player_init();
+
+    iprintf("%d/%d hud OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * Frame Pacing Tests
+ * ======================================================================== */
+
+static void run_pacing_tests(void) {
+    iprintf("--- Pacing Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    profiler_reset_session();
+    uint32_t t = 0xFFFF0000u;   /* The first frame crosses the counter wrap */
+    pacing_reset(t);
+
+    /* Test 1: on-time frames (with wake-up jitter) run one step */
+    t += BUS_TICKS_PER_FRAME + 300;
+    int on_time = pacing_frame_begin(t);
+    t += BUS_TICKS_PER_FRAME - 300;
+    test("pace_on_time", on_time == 1 && pacing_frame_begin(t) == 1 &&
+                         pacing_last_caught_up() == 0);
+
+    /* Test 2: two missed VBlanks are made up */
+    t += 3 * BUS_TICKS_PER_FRAME;
+    test("pace_catch_up", pacing_frame_begin(t) == 3 &&
+                          pacing_last_caught_up() == 2 && pacing_last_dropped() == 0);
+
+    /* Test 3: a long stall is capped; the rest is dropped */
+    t += 10 * BUS_TICKS_PER_FRAME;
+    test("pace_capped", pacing_frame_begin(t) == 1 + PACING_MAX_CATCHUP &&
+                        pacing_last_dropped() == 9 - PACING_MAX_CATCHUP);
+
+    /* Test 4: the profiler session counts both */
+    test("pace_profiler", profiler_session_caught_up() == 2 + PACING_MAX_CATCHUP &&
+                          profiler_session_dropped() == 9 - PACING_MAX_CATCHUP);
+
+    /* Cleanup */
+    profiler_reset_session();
+
+    iprintf("%d/%d pacing OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
+/* ========================================================================
+ * ARM7 Job Tests
+ * ======================================================================== */
+
+static void run_coproc_tests(void) {
+    iprintf("--- Coproc Tests ---\n");
+    int pre_passed = tests_passed;
+    int pre_total = tests_total;
+
+    coproc_flush();
+    static u8 out[COPROC_ROUND(64)] COPROC_ALIGN;
+    static const u8 runs[] = {
+        0x01, 'A', 'B', 0x24, 'C', 0x44, 'D', 'E', 0x63, 'a', 0xFF
+    };
+
+    /* Test 1: LZ job expands into dst */
+    memset(out, 0, sizeof(out));
+    CoprocJob lz = coproc_submit(COPROC_JOB_LZ, runs, sizeof(runs), out, sizeof(out));
+    test("coproc_lz", coproc_wait(lz) == 16 && coproc_done(lz) &&
+                      memcmp(out, "ABCCCCCDEDEDabcd", 16) == 0);
+
+    /* Test 2: checksum job matches the save code's checksum */
+    uint8_t hi, lo;
+    save_checksum(runs, sizeof(runs), &hi, &lo);
+    CoprocJob chk = coproc_submit(COPROC_JOB_CHECKSUM, runs, sizeof(runs), NULL, 0);
+    test("coproc_checksum", coproc_wait(chk) == ((hi << 8) | lo));
+
+    /* Test 3: every handle keeps its own result, in submission order */
+    CoprocJob a = coproc_submit(COPROC_JOB_CHECKSUM, runs, sizeof(runs), NULL, 0);
+    CoprocJob b = coproc_submit(COPROC_JOB_CHECKSUM, runs, 2, NULL, 0);
+    coproc_flush();
+    test("coproc_order", b == a + 1 && coproc_pending() == 0 &&
+                         coproc_result(a) == ((hi << 8) | lo) &&
+                         coproc_result(b) == (runs[0] << 8 | runs[1]));
+
+    /* Test 4: results expire once their slot is reused */
+    for (int i = 0; i < COPROC_QUEUE_MAX; i++) {
+        coproc_submit(COPROC_JOB_CHECKSUM, runs, 2, NULL, 0);
+    }
+    coproc_flush();
+    test("coproc_expired", coproc_result(a) == -1 && coproc_result(b) == -1 &&
+                           coproc_result(b + COPROC_QUEUE_MAX) >= 0);
+
+    /* Test 5: a descriptor's message is its cache line in main RAM */
+    CoprocDesc* d = coproc_desc_from_msg(0x1234);
+    test("coproc_msg", (uintptr_t)d == COPROC_MAIN_RAM + 0x1234 * COPROC_CACHE_LINE &&
+                       coproc_msg_from_desc(d) == 0x1234);
+
+    /* Test 6: split pack read parses the same room as a one-shot read */
+    static RoomData split;
+    room_pack_read(0, 1, &g_current_room);
+    bool begun = room_pack_read_begin(0, 1);
+    test("coproc_pack_split", begun && room_pack_read_ready() &&
+                              room_pack_read_end(&split) &&
+                              split.width_tiles == g_current_room.width_tiles &&
+                              memcmp(split.tilemap, g_current_room.tilemap,
+                                     sizeof(split.tilemap)) == 0 &&
+                              !room_pack_read_ready());
+
+    /* Test 7: a saved slot's checksum is stored before anyone reads it */
+    SaveData sd = { .hp = 99, .hp_max = 99 };
+    save_write(0, &sd);
+    bool chk_pending = save_flush_pending();
+    SaveData back;
+    test("coproc_save", chk_pending && save_read(0, &back) && back.hp == 99 &&
+                        save_slot_valid(0));
+    save_delete(0);
+    save_flush_sync();
+
+    /* Cleanup: restore room (0,0) */
+    room_load(0, 0);
+
+    iprintf("%d/%d coproc OK\n",
+            tests_passed - pre_passed,
+            tests_total - pre_total);
+}
+
 /* ========================================================================
  * Run All Tests
  * ======================================================================== */
@@ -1116,6 +2624,22 @@ static void run_all_tests(void) {
     run_player_tests();
     run_audio_tests();
     run_save_tests();
+    run_oam_tests();
+    run_lz_tests();
+    run_upload_tests();
+    run_tile_anim_tests();
+    run_hblank_tests();
+    run_profiler_tests();
+    run_replay_tests();
+    run_snapshot_tests();
+    run_log_tests();
+    run_hud_tests();
+    run_pacing_tests();
+    run_coproc_tests();
+
+    /* Tests break blocks and collect items; don't let the game see them */
+    room_cache_clear();
+    log_flush();
 
     iprintf("\nTOTAL: %d/%d passed\n", tests_passed, tests_total);
     if (tests_passed == tests_total) {
@@ -1132,47 +2656,183 @@ static void run_all_tests(void) {
  * Main Entry Point
  * ======================================================================== */
 
+/* ========================================================================
+ * Debug Keys (held with DEBUG_KEY_MODIFIER)
+ * ======================================================================== */
+
+static bool session_reset_pending;
+
+/* Put the game back in its boot state so a replay sees the same world.
+ * Rooms are reloaded fresh; gameplay_enter re-inits everything else.
+ * Runs at the top of the frame, before the first replayed input_update(),
+ * so recording and playback both see title_enter on frame 0. */
+static void apply_session_reset(void) {
+    if (!session_reset_pending) return;
+    session_reset_pending = false;
+
+    room_unload();
+    room_cache_clear();
+    state_set(STATE_TITLE);
+    profiler_reset_session();
+}
+
+static void start_playback(void) {
+    if (input_replay_load(REPLAY_FILE_NAME) && input_replay_play()) {
+        session_reset_pending = true;
+        LOG_INFO("replay: playing %lu frames\n",
+                 (unsigned long)input_replay_length());
+    } else {
+        LOG_WARN("replay: no valid %s\n", REPLAY_FILE_NAME);
+    }
+}
+
+static void update_replay(void) {
+    if (input_replay_mode() != REPLAY_FINISHED) return;
+
+    profiler_log_session("replay");
+    input_replay_stop();
+}
+
+static void handle_debug_keys(void) {
+    /* Recorded debug chords must not act again during playback */
+    if (input_replay_mode() == REPLAY_PLAYING) return;
+    if (!input_held(DEBUG_KEY_MODIFIER)) return;
+
+    if (input_pressed(DEBUG_KEY_PROFILER))
+        profiler_toggle_overlay();
+
+    if (input_pressed(DEBUG_KEY_RECORD)) {
+        if (input_replay_mode() == REPLAY_RECORDING) {
+            input_replay_stop();
+            bool ok = input_replay_save(REPLAY_FILE_NAME);
+            LOG_INFO("replay: saved %lu frames %s\n",
+                     (unsigned long)input_replay_length(),
+                     ok ? "ok" : "FAILED");
+        } else {
+            input_replay_record();
+            session_reset_pending = true;
+            LOG_INFO("replay: recording\n");
+        }
+    }
+
+    if (input_pressed(DEBUG_KEY_PLAYBACK))
+        start_playback();
+
+    /* Snapshots only make sense of a running game */
+    if (state_current() == STATE_GAMEPLAY) {
+        if (input_pressed(DEBUG_KEY_SNAP_SAVE)) {
+            bool ok = snapshot_quick_save();
+            LOG_INFO("snapshot: save %s\n", ok ? "ok" : "FAILED");
+        }
+        if (input_pressed(DEBUG_KEY_SNAP_LOAD)) {
+            bool ok = snapshot_quick_load();
+            LOG_INFO("snapshot: load %s\n", ok ? "ok" : "FAILED");
+        }
+    }
+}
+
+/* One fixed simulation step. Catch-up steps have no fresh scanKeys, so
+ * input_update sees the same held keys (no new edges) and a replay
+ * still advances one recorded frame per step. */
+static void simulate_step(void) {
+    apply_session_reset();
+    input_update();
+    update_replay();
+    handle_debug_keys();
+    state_update();
+    audio_update();
+}
+
 int main(int argc, char* argv[]) {
     defaultExceptionHandler();
 
     /* Initialize graphics hardware */
     graphics_init();
 
-    /* Console on sub engine BG3 for debug text / HUD.
+    /* Console on sub engine BG3 for debug text and menus.
      * Map base 4, tile base 3 -- no conflict with HUD/MAP layers. */
     consoleInit(NULL, 3, BgType_Text4bpp, BgSize_T_256x256, 4, 3, false, true);
 
     /* Initialize subsystems */
+    coproc_init();          /* Before anything queues ARM7 jobs */
+    hud_init();
+    profiler_init();
     room_init();
     camera_init();
     audio_init();
     save_init();
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+    log_mount(LOG_FILE_PATH);
+#endif
+
+    /* Room pack and soundbank are optional: without them rooms load from
+     * the built-in set and the game runs muted */
+    bool nitro_ok = nitroFSInit(NULL);
+    if (!nitro_ok || !room_pack_mount(ROOM_PACK_PATH)) {
+        LOG_WARN("Room pack unavailable, using built-in rooms\n");
+    }
+    if (!nitro_ok || !audio_mount(AUDIO_SOUNDBANK_PATH)) {
+        LOG_WARN("Soundbank unavailable, audio muted\n");
+    }
 
 #ifdef DEBUG_TESTS
     run_all_tests();
 #endif
 
+    /* After the tests, which check the built-in boss programs */
+    if (nitro_ok) boss_mount(BOSS_PROGRAM_DIR);
+
+#ifdef DEBUG_BENCH
+    bool bench_ok = bench_run_all();
+#endif
+    log_flush();
+
     /* Initialize state manager and register game states */
     state_init();
     gameplay_register_states();
 
-    fprintf(stderr, "SuperMetroidDS: M17 boot complete\n");
+    LOG_INFO("SuperMetroidDS: M17 boot complete\n");
 
     /* Start at title screen */
     state_set(STATE_TITLE);
 
-    /* Main loop */
+#ifdef REPLAY_AUTOPLAY
+    start_playback();
+#endif
+
+    /* Main loop: missed VBlanks are made up by extra steps (pacing.h),
+     * rendered once */
+    pacing_reset(profiler_ticks());
     while (pmMainLoop()) {
         swiWaitForVBlank();
+        int steps = pacing_frame_begin(profiler_ticks());
+        profiler_frame_begin();
+        profiler_begin(PROF_UPLOAD);
+        graphics_vblank();
+        profiler_end(PROF_UPLOAD);
         scanKeys();
 
-        input_update();
-        state_update();
+        for (int i = 0; i < steps; i++) simulate_step();
+        save_flush_update();
 
         graphics_begin_frame();
         state_render();
+        profiler_render_overlay();
         graphics_end_frame();
+        profiler_frame_end();
+
+        /* Outside the profiled frame: console/FAT output can block */
+        log_drain(LOG_DRAIN_BUDGET);
     }
+    log_flush();
 
-    return 0;
+    /* Only reached on the host build, where pmMainLoop() returns false */
+    int exit_code = 0;
+#ifdef DEBUG_TESTS
+    if (tests_passed != tests_total) exit_code = 1;
+#endif
+#ifdef DEBUG_BENCH
+    if (!bench_ok) exit_code = 1;
+#endif
+    return exit_code;
 }
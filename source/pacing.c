@@ -0,0 +1,46 @@
+/**
+ * pacing.c - Frame pacing (fixed simulation step, catch-up on lag)
+ *
+ * The loop wakes at the start of VBlank, so consecutive wake-ups are a
+ * whole number of video frames apart plus a little wake-up jitter.
+ * Rounding the elapsed ticks to frames absorbs the jitter; anything
+ * past one frame is VBlanks the previous frame missed. Lag is not
+ * carried over: a stall longer than the cap costs real time once rather
+ * than keeping the loop behind.
+ */
+
+#include "pacing.h"
+#include "sm_config.h"
+#include "profiler.h"
+
+static uint32_t last_ticks;
+static int      last_caught_up;
+static int      last_dropped;
+
+void pacing_reset(uint32_t now_ticks) {
+    last_ticks = now_ticks;
+    last_caught_up = 0;
+    last_dropped = 0;
+}
+
+int pacing_frame_begin(uint32_t now_ticks) {
+    uint32_t elapsed = now_ticks - last_ticks;      /* Wrap-safe */
+    last_ticks = now_ticks;
+
+    uint32_t frames = (elapsed + BUS_TICKS_PER_FRAME / 2) / BUS_TICKS_PER_FRAME;
+    uint32_t missed = (frames > 1) ? frames - 1 : 0;
+
+    last_caught_up = (missed > PACING_MAX_CATCHUP) ? PACING_MAX_CATCHUP
+                                                   : (int)missed;
+    last_dropped = (int)(missed - (uint32_t)last_caught_up);
+    profiler_frame_pacing(last_caught_up, last_dropped);
+    return 1 + last_caught_up;
+}
+
+int pacing_last_caught_up(void) {
+    return last_caught_up;
+}
+
+int pacing_last_dropped(void) {
+    return last_dropped;
+}
@@ -2,6 +2,8 @@
  * physics.c - Physics engine
  *
  * Gravity, velocity integration, tile-based collision resolution.
+ * Hitbox span tests use the room's packed solid bitmaps
+ * (room_row_has_solid / room_col_has_solid).
  * All values use 16.16 fixed-point matching exact SNES NTSC constants.
  *
  * Collision uses axis-separated movement:
@@ -27,34 +29,6 @@ static inline int fx_to_tile(fx32 pos) {
     return FX_TO_INT(pos) >> TILE_SHIFT;
 }
 
-/* Returns true if collision type acts as solid for movement */
-static inline bool is_collision_solid(uint8_t coll) {
-    if (coll == COLL_SOLID) return true;
-    /* Special blocks (0x20-0x2F) are solid until broken */
-    if ((coll & 0xF0) == COLL_SPECIAL_BASE) return true;
-    return false;
-}
-
-/* Check if any tile in a horizontal range at a given row is solid */
-static bool row_has_solid(int tile_x_min, int tile_x_max, int tile_y) {
-    for (int tx = tile_x_min; tx <= tile_x_max; tx++) {
-        if (is_collision_solid(room_get_collision(tx, tile_y))) {
-            return true;
-        }
-    }
-    return false;
-}
-
-/* Check if any tile in a vertical range at a given column is solid */
-static bool col_has_solid(int tile_x, int tile_y_min, int tile_y_max) {
-    for (int ty = tile_y_min; ty <= tile_y_max; ty++) {
-        if (is_collision_solid(room_get_collision(tile_x, ty))) {
-            return true;
-        }
-    }
-    return false;
-}
-
 /* ========================================================================
  * Horizontal Collision Resolution
  *
@@ -63,9 +37,10 @@ static bool col_has_solid(int tile_x, int tile_y_min, int tile_y_max) {
  *
  * Safe against tunneling as long as |vel.x| < TILE_SIZE per frame.
  * Max horizontal speed is 14 px/f (shinespark); TILE_SIZE = 16.
+ * Faster bodies take the swept path below instead.
  * ======================================================================== */
 
-static void resolve_horizontal(PhysicsBody* body) {
+SM_ITCM static void resolve_horizontal(PhysicsBody* body) {
     fx32 top    = body->pos.y - body->hitbox.half_h;
     fx32 bottom = body->pos.y + body->hitbox.half_h;
 
@@ -78,7 +53,7 @@ static void resolve_horizontal(PhysicsBody* body) {
         fx32 right = body->pos.x + body->hitbox.half_w;
         int tile_x = fx_to_tile(right - 1);
 
-        if (col_has_solid(tile_x, tile_t, tile_b)) {
+        if (room_col_has_solid(tile_x, tile_t, tile_b)) {
             /* Snap: body right edge = solid tile's left edge */
             body->pos.x = INT_TO_FX(tile_x * TILE_SIZE) - body->hitbox.half_w;
             body->vel.x = 0;
@@ -89,7 +64,7 @@ static void resolve_horizontal(PhysicsBody* body) {
         fx32 left = body->pos.x - body->hitbox.half_w;
         int tile_x = fx_to_tile(left);
 
-        if (col_has_solid(tile_x, tile_t, tile_b)) {
+        if (room_col_has_solid(tile_x, tile_t, tile_b)) {
             /* Snap: body left edge = solid tile's right edge */
             body->pos.x = INT_TO_FX((tile_x + 1) * TILE_SIZE) + body->hitbox.half_w;
             body->vel.x = 0;
@@ -103,9 +78,10 @@ static void resolve_horizontal(PhysicsBody* body) {
  *
  * After moving pos.y by vel.y, check leading edge against solid tiles.
  * Also provides ground sensor when vel.y == 0.
+ * Same |vel.y| < TILE_SIZE assumption as horizontal.
  * ======================================================================== */
 
-static void resolve_vertical(PhysicsBody* body) {
+SM_ITCM static void resolve_vertical(PhysicsBody* body) {
     fx32 left  = body->pos.x - body->hitbox.half_w;
     fx32 right = body->pos.x + body->hitbox.half_w;
 
@@ -118,7 +94,7 @@ static void resolve_vertical(PhysicsBody* body) {
         fx32 bottom = body->pos.y + body->hitbox.half_h;
         int tile_y = fx_to_tile(bottom - 1);
 
-        if (row_has_solid(tile_l, tile_r, tile_y)) {
+        if (room_row_has_solid(tile_l, tile_r, tile_y)) {
             /* Land: body bottom = solid tile's top edge */
             body->pos.y = INT_TO_FX(tile_y * TILE_SIZE) - body->hitbox.half_h;
             body->vel.y = 0;
@@ -129,7 +105,7 @@ static void resolve_vertical(PhysicsBody* body) {
         fx32 top = body->pos.y - body->hitbox.half_h;
         int tile_y = fx_to_tile(top);
 
-        if (row_has_solid(tile_l, tile_r, tile_y)) {
+        if (room_row_has_solid(tile_l, tile_r, tile_y)) {
             /* Hit ceiling: body top = solid tile's bottom edge */
             body->pos.y = INT_TO_FX((tile_y + 1) * TILE_SIZE) + body->hitbox.half_h;
             body->vel.y = 0;
@@ -138,6 +114,97 @@ static void resolve_vertical(PhysicsBody* body) {
     }
 }
 
+/* ========================================================================
+ * Swept Movement (fast bodies)
+ *
+ * At |vel| >= SWEEP_THRESHOLD the leading edge can jump over a whole
+ * tile in one frame. Instead of moving then resolving, walk the tile
+ * boundaries the leading edge crosses between the old and new position
+ * and stop at the first solid column/row. Cost is one span query per
+ * tile crossed, so slow bodies keep the cheap path above.
+ * ======================================================================== */
+
+#define SWEEP_THRESHOLD INT_TO_FX(TILE_SIZE)
+
+SM_ITCM static void sweep_horizontal(PhysicsBody* body) {
+    int tile_t = fx_to_tile(body->pos.y - body->hitbox.half_h);
+    int tile_b = fx_to_tile(body->pos.y + body->hitbox.half_h - 1);
+
+    if (body->vel.x > 0) {
+        fx32 edge = body->pos.x + body->hitbox.half_w - 1;
+        int tile_end = fx_to_tile(edge + body->vel.x);
+        for (int tx = fx_to_tile(edge) + 1; tx <= tile_end; tx++) {
+            if (room_col_has_solid(tx, tile_t, tile_b)) {
+                body->pos.x = INT_TO_FX(tx * TILE_SIZE) - body->hitbox.half_w;
+                body->vel.x = 0;
+                body->contact.on_wall_right = true;
+                return;
+            }
+        }
+    } else {
+        fx32 edge = body->pos.x - body->hitbox.half_w;
+        int tile_end = fx_to_tile(edge + body->vel.x);
+        for (int tx = fx_to_tile(edge) - 1; tx >= tile_end; tx--) {
+            if (room_col_has_solid(tx, tile_t, tile_b)) {
+                body->pos.x = INT_TO_FX((tx + 1) * TILE_SIZE) + body->hitbox.half_w;
+                body->vel.x = 0;
+                body->contact.on_wall_left = true;
+                return;
+            }
+        }
+    }
+    body->pos.x += body->vel.x;
+}
+
+SM_ITCM static void sweep_vertical(PhysicsBody* body) {
+    int tile_l = fx_to_tile(body->pos.x - body->hitbox.half_w);
+    int tile_r = fx_to_tile(body->pos.x + body->hitbox.half_w - 1);
+
+    if (body->vel.y > 0) {
+        fx32 edge = body->pos.y + body->hitbox.half_h - 1;
+        int tile_end = fx_to_tile(edge + body->vel.y);
+        for (int ty = fx_to_tile(edge) + 1; ty <= tile_end; ty++) {
+            if (room_row_has_solid(tile_l, tile_r, ty)) {
+                body->pos.y = INT_TO_FX(ty * TILE_SIZE) - body->hitbox.half_h;
+                body->vel.y = 0;
+                body->contact.on_ground = true;
+                return;
+            }
+        }
+    } else {
+        fx32 edge = body->pos.y - body->hitbox.half_h;
+        int tile_end = fx_to_tile(edge + body->vel.y);
+        for (int ty = fx_to_tile(edge) - 1; ty >= tile_end; ty--) {
+            if (room_row_has_solid(tile_l, tile_r, ty)) {
+                body->pos.y = INT_TO_FX((ty + 1) * TILE_SIZE) + body->hitbox.half_h;
+                body->vel.y = 0;
+                body->contact.on_ceiling = true;
+                return;
+            }
+        }
+    }
+    body->pos.y += body->vel.y;
+}
+
+/* Move along X and resolve, choosing the swept path for fast bodies */
+SM_ITCM static void move_horizontal(PhysicsBody* body) {
+    if (body->vel.x >= SWEEP_THRESHOLD || body->vel.x <= -SWEEP_THRESHOLD) {
+        sweep_horizontal(body);
+    } else {
+        body->pos.x += body->vel.x;
+        resolve_horizontal(body);
+    }
+}
+
+SM_ITCM static void move_vertical(PhysicsBody* body) {
+    if (body->vel.y >= SWEEP_THRESHOLD || body->vel.y <= -SWEEP_THRESHOLD) {
+        sweep_vertical(body);
+    } else {
+        body->pos.y += body->vel.y;
+        resolve_vertical(body);
+    }
+}
+
 /* ========================================================================
  * Ground Sensor
  *
@@ -145,7 +212,7 @@ static void resolve_vertical(PhysicsBody* body) {
  * Sets on_ground if solid. Used when vel.y == 0 to confirm standing.
  * ======================================================================== */
 
-static void check_ground_sensor(PhysicsBody* body) {
+SM_ITCM static void check_ground_sensor(PhysicsBody* body) {
     if (body->contact.on_ground) return;  /* Already detected by landing */
 
     fx32 sensor_y = body->pos.y + body->hitbox.half_h;
@@ -154,7 +221,7 @@ static void check_ground_sensor(PhysicsBody* body) {
     int tile_l = fx_to_tile(body->pos.x - body->hitbox.half_w);
     int tile_r = fx_to_tile(body->pos.x + body->hitbox.half_w - 1);
 
-    if (row_has_solid(tile_l, tile_r, tile_y)) {
+    if (room_row_has_solid(tile_l, tile_r, tile_y)) {
         body->contact.on_ground = true;
     }
 }
@@ -163,7 +230,7 @@ static void check_ground_sensor(PhysicsBody* body) {
  * Public API
  * ======================================================================== */
 
-void physics_apply_gravity(PhysicsBody* body) {
+SM_ITCM void physics_apply_gravity(PhysicsBody* body) {
     fx32 gravity;
     fx32 terminal;
 
@@ -205,7 +272,7 @@ void physics_resolve_collisions(PhysicsBody* body) {
     check_ground_sensor(body);
 }
 
-void physics_update_body(PhysicsBody* body) {
+SM_ITCM void physics_update_body(PhysicsBody* body) {
     /* 1. Apply gravity (environment-dependent) */
     physics_apply_gravity(body);
 
@@ -216,13 +283,11 @@ void physics_update_body(PhysicsBody* body) {
     /* 3. Clear contact flags */
     memset(&body->contact, 0, sizeof(body->contact));
 
-    /* 4. Move X, resolve X collisions */
-    body->pos.x += body->vel.x;
-    resolve_horizontal(body);
+    /* 4. Move X, resolve X collisions (swept when fast) */
+    move_horizontal(body);
 
-    /* 5. Move Y, resolve Y collisions */
-    body->pos.y += body->vel.y;
-    resolve_vertical(body);
+    /* 5. Move Y, resolve Y collisions (swept when fast) */
+    move_vertical(body);
 
     /* 6. Ground sensor (for standing detection when vel.y == 0) */
     check_ground_sensor(body);
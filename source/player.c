@@ -9,14 +9,20 @@
  *   1. State handler (reads input, sets velocity, triggers transitions)
  *   2. Physics (gravity, integration, collision resolution)
  *   3. Post-physics (landing detection, falling-off-edge detection)
- *   4. Timer decrements
+ *   4. Timer decrements, animation advance
+ *
+ * Animation frames live in a main-RAM bank; player_render streams only
+ * the current frame into OBJ tiles 0-3 (see tile_anim.h).
  */
 
 #include "player.h"
 #include "camera.h"
 #include "input.h"
 #include "graphics.h"
+#include "tile_anim.h"
 #include "room.h"
+#include "audio.h"
+#include "profiler.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -24,7 +30,7 @@
  * Global Player Instance
  * ======================================================================== */
 
-Player g_player;
+SM_DTCM_BSS Player g_player;
 
 /* ========================================================================
  * State Handler Table
@@ -261,10 +267,66 @@ static void post_physics_check(void) {
 }
 
 /* ========================================================================
- * Test Sprite Data
+ * Animation Table / Frame Bank
  * ======================================================================== */
 
-static u8 player_sprite_data[128];  /* 16x16 @ 4bpp = 128 bytes */
+typedef enum {
+    PANIM_STAND = 0,
+    PANIM_RUN,
+    PANIM_JUMP,
+    PANIM_SPIN,
+    PANIM_FALL,
+    PANIM_CROUCH,
+    PANIM_MORPH,
+    PANIM_HURT,
+    PANIM_DEATH,
+    PANIM_COUNT
+} PlayerAnimID;
+
+/* Frames [first, first + count) of the bank, each held for ticks */
+typedef struct {
+    uint8_t first;
+    uint8_t count;
+    uint8_t ticks;
+} PlayerAnimDef;
+
+static const PlayerAnimDef player_anims[PANIM_COUNT] = {
+    [PANIM_STAND]  = {  0,  1, 1 },
+    [PANIM_RUN]    = {  1, 10, 3 },
+    [PANIM_JUMP]   = { 11,  2, 6 },
+    [PANIM_SPIN]   = { 13,  8, 2 },
+    [PANIM_FALL]   = { 21,  1, 1 },
+    [PANIM_CROUCH] = { 22,  1, 1 },
+    [PANIM_MORPH]  = { 23,  8, 3 },
+    [PANIM_HURT]   = { 31,  1, 1 },
+    [PANIM_DEATH]  = { 32,  1, 1 },
+};
+
+#define PLAYER_FRAME_COUNT  33
+#define PLAYER_FRAME_BYTES  128   /* 16x16 @ 4bpp */
+
+static const uint8_t state_anims[PSTATE_COUNT] = {
+    [PSTATE_STANDING]          = PANIM_STAND,
+    [PSTATE_RUNNING]           = PANIM_RUN,
+    [PSTATE_JUMPING]           = PANIM_JUMP,
+    [PSTATE_SPIN_JUMPING]      = PANIM_SPIN,
+    [PSTATE_FALLING]           = PANIM_FALL,
+    [PSTATE_CROUCHING]         = PANIM_CROUCH,
+    [PSTATE_MORPHBALL]         = PANIM_MORPH,
+    [PSTATE_SPRING_BALL]       = PANIM_MORPH,
+    [PSTATE_WALLJUMP]          = PANIM_SPIN,
+    [PSTATE_DAMAGE]            = PANIM_HURT,
+    [PSTATE_DEATH]             = PANIM_DEATH,
+    [PSTATE_SHINESPARK_CHARGE] = PANIM_CROUCH,
+    [PSTATE_SHINESPARK]        = PANIM_JUMP,
+    [PSTATE_GRAPPLE]           = PANIM_JUMP,
+};
+
+/* Placeholder art: green square with a yellow band whose row encodes the
+ * frame number, so streaming is visible on hardware. Real frames will be
+ * loaded into this bank; VRAM use stays one frame either way. */
+static u8 player_frame_bank[PLAYER_FRAME_COUNT][PLAYER_FRAME_BYTES];
+static SpriteStream player_stream;
 
 static const u16 player_palette[16] = {
     RGB15(0, 0, 0),       /* 0: transparent */
@@ -274,6 +336,31 @@ static const u16 player_palette[16] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+/* ========================================================================
+ * Animation
+ * ======================================================================== */
+
+/* Not called while dead: state_death owns anim.frame_timer as its
+ * countdown. A zero timer (fresh from change_state) restarts the anim. */
+static void update_animation(void) {
+    AnimController* a = &g_player.anim;
+    uint8_t id = state_anims[g_player.state];
+    const PlayerAnimDef* def = &player_anims[id];
+
+    if (a->anim_id != id || a->frame_timer == 0) {
+        a->anim_id = id;
+        a->frame_index = 0;
+        a->frame_timer = def->ticks;
+        return;
+    }
+    if (def->count < 2) return;
+
+    if (--a->frame_timer == 0) {
+        a->frame_timer = def->ticks;
+        a->frame_index = (uint16_t)((a->frame_index + 1) % def->count);
+    }
+}
+
 /* ========================================================================
  * Public API
  * ======================================================================== */
@@ -310,9 +397,18 @@ void player_init(void) {
     state_fns[PSTATE_SHINESPARK]      = state_stub;
     state_fns[PSTATE_GRAPPLE]         = state_stub;
 
-    /* Load placeholder sprite (green 16x16 square) */
-    memset(player_sprite_data, 0x22, sizeof(player_sprite_data));
-    graphics_load_sprite_tiles(player_sprite_data, sizeof(player_sprite_data), 0);
+    /* Build placeholder frames; tiles are 8x8 in 1D order (TL,TR,BL,BR) */
+    memset(player_frame_bank, 0x22, sizeof(player_frame_bank));
+    for (int f = 0; f < PLAYER_FRAME_COUNT; f++) {
+        int row = f % 16;
+        int tile = (row >= 8) ? 2 : 0;
+        for (int t = tile; t < tile + 2; t++) {
+            memset(&player_frame_bank[f][t * 32 + (row & 7) * 4], 0x11, 4);
+        }
+    }
+    sprite_stream_init(&player_stream, player_frame_bank,
+                       PLAYER_FRAME_BYTES, 0);
+    sprite_stream_show(&player_stream, 0);
     graphics_load_sprite_palette(0, player_palette);
 }
 
@@ -325,7 +421,9 @@ void player_update(void) {
     }
 
     /* 2. Physics (gravity, integration, collision) */
+    profiler_begin(PROF_PHYSICS);
     physics_update_body(&g_player.body);
+    profiler_end(PROF_PHYSICS);
 
     /* 3. Post-physics state corrections (landing, edge falling, apex) */
     post_physics_check();
@@ -356,35 +454,40 @@ void player_update(void) {
     if (g_player.body.contact.on_ground) {
         int fx = FX_TO_INT(g_player.body.pos.x) >> TILE_SHIFT;
         int fy = FX_TO_INT(g_player.body.pos.y + g_player.body.hitbox.half_h) >> TILE_SHIFT;
-        if (room_get_collision(fx, fy) == COLL_SPECIAL_CRUMBLE) {
-            int w = g_current_room.width_tiles;
-            int idx = fy * w + fx;
-            if (g_current_room.crumble_timer[idx] == 0) {
-                g_current_room.crumble_timer[idx] = 30;  /* 30 frame timer */
-            }
-        }
+        room_start_crumble(fx, fy);
     }
 
     /* 6. Decrement timers */
     if (g_player.invuln_timer > 0) g_player.invuln_timer--;
     if (g_player.shinespark_timer > 0) g_player.shinespark_timer--;
+
+    /* 7. Animation */
+    update_animation();
+}
+
+int player_get_anim_frame(void) {
+    if (g_player.state == PSTATE_DEATH) return player_anims[PANIM_DEATH].first;
+    const PlayerAnimDef* def = &player_anims[g_player.anim.anim_id];
+    return def->first + g_player.anim.frame_index % def->count;
 }
 
 void player_render(void) {
+    sprite_stream_show(&player_stream, player_get_anim_frame());
+
     if (!g_player.alive) {
         /* Death state: show sprite briefly then hide */
         if (g_player.state == PSTATE_DEATH) {
             int sx = FX_TO_INT(g_player.body.pos.x) - FX_TO_INT(g_camera.x) - 8;
             int sy = FX_TO_INT(g_player.body.pos.y) - FX_TO_INT(g_camera.y) - 8;
-            graphics_set_sprite(OAM_PLAYER_START, sx, sy, 0, 0, 1,
-                               g_player.facing == DIR_LEFT, false);
+            graphics_draw_sprite(sx, sy, 0, 0, 1,
+                                 g_player.facing == DIR_LEFT, false,
+                                 SPR_PRIO_PLAYER);
         }
         return;
     }
 
     /* I-frame blink: hide sprite every other 4 frames */
     if (g_player.invuln_timer > 0 && (g_player.invuln_timer & 4)) {
-        graphics_hide_sprite(OAM_PLAYER_START);
         return;
     }
 
@@ -392,8 +495,8 @@ void player_render(void) {
     int sx = FX_TO_INT(g_player.body.pos.x) - FX_TO_INT(g_camera.x) - 8;
     int sy = FX_TO_INT(g_player.body.pos.y) - FX_TO_INT(g_camera.y) - 8;
 
-    graphics_set_sprite(OAM_PLAYER_START, sx, sy, 0, 0, 1,
-                       g_player.facing == DIR_LEFT, false);
+    graphics_draw_sprite(sx, sy, 0, 0, 1, g_player.facing == DIR_LEFT, false,
+                         SPR_PRIO_PLAYER);
 }
 
 void player_damage(int16_t damage) {
@@ -402,6 +505,7 @@ void player_damage(int16_t damage) {
 
     g_player.hp -= damage;
     g_player.invuln_timer = INVULN_FRAMES;
+    audio_play_sfx(SFX_DAMAGE);
 
     if (g_player.hp <= 0) {
         g_player.hp = 0;
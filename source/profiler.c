@@ -0,0 +1,251 @@
+/**
+ * profiler.c - Per-frame CPU profiler
+ *
+ * Timer PROFILER_TIMER runs at the bus clock (33.51 MHz, DIV_1) and
+ * overflows into PROFILER_TIMER+1 in cascade mode, giving a 32-bit free
+ * running counter. Reading it costs two or three 16-bit I/O reads, cheap
+ * enough to leave scopes compiled into release builds.
+ *
+ * History is a static ring of per-frame totals per scope (~2KB).
+ */
+
+#include "profiler.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ========================================================================
+ * State
+ * ======================================================================== */
+
+static uint32_t scope_start[PROF_SCOPE_COUNT];
+static uint32_t scope_accum[PROF_SCOPE_COUNT];     /* ticks this frame */
+
+static uint32_t history[PROF_SCOPE_COUNT][PROF_WINDOW_FRAMES];  /* cycles */
+static int      history_pos;
+static int      history_len;
+
+/* Session totals (since profiler_reset_session) */
+static uint64_t session_sum[PROF_SCOPE_COUNT];
+static uint32_t session_min[PROF_SCOPE_COUNT];
+static uint32_t session_max[PROF_SCOPE_COUNT];
+static uint32_t session_frames;
+static uint32_t session_over;
+static uint32_t session_caught_up;
+static uint32_t session_dropped;
+
+static bool     overlay_visible;
+static bool     overlay_clear_pending;
+static int      overlay_timer;
+
+static const char* const scope_names[PROF_SCOPE_COUNT] = {
+    [PROF_FRAME]      = "FRAME",
+    [PROF_PLAYER]     = "PLAYER",
+    [PROF_PHYSICS]    = "PHYSICS",
+    [PROF_ENEMY]      = "ENEMY",
+    [PROF_PROJECTILE] = "PROJ",
+    [PROF_BOSS]       = "BOSS",
+    [PROF_CAMERA]     = "CAMERA",
+    [PROF_HUD]        = "HUD",
+    [PROF_UPLOAD]     = "UPLOAD",
+};
+
+/* ========================================================================
+ * Timer
+ * ======================================================================== */
+
+uint32_t profiler_ticks(void) {
+    /* High half may tick between the two reads; re-read low if so */
+    uint16_t hi = TIMER_DATA(PROFILER_TIMER + 1);
+    uint16_t lo = TIMER_DATA(PROFILER_TIMER);
+    uint16_t hi2 = TIMER_DATA(PROFILER_TIMER + 1);
+    if (hi2 != hi) {
+        lo = TIMER_DATA(PROFILER_TIMER);
+        hi = hi2;
+    }
+    return ((uint32_t)hi << 16) | lo;
+}
+
+void profiler_init(void) {
+    TIMER_CR(PROFILER_TIMER) = 0;
+    TIMER_CR(PROFILER_TIMER + 1) = 0;
+    TIMER_DATA(PROFILER_TIMER) = 0;
+    TIMER_DATA(PROFILER_TIMER + 1) = 0;
+    TIMER_CR(PROFILER_TIMER + 1) = TIMER_ENABLE | TIMER_CASCADE;
+    TIMER_CR(PROFILER_TIMER) = TIMER_ENABLE | TIMER_DIV_1;
+
+    memset(scope_start, 0, sizeof(scope_start));
+    memset(scope_accum, 0, sizeof(scope_accum));
+    memset(history, 0, sizeof(history));
+    history_pos = 0;
+    history_len = 0;
+    profiler_reset_session();
+    overlay_visible = false;
+    overlay_clear_pending = false;
+    overlay_timer = 0;
+}
+
+/* ========================================================================
+ * Scopes
+ * ======================================================================== */
+
+void profiler_begin(ProfScope scope) {
+    scope_start[scope] = profiler_ticks();
+}
+
+void profiler_end(ProfScope scope) {
+    scope_accum[scope] += profiler_ticks() - scope_start[scope];
+}
+
+void profiler_frame_begin(void) {
+    memset(scope_accum, 0, sizeof(scope_accum));
+    profiler_begin(PROF_FRAME);
+}
+
+void profiler_frame_end(void) {
+    profiler_end(PROF_FRAME);
+
+    for (int s = 0; s < PROF_SCOPE_COUNT; s++) {
+        uint32_t cyc = profiler_ticks_to_cycles(scope_accum[s]);
+        history[s][history_pos] = cyc;
+        session_sum[s] += cyc;
+        if (cyc < session_min[s]) session_min[s] = cyc;
+        if (cyc > session_max[s]) session_max[s] = cyc;
+    }
+    session_frames++;
+    if (history[PROF_FRAME][history_pos] > CYCLES_PER_FRAME) session_over++;
+
+    history_pos = (history_pos + 1) % PROF_WINDOW_FRAMES;
+    if (history_len < PROF_WINDOW_FRAMES) history_len++;
+}
+
+/* ========================================================================
+ * Statistics
+ * ======================================================================== */
+
+void profiler_get_stats(ProfScope scope, ProfStats* out) {
+    memset(out, 0, sizeof(ProfStats));
+    if (scope < 0 || scope >= PROF_SCOPE_COUNT || history_len == 0) return;
+
+    const uint32_t* h = history[scope];
+    int last = (history_pos + PROF_WINDOW_FRAMES - 1) % PROF_WINDOW_FRAMES;
+    out->last = h[last];
+    out->min = 0xFFFFFFFFu;
+
+    uint32_t sum = 0;
+    for (int i = 0; i < history_len; i++) {
+        uint32_t v = h[i];
+        sum += v;
+        if (v < out->min) out->min = v;
+        if (v > out->max) out->max = v;
+    }
+    out->avg = sum / history_len;
+}
+
+void profiler_reset_session(void) {
+    memset(session_sum, 0, sizeof(session_sum));
+    memset(session_max, 0, sizeof(session_max));
+    memset(session_min, 0xFF, sizeof(session_min));
+    session_frames = 0;
+    session_over = 0;
+    session_caught_up = 0;
+    session_dropped = 0;
+}
+
+void profiler_get_session(ProfScope scope, ProfStats* out) {
+    memset(out, 0, sizeof(ProfStats));
+    if (scope < 0 || scope >= PROF_SCOPE_COUNT || session_frames == 0) return;
+
+    int last = (history_pos + PROF_WINDOW_FRAMES - 1) % PROF_WINDOW_FRAMES;
+    out->last = history[scope][last];
+    out->min = session_min[scope];
+    out->max = session_max[scope];
+    out->avg = (uint32_t)(session_sum[scope] / session_frames);
+}
+
+uint32_t profiler_session_frames(void) {
+    return session_frames;
+}
+
+uint32_t profiler_session_over_budget(void) {
+    return session_over;
+}
+
+void profiler_frame_pacing(int caught_up, int dropped) {
+    session_caught_up += (uint32_t)caught_up;
+    session_dropped += (uint32_t)dropped;
+}
+
+uint32_t profiler_session_caught_up(void) {
+    return session_caught_up;
+}
+
+uint32_t profiler_session_dropped(void) {
+    return session_dropped;
+}
+
+void profiler_log_session(const char* label) {
+    fprintf(stderr, "prof: %s frames=%lu over_budget=%lu "
+            "caught_up=%lu dropped=%lu\n",
+            label, (unsigned long)session_frames, (unsigned long)session_over,
+            (unsigned long)session_caught_up, (unsigned long)session_dropped);
+    for (int s = 0; s < PROF_SCOPE_COUNT; s++) {
+        ProfStats st;
+        profiler_get_session((ProfScope)s, &st);
+        fprintf(stderr, "prof:   %-8s min=%lu avg=%lu max=%lu\n",
+                scope_names[s], (unsigned long)st.min,
+                (unsigned long)st.avg, (unsigned long)st.max);
+    }
+}
+
+/* ========================================================================
+ * Overlay
+ *
+ * One row per scope: name, min/avg/max in kcycles, avg as % of the
+ * CYCLES_PER_FRAME budget, then the session's caught-up/dropped steps.
+ * Redrawn at a low rate so iprintf itself doesn't dominate the numbers
+ * it reports.
+ * ======================================================================== */
+
+void profiler_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+    overlay_timer = 0;
+    if (!overlay_visible) overlay_clear_pending = true;
+}
+
+bool profiler_overlay_visible(void) {
+    return overlay_visible;
+}
+
+void profiler_render_overlay(void) {
+    if (overlay_clear_pending) {
+        /* Blank the rows we used */
+        for (int r = 0; r <= PROF_SCOPE_COUNT + 1; r++) {
+            iprintf("\x1b[%d;0H%-32s", PROF_OVERLAY_ROW + r, "");
+        }
+        overlay_clear_pending = false;
+    }
+    if (!overlay_visible) return;
+    if (overlay_timer > 0) {
+        overlay_timer--;
+        return;
+    }
+    overlay_timer = PROF_OVERLAY_INTERVAL;
+
+    iprintf("\x1b[%d;0H%-8s %5s %5s %5s %3s  ", PROF_OVERLAY_ROW,
+            "kcyc", "min", "avg", "max", "%");
+
+    for (int s = 0; s < PROF_SCOPE_COUNT; s++) {
+        ProfStats st;
+        profiler_get_stats((ProfScope)s, &st);
+        iprintf("\x1b[%d;0H%-8s %5lu %5lu %5lu %3lu  ",
+                PROF_OVERLAY_ROW + 1 + s, scope_names[s],
+                (unsigned long)(st.min / 1000),
+                (unsigned long)(st.avg / 1000),
+                (unsigned long)(st.max / 1000),
+                (unsigned long)((uint64_t)st.avg * 100 / CYCLES_PER_FRAME));
+    }
+    iprintf("\x1b[%d;0H%-8s %5lu %-5s %5lu    ",
+            PROF_OVERLAY_ROW + 1 + PROF_SCOPE_COUNT, "catchup",
+            (unsigned long)session_caught_up, "drop",
+            (unsigned long)session_dropped);
+}
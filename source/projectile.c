@@ -4,6 +4,8 @@
  * Fixed-size pool (MAX_PROJECTILES=32) with swap-remove.
  * Handles beams, missiles, bombs, enemy bullets.
  * Collision: projectile vs enemy, projectile vs player, projectile vs tiles.
+ * Enemy/boss candidates come from the broadphase grid, rebuilt once at
+ * the start of projectile_update_all after enemies and boss have moved.
  *
  * Beams travel in facing direction, destroyed on wall hit (except Wave).
  * Bombs sit in place, explode on timer, apply bomb jump to nearby player.
@@ -15,6 +17,7 @@
 #include "player.h"
 #include "enemy.h"
 #include "boss.h"
+#include "broadphase.h"
 #include "room.h"
 #include "graphics.h"
 #include "fixed_math.h"
@@ -25,7 +28,7 @@
  * Projectile Pool
  * ======================================================================== */
 
-static Projectile pool[MAX_PROJECTILES];
+SM_DTCM_BSS static Projectile pool[MAX_PROJECTILES];
 static int active_count;
 
 /* ========================================================================
@@ -80,13 +83,6 @@ static const ProjTypeDef proj_defs[PROJ_TYPE_COUNT] = {
     [PROJ_ENEMY_BULLET]  = {  10, INT_TO_FX(2),  120, INT_TO_FX(3), INT_TO_FX(3), false, false },
 };
 
-/* Solid tile test (matches physics.c is_collision_solid logic) */
-static inline bool tile_is_solid(uint8_t coll) {
-    if (coll == COLL_SOLID) return true;
-    if ((coll & 0xF0) == COLL_SPECIAL_BASE) return true;
-    return false;
-}
-
 /* ========================================================================
  * AABB Overlap Check
  * ======================================================================== */
@@ -109,12 +105,12 @@ static void bomb_explode(Projectile* p) {
     AABBfx blast = { def->half_w, def->half_h };
 
     /* Damage enemies in blast radius */
-    for (int e = enemy_get_count() - 1; e >= 0; e--) {
-        Enemy* en = enemy_get(e);
-        if (!en) continue;
-        if (aabb_overlap(p->pos, blast, en->body.pos, en->body.hitbox)) {
-            enemy_damage(e, def->damage);
-        }
+    BroadphaseRef hits[BP_MAX_ENTITIES];
+    int n = broadphase_query(p->pos, blast, BP_MASK_ENEMY, hits, BP_MAX_ENTITIES);
+    for (int h = 0; h < n; h++) {
+        Enemy* en = enemy_get(hits[h].index);
+        if (!en || !en->active) continue;  /* Killed earlier this frame */
+        enemy_damage(hits[h].index, def->damage);
     }
 
     /* Break bomb blocks in blast radius */
@@ -147,22 +143,23 @@ static void bomb_explode(Projectile* p) {
  * Collision: Player Projectile vs Enemies
  * ======================================================================== */
 
-static void check_enemy_hits(int proj_idx) {
+SM_ITCM static void check_enemy_hits(int proj_idx) {
     Projectile* p = &pool[proj_idx];
     const ProjTypeDef* def = &proj_defs[p->type];
     AABBfx pbox = { p->hitbox.half_w, p->hitbox.half_h };
 
-    for (int e = enemy_get_count() - 1; e >= 0; e--) {
-        Enemy* en = enemy_get(e);
-        if (!en) continue;
+    BroadphaseRef hits[BP_MAX_ENTITIES];
+    int n = broadphase_query(p->pos, pbox, BP_MASK_ENEMY, hits, BP_MAX_ENTITIES);
 
-        if (aabb_overlap(p->pos, pbox, en->body.pos, en->body.hitbox)) {
-            enemy_damage(e, p->damage);
+    for (int h = 0; h < n; h++) {
+        Enemy* en = enemy_get(hits[h].index);
+        if (!en || !en->active) continue;  /* Killed earlier this frame */
 
-            if (!def->enemy_pass) {
-                p->active = false;
-                return;
-            }
+        enemy_damage(hits[h].index, p->damage);
+
+        if (!def->enemy_pass) {
+            p->active = false;
+            return;
         }
     }
 }
@@ -177,11 +174,24 @@ static void check_boss_hit(int proj_idx) {
     Projectile* p = &pool[proj_idx];
     AABBfx pbox = { p->hitbox.half_w, p->hitbox.half_h };
 
-    if (aabb_overlap(p->pos, pbox, g_boss.body.pos, g_boss.body.hitbox)) {
-        boss_damage(p->damage);
-        /* Destroy projectile on hit (boss is always blocking) */
-        p->active = false;
+    BroadphaseRef hits[BOSS_MAX_PARTS];
+    int n = broadphase_query(p->pos, pbox, BP_MASK_BOSS, hits, BOSS_MAX_PARTS);
+    if (n == 0) return;
+
+    /* Overlapping parts: the one that takes the most damage gets the hit */
+    int best = hits[0].index;
+    int32_t best_damage = boss_part_damage(best, p->damage);
+    for (int h = 1; h < n; h++) {
+        int32_t d = boss_part_damage(hits[h].index, p->damage);
+        if (d > best_damage) {
+            best = hits[h].index;
+            best_damage = d;
+        }
     }
+    boss_damage_part(best, p->damage);
+
+    /* Destroy projectile on hit (every part blocks, armor included) */
+    p->active = false;
 }
 
 /* ========================================================================
@@ -261,7 +271,10 @@ void projectile_clear_all(void) {
  * Public API: Per-Frame Update
  * ======================================================================== */
 
-void projectile_update_all(void) {
+SM_ITCM void projectile_update_all(void) {
+    /* Enemies and boss have moved for this frame: bucket them once */
+    broadphase_build();
+
     for (int i = active_count - 1; i >= 0; i--) {
         Projectile* p = &pool[i];
         if (!p->active) {
@@ -303,7 +316,7 @@ void projectile_update_all(void) {
             int tile_x = FX_TO_INT(p->pos.x) >> TILE_SHIFT;
             int tile_y = FX_TO_INT(p->pos.y) >> TILE_SHIFT;
             uint8_t coll = room_get_collision(tile_x, tile_y);
-            if (tile_is_solid(coll)) {
+            if (room_coll_is_solid(coll)) {
                 p->active = false;
                 projectile_remove(i);
                 continue;
@@ -356,19 +369,32 @@ void projectile_render_all(void) {
         int sx = FX_TO_INT(p->pos.x) - cam_x - 8;
         int sy = FX_TO_INT(p->pos.y) - cam_y - 8;
 
-        int oam_idx = OAM_PROJ_START + i;
-
         /* Cull off-screen */
         if (sx < -16 || sx > SCREEN_WIDTH || sy < -16 || sy > SCREEN_HEIGHT) {
-            graphics_hide_sprite(oam_idx);
             continue;
         }
 
-        graphics_set_sprite(oam_idx, sx, sy, 8, 2, 0, false, false);
+        graphics_draw_sprite(sx, sy, 8, 2, 0, false, false, SPR_PRIO_HIGH);
     }
+}
 
-    /* Hide unused projectile OAM slots */
-    for (int i = active_count; i < OAM_PROJ_COUNT && i < MAX_PROJECTILES; i++) {
-        graphics_hide_sprite(OAM_PROJ_START + i);
-    }
+/* ========================================================================
+ * Snapshot
+ * ======================================================================== */
+
+void projectile_snapshot_save(SnapshotWriter* w) {
+    snapshot_write(w, &active_count, sizeof(active_count));
+    snapshot_write(w, pool, active_count * sizeof(Projectile));
+}
+
+void projectile_snapshot_load(SnapshotReader* r) {
+    int count = 0;
+    snapshot_read(r, &count, sizeof(count));
+    if (count < 0 || count > MAX_PROJECTILES) r->ok = false;
+    if (!r->ok) return;
+
+    projectile_clear_all();
+    active_count = count;
+    snapshot_read(r, pool, active_count * sizeof(Projectile));
+    if (active_count > 0) load_proj_sprites();
 }
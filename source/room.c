@@ -3,25 +3,151 @@
  *
  * Single global room, O(1) tile collision queries, VRAM upload.
  * Multi-room world with door connections (M17a).
- * Currently uses hardcoded test rooms.
- * Will be replaced with bin2o-embedded ROM data when asset pipeline is complete.
+ * Destructible terrain is redrawn through a dirty-tile queue: changed
+ * metatiles are re-expanded into 2x2 BG map patches instead of a
+ * full map rebuild.
+ * Rooms larger than the 512x512 hardware BG are shown through a 32x32
+ * metatile window that wraps around the BG map; camera movement streams
+ * in newly exposed columns/rows (see Scroll Streaming).
+ * Rooms come from the NitroFS room pack, with the hardcoded test rooms
+ * as fallback, and are built in a second buffer first so a door can
+ * prefetch its destination (see Room Prefetch).
  */
 
 #include "room.h"
 #include "graphics.h"
+#include "tile_anim.h"
+#include "room_pack.h"
+#include "log.h"
+#include <stddef.h>
 #include <string.h>
-#include <stdio.h>
 
 /* The single global room instance */
 RoomData g_current_room;
+SM_DTCM_BSS RoomSolidMap g_room_solid;
 
 /* ========================================================================
- * Static BG map buffer for VRAM upload
+ * Static BG map buffers for VRAM upload
  * 512x512 BG = 64x64 tile entries = 8192 bytes.
  * Too large for DTCM stack (~16KB total), so it's static.
+ * Two buffers: the live room's map and the one the prefetched room is
+ * expanded into. They swap when a prefetched room is committed.
  * ======================================================================== */
 
-static u16 vram_bgmap[64 * 64];
+static u16  bgmap_buffers[2][64 * 64];
+static u16* vram_bgmap = bgmap_buffers[0];
+
+/* ========================================================================
+ * Dirty Metatile Queue
+ *
+ * Metatile indices (y * width + x) whose tilemap entry changed since the
+ * last flush. Deduplicated on insert. If more tiles change in one frame
+ * than the queue holds, the next flush falls back to a full upload.
+ * ======================================================================== */
+
+#define ROOM_DIRTY_MAX 32
+
+static uint16_t dirty_tiles[ROOM_DIRTY_MAX];
+static int      dirty_count;
+static bool     dirty_overflow;
+
+static void mark_tile_dirty(int idx) {
+    if (dirty_overflow) return;
+    for (int i = 0; i < dirty_count; i++) {
+        if (dirty_tiles[i] == idx) return;
+    }
+    if (dirty_count >= ROOM_DIRTY_MAX) {
+        dirty_overflow = true;
+        return;
+    }
+    dirty_tiles[dirty_count++] = (uint16_t)idx;
+}
+
+static void clear_dirty_tiles(void) {
+    dirty_count = 0;
+    dirty_overflow = false;
+}
+
+/* ========================================================================
+ * Solid Bitmaps
+ * ======================================================================== */
+
+static inline void set_solid_bit(int tile_x, int tile_y, bool solid) {
+    uint32_t row_bit = 1u << (tile_x & 31);
+    uint32_t col_bit = 1u << (tile_y & 31);
+    uint32_t* row_word = &g_room_solid.rows[tile_y][tile_x >> 5];
+    uint32_t* col_word = &g_room_solid.cols[tile_x][tile_y >> 5];
+    if (solid) {
+        *row_word |= row_bit;
+        *col_word |= col_bit;
+    } else {
+        *row_word &= ~row_bit;
+        *col_word &= ~col_bit;
+    }
+}
+
+static void build_solid_bitmaps(const RoomData* r, RoomSolidMap* map) {
+    int w = r->width_tiles;
+    int h = r->height_tiles;
+
+    memset(map, 0, sizeof(*map));
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (room_coll_is_solid(r->collision[y * w + x])) {
+                map->rows[y][x >> 5] |= 1u << (x & 31);
+                map->cols[x][y >> 5] |= 1u << (y & 31);
+            }
+        }
+    }
+}
+
+/* Any bit set in the inclusive bit range [lo, hi] of a word array */
+static inline bool bits_any(const uint32_t* words, int lo, int hi) {
+    int w_lo = lo >> 5;
+    int w_hi = hi >> 5;
+    for (int w = w_lo; w <= w_hi; w++) {
+        uint32_t mask = 0xFFFFFFFFu;
+        if (w == w_lo) mask &= 0xFFFFFFFFu << (lo & 31);
+        if (w == w_hi && (hi & 31) != 31) mask &= (2u << (hi & 31)) - 1;
+        if (words[w] & mask) return true;
+    }
+    return false;
+}
+
+/* Offset of 8x8 map entry (tx, ty) within the 512x512 BG map.
+ * 4 blocks of 32x32 entries, see VRAM Upload below. */
+static inline int bgmap_offset(int tx, int ty) {
+    int block = (tx >= 32 ? 1 : 0) + (ty >= 32 ? 2 : 0);
+    return block * 1024 + (ty & 31) * 32 + (tx & 31);
+}
+
+/* ========================================================================
+ * Scroll Streaming Window
+ *
+ * The 512x512 BG holds 32x32 metatiles. Room metatile (mx, my) always
+ * lives in map slot (mx & 31, my & 31), so BG pixel = room pixel & 511
+ * and the hardware scroll wrap does the rest. stream_x/stream_y is the
+ * top-left metatile of the resident window.
+ * ======================================================================== */
+
+#define STREAM_WINDOW_TILES 32  /* Resident metatiles per axis */
+#define STREAM_MARGIN_X      8  /* Columns kept left of the camera */
+#define STREAM_MARGIN_Y     10  /* Rows kept above the camera */
+#define STREAM_MAX_STEP      2  /* Larger jumps rebuild the whole map */
+
+static int stream_x;
+static int stream_y;
+
+/* Map offset of sub-tile (dx, dy) of room metatile (mx, my) */
+static inline int metatile_map_offset(int mx, int my, int dx, int dy) {
+    return bgmap_offset((mx * 2 + dx) & 63, (my * 2 + dy) & 63);
+}
+
+static inline bool metatile_resident(int mx, int my) {
+    return mx >= stream_x && mx < stream_x + STREAM_WINDOW_TILES &&
+           my >= stream_y && my < stream_y + STREAM_WINDOW_TILES;
+}
 
 /* ========================================================================
  * Test Tile / Palette Data
@@ -66,6 +192,42 @@ static const u8 test_tile_hazard[32] = {
     0x33, 0x33, 0x33, 0x33
 };
 
+/* Hazard tile animation: 4 frames of red/blue bands scrolling down 2px
+ * per frame. Overwrites tile 3 of the test tileset. */
+#define LAVA_PX(r, k)   ((((r) + 2 * (k)) & 7) < 4 ? 0x33 : 0x13)
+#define LAVA_ROW(r, k)  LAVA_PX(r, k), LAVA_PX(r, k), LAVA_PX(r, k), LAVA_PX(r, k)
+#define LAVA_FRAME(k)   { LAVA_ROW(0, k), LAVA_ROW(1, k), LAVA_ROW(2, k), \
+                          LAVA_ROW(3, k), LAVA_ROW(4, k), LAVA_ROW(5, k), \
+                          LAVA_ROW(6, k), LAVA_ROW(7, k) }
+
+static const u8 test_hazard_frames[4][32] = {
+    LAVA_FRAME(0), LAVA_FRAME(1), LAVA_FRAME(2), LAVA_FRAME(3)
+};
+
+/* Test metatiles: each is one tile repeated (0 empty, 1 solid,
+ * 2 platform, 3 hazard) */
+#define TEST_METATILE(t) { { (t), (t), (t), (t) } }
+static const MetatileDef test_metatiles[] = {
+    TEST_METATILE(0), TEST_METATILE(1), TEST_METATILE(2), TEST_METATILE(3)
+};
+
+/* Metatile table of the loaded tileset (set by upload_tileset) */
+static const MetatileDef* metatile_defs = test_metatiles;
+static int                metatile_def_count =
+    sizeof(test_metatiles) / sizeof(test_metatiles[0]);
+
+/* BG map entry for sub-tile (dx, dy) of a metatile. Indices past the
+ * table draw as metatile 0. */
+static inline u16 metatile_bg_entry(uint16_t metatile, int dx, int dy) {
+    if (metatile >= metatile_def_count) metatile = 0;
+    return metatile_defs[metatile].sub[dy * 2 + dx];
+}
+
+/* Animation table for the test tileset */
+static const TileAnimDef test_tileset_anims[] = {
+    { 3, 1, 4, 8, &test_hazard_frames[0][0] },
+};
+
 /* Test palette (BGR555) */
 static const u16 test_palette[16] = {
     RGB15(0, 0, 0),       /* 0: black (backdrop) */
@@ -79,30 +241,30 @@ static const u16 test_palette[16] = {
  * Helper: fill room edges (walls + floor)
  * ======================================================================== */
 
-static void fill_room_shell(int w, int h) {
+static void fill_room_shell(RoomData* r, int w, int h) {
     for (int y = 0; y < h; y++) {
         for (int x = 0; x < w; x++) {
             int idx = y * w + x;
 
             /* Floor: bottom 2 rows */
             if (y >= h - 2) {
-                g_current_room.collision[idx] = COLL_SOLID;
-                g_current_room.tilemap[idx] = 1;
+                r->collision[idx] = COLL_SOLID;
+                r->tilemap[idx] = 1;
             }
             /* Left wall */
             else if (x == 0) {
-                g_current_room.collision[idx] = COLL_SOLID;
-                g_current_room.tilemap[idx] = 1;
+                r->collision[idx] = COLL_SOLID;
+                r->tilemap[idx] = 1;
             }
             /* Right wall */
             else if (x == w - 1) {
-                g_current_room.collision[idx] = COLL_SOLID;
-                g_current_room.tilemap[idx] = 1;
+                r->collision[idx] = COLL_SOLID;
+                r->tilemap[idx] = 1;
             }
             /* Air */
             else {
-                g_current_room.collision[idx] = COLL_AIR;
-                g_current_room.tilemap[idx] = 0;
+                r->collision[idx] = COLL_AIR;
+                r->tilemap[idx] = 0;
             }
         }
     }
@@ -110,11 +272,11 @@ static void fill_room_shell(int w, int h) {
 
 /* Punch a 1x3 door opening in a wall column.
  * Samus is 40px tall (half_h=20); 3 metatiles = 48px gives clearance. */
-static void punch_door_opening(int door_x, int door_y, int w) {
+static void punch_door_opening(RoomData* r, int door_x, int door_y, int w) {
     for (int dy = 0; dy < 3; dy++) {
         int idx = (door_y + dy) * w + door_x;
-        g_current_room.collision[idx] = COLL_AIR;
-        g_current_room.tilemap[idx] = 0;
+        r->collision[idx] = COLL_AIR;
+        r->tilemap[idx] = 0;
     }
 }
 
@@ -125,16 +287,16 @@ static void punch_door_opening(int door_x, int door_y, int w) {
  * Added: door on right wall -> room (0,1).
  * ======================================================================== */
 
-static void load_room_0_0(void) {
-    g_current_room.width_tiles = 16;
-    g_current_room.height_tiles = 12;
-    g_current_room.tileset_id = 0;
+static void load_room_0_0(RoomData* r) {
+    r->width_tiles = 16;
+    r->height_tiles = 12;
+    r->tileset_id = 0;
 
     int w = 16, h = 12;
 
-    memset(g_current_room.collision, COLL_AIR, sizeof(g_current_room.collision));
-    memset(g_current_room.bts, 0, sizeof(g_current_room.bts));
-    memset(g_current_room.tilemap, 0, sizeof(g_current_room.tilemap));
+    memset(r->collision, COLL_AIR, sizeof(r->collision));
+    memset(r->bts, 0, sizeof(r->bts));
+    memset(r->tilemap, 0, sizeof(r->tilemap));
 
     for (int y = 0; y < h; y++) {
         for (int x = 0; x < w; x++) {
@@ -142,18 +304,18 @@ static void load_room_0_0(void) {
 
             /* Floor: bottom 2 rows */
             if (y >= h - 2) {
-                g_current_room.collision[idx] = COLL_SOLID;
-                g_current_room.tilemap[idx] = 1;
+                r->collision[idx] = COLL_SOLID;
+                r->tilemap[idx] = 1;
             }
             /* Walls: left and right edges */
             else if (x == 0 || x == w - 1) {
-                g_current_room.collision[idx] = COLL_SOLID;
-                g_current_room.tilemap[idx] = 1;
+                r->collision[idx] = COLL_SOLID;
+                r->tilemap[idx] = 1;
             }
             /* Platform: middle of room */
             else if (y == 6 && x >= 5 && x <= 10) {
-                g_current_room.collision[idx] = COLL_SOLID;
-                g_current_room.tilemap[idx] = 2;
+                r->collision[idx] = COLL_SOLID;
+                r->tilemap[idx] = 2;
             }
         }
     }
@@ -161,27 +323,27 @@ static void load_room_0_0(void) {
     /* Save station tile at (3, 9) - just above floor */
     {
         int idx = 9 * w + 3;
-        g_current_room.collision[idx] = COLL_SPECIAL_SAVE;
-        g_current_room.tilemap[idx] = 3;  /* hazard tile for visibility */
+        r->collision[idx] = COLL_SPECIAL_SAVE;
+        r->tilemap[idx] = 3;  /* hazard tile for visibility */
     }
 
     /* Door opening on right wall: tiles (15, 7) and (15, 8) */
-    punch_door_opening(15, 7, w);
+    punch_door_opening(r, 15, 7, w);
 
     /* Doors */
-    g_current_room.doors[0] = (DoorData){
+    r->doors[0] = (DoorData){
         .dest_area = 0, .dest_room = 1,
         .direction = DIR_RIGHT, .door_type = 0,
         .door_x = 15, .door_y = 7,
         .spawn_x = 32, .spawn_y = 148
     };
-    g_current_room.door_count = 1;
+    r->door_count = 1;
 
     /* Enemy spawns */
-    g_current_room.spawns[0] = (EnemySpawnData){ 1, 64, 148, 0, 0 };   /* Zoomer left */
-    g_current_room.spawns[1] = (EnemySpawnData){ 1, 192, 148, 0, 0 };  /* Zoomer right */
-    g_current_room.spawns[2] = (EnemySpawnData){ 3, 128, 48, 0, 0 };   /* Waver center */
-    g_current_room.spawn_count = 3;
+    r->spawns[0] = (EnemySpawnData){ 1, 64, 148, 0, 0 };   /* Zoomer left */
+    r->spawns[1] = (EnemySpawnData){ 1, 192, 148, 0, 0 };  /* Zoomer right */
+    r->spawns[2] = (EnemySpawnData){ 3, 128, 48, 0, 0 };   /* Waver center */
+    r->spawn_count = 3;
 }
 
 /* ========================================================================
@@ -191,100 +353,100 @@ static void load_room_0_0(void) {
  * Doors: left -> room (0,0), right -> room (0,2).
  * ======================================================================== */
 
-static void load_room_0_1(void) {
-    g_current_room.width_tiles = 32;
-    g_current_room.height_tiles = 12;
-    g_current_room.tileset_id = 0;
+static void load_room_0_1(RoomData* r) {
+    r->width_tiles = 32;
+    r->height_tiles = 12;
+    r->tileset_id = 0;
 
     int w = 32, h = 12;
 
-    memset(g_current_room.collision, COLL_AIR, sizeof(g_current_room.collision));
-    memset(g_current_room.bts, 0, sizeof(g_current_room.bts));
-    memset(g_current_room.tilemap, 0, sizeof(g_current_room.tilemap));
+    memset(r->collision, COLL_AIR, sizeof(r->collision));
+    memset(r->bts, 0, sizeof(r->bts));
+    memset(r->tilemap, 0, sizeof(r->tilemap));
 
-    fill_room_shell(w, h);
+    fill_room_shell(r, w, h);
 
     /* Platforms at different heights for variety */
     /* Low platform left side */
     for (int x = 6; x <= 10; x++) {
         int idx = 8 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
     /* High platform center */
     for (int x = 14; x <= 18; x++) {
         int idx = 5 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
     /* Mid platform right side */
     for (int x = 22; x <= 26; x++) {
         int idx = 7 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
 
     /* Spike row on floor near center (tiles 12-16 at row 9, just above floor) */
     for (int x = 12; x <= 16; x++) {
         int idx = 9 * w + x;
-        g_current_room.collision[idx] = COLL_HAZARD_SPIKE;
-        g_current_room.tilemap[idx] = 3;  /* hazard tile */
+        r->collision[idx] = COLL_HAZARD_SPIKE;
+        r->tilemap[idx] = 3;  /* hazard tile */
     }
 
     /* Shot blocks guarding items (tiles 20-21 at row 8) */
     for (int x = 20; x <= 21; x++) {
         int idx = 8 * w + x;
-        g_current_room.collision[idx] = COLL_SPECIAL_SHOT;
-        g_current_room.tilemap[idx] = 3;
+        r->collision[idx] = COLL_SPECIAL_SHOT;
+        r->tilemap[idx] = 3;
     }
 
     /* Bomb block (tile 22 at row 8) */
     {
         int idx = 8 * w + 22;
-        g_current_room.collision[idx] = COLL_SPECIAL_BOMB;
-        g_current_room.tilemap[idx] = 3;
+        r->collision[idx] = COLL_SPECIAL_BOMB;
+        r->tilemap[idx] = 3;
     }
 
     /* Crumble block bridge (tiles 3-5 at row 5) */
     for (int x = 3; x <= 5; x++) {
         int idx = 5 * w + x;
-        g_current_room.collision[idx] = COLL_SPECIAL_CRUMBLE;
-        g_current_room.tilemap[idx] = 2;  /* looks like platform */
+        r->collision[idx] = COLL_SPECIAL_CRUMBLE;
+        r->tilemap[idx] = 2;  /* looks like platform */
     }
 
     /* Door openings */
-    punch_door_opening(0, 7, w);   /* Left wall */
-    punch_door_opening(31, 7, w);  /* Right wall */
+    punch_door_opening(r, 0, 7, w);   /* Left wall */
+    punch_door_opening(r, 31, 7, w);  /* Right wall */
 
     /* Doors */
-    g_current_room.doors[0] = (DoorData){
+    r->doors[0] = (DoorData){
         .dest_area = 0, .dest_room = 0,
         .direction = DIR_LEFT, .door_type = 0,
         .door_x = 0, .door_y = 7,
         .spawn_x = 224, .spawn_y = 148
     };
-    g_current_room.doors[1] = (DoorData){
+    r->doors[1] = (DoorData){
         .dest_area = 0, .dest_room = 2,
         .direction = DIR_RIGHT, .door_type = 0,
         .door_x = 31, .door_y = 7,
         .spawn_x = 32, .spawn_y = 300
     };
-    g_current_room.door_count = 2;
+    r->door_count = 2;
 
     /* Enemy spawns - different types to distinguish rooms */
-    g_current_room.spawns[0] = (EnemySpawnData){ 2, 128, 148, 0, 0 };  /* Geemer left */
-    g_current_room.spawns[1] = (EnemySpawnData){ 5, 256, 120, 0, 0 };  /* Sidehopper center */
-    g_current_room.spawns[2] = (EnemySpawnData){ 1, 400, 148, 0, 0 };  /* Zoomer right */
-    g_current_room.spawn_count = 3;
+    r->spawns[0] = (EnemySpawnData){ 2, 128, 148, 0, 0 };  /* Geemer left */
+    r->spawns[1] = (EnemySpawnData){ 5, 256, 120, 0, 0 };  /* Sidehopper center */
+    r->spawns[2] = (EnemySpawnData){ 1, 400, 148, 0, 0 };  /* Zoomer right */
+    r->spawn_count = 3;
 
     /* Items behind breakable blocks */
-    g_current_room.items[0] = (ItemData){
+    r->items[0] = (ItemData){
         ITEM_MISSILE_TANK, INT_TO_FX(336), INT_TO_FX(140), false
     };
-    g_current_room.items[1] = (ItemData){
+    r->items[1] = (ItemData){
         ITEM_ENERGY_TANK, INT_TO_FX(368), INT_TO_FX(140), false
     };
-    g_current_room.item_count = 2;
+    r->item_count = 2;
 }
 
 /* ========================================================================
@@ -294,90 +456,90 @@ static void load_room_0_1(void) {
  * Door: left -> room (0,1).
  * ======================================================================== */
 
-static void load_room_0_2(void) {
-    g_current_room.width_tiles = 16;
-    g_current_room.height_tiles = 24;
-    g_current_room.tileset_id = 0;
+static void load_room_0_2(RoomData* r) {
+    r->width_tiles = 16;
+    r->height_tiles = 24;
+    r->tileset_id = 0;
 
     int w = 16, h = 24;
 
-    memset(g_current_room.collision, COLL_AIR, sizeof(g_current_room.collision));
-    memset(g_current_room.bts, 0, sizeof(g_current_room.bts));
-    memset(g_current_room.tilemap, 0, sizeof(g_current_room.tilemap));
+    memset(r->collision, COLL_AIR, sizeof(r->collision));
+    memset(r->bts, 0, sizeof(r->bts));
+    memset(r->tilemap, 0, sizeof(r->tilemap));
 
-    fill_room_shell(w, h);
+    fill_room_shell(r, w, h);
 
     /* Ceiling: top row */
     for (int x = 0; x < w; x++) {
         int idx = 0 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 1;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 1;
     }
 
     /* Staircase platforms going up */
     /* Bottom platform */
     for (int x = 3; x <= 8; x++) {
         int idx = 20 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
     /* Mid-low platform */
     for (int x = 8; x <= 13; x++) {
         int idx = 16 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
     /* Mid-high platform */
     for (int x = 3; x <= 8; x++) {
         int idx = 12 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
     /* Top platform (extended to x=14 for right door access) */
     for (int x = 8; x <= 14; x++) {
         int idx = 8 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
     /* High ledge */
     for (int x = 3; x <= 8; x++) {
         int idx = 4 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 2;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 2;
     }
 
     /* Lava pool at bottom (row 21, above floor).
      * Starts at x=4 to leave safe landing zone near left door. */
     for (int x = 4; x < w - 1; x++) {
         int idx = 21 * w + x;
-        g_current_room.collision[idx] = COLL_HAZARD_LAVA;
-        g_current_room.tilemap[idx] = 3;  /* hazard tile */
+        r->collision[idx] = COLL_HAZARD_LAVA;
+        r->tilemap[idx] = 3;  /* hazard tile */
     }
 
     /* Door opening on left wall near bottom: tiles (0, 19) and (0, 20) */
-    punch_door_opening(0, 19, w);
+    punch_door_opening(r, 0, 19, w);
     /* Door opening on right wall: tiles (15, 5)-(15, 7), aligned with top platform */
-    punch_door_opening(15, 5, w);
+    punch_door_opening(r, 15, 5, w);
 
     /* Doors */
-    g_current_room.doors[0] = (DoorData){
+    r->doors[0] = (DoorData){
         .dest_area = 0, .dest_room = 1,
         .direction = DIR_LEFT, .door_type = 0,
         .door_x = 0, .door_y = 19,
         .spawn_x = 480, .spawn_y = 148
     };
-    g_current_room.doors[1] = (DoorData){
+    r->doors[1] = (DoorData){
         .dest_area = 0, .dest_room = 3,
         .direction = DIR_RIGHT, .door_type = 0,
         .door_x = 15, .door_y = 5,
         .spawn_x = 32, .spawn_y = 140
     };
-    g_current_room.door_count = 2;
+    r->door_count = 2;
 
     /* Enemy spawns - wavers for vertical room */
-    g_current_room.spawns[0] = (EnemySpawnData){ 3, 128, 80, 0, 0 };   /* Waver top */
-    g_current_room.spawns[1] = (EnemySpawnData){ 3, 128, 240, 0, 0 };  /* Waver bottom */
-    g_current_room.spawn_count = 2;
+    r->spawns[0] = (EnemySpawnData){ 3, 128, 80, 0, 0 };   /* Waver top */
+    r->spawns[1] = (EnemySpawnData){ 3, 128, 240, 0, 0 };  /* Waver bottom */
+    r->spawn_count = 2;
 }
 
 /* ========================================================================
@@ -387,47 +549,47 @@ static void load_room_0_2(void) {
  * Door: left -> room (0,2).
  * ======================================================================== */
 
-static void load_room_0_3(void) {
-    g_current_room.width_tiles = 16;
-    g_current_room.height_tiles = 12;
-    g_current_room.tileset_id = 0;
+static void load_room_0_3(RoomData* r) {
+    r->width_tiles = 16;
+    r->height_tiles = 12;
+    r->tileset_id = 0;
 
     int w = 16, h = 12;
 
-    memset(g_current_room.collision, COLL_AIR, sizeof(g_current_room.collision));
-    memset(g_current_room.bts, 0, sizeof(g_current_room.bts));
-    memset(g_current_room.tilemap, 0, sizeof(g_current_room.tilemap));
+    memset(r->collision, COLL_AIR, sizeof(r->collision));
+    memset(r->bts, 0, sizeof(r->bts));
+    memset(r->tilemap, 0, sizeof(r->tilemap));
 
-    fill_room_shell(w, h);
+    fill_room_shell(r, w, h);
 
     /* Ceiling */
     for (int x = 0; x < w; x++) {
         int idx = 0 * w + x;
-        g_current_room.collision[idx] = COLL_SOLID;
-        g_current_room.tilemap[idx] = 1;
+        r->collision[idx] = COLL_SOLID;
+        r->tilemap[idx] = 1;
     }
 
     /* Door opening on left wall: tiles (0, 7) and (0, 8) */
-    punch_door_opening(0, 7, w);
+    punch_door_opening(r, 0, 7, w);
 
     /* Doors */
-    g_current_room.doors[0] = (DoorData){
+    r->doors[0] = (DoorData){
         .dest_area = 0, .dest_room = 2,
         .direction = DIR_LEFT, .door_type = 0,
         .door_x = 0, .door_y = 7,
         .spawn_x = 224, .spawn_y = 108
     };
-    g_current_room.door_count = 1;
+    r->door_count = 1;
 
     /* No enemy spawns - boss spawned separately by gameplay code */
-    g_current_room.spawn_count = 0;
+    r->spawn_count = 0;
 }
 
 /* ========================================================================
  * Room Dispatch Table
  * ======================================================================== */
 
-typedef void (*RoomLoadFn)(void);
+typedef void (*RoomLoadFn)(RoomData* r);
 
 typedef struct {
     uint8_t area_id;
@@ -460,62 +622,72 @@ static const RoomTableEntry* find_room(uint8_t area_id, uint8_t room_id) {
 
 void room_init(void) {
     memset(&g_current_room, 0, sizeof(g_current_room));
+    clear_dirty_tiles();
+    room_cache_clear();
 }
 
+static void cache_store_current(void);
+static void cache_drop(uint8_t area_id, uint8_t room_id);
+static bool prefetch_finish(uint8_t area_id, uint8_t room_id);
+static void prefetch_commit(void);
+
 bool room_load(uint8_t area_id, uint8_t room_id) {
-    /* Unload previous room if any */
+    /* Leaving a room keeps it (broken blocks, collected items) for the
+     * way back; reloading the live room starts it fresh. */
     if (g_current_room.loaded) {
+        if (g_current_room.area_id == area_id && g_current_room.room_id == room_id) {
+            cache_drop(area_id, room_id);
+        } else {
+            cache_store_current();
+        }
         room_unload();
     }
 
-    const RoomTableEntry* entry = find_room(area_id, room_id);
-    if (!entry) return false;
-
-    /* Set area/room IDs before load function */
-    g_current_room.area_id = area_id;
-    g_current_room.room_id = room_id;
-
-    /* Call room-specific load function */
-    entry->load_fn();
-
-    /* Compute scroll bounds */
-    int w = g_current_room.width_tiles;
-    int h = g_current_room.height_tiles;
-    g_current_room.scroll_max_x = (w * TILE_SIZE) - SCREEN_WIDTH;
-    g_current_room.scroll_max_y = (h * TILE_SIZE) - SCREEN_HEIGHT;
-    if (g_current_room.scroll_max_x < 0) g_current_room.scroll_max_x = 0;
-    if (g_current_room.scroll_max_y < 0) g_current_room.scroll_max_y = 0;
-
-    g_current_room.loaded = true;
-
-    /* Upload graphics to VRAM */
-    room_upload_to_vram();
-
-    fprintf(stderr, "Room %d:%d (%dx%d) doors=%d spawns=%d\n",
-            area_id, room_id,
-            g_current_room.width_tiles,
-            g_current_room.height_tiles,
-            g_current_room.door_count,
-            g_current_room.spawn_count);
-
+    /* A room prefetched ahead of time only needs the commit; otherwise
+     * the remaining prefetch stages run now, in this frame. */
+    if (!prefetch_finish(area_id, room_id)) return false;
+    prefetch_commit();
     return true;
 }
 
 void room_unload(void) {
+    clear_dirty_tiles();
     g_current_room.loaded = false;
     g_current_room.width_tiles = 0;
     g_current_room.height_tiles = 0;
     g_current_room.door_count = 0;
     g_current_room.spawn_count = 0;
+    g_current_room.crumble_count = 0;
 }
 
-uint8_t room_get_collision(int tile_x, int tile_y) {
+SM_ITCM uint8_t room_get_collision(int tile_x, int tile_y) {
     if (!g_current_room.loaded) return COLL_SOLID;
     if (tile_x < 0 || tile_x >= g_current_room.width_tiles) return COLL_SOLID;
     if (tile_y < 0 || tile_y >= g_current_room.height_tiles) return COLL_SOLID;
     return g_current_room.collision[tile_y * g_current_room.width_tiles + tile_x];
 }
 
+SM_ITCM bool room_is_solid(int tile_x, int tile_y) {
+    if (!g_current_room.loaded) return true;
+    if (tile_x < 0 || tile_x >= g_current_room.width_tiles) return true;
+    if (tile_y < 0 || tile_y >= g_current_room.height_tiles) return true;
+    return (g_room_solid.rows[tile_y][tile_x >> 5] >> (tile_x & 31)) & 1;
+}
+
+SM_ITCM bool room_row_has_solid(int tile_x_min, int tile_x_max, int tile_y) {
+    if (!g_current_room.loaded) return true;
+    if (tile_y < 0 || tile_y >= g_current_room.height_tiles) return true;
+    if (tile_x_min < 0 || tile_x_max >= g_current_room.width_tiles) return true;
+    return bits_any(g_room_solid.rows[tile_y], tile_x_min, tile_x_max);
+}
+
+SM_ITCM bool room_col_has_solid(int tile_x, int tile_y_min, int tile_y_max) {
+    if (!g_current_room.loaded) return true;
+    if (tile_x < 0 || tile_x >= g_current_room.width_tiles) return true;
+    if (tile_y_min < 0 || tile_y_max >= g_current_room.height_tiles) return true;
+    return bits_any(g_room_solid.cols[tile_x], tile_y_min, tile_y_max);
+}
+
 uint8_t room_get_bts(int tile_x, int tile_y) {
     if (!g_current_room.loaded) return 0;
     if (tile_x < 0 || tile_x >= g_current_room.width_tiles) return 0;
@@ -527,7 +699,25 @@ void room_set_collision(int tile_x, int tile_y, uint8_t new_type) {
     if (!g_current_room.loaded) return;
     if (tile_x < 0 || tile_x >= g_current_room.width_tiles) return;
     if (tile_y < 0 || tile_y >= g_current_room.height_tiles) return;
-    g_current_room.collision[tile_y * g_current_room.width_tiles + tile_x] = new_type;
+    int idx = tile_y * g_current_room.width_tiles + tile_x;
+    g_current_room.collision[idx] = new_type;
+    set_solid_bit(tile_x, tile_y, room_coll_is_solid(new_type));
+
+    /* A block broken to air also loses its graphic */
+    if (new_type == COLL_AIR && g_current_room.tilemap[idx] != 0) {
+        g_current_room.tilemap[idx] = 0;
+        mark_tile_dirty(idx);
+    }
+}
+
+void room_set_metatile(int tile_x, int tile_y, uint16_t metatile) {
+    if (!g_current_room.loaded) return;
+    if (tile_x < 0 || tile_x >= g_current_room.width_tiles) return;
+    if (tile_y < 0 || tile_y >= g_current_room.height_tiles) return;
+    int idx = tile_y * g_current_room.width_tiles + tile_x;
+    if (g_current_room.tilemap[idx] == metatile) return;
+    g_current_room.tilemap[idx] = metatile;
+    mark_tile_dirty(idx);
 }
 
 /* ========================================================================
@@ -555,6 +745,31 @@ const DoorData* room_check_door_collision(const PhysicsBody* body) {
     return NULL;
 }
 
+const DoorData* room_find_door_near(const PhysicsBody* body, int margin_px) {
+    if (!g_current_room.loaded) return NULL;
+
+    int px = FX_TO_INT(body->pos.x);
+    int py = FX_TO_INT(body->pos.y);
+    const DoorData* best = NULL;
+    int best_dist = margin_px + 1;
+
+    for (int i = 0; i < g_current_room.door_count; i++) {
+        const DoorData* d = &g_current_room.doors[i];
+
+        /* Chebyshev distance to the door's 1x3 tile rect */
+        int x0 = d->door_x * TILE_SIZE, x1 = x0 + TILE_SIZE - 1;
+        int y0 = d->door_y * TILE_SIZE, y1 = y0 + 3 * TILE_SIZE - 1;
+        int dx = px < x0 ? x0 - px : (px > x1 ? px - x1 : 0);
+        int dy = py < y0 ? y0 - py : (py > y1 ? py - y1 : 0);
+        int dist = dx > dy ? dx : dy;
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = d;
+        }
+    }
+    return best;
+}
+
 /* ========================================================================
  * Item Pickup
  * ======================================================================== */
@@ -587,25 +802,38 @@ ItemTypeID room_check_item_pickup(const PhysicsBody* body) {
  * Crumble Block Update
  * ======================================================================== */
 
+bool room_start_crumble(int tile_x, int tile_y) {
+    if (room_get_collision(tile_x, tile_y) != COLL_SPECIAL_CRUMBLE) return true;
+
+    uint16_t idx = (uint16_t)(tile_y * g_current_room.width_tiles + tile_x);
+    for (int i = 0; i < g_current_room.crumble_count; i++) {
+        if (g_current_room.crumbles[i].tile_idx == idx) return true;
+    }
+    if (g_current_room.crumble_count >= MAX_CRUMBLES) return false;
+
+    CrumbleBlock* c = &g_current_room.crumbles[g_current_room.crumble_count++];
+    c->tile_idx = idx;
+    c->timer = CRUMBLE_DELAY_FRAMES;
+    return true;
+}
+
 void room_update_crumble_blocks(void) {
     if (!g_current_room.loaded) return;
 
-    int w = g_current_room.width_tiles;
-    int h = g_current_room.height_tiles;
+    /* Iterate backward for safe swap-remove */
+    for (int i = g_current_room.crumble_count - 1; i >= 0; i--) {
+        CrumbleBlock* c = &g_current_room.crumbles[i];
+        if (--c->timer > 0) continue;
 
-    for (int y = 0; y < h; y++) {
-        for (int x = 0; x < w; x++) {
-            int idx = y * w + x;
-            if (g_current_room.crumble_timer[idx] > 0) {
-                g_current_room.crumble_timer[idx]--;
-                if (g_current_room.crumble_timer[idx] == 0) {
-                    g_current_room.collision[idx] = COLL_AIR;
-                    g_current_room.tilemap[idx] = 0;
-                    /* VRAM update deferred to next room_upload_to_vram call
-                     * or inline update of the specific BG map entry */
-                }
-            }
-        }
+        int idx = c->tile_idx;
+        g_current_room.collision[idx] = COLL_AIR;
+        g_current_room.tilemap[idx] = 0;
+        set_solid_bit(idx % g_current_room.width_tiles,
+                      idx / g_current_room.width_tiles, false);
+        mark_tile_dirty(idx);
+
+        g_current_room.crumbles[i] =
+            g_current_room.crumbles[--g_current_room.crumble_count];
     }
 }
 
@@ -621,6 +849,9 @@ void room_update_crumble_blocks(void) {
  *   Block 2: rows 32-63, cols 0-31
  *   Block 3: rows 32-63, cols 32-63
  *
+ * Only the 32x32 metatile streaming window is uploaded; larger rooms
+ * are filled in by room_stream_update() as the camera moves.
+ *
  * BG map entry (16 bits):
  *   Bits 0-9:   Tile index
  *   Bit 10:     H-flip
@@ -628,9 +859,64 @@ void room_update_crumble_blocks(void) {
  *   Bits 12-15: Palette number
  * ======================================================================== */
 
-void room_upload_to_vram(void) {
-    if (!g_current_room.loaded) return;
+/* Expand a room's 32x32 metatile window at (ox, oy) into an 8x8 BG map */
+static void expand_bg_map(const RoomData* r, int ox, int oy, u16* map) {
+    int w = r->width_tiles;
+    int h = r->height_tiles;
+
+    int x_end = ox + STREAM_WINDOW_TILES;
+    int y_end = oy + STREAM_WINDOW_TILES;
+    if (x_end > w) x_end = w;
+    if (y_end > h) y_end = h;
+
+    memset(map, 0, sizeof(bgmap_buffers[0]));
+
+    for (int my = oy; my < y_end; my++) {
+        for (int mx = ox; mx < x_end; mx++) {
+            uint16_t metatile = r->tilemap[my * w + mx];
 
+            /* Expand to 2x2 in the BG map */
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    map[metatile_map_offset(mx, my, dx, dy)] =
+                        metatile_bg_entry(metatile, dx, dy);
+                }
+            }
+        }
+    }
+}
+
+/* Queue the live BG map. Supersedes any queued tile patches. */
+static void upload_bg_map(void) {
+    graphics_load_bg_tilemap(BG_LAYER_LEVEL, vram_bgmap, sizeof(bgmap_buffers[0]));
+    clear_dirty_tiles();
+}
+
+/* Rebuild the whole 8x8 BG map for the resident window and upload it */
+static void build_bg_map(void) {
+    expand_bg_map(&g_current_room, stream_x, stream_y, vram_bgmap);
+    upload_bg_map();
+}
+
+/* Queue the 4 BG map entries of one metatile. False if the queue is full. */
+static bool queue_metatile(int mx, int my) {
+    int w = g_current_room.width_tiles;
+    uint16_t metatile = g_current_room.tilemap[my * w + mx];
+
+    for (int dy = 0; dy < 2; dy++) {
+        for (int dx = 0; dx < 2; dx++) {
+            if (!graphics_queue_bg_map_entry(BG_LAYER_LEVEL,
+                    metatile_map_offset(mx, my, dx, dy),
+                    metatile_bg_entry(metatile, dx, dy))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Tileset, palette and tile animations of the current room */
+static void upload_tileset(void) {
     /* 1. Upload test tileset (4 tiles: empty, solid, platform, hazard)
      * MUST be static: DMA cannot access DTCM (stack memory).
      * Local arrays live on the DTCM stack, which is tightly coupled
@@ -641,43 +927,491 @@ void room_upload_to_vram(void) {
     memcpy(&tileset[64],  test_tile_platform, 32);
     memcpy(&tileset[96],  test_tile_hazard,   32);
     graphics_load_bg_tileset(BG_LAYER_LEVEL, tileset, sizeof(tileset));
+    tile_anim_set(BG_LAYER_LEVEL, test_tileset_anims,
+                  sizeof(test_tileset_anims) / sizeof(test_tileset_anims[0]));
+    metatile_defs = test_metatiles;
+    metatile_def_count = sizeof(test_metatiles) / sizeof(test_metatiles[0]);
 
     /* 2. Upload palette */
     graphics_load_bg_palette(0, test_palette);
+}
+
+void room_upload_to_vram(void) {
+    if (!g_current_room.loaded) return;
+
+    upload_tileset();
+
+    /* 3. Build and upload the BG map for the resident window */
+    build_bg_map();
+}
+
+/* ========================================================================
+ * Dirty Tile Flush
+ *
+ * Re-expands each dirty metatile into its 2x2 BG map entries and queues
+ * them as graphics patches, which graphics_vblank commits to VRAM.
+ * Call once per frame after gameplay logic.
+ * ======================================================================== */
+
+void room_flush_dirty_tiles(void) {
+    if (!g_current_room.loaded) return;
+    if (dirty_count == 0 && !dirty_overflow) return;
+
+    if (dirty_overflow) {
+        build_bg_map();
+        return;
+    }
 
-    /* 3. Build 8x8 BG map from metatile tilemap */
     int w = g_current_room.width_tiles;
-    int h = g_current_room.height_tiles;
 
-    memset(vram_bgmap, 0, sizeof(vram_bgmap));
+    for (int i = 0; i < dirty_count; i++) {
+        int mx = dirty_tiles[i] % w;
+        int my = dirty_tiles[i] / w;
 
-    for (int my = 0; my < h && my * 2 < 64; my++) {
-        for (int mx = 0; mx < w && mx * 2 < 64; mx++) {
-            uint16_t metatile = g_current_room.tilemap[my * w + mx];
+        /* Off-window tiles are picked up when streamed in */
+        if (!metatile_resident(mx, my)) continue;
 
-            /* Simple mapping: metatile N -> all four 8x8 sub-tiles use tile N.
-             * When real metatile definitions are available, this will look up
-             * a MetatileDef table for proper 4-tile expansion. */
-            uint16_t entry = metatile & 0x03FF;  /* tile index, palette 0, no flip */
+        if (!queue_metatile(mx, my)) {
+            /* Patch queue full -- rebuild everything instead */
+            build_bg_map();
+            return;
+        }
+    }
 
-            /* Expand to 2x2 in the BG map */
-            for (int dy = 0; dy < 2; dy++) {
-                for (int dx = 0; dx < 2; dx++) {
-                    int tx = mx * 2 + dx;
-                    int ty = my * 2 + dy;
+    clear_dirty_tiles();
+}
 
-                    /* 512x512 map: 4 blocks of 32x32 entries */
-                    int block = (tx >= 32 ? 1 : 0) + (ty >= 32 ? 2 : 0);
-                    int local_x = tx & 31;
-                    int local_y = ty & 31;
-                    int offset = block * 1024 + local_y * 32 + local_x;
+int room_get_dirty_tile_count(void) {
+    return dirty_count;
+}
 
-                    vram_bgmap[offset] = entry;
-                }
+/* ========================================================================
+ * Scroll Streaming
+ *
+ * Keeps the resident window centred on the camera. Each metatile step
+ * writes one 32-metatile column or row (128 map entries) through the
+ * patch queue, so VRAM traffic per frame is bounded regardless of room
+ * size. Jumps larger than STREAM_MAX_STEP (door spawn, camera snap)
+ * rebuild the full map instead.
+ * ======================================================================== */
+
+static int stream_origin(int cam_tile, int margin, int room_tiles) {
+    int origin = cam_tile - margin;
+    int max_origin = room_tiles - STREAM_WINDOW_TILES;
+    if (max_origin < 0) max_origin = 0;
+    if (origin > max_origin) origin = max_origin;
+    if (origin < 0) origin = 0;
+    return origin;
+}
+
+static bool stream_column(int mx) {
+    int y_end = stream_y + STREAM_WINDOW_TILES;
+    if (y_end > g_current_room.height_tiles) y_end = g_current_room.height_tiles;
+    for (int my = stream_y; my < y_end; my++) {
+        if (!queue_metatile(mx, my)) return false;
+    }
+    return true;
+}
+
+static bool stream_row(int my) {
+    int x_end = stream_x + STREAM_WINDOW_TILES;
+    if (x_end > g_current_room.width_tiles) x_end = g_current_room.width_tiles;
+    for (int mx = stream_x; mx < x_end; mx++) {
+        if (!queue_metatile(mx, my)) return false;
+    }
+    return true;
+}
+
+void room_stream_update(int scroll_x, int scroll_y) {
+    if (!g_current_room.loaded) return;
+
+    int ox = stream_origin(scroll_x >> TILE_SHIFT, STREAM_MARGIN_X,
+                           g_current_room.width_tiles);
+    int oy = stream_origin(scroll_y >> TILE_SHIFT, STREAM_MARGIN_Y,
+                           g_current_room.height_tiles);
+
+    int step_x = ox - stream_x;
+    int step_y = oy - stream_y;
+    if (step_x == 0 && step_y == 0) return;
+
+    if (step_x > STREAM_MAX_STEP || step_x < -STREAM_MAX_STEP ||
+        step_y > STREAM_MAX_STEP || step_y < -STREAM_MAX_STEP) {
+        stream_x = ox;
+        stream_y = oy;
+        build_bg_map();
+        return;
+    }
+
+    bool ok = true;
+
+    /* Columns first (using the old row range), then rows */
+    while (ok && stream_x < ox) {
+        stream_x++;
+        ok = stream_column(stream_x + STREAM_WINDOW_TILES - 1);
+    }
+    while (ok && stream_x > ox) {
+        stream_x--;
+        ok = stream_column(stream_x);
+    }
+    while (ok && stream_y < oy) {
+        stream_y++;
+        ok = stream_row(stream_y + STREAM_WINDOW_TILES - 1);
+    }
+    while (ok && stream_y > oy) {
+        stream_y--;
+        ok = stream_row(stream_y);
+    }
+
+    if (!ok) {
+        stream_x = ox;
+        stream_y = oy;
+        build_bg_map();
+    }
+}
+
+void room_stream_get_origin(int* tile_x, int* tile_y) {
+    if (tile_x) *tile_x = stream_x;
+    if (tile_y) *tile_y = stream_y;
+}
+
+/* ========================================================================
+ * Room Prefetch
+ *
+ * The next room is built into a second RoomData -- with its own solid
+ * bitmaps and BG map -- while the current room stays live. Each
+ * room_prefetch_update() runs one stage, so the decode, the bitmap pass
+ * and the map expansion land on separate frames; a compressed pack
+ * record expands on the ARM7 (coproc.h) in between, and the unpack
+ * stage just waits on it. Committing is then two copies and a buffer
+ * swap, and the uploads it queues are spread over the following VBlanks
+ * by the graphics upload budget.
+ *
+ * Deliberately, those uploads run during the fade-in, not the fade-out:
+ * BG tiles and map live in a single VRAM area, and writing the next
+ * room there while the old one is still fading out would show it torn.
+ * TRANS_FADEIN holds the screen black until every transfer has landed.
+ * The decode stage is one fread of the whole record; it runs when
+ * Samus comes within DOOR_PREFETCH_MARGIN_PX of the door, well ahead of
+ * the transition, rather than being split across frames.
+ * ======================================================================== */
+
+typedef enum {
+    PREFETCH_IDLE = 0,
+    PREFETCH_DECODE,        /* Read layout/doors/spawns/items */
+    PREFETCH_UNPACK,        /* Pack record expanding in the background */
+    PREFETCH_SOLID,         /* Build solid bitmaps */
+    PREFETCH_BGMAP,         /* Expand the initial BG map window */
+    PREFETCH_READY
+} PrefetchStage;
+
+static PrefetchStage prefetch_stage;
+static uint8_t       prefetch_area;
+static uint8_t       prefetch_room_id;
+static bool          prefetch_from_pack;
+static RoomData      prefetch_room;
+static RoomSolidMap  prefetch_solid;
+static u16*          prefetch_bgmap = bgmap_buffers[1];
+static bool          current_from_pack;     /* Source of the live room */
+
+static bool cache_fetch(uint8_t area_id, uint8_t room_id);
+
+/* Fill prefetch_room from the built-in table */
+static bool prefetch_load_builtin(void) {
+    const RoomTableEntry* entry = find_room(prefetch_area, prefetch_room_id);
+    if (!entry) return false;
+    RoomData* r = &prefetch_room;
+    r->door_count = 0;
+    r->spawn_count = 0;
+    r->item_count = 0;
+    entry->load_fn(r);
+    prefetch_from_pack = false;
+    return true;
+}
+
+/* Runtime fields of a freshly decoded prefetch_room */
+static void prefetch_init_runtime(void) {
+    RoomData* r = &prefetch_room;
+    r->area_id = prefetch_area;
+    r->room_id = prefetch_room_id;
+    r->crumble_count = 0;
+    r->loaded = false;
+
+    /* Compute scroll bounds */
+    r->scroll_max_x = (r->width_tiles * TILE_SIZE) - SCREEN_WIDTH;
+    r->scroll_max_y = (r->height_tiles * TILE_SIZE) - SCREEN_HEIGHT;
+    if (r->scroll_max_x < 0) r->scroll_max_x = 0;
+    if (r->scroll_max_y < 0) r->scroll_max_y = 0;
+}
+
+/* Start the room from the pack (expanded in the background), else
+ * build it from the built-in table now */
+static PrefetchStage prefetch_decode(void) {
+    if (room_pack_read_begin(prefetch_area, prefetch_room_id)) {
+        return PREFETCH_UNPACK;
+    }
+    if (!prefetch_load_builtin()) return PREFETCH_IDLE;
+    prefetch_init_runtime();
+    return PREFETCH_SOLID;
+}
+
+/* Parse the expanded pack record, waiting for it if it is not done */
+static PrefetchStage prefetch_unpack(void) {
+    RoomData* r = &prefetch_room;
+    r->door_count = 0;
+    r->spawn_count = 0;
+    r->item_count = 0;
+
+    /* Built-in rooms cover a corrupt record */
+    prefetch_from_pack = room_pack_read_end(r);
+    if (!prefetch_from_pack && !prefetch_load_builtin()) return PREFETCH_IDLE;
+    prefetch_init_runtime();
+    return PREFETCH_SOLID;
+}
+
+static bool prefetch_matches(uint8_t area_id, uint8_t room_id) {
+    return prefetch_stage != PREFETCH_IDLE &&
+           prefetch_area == area_id && prefetch_room_id == room_id;
+}
+
+bool room_prefetch(uint8_t area_id, uint8_t room_id) {
+    if (prefetch_matches(area_id, room_id)) return true;
+    if (!room_cache_has(area_id, room_id) &&
+        !room_pack_has(area_id, room_id) && !find_room(area_id, room_id)) {
+        return false;
+    }
+
+    /* A newer request replaces whatever was in flight */
+    prefetch_area = area_id;
+    prefetch_room_id = room_id;
+    prefetch_stage = PREFETCH_DECODE;
+    return true;
+}
+
+void room_prefetch_update(void) {
+    switch (prefetch_stage) {
+        case PREFETCH_DECODE:
+            /* A cached room arrives with its bitmaps and map already built */
+            if (cache_fetch(prefetch_area, prefetch_room_id)) {
+                prefetch_stage = PREFETCH_READY;
+                break;
             }
+            prefetch_stage = prefetch_decode();
+            break;
+        case PREFETCH_UNPACK:
+            if (room_pack_read_ready()) prefetch_stage = prefetch_unpack();
+            break;
+        case PREFETCH_SOLID:
+            build_solid_bitmaps(&prefetch_room, &prefetch_solid);
+            prefetch_stage = PREFETCH_BGMAP;
+            break;
+        case PREFETCH_BGMAP:
+            /* Window starts at the top-left corner, as after camera_init */
+            expand_bg_map(&prefetch_room, 0, 0, prefetch_bgmap);
+            prefetch_stage = PREFETCH_READY;
+            break;
+        default:
+            break;
+    }
+}
+
+bool room_prefetch_ready(uint8_t area_id, uint8_t room_id) {
+    return prefetch_matches(area_id, room_id) && prefetch_stage == PREFETCH_READY;
+}
+
+void room_prefetch_cancel(void) {
+    prefetch_stage = PREFETCH_IDLE;
+}
+
+/* Request the room and run its remaining stages to completion */
+static bool prefetch_finish(uint8_t area_id, uint8_t room_id) {
+    if (!room_prefetch(area_id, room_id)) return false;
+    while (prefetch_stage != PREFETCH_IDLE && prefetch_stage != PREFETCH_READY) {
+        if (prefetch_stage == PREFETCH_UNPACK) prefetch_stage = prefetch_unpack();
+        else room_prefetch_update();
+    }
+    return prefetch_stage == PREFETCH_READY;
+}
+
+/* Make the ready prefetched room current and queue its uploads */
+static void prefetch_commit(void) {
+    memcpy(&g_current_room, &prefetch_room, sizeof(RoomData));
+    memcpy(&g_room_solid, &prefetch_solid, sizeof(RoomSolidMap));
+    g_current_room.loaded = true;
+    current_from_pack = prefetch_from_pack;
+    prefetch_stage = PREFETCH_IDLE;
+
+    /* The live map buffer becomes the next prefetch target. Its pending
+     * upload (same dst/size) is replaced by the one queued below. */
+    u16* old_map = vram_bgmap;
+    vram_bgmap = prefetch_bgmap;
+    prefetch_bgmap = old_map;
+
+    stream_x = 0;
+    stream_y = 0;
+    upload_tileset();
+    upload_bg_map();
+
+    LOG_INFO("Room %d:%d (%dx%d) doors=%d spawns=%d src=%s\n",
+             g_current_room.area_id, g_current_room.room_id,
+             g_current_room.width_tiles,
+             g_current_room.height_tiles,
+             g_current_room.door_count,
+             g_current_room.spawn_count,
+             current_from_pack ? "pack" : "built-in");
+}
+
+/* ========================================================================
+ * Room Cache
+ *
+ * Rooms Samus has left, kept decoded with their solid bitmaps and BG
+ * map so backtracking is a copy into the prefetch buffers instead of a
+ * decode. Entries hold the room as it was left, so broken blocks and
+ * collected items survive until the entry is evicted (least recently
+ * used first) or the cache is cleared for a new session.
+ * ======================================================================== */
+
+typedef struct {
+    RoomData     room;
+    RoomSolidMap solid;
+    u16          bgmap[64 * 64];
+    uint32_t     last_used;     /* cache_clock at last store/fetch */
+    bool         from_pack;
+    bool         valid;
+} RoomCacheEntry;
+
+#define ROOM_CACHE_ENTRIES (ROOM_CACHE_BUDGET / sizeof(RoomCacheEntry))
+_Static_assert(ROOM_CACHE_ENTRIES >= 1, "ROOM_CACHE_BUDGET below one room");
+
+static RoomCacheEntry room_cache[ROOM_CACHE_ENTRIES];
+static uint32_t       cache_clock;
+
+static RoomCacheEntry* cache_find(uint8_t area_id, uint8_t room_id) {
+    for (int i = 0; i < (int)ROOM_CACHE_ENTRIES; i++) {
+        RoomCacheEntry* e = &room_cache[i];
+        if (e->valid && e->room.area_id == area_id && e->room.room_id == room_id) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/* Save the live room, replacing its old entry or the least recently used */
+static void cache_store_current(void) {
+    RoomCacheEntry* e = cache_find(g_current_room.area_id, g_current_room.room_id);
+    if (!e) {
+        e = &room_cache[0];
+        for (int i = 0; i < (int)ROOM_CACHE_ENTRIES; i++) {
+            RoomCacheEntry* c = &room_cache[i];
+            if (!c->valid) { e = c; break; }
+            if (c->last_used < e->last_used) e = c;
         }
     }
 
-    /* 4. Upload BG map to VRAM */
-    graphics_load_bg_tilemap(BG_LAYER_LEVEL, vram_bgmap, sizeof(vram_bgmap));
+    memcpy(&e->room, &g_current_room, sizeof(RoomData));
+    memcpy(&e->solid, &g_room_solid, sizeof(RoomSolidMap));
+    e->room.loaded = false;
+    expand_bg_map(&e->room, 0, 0, e->bgmap);
+    e->from_pack = current_from_pack;
+    e->last_used = ++cache_clock;
+    e->valid = true;
+
+    /* A prefetch of this room started before now would be stale */
+    if (prefetch_matches(g_current_room.area_id, g_current_room.room_id)) {
+        room_prefetch_cancel();
+    }
+}
+
+static void cache_drop(uint8_t area_id, uint8_t room_id) {
+    RoomCacheEntry* e = cache_find(area_id, room_id);
+    if (e) e->valid = false;
+}
+
+/* Copy a cached room into the prefetch buffers. False on a miss. */
+static bool cache_fetch(uint8_t area_id, uint8_t room_id) {
+    RoomCacheEntry* e = cache_find(area_id, room_id);
+    if (!e) return false;
+
+    memcpy(&prefetch_room, &e->room, sizeof(RoomData));
+    memcpy(&prefetch_solid, &e->solid, sizeof(RoomSolidMap));
+    memcpy(prefetch_bgmap, e->bgmap, sizeof(e->bgmap));
+    prefetch_from_pack = e->from_pack;
+    e->last_used = ++cache_clock;
+    return true;
+}
+
+bool room_cache_has(uint8_t area_id, uint8_t room_id) {
+    return cache_find(area_id, room_id) != NULL;
+}
+
+int room_cache_count(void) {
+    int n = 0;
+    for (int i = 0; i < (int)ROOM_CACHE_ENTRIES; i++) {
+        if (room_cache[i].valid) n++;
+    }
+    return n;
+}
+
+int room_cache_capacity(void) {
+    return (int)ROOM_CACHE_ENTRIES;
+}
+
+void room_cache_clear(void) {
+    for (int i = 0; i < (int)ROOM_CACHE_ENTRIES; i++) {
+        room_cache[i].valid = false;
+    }
+    room_prefetch_cancel();
+}
+
+/* ========================================================================
+ * Snapshot
+ *
+ * Header fields, then collision/bts/tilemap for width * height metatiles
+ * only, then everything from doors on (spawns, items, crumbles, scroll
+ * bounds), then the streaming window origin.
+ * ======================================================================== */
+
+#define ROOM_SNAP_HEAD  offsetof(RoomData, collision)
+#define ROOM_SNAP_TAIL  (sizeof(RoomData) - offsetof(RoomData, doors))
+
+void room_snapshot_save(SnapshotWriter* w) {
+    const RoomData* r = &g_current_room;
+    uint32_t n = (uint32_t)r->width_tiles * r->height_tiles;
+
+    snapshot_write(w, r, ROOM_SNAP_HEAD);
+    snapshot_write(w, r->collision, n);
+    snapshot_write(w, r->bts, n);
+    snapshot_write(w, r->tilemap, n * sizeof(uint16_t));
+    snapshot_write(w, r->doors, ROOM_SNAP_TAIL);
+    snapshot_write(w, &stream_x, sizeof(stream_x));
+    snapshot_write(w, &stream_y, sizeof(stream_y));
+    snapshot_write(w, &current_from_pack, sizeof(current_from_pack));
+}
+
+void room_snapshot_load(SnapshotReader* rd) {
+    /* Check the size before anything lands in g_current_room */
+    u8 head[ROOM_SNAP_HEAD];
+    uint16_t w, h;
+    snapshot_read(rd, head, sizeof(head));
+    memcpy(&w, head + offsetof(RoomData, width_tiles), sizeof(w));
+    memcpy(&h, head + offsetof(RoomData, height_tiles), sizeof(h));
+    if (w > MAX_ROOM_WIDTH_TILES || h > MAX_ROOM_HEIGHT_TILES) rd->ok = false;
+    if (!rd->ok) return;
+
+    room_prefetch_cancel();
+    room_cache_clear();
+
+    RoomData* r = &g_current_room;
+    uint32_t n = (uint32_t)w * h;
+    memcpy(r, head, sizeof(head));
+    snapshot_read(rd, r->collision, n);
+    snapshot_read(rd, r->bts, n);
+    snapshot_read(rd, r->tilemap, n * sizeof(uint16_t));
+    snapshot_read(rd, r->doors, ROOM_SNAP_TAIL);
+    snapshot_read(rd, &stream_x, sizeof(stream_x));
+    snapshot_read(rd, &stream_y, sizeof(stream_y));
+    snapshot_read(rd, &current_from_pack, sizeof(current_from_pack));
+
+    build_solid_bitmaps(r, &g_room_solid);
+    clear_dirty_tiles();
+    room_upload_to_vram();
 }
@@ -0,0 +1,239 @@
+/**
+ * room_pack.c - Compiled room pack (rooms.bin) reader
+ *
+ * The file stays open while mounted. Arrays that match their on-disk
+ * layout (doors, spawns, collision, bts, tilemap) are read directly into
+ * the RoomData; only items are converted (pixels -> fx32). Compressed
+ * records are read in one fread and expanded into a scratch buffer by the
+ * ARM7 (coproc.h), which the same field reader then copies from once
+ * room_pack_read_end is reached. Record sizes are checked against the
+ * index so a truncated or stale pack fails the load instead of leaving a
+ * half-written room.
+ */
+
+#include "room_pack.h"
+#include "coproc.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+
+/* On-disk layout relies on these matching the packer */
+_Static_assert(sizeof(RoomPackHeader) == 16, "RoomPackHeader layout");
+_Static_assert(sizeof(RoomPackEntry) == 12, "RoomPackEntry layout");
+_Static_assert(sizeof(RoomPackRecord) == 8, "RoomPackRecord layout");
+_Static_assert(sizeof(RoomPackItem) == 8, "RoomPackItem layout");
+_Static_assert(sizeof(DoorData) == 12, "DoorData layout");
+_Static_assert(sizeof(EnemySpawnData) == 10, "EnemySpawnData layout");
+
+static FILE*         pack_file;
+static RoomPackEntry pack_index[ROOM_PACK_MAX_ROOMS];
+static int           pack_count;
+
+/* Compressed records: stored bytes, then the expanded record. Both are
+ * the ARM7's while a job runs; the output is whole cache lines. */
+static u8 lz_stored[ROOM_PACK_RECORD_MAX];
+static u8 lz_record[COPROC_ROUND(ROOM_PACK_RECORD_MAX)] COPROC_ALIGN;
+
+/* Read started by room_pack_read_begin */
+static struct {
+    const RoomPackEntry* entry;     /* NULL: none */
+    bool                 lz;        /* job is expanding lz_stored */
+    CoprocJob            job;
+} pending;
+
+/* Drop the pending read; an expansion in flight still owns the buffers */
+static void read_cancel(void) {
+    if (pending.entry && pending.lz) coproc_wait(pending.job);
+    pending.entry = NULL;
+}
+
+/* ========================================================================
+ * Mount
+ * ======================================================================== */
+
+bool room_pack_mount(const char* path) {
+    room_pack_unmount();
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    RoomPackHeader hdr;
+    bool ok = fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+              hdr.magic == ROOM_PACK_MAGIC &&
+              hdr.version == ROOM_PACK_VERSION &&
+              hdr.room_count <= ROOM_PACK_MAX_ROOMS &&
+              fseek(f, (long)hdr.index_offset, SEEK_SET) == 0 &&
+              fread(pack_index, sizeof(RoomPackEntry), hdr.room_count, f) ==
+                  hdr.room_count;
+
+    /* The index must be sorted for the binary search, records in bounds */
+    for (int i = 0; ok && i < hdr.room_count; i++) {
+        const RoomPackEntry* e = &pack_index[i];
+        if (i > 0 && e->key <= pack_index[i - 1].key) ok = false;
+        if (e->offset > hdr.file_size || e->size > hdr.file_size - e->offset) ok = false;
+    }
+
+    if (!ok) {
+        fclose(f);
+        LOG_WARN("room_pack: %s is not a valid pack\n", path);
+        return false;
+    }
+
+    pack_file = f;
+    pack_count = hdr.room_count;
+    LOG_INFO("room_pack: %s, %d rooms\n", path, pack_count);
+    return true;
+}
+
+void room_pack_unmount(void) {
+    read_cancel();
+    if (pack_file) fclose(pack_file);
+    pack_file = NULL;
+    pack_count = 0;
+}
+
+bool room_pack_mounted(void) {
+    return pack_file != NULL;
+}
+
+int room_pack_room_count(void) {
+    return pack_count;
+}
+
+/* ========================================================================
+ * Lookup
+ * ======================================================================== */
+
+static const RoomPackEntry* find_entry(uint8_t area_id, uint8_t room_id) {
+    uint16_t key = (uint16_t)((area_id << 8) | room_id);
+    int lo = 0, hi = pack_count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        uint16_t k = pack_index[mid].key;
+        if (k == key) return &pack_index[mid];
+        if (k < key) lo = mid + 1;
+        else         hi = mid - 1;
+    }
+    return NULL;
+}
+
+bool room_pack_has(uint8_t area_id, uint8_t room_id) {
+    return pack_file && find_entry(area_id, room_id);
+}
+
+/* ========================================================================
+ * Room Read
+ * ======================================================================== */
+
+/* Record source: the pack file at the record, or an expanded record */
+typedef struct {
+    const u8* mem;          /* NULL: read from pack_file */
+    uint32_t  size;         /* Bytes available */
+    uint32_t  used;         /* Bytes consumed */
+} RecordReader;
+
+static bool read_exact(RecordReader* rd, void* dst, uint32_t size) {
+    if (size == 0) return true;
+    if (size > rd->size - rd->used) return false;
+    if (rd->mem) {
+        memcpy(dst, rd->mem + rd->used, size);
+    } else if (fread(dst, 1, size, pack_file) != size) {
+        return false;
+    }
+    rd->used += size;
+    return true;
+}
+
+static bool skip_pad(RecordReader* rd, uint32_t align) {
+    uint32_t pad = (align - (rd->used % align)) % align;
+    if (pad > rd->size - rd->used) return false;
+    rd->used += pad;
+    return pad == 0 || rd->mem || fseek(pack_file, (long)pad, SEEK_CUR) == 0;
+}
+
+bool room_pack_read_begin(uint8_t area_id, uint8_t room_id) {
+    read_cancel();
+    if (!pack_file) return false;
+    const RoomPackEntry* e = find_entry(area_id, room_id);
+    if (!e) return false;
+
+    pending.lz = (e->flags & ROOM_PACK_FLAG_LZ) != 0;
+    if (pending.lz) {
+        if (e->size > sizeof(lz_stored) ||
+            fseek(pack_file, (long)e->offset, SEEK_SET) != 0 ||
+            fread(lz_stored, 1, e->size, pack_file) != e->size) {
+            return false;
+        }
+        pending.job = coproc_submit(COPROC_JOB_LZ, lz_stored, e->size,
+                                    lz_record, sizeof(lz_record));
+    }
+    pending.entry = e;
+    return true;
+}
+
+bool room_pack_read_ready(void) {
+    return pending.entry && (!pending.lz || coproc_done(pending.job));
+}
+
+/* Parse a record from rd into out */
+static bool read_record(RecordReader* rd, RoomData* out) {
+    RoomPackRecord rec;
+    if (!read_exact(rd, &rec, sizeof(rec))) return false;
+
+    uint32_t cells = (uint32_t)rec.width_tiles * rec.height_tiles;
+    if (rec.width_tiles == 0 || rec.width_tiles > MAX_ROOM_WIDTH_TILES ||
+        rec.height_tiles == 0 || rec.height_tiles > MAX_ROOM_HEIGHT_TILES ||
+        rec.door_count > MAX_DOORS || rec.spawn_count > MAX_ENEMIES ||
+        rec.item_count > MAX_ITEMS) {
+        return false;
+    }
+
+    memset(out->collision, COLL_AIR, sizeof(out->collision));
+    memset(out->bts, 0, sizeof(out->bts));
+    memset(out->tilemap, 0, sizeof(out->tilemap));
+
+    RoomPackItem items[MAX_ITEMS];
+    bool ok = read_exact(rd, out->doors, rec.door_count * sizeof(DoorData)) &&
+              read_exact(rd, out->spawns, rec.spawn_count * sizeof(EnemySpawnData)) &&
+              read_exact(rd, items, rec.item_count * sizeof(RoomPackItem)) &&
+              skip_pad(rd, 4) &&
+              read_exact(rd, out->collision, cells) &&
+              read_exact(rd, out->bts, cells) &&
+              skip_pad(rd, 2) &&
+              read_exact(rd, out->tilemap, cells * sizeof(uint16_t));
+    if (!ok) return false;
+
+    out->width_tiles = rec.width_tiles;
+    out->height_tiles = rec.height_tiles;
+    out->tileset_id = rec.tileset_id;
+    out->door_count = rec.door_count;
+    out->spawn_count = rec.spawn_count;
+    out->item_count = rec.item_count;
+    for (int i = 0; i < rec.item_count; i++) {
+        out->items[i] = (ItemData){
+            (ItemTypeID)items[i].type,
+            INT_TO_FX(items[i].x), INT_TO_FX(items[i].y), false
+        };
+    }
+    return true;
+}
+
+bool room_pack_read_end(RoomData* out) {
+    const RoomPackEntry* e = pending.entry;
+    if (!e) return false;
+    pending.entry = NULL;
+
+    RecordReader rd = { NULL, e->size, 0 };
+    if (pending.lz) {
+        int32_t n = coproc_wait(pending.job);
+        if (n < 0) return false;
+        rd = (RecordReader){ lz_record, (uint32_t)n, 0 };
+    } else if (fseek(pack_file, (long)e->offset, SEEK_SET) != 0) {
+        return false;
+    }
+    return read_record(&rd, out);
+}
+
+bool room_pack_read(uint8_t area_id, uint8_t room_id, RoomData* out) {
+    return room_pack_read_begin(area_id, room_id) && room_pack_read_end(out);
+}
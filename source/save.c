@@ -10,9 +10,16 @@
  *
  * Backed by libfat filesystem (SD card on flash carts, emulator FS).
  * Falls back to in-memory-only (no persistence) if FAT unavailable.
+ * Writes only touch the RAM image; save_flush_update() writes it back
+ * through a temp file a chunk per frame, so the .sav is always whole.
+ * A written slot's checksum is computed on the ARM7 (coproc.h) and
+ * stored before the flush that carries the slot starts.
  */
 
 #include "save.h"
+#include "sm_config.h"
+#include "log.h"
+#include "coproc.h"
 #include <nds.h>
 #include <nds/dldi.h>
 #include <fat.h>
@@ -105,43 +112,106 @@
  * Static Data
  * ======================================================================== */
 
-#define SAVE_FILE_NAME "SuperMetroidDS.sav"
-
 static const uint16_t slot_offsets[3] = {
     SNES_SLOT_0, SNES_SLOT_1, SNES_SLOT_2
 };
 
 /* In-memory image of the full 8KB SNES SRAM.
- * Loaded from .sav file at init, flushed back on write/delete. */
+ * Loaded from the .sav file at mount, written back by save_flush_update(). */
 static uint8_t sram_image[SNES_SRAM_SIZE];
 
 /* Working buffer for building/reading a slot */
 static uint8_t slot_buf[SNES_SLOT_SIZE];
 
-/* Whether FAT filesystem is available for persistence */
-static bool fat_available;
+/* Set by every sram_* write; cleared when a flush takes its snapshot */
+static bool sram_dirty;
 
 /* ========================================================================
  * FAT File I/O
+ *
+ * Every flush writes a snapshot of the whole image to <path>.tmp, then
+ * replaces the .sav with it, so a power cut at any point leaves either
+ * the old or the new file complete -- never a half-patched slot. Mount
+ * finishes a replace cut short between the remove and the rename. The
+ * work is spread over frames by save_flush_update().
  * ======================================================================== */
 
+/* Backing file; persistence is off while save_path is empty */
+static char save_path[64];
+static char temp_path[sizeof(save_path) + 4];
+
+static struct {
+    FILE*    file;          /* Temp image, open while a flush is in progress */
+    uint32_t done;          /* Bytes of the snapshot written */
+} flush;
+
+/* Image as it was when the flush began; later writes go to the next flush */
+static uint8_t flush_image[SNES_SRAM_SIZE];
+
+static bool file_exists(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fclose(f);
+    return true;
+}
+
+static long file_size(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    long size = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    fclose(f);
+    return size;
+}
+
+/* Load the .sav, first finishing a temp replace cut short by power loss.
+ * Only a complete temp next to a missing .sav is promoted; a partial one
+ * (power lost while writing it, e.g. during the very first save) goes. */
 static void sram_load_from_file(void) {
-    FILE* f = fopen(SAVE_FILE_NAME, "rb");
+    if (file_exists(temp_path)) {
+        if (!file_exists(save_path) && file_size(temp_path) == SNES_SRAM_SIZE) {
+            rename(temp_path, save_path);
+            LOG_WARN("save: recovered %s\n", temp_path);
+        } else {
+            remove(temp_path);          /* Never finished */
+        }
+    }
+
+    FILE* f = fopen(save_path, "rb");
     if (f) {
         fread(sram_image, 1, SNES_SRAM_SIZE, f);
         fclose(f);
-        fprintf(stderr, "save: loaded %s\n", SAVE_FILE_NAME);
+        LOG_INFO("save: loaded %s\n", save_path);
     }
     /* If file doesn't exist, sram_image stays zeroed (no saves) */
 }
 
-static void sram_flush_to_file(void) {
-    if (!fat_available) return;
-    FILE* f = fopen(SAVE_FILE_NAME, "wb");
-    if (f) {
-        fwrite(sram_image, 1, SNES_SRAM_SIZE, f);
-        fclose(f);
+static bool flush_begin(void) {
+    flush.file = fopen(temp_path, "wb");
+    if (!flush.file) return false;
+    memcpy(flush_image, sram_image, SNES_SRAM_SIZE);
+    flush.done = 0;
+    sram_dirty = false;
+    return true;
+}
+
+/* Write up to budget bytes of the snapshot; true when it replaced the .sav */
+static bool flush_step(uint32_t budget, bool* failed) {
+    uint32_t n = SNES_SRAM_SIZE - flush.done;
+    if (n > budget) n = budget;
+    if (fwrite(&flush_image[flush.done], 1, n, flush.file) != n) {
+        *failed = true;
+        return false;
     }
+    flush.done += n;
+    if (flush.done < SNES_SRAM_SIZE) return false;
+
+    if (fclose(flush.file) != 0) *failed = true;
+    flush.file = NULL;
+    if (*failed) return false;
+    /* FAT rename won't overwrite, so the .sav goes first */
+    remove(save_path);
+    if (rename(temp_path, save_path) != 0) *failed = true;
+    return !*failed;
 }
 
 /* ========================================================================
@@ -154,14 +224,17 @@ static void sram_read_bytes(uint32_t offset, void* dst, uint32_t len) {
 
 static void sram_write_bytes(uint32_t offset, const void* src, uint32_t len) {
     memcpy(&sram_image[offset], src, len);
+    sram_dirty = true;
 }
 
 static void sram_zero(uint32_t offset, uint32_t len) {
     memset(&sram_image[offset], 0, len);
+    sram_dirty = true;
 }
 
 static void sram_write_u8(uint32_t offset, uint8_t val) {
     sram_image[offset] = val;
+    sram_dirty = true;
 }
 
 static uint8_t sram_read_u8(uint32_t offset) {
@@ -181,35 +254,6 @@ static uint16_t buf_get_u16(uint16_t offset) {
     return (uint16_t)slot_buf[offset] | ((uint16_t)slot_buf[offset + 1] << 8);
 }
 
-/* ========================================================================
- * SNES Checksum (alternating-byte accumulator)
- *
- * Even bytes accumulate in 'high', odd bytes in 'low'.
- * Overflow from high carries into low; overflow from low is discarded.
- * ======================================================================== */
-
-static void snes_checksum(const uint8_t* data, uint32_t len,
-                           uint8_t* out_hi, uint8_t* out_lo) {
-    uint16_t high = 0, low = 0;
-
-    for (uint32_t i = 0; i < len; i += 2) {
-        high += data[i];
-        if (high > 0xFF) {
-            high &= 0xFF;
-            low++;
-        }
-        if (i + 1 < len) {
-            low += data[i + 1];
-            if (low > 0xFF) {
-                low &= 0xFF;
-            }
-        }
-    }
-
-    *out_hi = (uint8_t)high;
-    *out_lo = (uint8_t)low;
-}
-
 /* Write checksum + complement to all 4 SRAM locations */
 static void write_checksums(int slot, uint8_t chk_hi, uint8_t chk_lo) {
     uint8_t comp_hi = chk_hi ^ 0xFF;
@@ -228,12 +272,48 @@ static void write_checksums(int slot, uint8_t chk_hi, uint8_t chk_lo) {
     sram_write_u8(COMP_REDUNDANT + slot * 2 + 1, comp_lo);
 }
 
+/* Zero checksum and complement for a slot (primary + redundant).
+ * A complement of 0 never matches chk^0xFF, so the slot reads as empty. */
+static void clear_checksums(int slot) {
+    sram_zero(CHK_PRIMARY    + slot * 2, 2);
+    sram_zero(COMP_PRIMARY   + slot * 2, 2);
+    sram_zero(CHK_REDUNDANT  + slot * 2, 2);
+    sram_zero(COMP_REDUNDANT + slot * 2, 2);
+}
+
+/* Checksum of the last save_write, running on the ARM7 over the slot's
+ * bytes in sram_image */
+static struct {
+    bool      active;
+    int       slot;
+    CoprocJob job;
+} pending_chk;
+
+/* Store the pending checksum once its job is done; wait blocks on it.
+ * Everything that reads or rewrites a slot settles first. */
+static void checksum_settle(bool wait) {
+    if (!pending_chk.active) return;
+    if (!wait && !coproc_done(pending_chk.job)) return;
+
+    int slot = pending_chk.slot;
+    int32_t chk = coproc_wait(pending_chk.job);
+    pending_chk.active = false;
+    if (chk < 0) {
+        /* Result expired behind newer jobs: cheap enough to redo */
+        uint8_t hi, lo;
+        save_checksum(&sram_image[slot_offsets[slot]], SNES_SLOT_SIZE, &hi, &lo);
+        chk = (hi << 8) | lo;
+    }
+    write_checksums(slot, (uint8_t)(chk >> 8), (uint8_t)chk);
+    LOG_INFO("save: write slot %d (chk=%04X)\n", slot, (unsigned)chk);
+}
+
 /* Validate checksum for a slot. Fills slot_buf on success. */
 static bool validate_checksum(int slot) {
     sram_read_bytes(slot_offsets[slot], slot_buf, SNES_SLOT_SIZE);
 
     uint8_t calc_hi, calc_lo;
-    snes_checksum(slot_buf, SNES_SLOT_SIZE, &calc_hi, &calc_lo);
+    save_checksum(slot_buf, SNES_SLOT_SIZE, &calc_hi, &calc_lo);
 
     /* Try primary pair */
     uint8_t chk_hi  = sram_read_u8(CHK_PRIMARY  + slot * 2);
@@ -413,8 +493,9 @@ static void write_default_controls(void) {
  * ======================================================================== */
 
 void save_init(void) {
+    save_unmount();
     memset(sram_image, 0, SNES_SRAM_SIZE);
-    fat_available = false;
+    sram_dirty = false;
 
     /* Only attempt FAT if DLDI driver was actually patched by a loader.
      * __dldi_start is in ARM7 WRAM (0x0380B000) -- NOT ARM9-accessible.
@@ -423,19 +504,76 @@ void save_init(void) {
      * on an unpatched DLDI can hang (e.g. melonDS without SD configured). */
     DLDI_INTERFACE dldi_copy;
     if (dldiDumpInternal(&dldi_copy) && dldi_copy.disc.features != 0) {
-        fat_available = fatInitDefault();
-        if (fat_available) {
-            sram_load_from_file();
+        if (fatInitDefault()) {
+            save_mount(SAVE_FILE_PATH);
         }
     }
 
-    fprintf(stderr, "save: init, persistence=%s (%u bytes/slot)\n",
-            fat_available ? "FAT" : "none", SNES_SLOT_SIZE);
+    LOG_INFO("save: init, persistence=%s (%u bytes/slot)\n",
+             save_path[0] ? "FAT" : "none", SNES_SLOT_SIZE);
+}
+
+bool save_mount(const char* path) {
+    save_unmount();
+    if (path == NULL || strlen(path) >= sizeof(save_path)) return false;
+
+    strcpy(save_path, path);
+    strcpy(temp_path, path);
+    strcat(temp_path, ".tmp");
+
+    memset(sram_image, 0, SNES_SRAM_SIZE);
+    sram_load_from_file();
+    sram_dirty = false;
+    return true;
+}
+
+void save_unmount(void) {
+    save_flush_sync();
+    save_path[0] = '\0';
+}
+
+void save_flush_update(void) {
+    checksum_settle(false);
+    if (!save_path[0]) {
+        sram_dirty = false;     /* In-memory only: nothing to write back */
+        return;
+    }
+    /* A slot goes out in the same flush as its checksum */
+    if (pending_chk.active && !flush.file) return;
+
+    bool failed = false;
+    bool finished = false;
+    if (!flush.file) {
+        if (!sram_dirty) return;
+        if (!flush_begin()) failed = true;
+    }
+    if (!failed) finished = flush_step(SAVE_FLUSH_CHUNK, &failed);
+
+    if (failed) {
+        /* Card removed or read-only: keep playing from the RAM image */
+        if (flush.file) fclose(flush.file);
+        flush.file = NULL;
+        LOG_ERROR("save: write to %s failed, persistence off\n", save_path);
+        save_path[0] = '\0';
+    } else if (finished) {
+        LOG_INFO("save: flushed %s\n", save_path);
+    }
+}
+
+bool save_flush_pending(void) {
+    return flush.file != NULL || (save_path[0] && sram_dirty) ||
+           pending_chk.active;
+}
+
+void save_flush_sync(void) {
+    checksum_settle(true);
+    while (save_flush_pending()) save_flush_update();
 }
 
 bool save_write(int slot, const SaveData* data) {
     if (slot < 0 || slot >= SAVE_SLOT_COUNT) return false;
     if (data == NULL) return false;
+    checksum_settle(true);
 
     /* Clear buffer to zero (unpopulated fields stay 0) */
     memset(slot_buf, 0, SNES_SLOT_SIZE);
@@ -491,22 +629,20 @@ bool save_write(int slot, const SaveData* data) {
     /* --- Write to SRAM image --- */
     sram_write_bytes(slot_offsets[slot], slot_buf, SNES_SLOT_SIZE);
 
-    /* Calculate and store checksums */
-    uint8_t chk_hi, chk_lo;
-    snes_checksum(slot_buf, SNES_SLOT_SIZE, &chk_hi, &chk_lo);
-    write_checksums(slot, chk_hi, chk_lo);
-
-    /* Flush to filesystem */
-    sram_flush_to_file();
-
-    fprintf(stderr, "save: write slot %d (chk=%02X%02X)\n",
-            slot, chk_hi, chk_lo);
+    /* Checksum runs on the ARM7; save_flush_update() stores it and
+     * writes the slot back over the next frames */
+    pending_chk.active = true;
+    pending_chk.slot = slot;
+    pending_chk.job = coproc_submit(COPROC_JOB_CHECKSUM,
+                                    &sram_image[slot_offsets[slot]], SNES_SLOT_SIZE,
+                                    NULL, 0);
     return true;
 }
 
 bool save_read(int slot, SaveData* data) {
     if (slot < 0 || slot >= SAVE_SLOT_COUNT) return false;
     if (data == NULL) return false;
+    checksum_settle(true);
 
     /* Validate checksum (also fills slot_buf) */
     if (!validate_checksum(slot)) return false;
@@ -548,22 +684,22 @@ bool save_read(int slot, SaveData* data) {
 
 bool save_slot_valid(int slot) {
     if (slot < 0 || slot >= SAVE_SLOT_COUNT) return false;
+    checksum_settle(true);
     return validate_checksum(slot);
 }
 
 void save_delete(int slot) {
     if (slot < 0 || slot >= SAVE_SLOT_COUNT) return;
+    checksum_settle(true);
 
     /* Zero the slot data */
     sram_zero(slot_offsets[slot], SNES_SLOT_SIZE);
 
     /* Invalidate checksums: write 0 for both checksum and complement.
      * Since complement should be chk^0xFF, storing 0 for both
-     * guarantees validation fails. */
-    write_checksums(slot, 0, 0);
-
-    /* Flush to filesystem */
-    sram_flush_to_file();
+     * guarantees validation fails. (write_checksums() would store the
+     * matching 0xFF complement and make the zeroed slot valid.) */
+    clear_checksums(slot);
 
-    fprintf(stderr, "save: delete slot %d\n", slot);
+    LOG_INFO("save: delete slot %d\n", slot);
 }
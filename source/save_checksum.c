@@ -0,0 +1,33 @@
+/**
+ * save_checksum.c - SNES SRAM checksum
+ *
+ * Kept apart from save.c so the ARM7 worker can link it without the
+ * FAT code (coproc.h runs slot checksums there).
+ *
+ * Even bytes accumulate in 'high', odd bytes in 'low'.
+ * Overflow from high carries into low; overflow from low is discarded.
+ */
+
+#include "save.h"
+
+void save_checksum(const uint8_t* data, uint32_t len,
+                   uint8_t* out_hi, uint8_t* out_lo) {
+    uint16_t high = 0, low = 0;
+
+    for (uint32_t i = 0; i < len; i += 2) {
+        high += data[i];
+        if (high > 0xFF) {
+            high &= 0xFF;
+            low++;
+        }
+        if (i + 1 < len) {
+            low += data[i + 1];
+            if (low > 0xFF) {
+                low &= 0xFF;
+            }
+        }
+    }
+
+    *out_hi = (uint8_t)high;
+    *out_lo = (uint8_t)low;
+}
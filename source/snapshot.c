@@ -0,0 +1,226 @@
+/**
+ * snapshot.c - Quick-save snapshots of the live simulation
+ *
+ * Each module with gameplay state writes its own section through the
+ * SnapshotWriter, in the order listed in write_sections(). Sections are
+ * raw struct images; the header's layout stamp rejects blobs from a
+ * build whose structs differ, and the checksum is verified before any
+ * section is applied, so a bad blob leaves the running game alone.
+ */
+
+#include "snapshot.h"
+#include "sm_config.h"
+#include "player.h"
+#include "room.h"
+#include "enemy.h"
+#include "projectile.h"
+#include "boss.h"
+#include "boss_vm.h"
+#include "camera.h"
+#include "input.h"
+#include "gameplay.h"
+#include <stdio.h>
+#include <string.h>
+
+_Static_assert(SNAPSHOT_MAX_BYTES >=
+               sizeof(SnapshotHeader) + sizeof(RoomData) + sizeof(Player) +
+               MAX_ENEMIES * (sizeof(Enemy) + sizeof(PhysicsBody)) +
+               MAX_PROJECTILES * sizeof(Projectile) + sizeof(Boss) +
+               sizeof(BossProgramHeader) + BOSS_PROGRAM_MAX_OPS * sizeof(BossOp) +
+               1024,
+               "SNAPSHOT_MAX_BYTES below a worst-case snapshot");
+
+/* Quick-save slot (also the staging buffer for snapshot files) */
+static u8       quick_slot[SNAPSHOT_MAX_BYTES] __attribute__((aligned(4)));
+static uint32_t quick_size;
+
+/* ========================================================================
+ * Writer / Reader
+ * ======================================================================== */
+
+void snapshot_write(SnapshotWriter* w, const void* src, uint32_t len) {
+    if (!w->ok) return;
+    if (len > w->cap - w->used) {
+        w->ok = false;
+        return;
+    }
+    memcpy(w->buf + w->used, src, len);
+    w->used += len;
+}
+
+void snapshot_read(SnapshotReader* r, void* dst, uint32_t len) {
+    if (!r->ok) return;
+    if (len > r->size - r->used) {
+        r->ok = false;
+        return;
+    }
+    memcpy(dst, r->buf + r->used, len);
+    r->used += len;
+}
+
+/* FNV-1a */
+static uint32_t hash_bytes(uint32_t h, const void* data, uint32_t len) {
+    const u8* p = data;
+    for (uint32_t i = 0; i < len; i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+#define HASH_SEED 2166136261u
+
+/* Changes whenever a struct a section copies changes size */
+static uint32_t layout_stamp(void) {
+    static const uint32_t sizes[] = {
+        SNAPSHOT_VERSION,
+        sizeof(RoomData), sizeof(Player), sizeof(Enemy), sizeof(PhysicsBody),
+        sizeof(Projectile), sizeof(Boss), sizeof(Camera),
+        sizeof(BossProgramHeader), sizeof(BossOp),
+        MAX_ENEMIES, MAX_PROJECTILES, ENEMY_TYPE_COUNT, INPUT_BUFFER_FRAMES,
+    };
+    return hash_bytes(HASH_SEED, sizes, sizeof(sizes));
+}
+
+/* ========================================================================
+ * Sections
+ *
+ * The room goes first: its load checks the room size before touching
+ * anything, the only check not covered by the header.
+ * ======================================================================== */
+
+static void write_sections(SnapshotWriter* w) {
+    room_snapshot_save(w);
+    snapshot_write(w, &g_player, sizeof(g_player));
+    enemy_snapshot_save(w);
+    projectile_snapshot_save(w);
+    boss_snapshot_save(w);
+    camera_snapshot_save(w);
+    input_snapshot_save(w);
+    gameplay_snapshot_save(w);
+}
+
+static void read_sections(SnapshotReader* r) {
+    room_snapshot_load(r);
+    snapshot_read(r, &g_player, sizeof(g_player));
+    enemy_snapshot_load(r);
+    projectile_snapshot_load(r);
+    boss_snapshot_load(r);
+    camera_snapshot_load(r);
+    input_snapshot_load(r);
+    gameplay_snapshot_load(r);
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+uint32_t snapshot_save(void* buf, uint32_t cap) {
+    if (!g_current_room.loaded || cap < sizeof(SnapshotHeader)) return 0;
+
+    SnapshotWriter w = { buf, cap, sizeof(SnapshotHeader), true };
+    write_sections(&w);
+    if (!w.ok) return 0;
+
+    SnapshotHeader hdr = {
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .reserved = 0,
+        .layout = layout_stamp(),
+        .size = w.used,
+        .checksum = hash_bytes(HASH_SEED, w.buf + sizeof(hdr), w.used - sizeof(hdr)),
+        .replay_frame = input_replay_frame(),
+    };
+    memcpy(buf, &hdr, sizeof(hdr));
+    return w.used;
+}
+
+/* Everything but the checksum, for a blob of size bytes */
+static bool header_ok(const SnapshotHeader* hdr, uint32_t size) {
+    return hdr->magic == SNAPSHOT_MAGIC && hdr->version == SNAPSHOT_VERSION &&
+           hdr->layout == layout_stamp() && hdr->size == size;
+}
+
+bool snapshot_load(const void* buf, uint32_t size) {
+    if (buf == NULL || size < sizeof(SnapshotHeader)) return false;
+
+    SnapshotHeader hdr;
+    memcpy(&hdr, buf, sizeof(hdr));
+    const u8* body = (const u8*)buf + sizeof(hdr);
+    if (!header_ok(&hdr, size) ||
+        hdr.checksum != hash_bytes(HASH_SEED, body, size - sizeof(hdr))) {
+        return false;
+    }
+
+    SnapshotReader r = { buf, size, sizeof(hdr), true };
+    read_sections(&r);
+
+    /* Replay fast-forward: carry on from the frame the snapshot was at */
+    if (input_replay_mode() == REPLAY_PLAYING) input_replay_seek(hdr.replay_frame);
+
+    return r.ok && r.used == size;
+}
+
+bool snapshot_quick_save(void) {
+    uint32_t n = snapshot_save(quick_slot, sizeof(quick_slot));
+    if (n == 0) return false;
+    quick_size = n;
+    return true;
+}
+
+bool snapshot_quick_load(void) {
+    return quick_size > 0 && snapshot_load(quick_slot, quick_size);
+}
+
+bool snapshot_quick_valid(void) {
+    return quick_size > 0;
+}
+
+bool snapshot_save_file(const char* path) {
+    if (!snapshot_quick_save()) return false;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(quick_slot, 1, quick_size, f) == quick_size;
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+/* Checksum the rest of an open snapshot file in small reads; true if it
+ * matches hdr and the file ends where hdr says */
+static bool file_body_ok(FILE* f, const SnapshotHeader* hdr) {
+    static u8 chunk[512];
+    uint32_t h = HASH_SEED;
+    uint32_t left = hdr->size - sizeof(*hdr);
+    while (left > 0) {
+        uint32_t n = left < sizeof(chunk) ? left : sizeof(chunk);
+        if (fread(chunk, 1, n, f) != n) return false;
+        h = hash_bytes(h, chunk, n);
+        left -= n;
+    }
+    return h == hdr->checksum && fgetc(f) == EOF;
+}
+
+bool snapshot_load_file(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    /* The file is checked in place first: the quick-save slot is only
+     * the staging buffer once the file is known to be good */
+    SnapshotHeader hdr;
+    bool valid = fread(&hdr, 1, sizeof(hdr), f) == sizeof(hdr) &&
+                 hdr.size >= sizeof(hdr) && hdr.size <= sizeof(quick_slot) &&
+                 header_ok(&hdr, hdr.size) && file_body_ok(f, &hdr) &&
+                 fseek(f, 0, SEEK_SET) == 0;
+    if (!valid) {
+        fclose(f);
+        return false;
+    }
+    quick_size = (uint32_t)fread(quick_slot, 1, hdr.size, f);
+    fclose(f);
+
+    if (!snapshot_quick_load()) {
+        quick_size = 0;
+        return false;
+    }
+    return true;
+}
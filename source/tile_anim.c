@@ -0,0 +1,104 @@
+/**
+ * tile_anim.c - Animated tiles and sprite frame streaming
+ *
+ * BG animations are a flat table installed per tileset; all of them
+ * tick together from tile_anim_update (called once per rendered
+ * gameplay frame, so pause freezes them). A frame change costs one
+ * queued upload of tile_count * 32 bytes, e.g. 128 bytes for a 2x2
+ * metatile of lava.
+ *
+ * Sprite streams don't tick on their own: the owner picks a frame each
+ * render and the stream skips the upload when it's already resident.
+ */
+
+#include "tile_anim.h"
+#include "graphics.h"
+#include <string.h>
+
+/* ========================================================================
+ * BG Tile Animations
+ * ======================================================================== */
+
+typedef struct {
+    const TileAnimDef* def;
+    uint8_t frame;
+    uint8_t timer;
+} TileAnimState;
+
+static TileAnimState anims[MAX_TILE_ANIMS];
+static int anim_count;
+static int anim_layer;
+
+/* A full queue just skips this frame's graphics; the next change
+ * uploads a complete frame again. */
+static void upload_frame(const TileAnimState* a) {
+    const TileAnimDef* d = a->def;
+    uint32_t bytes = (uint32_t)d->tile_count * 32;
+    graphics_load_bg_tiles(anim_layer, d->frames + a->frame * bytes, bytes,
+                           d->tile);
+}
+
+void tile_anim_init(void) {
+    memset(anims, 0, sizeof(anims));
+    anim_count = 0;
+    anim_layer = 0;
+}
+
+void tile_anim_set(int layer, const TileAnimDef* defs, int count) {
+    tile_anim_init();
+    if (!defs) return;
+    if (count > MAX_TILE_ANIMS) count = MAX_TILE_ANIMS;
+
+    anim_layer = layer;
+    for (int i = 0; i < count; i++) {
+        if (defs[i].frame_count == 0 || defs[i].tile_count == 0) continue;
+        TileAnimState* a = &anims[anim_count++];
+        a->def = &defs[i];
+        a->frame = 0;
+        a->timer = defs[i].frame_ticks;
+        upload_frame(a);
+    }
+}
+
+void tile_anim_update(void) {
+    for (int i = 0; i < anim_count; i++) {
+        TileAnimState* a = &anims[i];
+        if (a->def->frame_count < 2) continue;
+        if (a->timer > 1) {
+            a->timer--;
+            continue;
+        }
+        a->timer = a->def->frame_ticks;
+        a->frame = (uint8_t)((a->frame + 1) % a->def->frame_count);
+        upload_frame(a);
+    }
+}
+
+int tile_anim_get_frame(int index) {
+    if (index < 0 || index >= anim_count) return -1;
+    return anims[index].frame;
+}
+
+/* ========================================================================
+ * Sprite Frame Streams
+ * ======================================================================== */
+
+void sprite_stream_init(SpriteStream* s, const void* bank,
+                        uint16_t frame_bytes, uint16_t vram_tile) {
+    s->bank = bank;
+    s->frame_bytes = frame_bytes;
+    s->vram_tile = vram_tile;
+    s->current = -1;
+}
+
+bool sprite_stream_show(SpriteStream* s, int frame) {
+    if (!s->bank || frame < 0) return false;
+    if (s->current == frame) return true;
+
+    if (!graphics_load_sprite_tiles(s->bank + (uint32_t)frame * s->frame_bytes,
+                                    s->frame_bytes, s->vram_tile)) {
+        return false;
+    }
+    s->current = (int16_t)frame;
+    return true;
+}
@@ -4,26 +4,45 @@ build_assets.py - Master asset pipeline for Super Metroid DS port
 
 Pipeline stages:
 1. ROM extraction (if needed) - calls rom_extract.py
-2. Tile conversion - SNES 4bpp planar to DS 4bpp linear
+2. Tile conversion - SNES 4bpp planar to DS 4bpp linear, then duplicate
+   and flipped-duplicate tiles removed (tile_dedup.py; writes .remap and,
+   given assets_raw/tiletables/<name>.bin, a .mtd MetatileDef table)
 3. Palette conversion - SNES BGR555 to DS BGR555 (validation + pass-through)
-4. Tilemap conversion - SNES metatiles to DS BG map format
-5. Output to data/ directory for bin2o embedding
+4. Tilemap conversion - SNES metatiles to DS BG map format (remapped to
+   the deduplicated tileset of the same name, if any)
+5. Room pack - assets/rooms/*.json to nitrofs/rooms.bin (room_pack.py)
+6. Output to data/ directory for bin2o embedding
+   (--compress: room pack records stored LC_LZ2-compressed, expanded by
+   source/room_pack.c through source/lz.c as each room loads)
+
+Stages 2-5 are incremental and parallel. Each output is keyed by a
+SHA-256 of its inputs, the converter script and the options used, stored
+in data/.asset_hashes.json; outputs whose key is unchanged are skipped.
+The remaining conversions run --jobs at a time (default: CPU count).
 
 Directory structure:
   assets_raw/        - Extracted ROM data (from rom_extract.py)
     tilesets/        - SNES tile data
+    tiletables/      - SNES metatile tables (optional, per tileset)
     palettes/        - SNES palette data
     tilemaps/        - SNES tilemap data
   data/              - Converted assets ready for DS
     tiles/
     palettes/
     maps/
+  assets/rooms/      - Room definitions (JSON, hand-authored)
+  nitrofs/           - NitroFS image contents
+    rooms.bin        - Compiled room pack
 """
 
 import argparse
+import hashlib
+import json
 import os
 import sys
 import subprocess
+import time
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 
 
@@ -32,12 +51,18 @@ TOOLS_DIR = Path(__file__).parent
 PROJECT_DIR = TOOLS_DIR.parent
 ASSETS_RAW_DIR = PROJECT_DIR / "assets_raw"
 DATA_DIR = PROJECT_DIR / "data"
+ROOMS_DIR = PROJECT_DIR / "assets" / "rooms"
+NITRO_DIR = PROJECT_DIR / "nitrofs"
+HASH_MANIFEST = DATA_DIR / ".asset_hashes.json"
 
 # Tool scripts
 ROM_EXTRACT_SCRIPT = TOOLS_DIR / "rom_extract.py"
 TILE_CONVERTER_SCRIPT = TOOLS_DIR / "tile_converter.py"
 PALETTE_CONVERTER_SCRIPT = TOOLS_DIR / "palette_converter.py"
 TILEMAP_CONVERTER_SCRIPT = TOOLS_DIR / "tilemap_converter.py"
+ROOM_PACK_SCRIPT = TOOLS_DIR / "room_pack.py"
+LZ_COMPRESS_SCRIPT = TOOLS_DIR / "lz_compress.py"
+TILE_DEDUP_SCRIPT = TOOLS_DIR / "tile_dedup.py"
 
 
 def run_command(cmd, description):
@@ -49,18 +74,32 @@ def run_command(cmd, description):
         description: Human-readable description for error messages
     """
     print(f"[*] {description}")
+    ok, stdout, stderr = run_quiet(cmd)
+    if stdout:
+        print(stdout, end='')
+    if not ok:
+        print(f"[ERROR] {description} failed:", file=sys.stderr)
+        print(stderr, file=sys.stderr)
+    return ok
+
+
+def run_quiet(cmd):
+    """
+    Execute a command, capturing its output.
+
+    Args:
+        cmd: Command list to execute
+
+    Returns:
+        (success, stdout, stderr)
+    """
     try:
         result = subprocess.run(cmd, check=True, capture_output=True, text=True)
-        if result.stdout:
-            print(result.stdout, end='')
-        return True
+        return True, result.stdout, result.stderr
     except subprocess.CalledProcessError as e:
-        print(f"[ERROR] {description} failed:", file=sys.stderr)
-        print(e.stderr, file=sys.stderr)
-        return False
+        return False, e.stdout, e.stderr
     except FileNotFoundError as e:
-        print(f"[ERROR] Command not found: {e}", file=sys.stderr)
-        return False
+        return False, "", f"Command not found: {e}"
 
 
 def extract_rom(rom_path, force=False):
@@ -92,118 +131,201 @@ def extract_rom(rom_path, force=False):
     return run_command(cmd, "Extracting ROM data")
 
 
-def convert_tilesets():
-    """
-    Convert all tilesets from assets_raw/tilesets/ to data/tiles/
+# ============================================================
+# Incremental jobs
+# ============================================================
 
-    Returns:
-        Number of tilesets converted, or -1 on error
+class Job:
     """
-    tileset_dir = ASSETS_RAW_DIR / "tilesets"
-    output_dir = DATA_DIR / "tiles"
+    One output produced by one or more commands run in order.
 
-    if not tileset_dir.exists():
-        print(f"[WARNING] Tileset directory not found: {tileset_dir}", file=sys.stderr)
-        return 0
-
-    output_dir.mkdir(parents=True, exist_ok=True)
-
-    tileset_files = sorted(tileset_dir.glob("*.bin"))
-    if not tileset_files:
-        print(f"[WARNING] No tileset files (*.bin) found in {tileset_dir}", file=sys.stderr)
-        return 0
+    Args:
+        description: Human-readable name for progress/errors
+        inputs: Files whose content determines the output
+        output: Final output file
+        commands: Command lists to execute
+        options: Extra strings folded into the hash (flags that change the output)
+    """
 
-    converted = 0
-    for tileset_file in tileset_files:
-        output_file = output_dir / f"{tileset_file.stem}.ds.bin"
-        cmd = [
-            sys.executable, str(TILE_CONVERTER_SCRIPT),
-            str(tileset_file),
-            str(output_file)
-        ]
+    def __init__(self, description, inputs, output, commands, options=()):
+        self.description = description
+        self.inputs = list(inputs)
+        self.output = Path(output)
+        self.commands = commands
+        self.options = list(options)
+
+    def key(self):
+        """SHA-256 over the inputs, the scripts run and the options"""
+        h = hashlib.sha256()
+        scripts = [Path(c[1]) for c in self.commands if len(c) > 1]
+        for path in sorted(set(self.inputs) | set(scripts)):
+            h.update(str(Path(path).name).encode())
+            h.update(Path(path).read_bytes())
+        for cmd in self.commands:
+            h.update(" ".join(str(c) for c in cmd[2:]).encode())
+        for opt in self.options:
+            h.update(opt.encode())
+        return h.hexdigest()
+
+    def manifest_name(self):
+        return self.output.relative_to(PROJECT_DIR).as_posix()
+
+
+def job_worker(job):
+    """Run a job's commands; returns (job, success, stdout, stderr)"""
+    stdout = ""
+    for cmd in job.commands:
+        ok, out, err = run_quiet(cmd)
+        stdout += out or ""
+        if not ok:
+            return job, False, stdout, err
+    return job, True, stdout, ""
+
+
+def load_manifest():
+    try:
+        return json.loads(HASH_MANIFEST.read_text())
+    except (OSError, ValueError):
+        return {}
 
-        if run_command(cmd, f"Converting tileset: {tileset_file.name}"):
-            converted += 1
-        else:
-            return -1
 
-    return converted
+def save_manifest(manifest):
+    HASH_MANIFEST.parent.mkdir(parents=True, exist_ok=True)
+    HASH_MANIFEST.write_text(json.dumps(manifest, indent=1, sort_keys=True) + "\n")
 
 
-def convert_palettes():
+def run_jobs(jobs, manifest, workers):
     """
-    Convert all palettes from assets_raw/palettes/ to data/palettes/
+    Run the jobs whose output is missing or out of date, in parallel.
+
+    Args:
+        jobs: List of Job
+        manifest: dict of output name -> key (updated in place)
+        workers: Maximum concurrent jobs
 
     Returns:
-        Number of palettes converted, or -1 on error
+        (built, skipped) counts, or (-1, skipped) if any job failed
     """
-    palette_dir = ASSETS_RAW_DIR / "palettes"
-    output_dir = DATA_DIR / "palettes"
-
-    if not palette_dir.exists():
-        print(f"[WARNING] Palette directory not found: {palette_dir}", file=sys.stderr)
-        return 0
-
-    output_dir.mkdir(parents=True, exist_ok=True)
-
-    palette_files = sorted(palette_dir.glob("*.bin"))
-    if not palette_files:
-        print(f"[WARNING] No palette files (*.bin) found in {palette_dir}", file=sys.stderr)
-        return 0
-
-    converted = 0
-    for palette_file in palette_files:
-        output_file = output_dir / f"{palette_file.stem}.ds.pal"
-        cmd = [
-            sys.executable, str(PALETTE_CONVERTER_SCRIPT),
-            str(palette_file),
-            str(output_file)
-        ]
-
-        if run_command(cmd, f"Converting palette: {palette_file.name}"):
-            converted += 1
-        else:
-            return -1
-
-    return converted
-
-
-def convert_tilemaps():
+    pending = []
+    keys = {}
+    for job in jobs:
+        name = job.manifest_name()
+        keys[name] = job.key()
+        if job.output.exists() and manifest.get(name) == keys[name]:
+            continue
+        job.output.parent.mkdir(parents=True, exist_ok=True)
+        pending.append(job)
+
+    skipped = len(jobs) - len(pending)
+    if not pending:
+        return 0, skipped
+
+    failed = False
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        for job, ok, stdout, stderr in pool.map(job_worker, pending):
+            print(f"[*] {job.description}")
+            if stdout:
+                print(stdout, end='')
+            name = job.manifest_name()
+            if ok:
+                manifest[name] = keys[name]
+            else:
+                manifest.pop(name, None)
+                print(f"[ERROR] {job.description} failed:", file=sys.stderr)
+                print(stderr, file=sys.stderr)
+                failed = True
+
+    return (-1 if failed else len(pending)), skipped
+
+
+# ============================================================
+# Stages
+# ============================================================
+
+def conversion_jobs(kind, input_subdir, output_subdir, suffix, script, post=None):
     """
-    Convert all tilemaps from assets_raw/tilemaps/ to data/maps/
+    Build jobs converting assets_raw/<input_subdir>/*.bin into data/<output_subdir>/
+
+    Args:
+        kind: Asset kind for messages ("tileset", "palette", "tilemap")
+        input_subdir: Directory under assets_raw/
+        output_subdir: Directory under data/
+        suffix: Output suffix (e.g. ".ds.bin")
+        script: Converter script
+        post: Optional fn(input_file, output_file, commands) -> (commands, inputs)
+              adjusting the conversion commands; inputs are extra files read
 
     Returns:
-        Number of tilemaps converted, or -1 on error
+        List of Job
     """
-    tilemap_dir = ASSETS_RAW_DIR / "tilemaps"
-    output_dir = DATA_DIR / "maps"
-
-    if not tilemap_dir.exists():
-        print(f"[WARNING] Tilemap directory not found: {tilemap_dir}", file=sys.stderr)
-        return 0
-
-    output_dir.mkdir(parents=True, exist_ok=True)
+    input_dir = ASSETS_RAW_DIR / input_subdir
+    output_dir = DATA_DIR / output_subdir
+
+    if not input_dir.exists():
+        print(f"[WARNING] {kind.capitalize()} directory not found: {input_dir}", file=sys.stderr)
+        return []
+
+    input_files = sorted(input_dir.glob("*.bin"))
+    if not input_files:
+        print(f"[WARNING] No {kind} files (*.bin) found in {input_dir}", file=sys.stderr)
+        return []
+
+    jobs = []
+    for input_file in input_files:
+        output_file = output_dir / f"{input_file.stem}{suffix}"
+        commands = [[sys.executable, str(script), str(input_file), str(output_file)]]
+        inputs = [input_file]
+        if post:
+            commands, extra_inputs = post(input_file, output_file, commands)
+            inputs += extra_inputs
+        jobs.append(Job(f"Converting {kind}: {input_file.name}",
+                        inputs, output_file, commands))
+    return jobs
+
+
+def dedup_step(input_file, output_file, commands):
+    """Deduplicate a converted tileset in place, with its metatile table if extracted"""
+    cmd = [sys.executable, str(TILE_DEDUP_SCRIPT), str(output_file), str(output_file)]
+    inputs = [TILEMAP_CONVERTER_SCRIPT]
+    table = ASSETS_RAW_DIR / "tiletables" / input_file.name
+    if table.exists():
+        cmd += ["--metatiles", str(table)]
+        inputs.append(table)
+    return commands + [cmd], inputs
+
+
+def remap_step(input_file, output_file, commands):
+    """Convert a map against the same-named deduplicated tileset, if there is one"""
+    remap = DATA_DIR / "tiles" / f"{input_file.stem}.ds.bin.remap"
+    if not remap.exists():
+        return commands, []
+    return [commands[0] + ["--remap", str(remap)]] + commands[1:], [remap, TILE_DEDUP_SCRIPT]
+
+
+def room_pack_jobs(compress):
+    """
+    Build the job compiling assets/rooms/*.json into nitrofs/rooms.bin
 
-    tilemap_files = sorted(tilemap_dir.glob("*.bin"))
-    if not tilemap_files:
-        print(f"[WARNING] No tilemap files (*.bin) found in {tilemap_dir}", file=sys.stderr)
-        return 0
+    Args:
+        compress: LC_LZ2-compress the room records
 
-    converted = 0
-    for tilemap_file in tilemap_files:
-        output_file = output_dir / f"{tilemap_file.stem}.ds.map"
-        cmd = [
-            sys.executable, str(TILEMAP_CONVERTER_SCRIPT),
-            str(tilemap_file),
-            str(output_file)
-        ]
+    Returns:
+        List of Job (empty if there are no rooms)
+    """
+    room_files = sorted(ROOMS_DIR.glob("*.json"))
+    if not room_files:
+        print(f"[WARNING] No room files (*.json) found in {ROOMS_DIR}", file=sys.stderr)
+        return []
 
-        if run_command(cmd, f"Converting tilemap: {tilemap_file.name}"):
-            converted += 1
-        else:
-            return -1
+    cmd = [sys.executable, str(ROOM_PACK_SCRIPT), str(ROOMS_DIR), str(NITRO_DIR / "rooms.bin")]
+    if compress:
+        cmd.append("--compress")
 
-    return converted
+    # The packer reads enum names from these headers and imports the compressor
+    inputs = room_files + [PROJECT_DIR / "include" / "enemy.h",
+                           PROJECT_DIR / "include" / "sm_types.h",
+                           LZ_COMPRESS_SCRIPT]
+    return [Job(f"Packing {len(room_files)} rooms", inputs, NITRO_DIR / "rooms.bin", [cmd])]
 
 
 def main():
@@ -213,50 +335,64 @@ def main():
     parser.add_argument("--rom-path", help="Path to Super Metroid ROM (for extraction)")
     parser.add_argument("--force", action="store_true",
                         help="Force re-extraction of ROM even if assets_raw exists")
+    parser.add_argument("--compress", action="store_true",
+                        help="LC_LZ2-compress the room pack records")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count() or 1,
+                        help="Conversions to run in parallel (default: CPU count)")
+    parser.add_argument("--rebuild", action="store_true",
+                        help="Ignore the content hashes and convert everything")
 
     args = parser.parse_args()
+    workers = max(1, args.jobs)
 
     print("=" * 60)
     print("Super Metroid DS - Asset Conversion Pipeline")
     print("=" * 60)
 
     # Stage 1: ROM extraction
+    start = time.perf_counter()
     if not extract_rom(args.rom_path, args.force):
         print("\n[FAILED] ROM extraction failed", file=sys.stderr)
         sys.exit(1)
-
-    # Stage 2: Tile conversion
-    print("\n" + "-" * 60)
-    tileset_count = convert_tilesets()
-    if tileset_count < 0:
-        print("\n[FAILED] Tileset conversion failed", file=sys.stderr)
-        sys.exit(1)
-    print(f"[OK] Converted {tileset_count} tilesets")
-
-    # Stage 3: Palette conversion
-    print("\n" + "-" * 60)
-    palette_count = convert_palettes()
-    if palette_count < 0:
-        print("\n[FAILED] Palette conversion failed", file=sys.stderr)
-        sys.exit(1)
-    print(f"[OK] Converted {palette_count} palettes")
-
-    # Stage 4: Tilemap conversion
-    print("\n" + "-" * 60)
-    tilemap_count = convert_tilemaps()
-    if tilemap_count < 0:
-        print("\n[FAILED] Tilemap conversion failed", file=sys.stderr)
-        sys.exit(1)
-    print(f"[OK] Converted {tilemap_count} tilemaps")
+    timings = [("ROM extraction", None, None, time.perf_counter() - start)]
+
+    manifest = {} if args.rebuild else load_manifest()
+
+    # Stages 2-5: conversions and room pack
+    stages = [
+        ("Tilesets", lambda: conversion_jobs(
+            "tileset", "tilesets", "tiles", ".ds.bin", TILE_CONVERTER_SCRIPT, dedup_step)),
+        ("Palettes", lambda: conversion_jobs(
+            "palette", "palettes", "palettes", ".ds.pal", PALETTE_CONVERTER_SCRIPT)),
+        ("Tilemaps", lambda: conversion_jobs(
+            "tilemap", "tilemaps", "maps", ".ds.map", TILEMAP_CONVERTER_SCRIPT, remap_step)),
+        ("Rooms", lambda: room_pack_jobs(args.compress)),
+    ]
+
+    for title, make_jobs in stages:
+        print("\n" + "-" * 60)
+        start = time.perf_counter()
+        jobs = make_jobs()
+        built, skipped = run_jobs(jobs, manifest, workers)
+        save_manifest(manifest)
+        if built < 0:
+            print(f"\n[FAILED] {title} conversion failed", file=sys.stderr)
+            sys.exit(1)
+        elapsed = time.perf_counter() - start
+        timings.append((title, built, skipped, elapsed))
+        print(f"[OK] {title}: {built} built, {skipped} up to date ({elapsed:.2f}s)")
 
     # Summary
     print("\n" + "=" * 60)
     print("Asset Conversion Complete")
     print("=" * 60)
-    print(f"Tilesets:  {tileset_count}")
-    print(f"Palettes:  {palette_count}")
-    print(f"Tilemaps:  {tilemap_count}")
-    print(f"\nOutput directory: {DATA_DIR}")
+    print(f"{'Stage':<16}{'Built':>7}{'Cached':>8}{'Time':>9}")
+    for title, built, skipped, elapsed in timings:
+        counts = f"{'-':>7}{'-':>8}" if built is None else f"{built:>7}{skipped:>8}"
+        print(f"{title:<16}{counts}{elapsed:>8.2f}s")
+    print(f"{'Total':<16}{'':>15}{sum(t[3] for t in timings):>8.2f}s")
+    print(f"\nJobs: {workers}{'  (compressed room pack)' if args.compress else ''}")
+    print(f"Output directory: {DATA_DIR}")
     print("\nNext step: Run 'make' to build the DS ROM with embedded assets")
 
 
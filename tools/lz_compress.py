@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+lz_compress.py - Super Metroid LC_LZ2 compressor
+
+Produces streams that tools/lz_decompress.py and the on-device
+decompressor (source/lz.c) read back. See lz_decompress.py for the
+command format.
+
+Greedy parse: at each position the run that saves the most bytes wins
+(byte fill, word fill, increasing fill or back reference); anything else
+accumulates into literal runs. Runs are capped at 1024 bytes (10-bit
+extended length) and back references at output offset 0xFFFF.
+"""
+
+import argparse
+import sys
+from pathlib import Path
+
+from lz_decompress import decompress
+
+
+MAX_RUN = 1024
+MAX_SHORT_RUN = 32
+MAX_REF_OFFSET = 0xFFFF
+MAX_CHAIN = 64          # Match candidates tried per position
+
+CMD_LITERAL = 0
+CMD_BYTE_FILL = 1
+CMD_WORD_FILL = 2
+CMD_INC_FILL = 3
+CMD_BACKREF = 4
+
+# Payload bytes following the command header
+PAYLOAD = {CMD_BYTE_FILL: 1, CMD_WORD_FILL: 2, CMD_INC_FILL: 1, CMD_BACKREF: 2}
+
+
+def header(command, length):
+    """
+    Encode a command header.
+
+    Args:
+        command: Command number (0-4)
+        length: Run length in bytes (1-1024)
+
+    Returns:
+        1 or 2 header bytes
+    """
+    n = length - 1
+    if length <= MAX_SHORT_RUN:
+        return bytes([(command << 5) | n])
+    return bytes([0xE0 | (command << 2) | (n >> 8), n & 0xFF])
+
+
+def header_size(length):
+    return 1 if length <= MAX_SHORT_RUN else 2
+
+
+def run_length(data, pos, limit, predicate):
+    """Count bytes from pos (up to limit) for which predicate(i) holds."""
+    n = 0
+    while n < limit and predicate(pos + n, n):
+        n += 1
+    return n
+
+
+def best_run(data, pos, chains):
+    """
+    Find the run at pos that saves the most bytes over literals.
+
+    Args:
+        data: Input bytes
+        pos: Current position
+        chains: dict of 3-byte prefix -> list of earlier positions
+
+    Returns:
+        (command, length, payload bytes) or None
+    """
+    limit = min(MAX_RUN, len(data) - pos)
+    first = data[pos]
+    candidates = []
+
+    n = run_length(data, pos, limit, lambda i, k: data[i] == first)
+    candidates.append((CMD_BYTE_FILL, n, bytes([first])))
+
+    if limit >= 2:
+        pair = data[pos:pos + 2]
+        n = run_length(data, pos, limit, lambda i, k: data[i] == pair[k & 1])
+        candidates.append((CMD_WORD_FILL, n, bytes(pair)))
+
+    n = run_length(data, pos, limit, lambda i, k: data[i] == (first + k) & 0xFF)
+    candidates.append((CMD_INC_FILL, n, bytes([first])))
+
+    if pos + 3 <= len(data):
+        for ref in reversed(chains.get(data[pos:pos + 3], [])[-MAX_CHAIN:]):
+            if ref > MAX_REF_OFFSET:
+                continue
+            n = run_length(data, pos, limit, lambda i, k: data[ref + k] == data[i])
+            candidates.append((CMD_BACKREF, n, bytes([ref & 0xFF, ref >> 8])))
+
+    best = None
+    best_saving = 0
+    for command, length, payload in candidates:
+        saving = length - PAYLOAD[command] - header_size(length)
+        if saving > best_saving:
+            best, best_saving = (command, length, payload), saving
+    return best
+
+
+def compress(data):
+    """
+    Compress bytes into an LC_LZ2 stream (terminated by $FF).
+
+    Args:
+        data: Input bytes
+
+    Returns:
+        Compressed bytes
+    """
+    data = bytes(data)
+    out = bytearray()
+    literal = bytearray()
+    chains = {}
+    pos = 0
+
+    def flush_literal():
+        for i in range(0, len(literal), MAX_RUN):
+            chunk = literal[i:i + MAX_RUN]
+            out.extend(header(CMD_LITERAL, len(chunk)) + chunk)
+        literal.clear()
+
+    def index(start, end):
+        for i in range(start, min(end, len(data) - 2)):
+            chains.setdefault(data[i:i + 3], []).append(i)
+
+    while pos < len(data):
+        run = best_run(data, pos, chains)
+        if run is None:
+            literal.append(data[pos])
+            index(pos, pos + 1)
+            pos += 1
+            continue
+
+        command, length, payload = run
+        flush_literal()
+        out.extend(header(command, length) + payload)
+        index(pos, pos + length)
+        pos += length
+
+    flush_literal()
+    out.append(0xFF)
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compress a file with Super Metroid's LC_LZ2 format"
+    )
+    parser.add_argument("input_file", help="File to compress")
+    parser.add_argument("output_file", help="Compressed output (e.g. tiles.ds.bin.lz)")
+
+    args = parser.parse_args()
+
+    try:
+        data = Path(args.input_file).read_bytes()
+        packed = compress(data)
+        if decompress(packed, max_output=len(data) + 1) != data:
+            raise ValueError("round trip mismatch")
+        Path(args.output_file).write_bytes(packed)
+    except Exception as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    print(f"Compressed {len(data)} -> {len(packed)} bytes into '{args.output_file}'")
+
+
+if __name__ == "__main__":
+    main()
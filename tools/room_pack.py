@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""
+room_pack.py - Compile room definitions into the rooms.bin pack
+
+Reads assets/rooms/*.json and writes one binary pack that room.c reads
+from NitroFS (see include/room_pack.h for the C side of the format).
+
+Room JSON:
+  area, room, tileset, width, height   integers
+  map       list of `height` strings, `width` chars each (legend below)
+  bts       optional [[x, y, value], ...] Block Type Specifier overrides
+  doors     [{dest_area, dest_room, direction, type, x, y, spawn_x, spawn_y}]
+  spawns    [{enemy, x, y, param, properties}]   enemy = EnemyTypeID name
+  items     [{type, x, y}]                       type = ItemTypeID name
+
+Map legend (collision type, metatile):
+  .  air        #  solid wall (1)   =  solid platform (2)
+  C  crumble    X  shot block       B  bomb block
+  S  save       ^  spike            L  lava
+
+Pack layout (little-endian, all offsets from file start):
+  Header   16 bytes   magic "SRPK", u16 version, u16 room_count,
+                      u32 index_offset, u32 file_size
+  Index    12 bytes per room, sorted by key = area << 8 | room:
+                      u16 key, u16 flags, u32 offset, u32 size
+  Room     u16 width, u16 height, u8 tileset, u8 door_count,
+           u8 spawn_count, u8 item_count
+           doors  12 bytes each (DoorData field order)
+           spawns 10 bytes each (EnemySpawnData field order)
+           items   8 bytes each: u16 type, i16 x, i16 y, u16 reserved
+           pad to 4
+           collision[w*h] u8, bts[w*h] u8, pad to 2, tilemap[w*h] u16
+
+With --compress each record is stored LC_LZ2-compressed (lz_compress.py)
+when that is smaller; index flag bit 0 marks it and size is then the
+compressed size.
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+from pathlib import Path
+
+from lz_compress import compress
+
+
+TOOLS_DIR = Path(__file__).parent
+PROJECT_DIR = TOOLS_DIR.parent
+INCLUDE_DIR = PROJECT_DIR / "include"
+
+PACK_MAGIC = b"SRPK"
+PACK_VERSION = 1
+HEADER_SIZE = 16
+INDEX_ENTRY_SIZE = 12
+FLAG_LZ = 0x0001
+
+# Limits from sm_config.h / sm_types.h
+MAX_ROOM_WIDTH_TILES = 64
+MAX_ROOM_HEIGHT_TILES = 32
+MAX_DOORS = 8
+MAX_ENEMIES = 16
+MAX_ITEMS = 32
+
+# Collision types from sm_types.h
+COLL_AIR = 0x00
+COLL_SOLID = 0x01
+COLL_SPECIAL_SHOT = 0x21
+COLL_SPECIAL_BOMB = 0x22
+COLL_SPECIAL_CRUMBLE = 0x23
+COLL_SPECIAL_SAVE = 0x24
+COLL_HAZARD_SPIKE = 0x31
+COLL_HAZARD_LAVA = 0x32
+
+# Map char -> (collision, metatile)
+LEGEND = {
+    ".": (COLL_AIR, 0),
+    "#": (COLL_SOLID, 1),
+    "=": (COLL_SOLID, 2),
+    "C": (COLL_SPECIAL_CRUMBLE, 2),
+    "X": (COLL_SPECIAL_SHOT, 3),
+    "B": (COLL_SPECIAL_BOMB, 3),
+    "S": (COLL_SPECIAL_SAVE, 3),
+    "^": (COLL_HAZARD_SPIKE, 3),
+    "L": (COLL_HAZARD_LAVA, 3),
+}
+
+DIRECTIONS = {"left": 0, "right": 1, "up": 2, "down": 3}
+
+
+def read_enum(header, enum_name, prefix):
+    """
+    Parse a C `typedef enum { ... } enum_name;` into a name -> value dict.
+
+    Names are lowercased with `prefix` stripped (ENEMY_ZOOMER -> zoomer),
+    so room files stay in sync with the headers without a copy here.
+
+    Args:
+        header: Path to the C header
+        enum_name: Typedef name of the enum
+        prefix: Constant prefix to strip
+
+    Returns:
+        dict of name -> integer value
+    """
+    text = Path(header).read_text()
+    match = re.search(r"typedef enum\s*\{([^}]*)\}\s*" + enum_name + r"\s*;", text)
+    if not match:
+        raise ValueError(f"enum {enum_name} not found in {header}")
+
+    values = {}
+    next_value = 0
+    for line in match.group(1).split("\n"):
+        line = re.sub(r"/\*.*?\*/|//.*", "", line).strip().rstrip(",")
+        if not line:
+            continue
+        name, _, value = line.partition("=")
+        name = name.strip()
+        if value.strip():
+            next_value = int(value.strip(), 0)
+        if name.startswith(prefix):
+            values[name[len(prefix):].lower()] = next_value
+        next_value += 1
+    return values
+
+
+def pack_room(room, enemy_ids, item_ids):
+    """
+    Encode one room definition.
+
+    Args:
+        room: Parsed room JSON (dict)
+        enemy_ids: EnemyTypeID name -> value
+        item_ids: ItemTypeID name -> value
+
+    Returns:
+        (key, bytes) for the index and the room record
+    """
+    where = f"room {room.get('area')}:{room.get('room')}"
+    w, h = room["width"], room["height"]
+    if not (0 < w <= MAX_ROOM_WIDTH_TILES and 0 < h <= MAX_ROOM_HEIGHT_TILES):
+        raise ValueError(f"{where}: size {w}x{h} exceeds {MAX_ROOM_WIDTH_TILES}x{MAX_ROOM_HEIGHT_TILES}")
+
+    rows = room["map"]
+    if len(rows) != h or any(len(r) != w for r in rows):
+        raise ValueError(f"{where}: map must be {h} rows of {w} chars")
+
+    doors = room.get("doors", [])
+    spawns = room.get("spawns", [])
+    items = room.get("items", [])
+    if len(doors) > MAX_DOORS or len(spawns) > MAX_ENEMIES or len(items) > MAX_ITEMS:
+        raise ValueError(f"{where}: too many doors/spawns/items")
+
+    collision = bytearray(w * h)
+    bts = bytearray(w * h)
+    tilemap = []
+    for y, row in enumerate(rows):
+        for x, c in enumerate(row):
+            if c not in LEGEND:
+                raise ValueError(f"{where}: unknown map char '{c}' at ({x}, {y})")
+            coll, tile = LEGEND[c]
+            collision[y * w + x] = coll
+            tilemap.append(tile)
+    for x, y, value in room.get("bts", []):
+        bts[y * w + x] = value
+
+    out = bytearray(struct.pack("<HHBBBB", w, h, room.get("tileset", 0),
+                                len(doors), len(spawns), len(items)))
+    for d in doors:
+        out += struct.pack("<BBBBHHHH", d["dest_area"], d["dest_room"],
+                           DIRECTIONS[d["direction"]], d.get("type", 0),
+                           d["x"], d["y"], d["spawn_x"], d["spawn_y"])
+    for s in spawns:
+        out += struct.pack("<HhhHH", enemy_ids[s["enemy"]], s["x"], s["y"],
+                           s.get("param", 0), s.get("properties", 0))
+    for it in items:
+        out += struct.pack("<HhhH", item_ids[it["type"]], it["x"], it["y"], 0)
+
+    out += bytes(-len(out) % 4)
+    out += collision + bts
+    out += bytes(-len(out) % 2)
+    out += struct.pack(f"<{w * h}H", *tilemap)
+
+    key = (room["area"] << 8) | room["room"]
+    return key, bytes(out)
+
+
+def build_pack(room_files, use_lz=False):
+    """
+    Build the pack image from room JSON files.
+
+    Args:
+        room_files: Iterable of paths to room JSON files
+        use_lz: Store records LC_LZ2-compressed where that is smaller
+
+    Returns:
+        Pack bytes
+    """
+    enemy_ids = read_enum(INCLUDE_DIR / "enemy.h", "EnemyTypeID", "ENEMY_")
+    item_ids = read_enum(INCLUDE_DIR / "sm_types.h", "ItemTypeID", "ITEM_")
+
+    records = {}
+    for path in room_files:
+        room = json.loads(Path(path).read_text())
+        key, data = pack_room(room, enemy_ids, item_ids)
+        if key in records:
+            raise ValueError(f"{path}: duplicate room {key >> 8}:{key & 0xFF}")
+        records[key] = data
+
+    keys = sorted(records)
+    index_offset = HEADER_SIZE
+    offset = index_offset + INDEX_ENTRY_SIZE * len(keys)
+
+    index = bytearray()
+    body = bytearray()
+    for key in keys:
+        data = records[key]
+        flags = 0
+        if use_lz:
+            packed = compress(data)
+            if len(packed) < len(data):
+                data, flags = packed, FLAG_LZ
+        index += struct.pack("<HHII", key, flags, offset + len(body), len(data))
+        body += data + bytes(-len(data) % 4)
+
+    file_size = offset + len(body)
+    header = PACK_MAGIC + struct.pack("<HHII", PACK_VERSION, len(keys),
+                                      index_offset, file_size)
+    return header + index + body
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compile room JSON definitions into a rooms.bin pack"
+    )
+    parser.add_argument("room_dir", help="Directory of room JSON files")
+    parser.add_argument("output_file", help="Output pack (e.g. nitrofs/rooms.bin)")
+    parser.add_argument("--compress", action="store_true",
+                        help="LC_LZ2-compress room records")
+
+    args = parser.parse_args()
+
+    try:
+        room_files = sorted(Path(args.room_dir).glob("*.json"))
+        if not room_files:
+            raise ValueError(f"no room files in {args.room_dir}")
+        pack = build_pack(room_files, args.compress)
+        out = Path(args.output_file)
+        out.parent.mkdir(parents=True, exist_ok=True)
+        out.write_bytes(pack)
+    except Exception as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    print(f"Packed {len(room_files)} rooms ({len(pack)} bytes) into '{args.output_file}'")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""
+tcm_report.py - Report what the linker placed in ITCM / DTCM
+
+Parses the GNU ld map written by the DS build (build/SuperMetroidDS.map,
+from -Wl,-Map in the Makefile) and lists every symbol in the ARM9 tightly
+coupled memories with its size and object file, then checks the totals
+against the budgets:
+
+  ITCM: 32KB code (.itcm)
+  DTCM: 16KB shared with the stack; SM_DTCM (.dtcm) + SM_DTCM_BSS (.sbss)
+        must leave DTCM_STACK_RESERVE bytes free
+
+Code is placed with the SM_ITCM / SM_DTCM / SM_DTCM_BSS macros in
+include/sm_types.h. Exit status is 1 if a budget is exceeded.
+"""
+
+import argparse
+import re
+import sys
+
+ITCM_SIZE = 32 * 1024
+DTCM_SIZE = 16 * 1024
+DTCM_STACK_RESERVE = 10 * 1024
+
+# Output section -> memory it lives in
+TCM_SECTIONS = {
+    ".itcm": "ITCM",
+    ".dtcm": "DTCM",
+    ".sbss": "DTCM",
+}
+
+INPUT_RE = re.compile(r"^\s(\.\S+)?\s*(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S+)")
+SYMBOL_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)\s*$")
+OUTPUT_RE = re.compile(r"^(\.\S+)")
+
+
+def parse_map(path):
+    """
+    Collect TCM input sections and the symbols inside them.
+
+    Returns:
+        list of dicts: {section, memory, addr, size, obj, symbols: [(addr, name)]}
+    """
+    entries = []
+    current_out = None
+    pending_name = None
+    in_map = False
+
+    with open(path, "r", errors="replace") as f:
+        for raw in f:
+            line = raw.rstrip("\n")
+
+            if line.startswith("Linker script and memory map"):
+                in_map = True
+                continue
+            if not in_map:
+                continue
+
+            m = OUTPUT_RE.match(line)
+            if m:
+                current_out = m.group(1)
+                continue
+            if current_out not in TCM_SECTIONS:
+                continue
+
+            # Long input section names wrap onto the next line
+            stripped = line.strip()
+            if stripped.startswith(".") and len(stripped.split()) == 1:
+                pending_name = stripped
+                continue
+
+            m = INPUT_RE.match(line)
+            if m and not SYMBOL_RE.match(line):
+                size = int(m.group(3), 16)
+                if size:
+                    entries.append({
+                        "section": m.group(1) or pending_name or current_out,
+                        "memory": TCM_SECTIONS[current_out],
+                        "addr": int(m.group(2), 16),
+                        "size": size,
+                        "obj": m.group(4).split("/")[-1],
+                        "symbols": [],
+                    })
+                pending_name = None
+                continue
+
+            m = SYMBOL_RE.match(line)
+            if m and entries:
+                addr = int(m.group(1), 16)
+                last = entries[-1]
+                if last["addr"] <= addr < last["addr"] + last["size"]:
+                    last["symbols"].append((addr, m.group(2)))
+
+    return entries
+
+
+def symbol_sizes(entry):
+    """Size each symbol by the distance to the next one in its section."""
+    syms = sorted(entry["symbols"])
+    end = entry["addr"] + entry["size"]
+    if not syms:
+        return [(entry["section"], entry["size"])]
+    out = []
+    for i, (addr, name) in enumerate(syms):
+        nxt = syms[i + 1][0] if i + 1 < len(syms) else end
+        out.append((name, nxt - addr))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="List ITCM/DTCM contents from the ARM9 link map and check budgets"
+    )
+    parser.add_argument("map_file", nargs="?", default="build/SuperMetroidDS.map",
+                        help="Linker map (default: build/SuperMetroidDS.map)")
+    parser.add_argument("--stack-reserve", type=int, default=DTCM_STACK_RESERVE,
+                        help=f"DTCM bytes kept for the stack (default: {DTCM_STACK_RESERVE})")
+    args = parser.parse_args()
+
+    try:
+        entries = parse_map(args.map_file)
+    except OSError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    totals = {"ITCM": 0, "DTCM": 0}
+    for memory in ("ITCM", "DTCM"):
+        print(f"{memory}:")
+        for e in (e for e in entries if e["memory"] == memory):
+            totals[memory] += e["size"]
+            for name, size in symbol_sizes(e):
+                print(f"  {size:6d}  {name:32s} {e['obj']}")
+        print()
+
+    dtcm_budget = DTCM_SIZE - args.stack_reserve
+    ok = True
+    for memory, used, budget in (("ITCM", totals["ITCM"], ITCM_SIZE),
+                                 ("DTCM", totals["DTCM"], dtcm_budget)):
+        pct = used * 100 // budget if budget else 0
+        flag = "" if used <= budget else "  OVER BUDGET"
+        print(f"{memory}: {used} / {budget} bytes ({pct}%){flag}")
+        ok = ok and used <= budget
+
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -15,10 +15,18 @@ SNES 4bpp planar format (32 bytes per 8x8 tile):
 DS 4bpp linear format (32 bytes per 8x8 tile):
   Each byte holds 2 pixels (low nibble = even pixel, high nibble = odd pixel)
   4 bytes per row, 32 bytes per tile
+
+Whole tilesets go through convert_tileset(), which works a row at a time
+with lookup tables: one DS row is a little-endian u32 whose nibble x is
+pixel x, so each bitplane byte maps to a fixed "spread" of its bits and
+the row is the OR of the four shifted spreads, looked up in a 64K table
+indexed by each interleaved plane pair. It matches
+snes_4bpp_to_ds_4bpp_tile() exactly (check with --verify).
 """
 
 import argparse
 import sys
+from array import array
 
 
 def snes_4bpp_to_ds_4bpp_tile(snes_data):
@@ -65,7 +73,79 @@ def snes_4bpp_to_ds_4bpp_tile(snes_data):
     return ds_data
 
 
-def convert_tiles(input_path, output_path, tile_size=32):
+def _spread(b):
+    """Bitplane byte (MSB = leftmost pixel) -> bit 0 of nibble x for pixel x"""
+    value = 0
+    for x in range(8):
+        if b & (0x80 >> x):
+            value |= 1 << (4 * x)
+    return value
+
+
+SPREAD = [_spread(b) for b in range(256)]
+_pair_table = None
+
+
+def _pair_lut():
+    """64K table: LE u16 (plane n | plane n+1 << 8) -> spread(n) | spread(n+1) << 1"""
+    global _pair_table
+    if _pair_table is None:
+        _pair_table = array("I", (SPREAD[w & 0xFF] | (SPREAD[w >> 8] << 1)
+                                  for w in range(0x10000)))
+    return _pair_table
+
+
+def convert_tileset(snes_data):
+    """
+    Convert whole SNES 4bpp tiles to DS 4bpp in one batch.
+
+    Args:
+        snes_data: bytes whose length is a multiple of 32
+
+    Returns:
+        bytes of DS tile data (same length)
+    """
+    if len(snes_data) % 32 != 0:
+        raise ValueError(f"Tile data must be a multiple of 32 bytes, got {len(snes_data)}")
+    if not snes_data:
+        return b""
+
+    # Plane pairs (0,1) and (2,3) are byte-interleaved, so each row's pair
+    # is one LE u16: words 0-7 of a tile are rows 0-7 of planes 0/1,
+    # words 8-15 the same rows of planes 2/3.
+    words = array("H", bytes(snes_data))
+    if sys.byteorder == "big":
+        words.byteswap()
+    pair = _pair_lut()
+    rows = array("I", bytes(4 * (len(words) // 2)))
+    for base in range(0, len(words), 16):
+        out = base // 2
+        for y in range(8):
+            rows[out + y] = pair[words[base + y]] | (pair[words[base + 8 + y]] << 2)
+    if sys.byteorder == "big":
+        rows.byteswap()
+    return rows.tobytes()
+
+
+def verify_tileset(snes_data):
+    """
+    Check convert_tileset() against the per-tile reference.
+
+    Args:
+        snes_data: bytes whose length is a multiple of 32
+
+    Returns:
+        Index of the first mismatching tile, or -1 if identical
+    """
+    batch = convert_tileset(snes_data)
+    for i in range(len(snes_data) // 32):
+        ref = snes_4bpp_to_ds_4bpp_tile(snes_data[i * 32:(i + 1) * 32])
+        if batch[i * 32:(i + 1) * 32] != ref:
+            return i
+    return -1
+
+
+def convert_tiles(input_path, output_path, tile_size=32, verify=False):
     """
     Convert a file of SNES tiles to DS format.
 
@@ -73,6 +153,7 @@ def convert_tiles(input_path, output_path, tile_size=32):
         input_path: Path to input file containing SNES tile data
         output_path: Path to output file for DS tile data
         tile_size: Size of each tile in bytes (default 32 for 4bpp)
+        verify: Also convert tile by tile and fail on any difference
     """
     with open(input_path, 'rb') as f:
         snes_data = f.read()
@@ -81,19 +162,22 @@ def convert_tiles(input_path, output_path, tile_size=32):
         print(f"Warning: Input file size ({len(snes_data)} bytes) is not a multiple of tile_size ({tile_size})",
               file=sys.stderr)
 
-    ds_data = bytearray()
-    tile_count = 0
-
-    for offset in range(0, len(snes_data), tile_size):
-        snes_tile = snes_data[offset:offset + tile_size]
+    tile_count = len(snes_data) // tile_size
+    whole = tile_count * tile_size
+    if whole < len(snes_data):
+        print(f"Warning: Partial tile at offset {whole} ({len(snes_data) - whole} bytes), skipping",
+              file=sys.stderr)
 
-        if len(snes_tile) == tile_size:
-            ds_tile = snes_4bpp_to_ds_4bpp_tile(snes_tile)
-            ds_data.extend(ds_tile)
-            tile_count += 1
-        else:
-            print(f"Warning: Partial tile at offset {offset} ({len(snes_tile)} bytes), skipping",
-                  file=sys.stderr)
+    if tile_size == 32:
+        ds_data = convert_tileset(snes_data[:whole])
+        if verify:
+            bad = verify_tileset(snes_data[:whole])
+            if bad >= 0:
+                raise ValueError(f"batch conversion differs from reference at tile {bad}")
+    else:
+        ds_data = bytearray()
+        for offset in range(0, whole, tile_size):
+            ds_data.extend(snes_4bpp_to_ds_4bpp_tile(snes_data[offset:offset + tile_size]))
 
     with open(output_path, 'wb') as f:
         f.write(ds_data)
@@ -109,11 +193,13 @@ def main():
     parser.add_argument("output_file", help="Output file for DS tile data")
     parser.add_argument("--tile_size", type=int, default=32,
                         help="Size of each tile in bytes (default: 32 for 4bpp)")
+    parser.add_argument("--verify", action="store_true",
+                        help="Check the batch conversion against the per-tile reference")
 
     args = parser.parse_args()
 
     try:
-        convert_tiles(args.input_file, args.output_file, args.tile_size)
+        convert_tiles(args.input_file, args.output_file, args.tile_size, args.verify)
     except Exception as e:
         print(f"Error: {e}", file=sys.stderr)
         sys.exit(1)
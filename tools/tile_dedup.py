@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+tile_dedup.py - Deduplicate DS 4bpp tiles (including flipped copies)
+
+Input is a converted DS 4bpp tileset (tile_converter.py output). Tiles
+that are identical to an earlier tile, or to its H-, V- or HV-flipped
+form, are dropped; references to them become the kept tile plus flip
+bits, which the DS BG map applies for free.
+
+Outputs:
+  <out>            deduplicated tiles (DS 4bpp, 32 bytes each)
+  <out>.remap      u16 per input tile: new index | H-flip << 10 | V-flip << 11
+                   (tilemap_converter.py --remap applies it to 8x8 maps)
+  <out>.mtd        with --metatiles: one MetatileDef per metatile, four
+                   DS BG map entries (TL, TR, BL, BR) into the new set.
+                   Read by room.c's metatile expansion.
+
+--metatiles takes the tileset's SNES tile table: 8 bytes per 16x16
+metatile, four SNES BG entries (TL, TR, BL, BR) in the format
+tilemap_converter.py documents. Entry flips compose with the dedup
+flips (XOR), since flips commute.
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+from tilemap_converter import snes_tilemap_to_ds_bgmap
+
+
+TILE_BYTES = 32
+ROW_BYTES = 4
+HFLIP = 1 << 10
+VFLIP = 1 << 11
+INDEX_MASK = 0x03FF
+
+# Swap the two pixels (nibbles) of every byte
+_NIBBLE_SWAP = bytes(((b & 0x0F) << 4) | (b >> 4) for b in range(256))
+
+
+def hflip(tile):
+    """Mirror a DS 4bpp tile left-right"""
+    rows = [tile[y * ROW_BYTES:(y + 1) * ROW_BYTES] for y in range(8)]
+    return b"".join(bytes(reversed(r)).translate(_NIBBLE_SWAP) for r in rows)
+
+
+def vflip(tile):
+    """Mirror a DS 4bpp tile top-bottom"""
+    rows = [tile[y * ROW_BYTES:(y + 1) * ROW_BYTES] for y in range(8)]
+    return b"".join(reversed(rows))
+
+
+def dedup_tiles(data):
+    """
+    Deduplicate tiles up to flipping.
+
+    Args:
+        data: DS 4bpp tile bytes (multiple of 32)
+
+    Returns:
+        (unique tile bytes, remap list of u16 per input tile)
+    """
+    if len(data) % TILE_BYTES != 0:
+        raise ValueError(f"Tile data must be a multiple of {TILE_BYTES} bytes, got {len(data)}")
+
+    seen = {}           # tile bytes (any flip of a kept tile) -> remap entry
+    unique = bytearray()
+    remap = []
+
+    for offset in range(0, len(data), TILE_BYTES):
+        tile = bytes(data[offset:offset + TILE_BYTES])
+        entry = seen.get(tile)
+        if entry is None:
+            index = len(unique) // TILE_BYTES
+            if index > INDEX_MASK:
+                raise ValueError("more than 1024 unique tiles; BG map indices are 10-bit")
+            unique += tile
+            h = hflip(tile)
+            # First variant registered wins, so exact matches keep no flip
+            for variant, flips in ((tile, 0), (h, HFLIP), (vflip(tile), VFLIP),
+                                   (vflip(h), HFLIP | VFLIP)):
+                seen.setdefault(variant, index | flips)
+            entry = index
+        remap.append(entry)
+
+    return bytes(unique), remap
+
+
+def remap_entry(ds_entry, remap):
+    """Point a DS BG map entry at the deduplicated set, composing flips"""
+    tile = ds_entry & INDEX_MASK
+    if tile >= len(remap):
+        raise ValueError(f"tile {tile} out of range ({len(remap)} tiles)")
+    target = remap[tile]
+    return (ds_entry & ~(INDEX_MASK | HFLIP | VFLIP)) | (target & INDEX_MASK) | \
+           ((ds_entry ^ target) & (HFLIP | VFLIP))
+
+
+def build_metatiles(snes_table, remap):
+    """
+    Convert an SNES tile table into MetatileDefs over the deduplicated set.
+
+    Args:
+        snes_table: bytes, 8 per metatile (4 SNES BG entries)
+        remap: Remap list from dedup_tiles()
+
+    Returns:
+        bytes of MetatileDefs (4 little-endian u16 each)
+    """
+    if len(snes_table) % 8 != 0:
+        raise ValueError(f"Tile table must be 8 bytes per metatile, got {len(snes_table)}")
+    ds = snes_tilemap_to_ds_bgmap(snes_table)
+    entries = struct.unpack(f"<{len(ds) // 2}H", ds)
+    return struct.pack(f"<{len(entries)}H", *(remap_entry(e, remap) for e in entries))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Deduplicate DS 4bpp tiles including H/V-flipped variants"
+    )
+    parser.add_argument("input_file", help="DS 4bpp tileset (tile_converter.py output)")
+    parser.add_argument("output_file", help="Deduplicated tileset (may equal input_file)")
+    parser.add_argument("--metatiles", help="SNES tile table (8 bytes per metatile)")
+
+    args = parser.parse_args()
+
+    try:
+        data = Path(args.input_file).read_bytes()
+        unique, remap = dedup_tiles(data)
+        out = Path(args.output_file)
+        out.write_bytes(unique)
+        Path(str(out) + ".remap").write_bytes(struct.pack(f"<{len(remap)}H", *remap))
+        metatiles = 0
+        if args.metatiles:
+            mtd = build_metatiles(Path(args.metatiles).read_bytes(), remap)
+            Path(str(out) + ".mtd").write_bytes(mtd)
+            metatiles = len(mtd) // 8
+    except Exception as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    kept = len(unique) // TILE_BYTES
+    total = len(data) // TILE_BYTES
+    msg = f"Deduplicated {total} -> {kept} tiles"
+    if metatiles:
+        msg += f", {metatiles} metatiles"
+    print(f"{msg} into '{args.output_file}'")
+
+
+if __name__ == "__main__":
+    main()
@@ -15,10 +15,15 @@ DS BG map entry (2 bytes, 16-bit little-endian):
   Bit 10:     H-flip
   Bit 11:     V-flip
   Bits 12-15: Palette (4 bits)
+
+With --remap, tile indices are redirected through a tile_dedup.py remap
+file so the map references the deduplicated tileset (flips composed).
 """
 
 import argparse
+import struct
 import sys
+from pathlib import Path
 
 
 def snes_tilemap_to_ds_bgmap(snes_data):
@@ -65,19 +70,27 @@ def snes_tilemap_to_ds_bgmap(snes_data):
     return ds_data
 
 
-def convert_tilemap(input_path, output_path):
+def convert_tilemap(input_path, output_path, remap_path=None):
     """
     Convert SNES tilemap file to DS BG map format.
 
     Args:
         input_path: Path to input tilemap file
         output_path: Path to output BG map file
+        remap_path: Optional tile_dedup.py .remap file for the tileset
     """
     with open(input_path, 'rb') as f:
         snes_data = f.read()
 
     ds_data = snes_tilemap_to_ds_bgmap(snes_data)
 
+    if remap_path:
+        from tile_dedup import remap_entry
+        raw = Path(remap_path).read_bytes()
+        remap = struct.unpack(f"<{len(raw) // 2}H", raw)
+        entries = struct.unpack(f"<{len(ds_data) // 2}H", ds_data)
+        ds_data = struct.pack(f"<{len(entries)}H", *(remap_entry(e, remap) for e in entries))
+
     with open(output_path, 'wb') as f:
         f.write(ds_data)
 
@@ -91,11 +104,12 @@ def main():
     )
     parser.add_argument("input_file", help="Input tilemap file (SNES format)")
     parser.add_argument("output_file", help="Output BG map file (DS format)")
+    parser.add_argument("--remap", help="tile_dedup.py .remap file for the tileset")
 
     args = parser.parse_args()
 
     try:
-        convert_tilemap(args.input_file, args.output_file)
+        convert_tilemap(args.input_file, args.output_file, args.remap)
     except Exception as e:
         print(f"Error: {e}", file=sys.stderr)
         sys.exit(1)